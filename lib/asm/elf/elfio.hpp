@@ -40,6 +40,19 @@ namespace elf {
             create_mandatory_sections();
         }
 
+        //------------------------------------------------------------------------------
+        //! \brief Move constructor. Sections and Segments must point to the new object.
+        elfio(elfio &&other) noexcept:
+            sections(this),
+            segments(this),
+            header(std::move(other.header)),
+            sections_(std::move(other.sections_)),
+            segments_(std::move(other.segments_)),
+            current_file_pos(other.current_file_pos) {}
+
+        elfio(const elfio &) = delete;
+        elfio &operator=(const elfio &) = delete;
+
         //------------------------------------------------------------------------------
         //! \brief Save the ELF file to a file
         //! \param file_name The name of the file to save to
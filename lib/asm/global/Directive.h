@@ -2,6 +2,7 @@
 
 #include "asm/global/AssembleSlot.h"
 #include "asm/global/Slot.h"
+#include "base/global/GValueKind.h"
 #include "asm/x64/Assembler.h"
 #include "asm/x64/Relocation.h"
 
@@ -9,13 +10,18 @@
 namespace aasm {
     class Directive final {
     public:
-        explicit Directive(const Symbol* symbol, Slot&& slot) noexcept:
+        explicit Directive(const Symbol* symbol, Slot&& slot, const GValueKind kind) noexcept:
             m_symbol(symbol),
+            m_kind(kind),
             m_slot(std::move(slot)) {}
 
         [[nodiscard]]
         const Symbol* symbol() const noexcept { return m_symbol; }
 
+        /** Constant directives may be placed in read-only memory. */
+        [[nodiscard]]
+        GValueKind kind() const noexcept { return m_kind; }
+
         template<CodeBuffer Buffer>
         [[nodiscard]]
         constexpr std::vector<Relocation> emit(Buffer& buffer) const {
@@ -31,6 +37,7 @@ namespace aasm {
 
     private:
         const Symbol* m_symbol;
+        GValueKind m_kind;
         Slot m_slot;
     };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <deque>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -10,11 +11,25 @@
 namespace aasm {
     /**
      * Represents a symbol in the assembly code, which can be a label or a function name.
+     * Lookups and insertions are synchronized, so the table can be shared between codegen workers.
      */
     class SymbolTable final {
     public:
+        SymbolTable() = default;
+
+        SymbolTable(SymbolTable&& other) noexcept:
+            m_symbols(std::move(other.m_symbols)),
+            m_symbol_map(std::move(other.m_symbol_map)) {}
+
+        SymbolTable& operator=(SymbolTable&& other) noexcept {
+            m_symbols = std::move(other.m_symbols);
+            m_symbol_map = std::move(other.m_symbol_map);
+            return *this;
+        }
+
         std::pair<const Symbol*, bool> add(const std::string_view name, const BindAttribute bind) {
             assertion(!name.empty(), "Symbol name cannot be empty");
+            std::lock_guard guard(m_lock);
             if (const auto it = m_symbol_map.find(std::string(name)); it != m_symbol_map.end()) { //TODO string creation
                 return {it->second, false};
             }
@@ -26,6 +41,7 @@ namespace aasm {
 
         std::optional<const Symbol*> find(const std::string& name) const {
             assertion(!name.empty(), "Symbol name cannot be empty");
+            std::lock_guard guard(m_lock);
             if (const auto it = m_symbol_map.find(name); it != m_symbol_map.end()) {
                 return it->second;
             }
@@ -34,6 +50,7 @@ namespace aasm {
         }
 
     private:
+        mutable std::mutex m_lock;
         std::deque<Symbol> m_symbols;
         std::unordered_map<std::string, const Symbol*> m_symbol_map;
     };
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Assembler.h"
+#include "Peephole.h"
 
 namespace aasm {
     /**
@@ -24,6 +25,14 @@ namespace aasm {
             return details::Assembler::assemble(buffer, m_instructions, m_label_table);
         }
 
+        /**
+         * Runs the peephole optimizer over the instructions.
+         * @return how many times each rule fired.
+         */
+        PeepholeStats optimize() {
+            return Peephole::run(m_instructions, m_label_table);
+        }
+
         /**
          * Returns a number of instructions.
          */
@@ -219,6 +219,10 @@ namespace aasm {
             m_instructions.emplace_back(details::CallM(addr));
         }
 
+        constexpr void call(const GPReg reg) {
+            m_instructions.emplace_back(details::CallR(reg));
+        }
+
         // Move With Zero-Extend
         constexpr void movzx(const std::uint8_t src_size, const std::uint8_t dst_size, const GPReg src, const GPReg dst) {
             m_instructions.emplace_back(details::MovzxRR(src_size, dst_size, src, dst));
@@ -254,6 +258,32 @@ namespace aasm {
             m_instructions.emplace_back(details::NegM(size, addr));
         }
 
+        // One's Complement Negation
+        constexpr void nnot(const std::uint8_t size, const GPReg r) {
+            m_instructions.emplace_back(details::NotR(size, r));
+        }
+
+        constexpr void nnot(const std::uint8_t size, const Address& addr) {
+            m_instructions.emplace_back(details::NotM(size, addr));
+        }
+
+        // IMUL — Signed Multiply
+        constexpr void imul(const std::uint8_t size, const GPReg src, const GPReg dst) {
+            m_instructions.emplace_back(details::ImulRR(size, src, dst));
+        }
+
+        constexpr void imul(const std::uint8_t size, const Address& src, const GPReg dst) {
+            m_instructions.emplace_back(details::ImulRM(size, src, dst));
+        }
+
+        constexpr void imul(const std::uint8_t size, const std::int32_t imm, const GPReg src, const GPReg dst) {
+            m_instructions.emplace_back(details::ImulRRI(size, imm, src, dst));
+        }
+
+        constexpr void imul(const std::uint8_t size, const std::int32_t imm, const Address& src, const GPReg dst) {
+            m_instructions.emplace_back(details::ImulRMI(size, imm, src, dst));
+        }
+
         // IDIV — Signed Divide
         constexpr void idiv(const std::uint8_t size, const GPReg divisor) {
             m_instructions.emplace_back(details::IdivR(size, divisor));
@@ -500,6 +530,258 @@ namespace aasm {
             m_instructions.emplace_back(details::Cvtsi2sdRM(to_size, src, dst));
         }
 
+        // Move Unaligned Packed Single Precision Floating-Point Values
+        constexpr void vmovups(const std::uint8_t size, const XmmReg src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmovupsRR(size, src, dst));
+        }
+
+        constexpr void vmovups(const std::uint8_t size, const Address& src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmovupsRM(size, src, dst));
+        }
+
+        constexpr void vmovups(const std::uint8_t size, const XmmReg src, const Address& dst) {
+            m_instructions.emplace_back(details::VmovupsMR(size, src, dst));
+        }
+
+        // Move Doubleword/Quadword
+        constexpr void vmovd(const std::uint8_t size, const GPReg src, const XmmReg dst) {
+            switch (size) {
+                case 4: m_instructions.emplace_back(details::VmovdRR(src, dst)); break;
+                case 8: m_instructions.emplace_back(details::VmovqRR(src, dst)); break;
+                default: die("Invalid size for vmovd: {}", static_cast<unsigned>(size));
+            }
+        }
+
+        // Add Packed Single Precision Floating-Point Values
+        constexpr void vaddps(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VaddpsRR(size, src2, src1, dst));
+        }
+
+        constexpr void vaddps(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VaddpsRM(size, src2, src1, dst));
+        }
+
+        // Add Packed Double Precision Floating-Point Values
+        constexpr void vaddpd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VaddpdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vaddpd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VaddpdRM(size, src2, src1, dst));
+        }
+
+        // Add Packed Doubleword Integers
+        constexpr void vpaddd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpadddRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpaddd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpadddRM(size, src2, src1, dst));
+        }
+
+        // Add Packed Quadword Integers
+        constexpr void vpaddq(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpaddqRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpaddq(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpaddqRM(size, src2, src1, dst));
+        }
+
+        // Subtract Packed Single Precision Floating-Point Values
+        constexpr void vsubps(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VsubpsRR(size, src2, src1, dst));
+        }
+
+        constexpr void vsubps(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VsubpsRM(size, src2, src1, dst));
+        }
+
+        // Subtract Packed Double Precision Floating-Point Values
+        constexpr void vsubpd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VsubpdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vsubpd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VsubpdRM(size, src2, src1, dst));
+        }
+
+        // Subtract Packed Doubleword Integers
+        constexpr void vpsubd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpsubdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpsubd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpsubdRM(size, src2, src1, dst));
+        }
+
+        // Subtract Packed Quadword Integers
+        constexpr void vpsubq(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpsubqRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpsubq(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpsubqRM(size, src2, src1, dst));
+        }
+
+        // Multiply Packed Single Precision Floating-Point Values
+        constexpr void vmulps(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmulpsRR(size, src2, src1, dst));
+        }
+
+        constexpr void vmulps(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmulpsRM(size, src2, src1, dst));
+        }
+
+        // Multiply Packed Double Precision Floating-Point Values
+        constexpr void vmulpd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmulpdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vmulpd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VmulpdRM(size, src2, src1, dst));
+        }
+
+        // Multiply Packed Doubleword Integers and Store Low Result
+        constexpr void vpmulld(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpmulldRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpmulld(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpmulldRM(size, src2, src1, dst));
+        }
+
+        // Divide Packed Single Precision Floating-Point Values
+        constexpr void vdivps(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VdivpsRR(size, src2, src1, dst));
+        }
+
+        constexpr void vdivps(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VdivpsRM(size, src2, src1, dst));
+        }
+
+        // Divide Packed Double Precision Floating-Point Values
+        constexpr void vdivpd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VdivpdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vdivpd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VdivpdRM(size, src2, src1, dst));
+        }
+
+        // Bitwise Logical XOR of Packed Single Precision Floating-Point Values
+        constexpr void vxorps(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VxorpsRR(size, src2, src1, dst));
+        }
+
+        constexpr void vxorps(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VxorpsRM(size, src2, src1, dst));
+        }
+
+        // Compare Packed Doubleword Integers for Equality
+        constexpr void vpcmpeqd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpeqdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpcmpeqd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpeqdRM(size, src2, src1, dst));
+        }
+
+        // Compare Packed Quadword Integers for Equality
+        constexpr void vpcmpeqq(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpeqqRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpcmpeqq(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpeqqRM(size, src2, src1, dst));
+        }
+
+        // Compare Packed Signed Doubleword Integers for Greater Than
+        constexpr void vpcmpgtd(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpgtdRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpcmpgtd(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpgtdRM(size, src2, src1, dst));
+        }
+
+        // Compare Packed Signed Quadword Integers for Greater Than
+        constexpr void vpcmpgtq(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpgtqRR(size, src2, src1, dst));
+        }
+
+        constexpr void vpcmpgtq(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpcmpgtqRM(size, src2, src1, dst));
+        }
+
+        // Compare Packed Single Precision Floating-Point Values
+        constexpr void vcmpps(const std::uint8_t size, const VcmpPredicate predicate, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VcmppsRR(size, static_cast<std::uint8_t>(predicate), src2, src1, dst));
+        }
+
+        constexpr void vcmpps(const std::uint8_t size, const VcmpPredicate predicate, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VcmppsRM(size, static_cast<std::uint8_t>(predicate), src2, src1, dst));
+        }
+
+        // Compare Packed Double Precision Floating-Point Values
+        constexpr void vcmppd(const std::uint8_t size, const VcmpPredicate predicate, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VcmppdRR(size, static_cast<std::uint8_t>(predicate), src2, src1, dst));
+        }
+
+        constexpr void vcmppd(const std::uint8_t size, const VcmpPredicate predicate, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VcmppdRM(size, static_cast<std::uint8_t>(predicate), src2, src1, dst));
+        }
+
+        // Packed Interleave Shuffle of Single Precision Floating-Point Values
+        constexpr void vshufps(const std::uint8_t size, const std::uint8_t imm, const XmmReg src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VshufpsRR(size, imm, src2, src1, dst));
+        }
+
+        constexpr void vshufps(const std::uint8_t size, const std::uint8_t imm, const Address& src2, const XmmReg src1, const XmmReg dst) {
+            m_instructions.emplace_back(details::VshufpsRM(size, imm, src2, src1, dst));
+        }
+
+        // Broadcast Single Precision Floating-Point Value
+        constexpr void vbroadcastss(const std::uint8_t size, const XmmReg src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VbroadcastssRR(size, src, dst));
+        }
+
+        constexpr void vbroadcastss(const std::uint8_t size, const Address& src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VbroadcastssRM(size, src, dst));
+        }
+
+        // Broadcast Double Precision Floating-Point Value
+        constexpr void vbroadcastsd(const std::uint8_t size, const XmmReg src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VbroadcastsdRR(size, src, dst));
+        }
+
+        constexpr void vbroadcastsd(const std::uint8_t size, const Address& src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VbroadcastsdRM(size, src, dst));
+        }
+
+        // Broadcast Doubleword Integer
+        constexpr void vpbroadcastd(const std::uint8_t size, const XmmReg src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpbroadcastdRR(size, src, dst));
+        }
+
+        constexpr void vpbroadcastd(const std::uint8_t size, const Address& src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpbroadcastdRM(size, src, dst));
+        }
+
+        // Broadcast Quadword Integer
+        constexpr void vpbroadcastq(const std::uint8_t size, const XmmReg src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpbroadcastqRR(size, src, dst));
+        }
+
+        constexpr void vpbroadcastq(const std::uint8_t size, const Address& src, const XmmReg dst) {
+            m_instructions.emplace_back(details::VpbroadcastqRM(size, src, dst));
+        }
+
+        // Zero Upper Bits of YMM Registers
+        constexpr void vzeroupper() {
+            m_instructions.emplace_back(details::Vzeroupper());
+        }
+
         constexpr Label create_label() {
             const auto size = m_label_table.size();
             m_label_table.emplace_back(constants::NO_OFFSET);
@@ -518,6 +800,10 @@ namespace aasm {
             m_instructions.emplace_back(details::Jmp(label));
         }
 
+        constexpr void jmp(const Address& addr) {
+            m_instructions.emplace_back(details::JmpM(addr));
+        }
+
         constexpr void jcc(const CondType type, const Label& label) {
             m_instructions.emplace_back(details::Jcc(type, label));
         }
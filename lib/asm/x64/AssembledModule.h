@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "asm/x64/AsmModule.h"
+#include "asm/x64/ByteBuffer.h"
+
+namespace aasm {
+    /**
+     * Place of one function or global slot in an assembled section.
+     * Its relocations are 'relocation_count' consecutive entries of the section starting at 'first_relocation'.
+     */
+    struct SymbolChunk final {
+        const Symbol* symbol;
+        std::size_t offset;
+        std::size_t size;
+        std::size_t first_relocation;
+        std::size_t relocation_count;
+    };
+
+    /**
+     * Bytes of a section together with the symbols placed in it and their relocations.
+     * Offsets of symbols and relocations are relative to the start of the section.
+     */
+    class AssembledSection final {
+    public:
+        AssembledSection() = default;
+
+        AssembledSection(ByteBuffer&& bytes, std::vector<SymbolChunk>&& chunks, std::vector<Relocation>&& relocations) noexcept:
+            m_bytes(std::move(bytes)),
+            m_chunks(std::move(chunks)),
+            m_relocations(std::move(relocations)) {}
+
+        template<typename Emitter>
+        void append(const Symbol* symbol, const Emitter& emitter, const std::size_t alignment) {
+            m_bytes.align(alignment);
+            const auto start = m_bytes.size();
+            const auto first_relocation = m_relocations.size();
+            const auto relocations = emitter.emit(m_bytes);
+            m_relocations.insert(m_relocations.end(), relocations.begin(), relocations.end());
+            m_chunks.emplace_back(symbol, start, m_bytes.size() - start, first_relocation, relocations.size());
+        }
+
+        [[nodiscard]]
+        std::span<const std::uint8_t> bytes() const noexcept { return m_bytes.bytes(); }
+
+        [[nodiscard]]
+        std::span<const std::uint8_t> bytes(const SymbolChunk& chunk) const noexcept {
+            return bytes().subspan(chunk.offset, chunk.size);
+        }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept { return m_bytes.size(); }
+
+        [[nodiscard]]
+        std::span<const SymbolChunk> chunks() const noexcept { return m_chunks; }
+
+        [[nodiscard]]
+        std::span<const Relocation> relocations() const noexcept { return m_relocations; }
+
+        [[nodiscard]]
+        std::span<const Relocation> relocations(const SymbolChunk& chunk) const noexcept {
+            return relocations().subspan(chunk.first_relocation, chunk.relocation_count);
+        }
+
+    private:
+        ByteBuffer m_bytes;
+        std::vector<SymbolChunk> m_chunks;
+        std::vector<Relocation> m_relocations;
+    };
+
+    /**
+     * Module encoded exactly once. The JIT and the ELF writer both place these bytes and resolve these relocations.
+     */
+    class AssembledModule final {
+    public:
+        static constexpr std::size_t DATA_ALIGNMENT = 8;
+
+        /**
+         * @param function_alignment alignment of every function in the text section.
+         */
+        static AssembledModule assemble(const AsmModule& module, const std::size_t function_alignment = 1) {
+            AssembledModule assembled;
+            // Sort by name, so the layout doesn't depend on the hash map order.
+            for (const auto& [symbol, directive]: sorted_by_name(module.m_global_slots)) {
+                assembled.m_data.append(symbol, *directive, DATA_ALIGNMENT);
+            }
+
+            for (const auto& [symbol, buffer]: sorted_by_name(module.m_asm_buffers)) {
+                assembled.m_text.append(symbol, *buffer, function_alignment);
+            }
+
+            return assembled;
+        }
+
+        /**
+         * Restores the module encoded earlier, e.g. read back from the code cache.
+         */
+        static AssembledModule from_sections(AssembledSection&& text, AssembledSection&& data) noexcept {
+            AssembledModule assembled;
+            assembled.m_text = std::move(text);
+            assembled.m_data = std::move(data);
+            return assembled;
+        }
+
+        /** Functions of the module. */
+        [[nodiscard]]
+        const AssembledSection& text() const noexcept { return m_text; }
+
+        /** Global slots of the module. */
+        [[nodiscard]]
+        const AssembledSection& data() const noexcept { return m_data; }
+
+    private:
+        AssembledModule() = default;
+
+        template<typename T>
+        static std::vector<std::pair<const Symbol*, const T*>> sorted_by_name(const std::unordered_map<const Symbol*, T>& map) {
+            std::vector<std::pair<const Symbol*, const T*>> sorted;
+            sorted.reserve(map.size());
+            for (const auto& [symbol, value]: map) {
+                sorted.emplace_back(symbol, &value);
+            }
+
+            std::ranges::sort(sorted, {}, [](const auto& pair) { return pair.first->name(); });
+            return sorted;
+        }
+
+        AssembledSection m_text;
+        AssembledSection m_data;
+    };
+}
\ No newline at end of file
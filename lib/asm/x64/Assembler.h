@@ -1,8 +1,11 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <cstring>
 #include <ranges>
+#include <vector>
 
+#include "asm/x64/ByteBuffer.h"
 #include "instruction/X64Instruction.h"
 
 namespace aasm::details {
@@ -21,69 +24,154 @@ namespace aasm::details {
         }
 
     private:
+        /**
+         * Jump instruction and its current encoding. Every jump starts in the rel8 form.
+         */
+        struct JumpSite final {
+            std::uint32_t inst_idx;
+            std::uint32_t target_idx;
+            std::uint8_t size;
+            std::uint8_t long_size;
+        };
+
         constexpr explicit Assembler(const std::vector<X64Instruction> &instructions, const std::vector<std::uint32_t> &label_table) noexcept:
             m_label_table(label_table),
             m_instructions(instructions) {}
 
         template<CodeBuffer Buffer>
         constexpr std::vector<Relocation> emit(Buffer &buffer) {
-            offsets_from_start.reserve(m_instructions.size());
-            unresolved_labels.resize(m_instructions.size());
+            encode();
+            relax();
+            return write(buffer);
+        }
 
-            for (const auto &instruction: m_instructions) {
-                offsets_from_start.push_back(buffer.size());
-                std::visit([&](const auto &var) { emit_instruction(buffer, var); }, instruction);
+        /**
+         * Encodes all instructions except jumps, whose size depends on the layout.
+         */
+        constexpr void encode() {
+            offsets_from_start.reserve(m_instructions.size() + 1);
+            for (const auto& [idx, instruction]: std::views::enumerate(m_instructions)) {
+                offsets_from_start.push_back(m_code.size());
+                std::visit([&](const auto &var) { encode_instruction(static_cast<std::uint32_t>(idx), var); }, instruction);
             }
 
-            resolve_and_patch(buffer);
-            return std::move(m_relocations);
+            offsets_from_start.push_back(m_code.size());
         }
 
-        template<CodeBuffer Buffer, typename T>
-        constexpr void emit_instruction(Buffer& buffer, const T& inst) {
+        template<typename T>
+        constexpr void encode_instruction(const std::uint32_t idx, const T& inst) {
             if constexpr (std::is_same_v<T, Jmp> || std::is_same_v<T, Jcc>) {
-                emit_jump(buffer, inst);
+                const auto target_idx = m_label_table[inst.label().id()];
+                if (target_idx == constants::NO_OFFSET) {
+                    die("Label defined, but not set");
+                }
+
+                m_jumps.emplace_back(idx, target_idx, T::SHORT_SIZE, T::LONG_SIZE);
 
             } else {
-                if (const auto reloc = inst.emit(buffer); reloc.has_value()) {
-                    m_relocations.emplace_back(std::move(reloc.value()));
+                if (const auto reloc = inst.emit(m_code); reloc.has_value()) {
+                    m_relocations.emplace_back(idx, reloc.value());
                 }
             }
         }
 
-        template<CodeBuffer Buffer, typename T>
-        constexpr void emit_jump(Buffer& buffer, const T& var) {
-            const auto inst_idx = m_label_table[var.label().id()];
-            if (inst_idx == constants::NO_OFFSET) {
-                die("Label defined, but not set");
-            }
+        /**
+         * Grows the jumps whose displacement doesn't fit rel8 until no jump changes.
+         * A jump only grows, so the distances only grow too and the loop terminates.
+         */
+        constexpr void relax() {
+            m_growth.resize(m_jumps.size() + 1);
+            for (bool changed = true; changed;) {
+                for (const auto& [idx, jump]: std::views::enumerate(m_jumps)) {
+                    m_growth[idx + 1] = m_growth[idx] + jump.size;
+                }
 
-            if (inst_idx >= offsets_from_start.size()) {
-                // Label is defined, but not set yet. Handle it as unresolved.
-                var.emit_unresolved32(buffer);
-                unresolved_labels[var.label().id()].emplace_back(buffer.size());
-            } else {
-                const auto offset_from_function_start = offsets_from_start[inst_idx];
-                (void)var.emit(buffer, offset_from_function_start - static_cast<std::int64_t>(buffer.size()));
+                changed = false;
+                for (auto& jump: m_jumps) {
+                    if (jump.size == jump.long_size || Jmp::is_short(displacement(jump))) {
+                        continue;
+                    }
+
+                    jump.size = jump.long_size;
+                    changed = true;
+                }
             }
         }
 
+        /**
+         * Returns the offset of the instruction from the start of the function in the current layout.
+         */
+        [[nodiscard]]
+        constexpr std::int64_t final_offset(const std::uint32_t inst_idx) const {
+            const auto jumps_before = std::ranges::lower_bound(m_jumps, inst_idx, {}, &JumpSite::inst_idx) - m_jumps.begin();
+            return static_cast<std::int64_t>(offsets_from_start[inst_idx] + m_growth[jumps_before]);
+        }
+
+        [[nodiscard]]
+        constexpr std::int64_t displacement(const JumpSite& jump) const {
+            return final_offset(jump.target_idx) - final_offset(jump.inst_idx);
+        }
+
+        /**
+         * Copies the encoded instructions into the buffer and emits the jumps in their final form.
+         */
         template<CodeBuffer Buffer>
-        constexpr void resolve_and_patch(Buffer &buffer) {
-            for (const auto label_id: std::views::iota(0U, m_label_table.size())) {
-                const auto label_offset = offsets_from_start[m_label_table[label_id]];
-                for (const auto gap: unresolved_labels[label_id]) {
-                    buffer.patch32(gap - sizeof(std::int32_t), label_offset - gap);
+        constexpr std::vector<Relocation> write(Buffer &buffer) {
+            const auto base = buffer.size();
+            std::vector<Relocation> relocations;
+            relocations.reserve(m_relocations.size());
+
+            std::size_t next_jump{};
+            std::size_t next_reloc{};
+            for (std::uint32_t idx{}; idx < m_instructions.size(); ++idx) {
+                if (next_jump < m_jumps.size() && m_jumps[next_jump].inst_idx == idx) {
+                    const auto& jump = m_jumps[next_jump++];
+                    const auto visitor = [&]<typename T>(const T& inst) {
+                        if constexpr (std::is_same_v<T, Jmp> || std::is_same_v<T, Jcc>) {
+                            (void)inst.emit(buffer, static_cast<std::int32_t>(displacement(jump)));
+                        } else {
+                            std::unreachable();
+                        }
+                    };
+
+                    [[maybe_unused]]
+                    const auto start = buffer.size();
+                    std::visit(visitor, m_instructions[idx]);
+                    assertion(buffer.size() - start == jump.size, "Jump size mismatch after relaxation");
+                    continue;
+                }
+
+                copy_bytes(buffer, offsets_from_start[idx], offsets_from_start[idx + 1]);
+                const auto delta = checked_cast<std::int32_t>(base + m_growth[next_jump]);
+                for (; next_reloc < m_relocations.size() && m_relocations[next_reloc].first == idx; ++next_reloc) {
+                    relocations.push_back(m_relocations[next_reloc].second.shift(delta));
                 }
             }
+
+            return relocations;
+        }
+
+        template<CodeBuffer Buffer>
+        constexpr void copy_bytes(Buffer &buffer, std::size_t begin, const std::size_t end) const {
+            const auto bytes = m_code.bytes();
+            for (; begin + sizeof(std::uint64_t) <= end; begin += sizeof(std::uint64_t)) {
+                std::uint64_t value;
+                std::memcpy(&value, &bytes[begin], sizeof(value));
+                buffer.emit64(value);
+            }
+
+            for (; begin < end; ++begin) {
+                buffer.emit8(bytes[begin]);
+            }
         }
 
         const std::vector<std::uint32_t>& m_label_table; // HashMap from 'label' to instruction index
         const std::vector<X64Instruction> &m_instructions;
 
-        std::vector<std::int32_t> offsets_from_start; // instruction index to offset from code block start
-        std::vector<std::vector<std::int32_t>> unresolved_labels; // Hashmap from 'label' to vector of offsets where jmp operand must be patched.
-
-        std::vector<Relocation> m_relocations;
+        ByteBuffer m_code; // Instructions without jumps.
+        std::vector<std::size_t> offsets_from_start; // instruction index to offset in 'm_code'
+        std::vector<JumpSite> m_jumps; // Jumps in the instruction order.
+        std::vector<std::size_t> m_growth; // Total size of the first 'n' jumps.
+        std::vector<std::pair<std::uint32_t, Relocation>> m_relocations; // Relocations of 'm_code' with the instruction index.
     };
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "asm/x64/Common.h"
+#include "utility/ArithmeticUtils.h"
+
+namespace aasm {
+    /**
+     * Growable code buffer. Instructions are encoded into it once, without knowing the final size in advance.
+     */
+    class ByteBuffer final {
+    public:
+        ByteBuffer() = default;
+
+        void emit8(const std::uint8_t value) { m_data.push_back(value); }
+        void emit16(const std::uint16_t value) { append(&value, sizeof(value)); }
+        void emit32(const std::uint32_t value) { append(&value, sizeof(value)); }
+        void emit64(const std::uint64_t value) { append(&value, sizeof(value)); }
+
+        void patch32(const std::uint32_t offset, const std::uint32_t value) {
+            std::memcpy(&m_data[offset], &value, sizeof(value));
+        }
+
+        void patch64(const std::uint64_t offset, const std::uint64_t value) {
+            std::memcpy(&m_data[offset], &value, sizeof(value));
+        }
+
+        /** Pads the buffer with zeros up to the given alignment. */
+        void align(const std::size_t alignment) {
+            m_data.resize(align_up(m_data.size(), alignment));
+        }
+
+        void append(const std::span<const std::uint8_t> bytes) {
+            m_data.insert(m_data.end(), bytes.begin(), bytes.end());
+        }
+
+        void reserve(const std::size_t size) {
+            m_data.reserve(size);
+        }
+
+        [[nodiscard]]
+        std::span<const std::uint8_t> bytes() const noexcept { return m_data; }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept { return m_data.size(); }
+
+    private:
+        void append(const void* value, const std::size_t size) {
+            const auto bytes = static_cast<const std::uint8_t*>(value);
+            m_data.insert(m_data.end(), bytes, bytes + size);
+        }
+
+        std::vector<std::uint8_t> m_data;
+    };
+
+    static_assert(CodeBuffer<ByteBuffer>);
+}
\ No newline at end of file
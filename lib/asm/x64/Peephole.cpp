@@ -0,0 +1,432 @@
+#include "Peephole.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <optional>
+#include <ostream>
+
+#include "utility/Error.h"
+
+namespace aasm::details {
+    /**
+     * View of the instructions at the current position of the pass.
+     * Offsets count live instructions, so instructions removed earlier in the pass are skipped.
+     */
+    class PeepholeWindow final {
+    public:
+        PeepholeWindow(std::vector<X64Instruction>& instructions, const std::vector<std::uint32_t>& label_table):
+            m_instructions(instructions),
+            m_label_table(label_table),
+            m_removed(instructions.size(), false),
+            m_targets(instructions.size() + 1, false) {
+            for (const auto idx: label_table) {
+                if (idx != constants::NO_OFFSET) {
+                    m_targets[idx] = true;
+                }
+            }
+        }
+
+        void move_to(const std::size_t pos) noexcept {
+            m_pos = pos;
+        }
+
+        [[nodiscard]]
+        bool is_removed(const std::size_t idx) const noexcept {
+            return m_removed[idx];
+        }
+
+        [[nodiscard]]
+        bool changed() const noexcept {
+            return m_changed;
+        }
+
+        [[nodiscard]]
+        const X64Instruction* at(const std::size_t offset) const {
+            const auto idx = index(offset);
+            return idx == m_instructions.size() ? nullptr : &m_instructions[idx];
+        }
+
+        template<typename T>
+        [[nodiscard]]
+        const T* get(const std::size_t offset) const {
+            const auto inst = at(offset);
+            return inst == nullptr ? nullptr : std::get_if<T>(inst);
+        }
+
+        /** @return true if some jump may land on the instruction **/
+        [[nodiscard]]
+        bool is_label_target(const std::size_t offset) const {
+            return m_targets[index(offset)];
+        }
+
+        /** @return true if the label points to the instruction right after the one at the offset **/
+        [[nodiscard]]
+        bool targets_next(const Label& label, const std::size_t offset) const {
+            const auto target = m_label_table[label.id()];
+            if (target == constants::NO_OFFSET) {
+                return false;
+            }
+
+            return live_from(target) == index(offset + 1);
+        }
+
+        /** @return true if no instruction reads the flags before they are overwritten **/
+        [[nodiscard]]
+        bool are_flags_dead_after(std::size_t offset) const;
+
+        template<typename T, typename... Args>
+        void replace(const std::size_t offset, Args&&... args) {
+            m_instructions[index(offset)].emplace<T>(std::forward<Args>(args)...);
+            m_changed = true;
+        }
+
+        void remove(const std::size_t offset) {
+            const auto idx = index(offset);
+            m_removed[idx] = true;
+            if (m_targets[idx]) {
+                m_targets[live_from(idx + 1)] = true;
+            }
+
+            m_changed = true;
+        }
+
+        /**
+         * Drops the removed instructions and points the labels at the new indices.
+         */
+        void compact(std::vector<std::uint32_t>& label_table);
+
+    private:
+        [[nodiscard]]
+        std::size_t live_from(std::size_t idx) const noexcept {
+            while (idx < m_instructions.size() && m_removed[idx]) {
+                idx += 1;
+            }
+
+            return idx;
+        }
+
+        [[nodiscard]]
+        std::size_t index(const std::size_t offset) const noexcept {
+            auto idx = live_from(m_pos);
+            for (std::size_t i = 0; i < offset && idx < m_instructions.size(); ++i) {
+                idx = live_from(idx + 1);
+            }
+
+            return idx;
+        }
+
+        std::vector<X64Instruction>& m_instructions;
+        const std::vector<std::uint32_t>& m_label_table;
+        std::vector<bool> m_removed;
+        std::vector<bool> m_targets;
+        std::size_t m_pos{};
+        bool m_changed{};
+    };
+
+    template<typename T, typename... Ts>
+    concept one_of = (std::is_same_v<T, Ts> || ...);
+
+    enum class FlagsEffect: std::uint8_t {
+        None,
+        Read,
+        Write,
+        Unknown,
+    };
+
+    static FlagsEffect flags_effect(const X64Instruction& inst) {
+        const auto vis = []<typename T>(const T&) {
+            if constexpr (one_of<T, Jcc, SetCCR, CMovRR, CMovRM>) {
+                return FlagsEffect::Read;
+
+            } else if constexpr (one_of<T, CmpRR, CmpRI, CmpMI, CmpRM, CmpMR,
+                TestRR, TestRI, TestMI, TestRM, TestMR,
+                AddRR, AddRI, AddRM, AddMR, AddMI,
+                SubRR, SubRI, SubRM, SubMI, SubMR,
+                AndRR, AndRI, AndRM, AndMR, AndMI,
+                OrRR, OrRI, OrRM, OrMR, OrMI,
+                XorRR, XorRI, XorMI, XorRM, XorMR,
+                NegR, NegM,
+                UcomisdRR, UcomisdRM, UcomissRR, UcomissRM,
+                ComissRR, ComissRM, ComisdRR, ComisdRM>) {
+                return FlagsEffect::Write;
+
+            } else if constexpr (one_of<T, Ret, Call, CallM, CallR>) {
+                // Flags aren't preserved across the call and the return.
+                return FlagsEffect::Write;
+
+            } else if constexpr (one_of<T, Jmp, JmpM>) {
+                return FlagsEffect::Unknown;
+
+            } else {
+                return FlagsEffect::None;
+            }
+        };
+
+        return std::visit(vis, inst);
+    }
+
+    bool PeepholeWindow::are_flags_dead_after(std::size_t offset) const {
+        for (offset += 1; const auto inst = at(offset); ++offset) {
+            switch (flags_effect(*inst)) {
+                case FlagsEffect::None: break;
+                case FlagsEffect::Write: return true;
+                case FlagsEffect::Read: [[fallthrough]];
+                case FlagsEffect::Unknown: return false;
+            }
+        }
+
+        return true;
+    }
+
+    void PeepholeWindow::compact(std::vector<std::uint32_t>& label_table) {
+        std::vector<std::uint32_t> new_index(m_instructions.size() + 1);
+        std::vector<X64Instruction> instructions;
+        instructions.reserve(m_instructions.size());
+        for (std::size_t idx = 0; idx < m_instructions.size(); ++idx) {
+            new_index[idx] = static_cast<std::uint32_t>(instructions.size());
+            if (!m_removed[idx]) {
+                instructions.push_back(std::move(m_instructions[idx]));
+            }
+        }
+        new_index[m_instructions.size()] = static_cast<std::uint32_t>(instructions.size());
+
+        for (auto& target: label_table) {
+            if (target != constants::NO_OFFSET) {
+                target = new_index[target];
+            }
+        }
+
+        // The variant isn't assignable because of the const members of the instructions, so the storage is swapped.
+        m_instructions.swap(instructions);
+    }
+
+    /**
+     * mov %r, %r
+     * The 32-bit form zeroes the upper half of the register, so it stays.
+     */
+    static bool self_move(PeepholeWindow& window) {
+        const auto mov = window.get<MovRR>(0);
+        if (mov == nullptr || mov->src() != mov->dst() || mov->size() == 4) {
+            return false;
+        }
+
+        window.remove(0);
+        return true;
+    }
+
+    /**
+     * mov %a, %b
+     * mov %b, %a  <- removed
+     */
+    static bool move_back(PeepholeWindow& window) {
+        const auto first = window.get<MovRR>(0);
+        const auto second = window.get<MovRR>(1);
+        if (first == nullptr || second == nullptr || first->size() != second->size() || first->size() == 4) {
+            return false;
+        }
+        if (second->src() != first->dst() || second->dst() != first->src() || window.is_label_target(1)) {
+            return false;
+        }
+
+        window.remove(1);
+        return true;
+    }
+
+    /**
+     * mov %a, %t  <- removed
+     * mov %t, %b  => mov %a, %b
+     * mov ..., %t
+     */
+    static bool move_through_temporary(PeepholeWindow& window) {
+        const auto first = window.get<MovRR>(0);
+        const auto second = window.get<MovRR>(1);
+        if (first == nullptr || second == nullptr || first->size() != second->size()) {
+            return false;
+        }
+
+        const auto temp = first->dst();
+        if (second->src() != temp || second->dst() == temp || first->src() == temp || window.is_label_target(1)) {
+            return false;
+        }
+
+        // The temporary must be overwritten entirely without being read.
+        const auto overwrites_temp = [&] {
+            if (const auto mov = window.get<MovRR>(2); mov != nullptr) {
+                return mov->dst() == temp && mov->src() != temp && mov->size() >= 4;
+            }
+            if (const auto mov = window.get<MovRI>(2); mov != nullptr) {
+                return mov->dst() == temp && mov->size() >= 4;
+            }
+
+            return false;
+        };
+        if (!overwrites_temp()) {
+            return false;
+        }
+
+        const auto size = first->size();
+        const auto src = first->src();
+        const auto dst = second->dst();
+        window.replace<MovRR>(1, size, src, dst);
+        window.remove(0);
+        return true;
+    }
+
+    /**
+     * cmp $0, %r => test %r, %r
+     */
+    static bool compare_with_zero(PeepholeWindow& window) {
+        const auto cmp = window.get<CmpRI>(0);
+        if (cmp == nullptr || cmp->imm() != 0) {
+            return false;
+        }
+
+        const auto size = cmp->size();
+        const auto reg = cmp->dst();
+        window.replace<TestRR>(0, size, reg, reg);
+        return true;
+    }
+
+    /**
+     * mov $0, %r => xor %r, %r
+     * Only if the flags are dead, xor clobbers them.
+     */
+    static bool move_zero(PeepholeWindow& window) {
+        const auto mov = window.get<MovRI>(0);
+        if (mov == nullptr || mov->imm() != 0 || !window.are_flags_dead_after(0)) {
+            return false;
+        }
+
+        // The 32-bit xor zeroes the whole register and has a shorter encoding.
+        const auto size = mov->size() == 8 ? static_cast<std::uint8_t>(4) : mov->size();
+        const auto reg = mov->dst();
+        window.replace<XorRR>(0, size, reg, reg);
+        return true;
+    }
+
+    /**
+     * jmp L1  <- removed
+     * L1:
+     */
+    static bool jump_to_next(PeepholeWindow& window) {
+        const auto label = [&]() -> std::optional<Label> {
+            if (const auto jmp = window.get<Jmp>(0); jmp != nullptr) {
+                return jmp->label();
+            }
+            if (const auto jcc = window.get<Jcc>(0); jcc != nullptr) {
+                return jcc->label();
+            }
+
+            return std::nullopt;
+        }();
+
+        if (!label.has_value() || !window.targets_next(label.value(), 0)) {
+            return false;
+        }
+
+        window.remove(0);
+        return true;
+    }
+
+    /**
+     * jcc L1   => jncc L2
+     * jmp L2   <- removed
+     * L1:
+     */
+    static bool branch_over_jump(PeepholeWindow& window) {
+        const auto jcc = window.get<Jcc>(0);
+        const auto jmp = window.get<Jmp>(1);
+        if (jcc == nullptr || jmp == nullptr || window.is_label_target(1) || !window.targets_next(jcc->label(), 1)) {
+            return false;
+        }
+
+        const auto type = invert(jcc->type());
+        const auto label = jmp->label();
+        window.remove(1);
+        window.replace<Jcc>(0, type, label);
+        return true;
+    }
+
+    /**
+     * Rules in the order they are tried. A new rule is a function over the window and an entry here.
+     */
+    static constexpr std::array RULES{
+        PeepholeRule{"self_move", self_move},
+        PeepholeRule{"move_back", move_back},
+        PeepholeRule{"move_through_temporary", move_through_temporary},
+        PeepholeRule{"compare_with_zero", compare_with_zero},
+        PeepholeRule{"move_zero", move_zero},
+        PeepholeRule{"jump_to_next", jump_to_next},
+        PeepholeRule{"branch_over_jump", branch_over_jump},
+    };
+}
+
+namespace aasm {
+    PeepholeStats::PeepholeStats():
+        m_counts(details::RULES.size(), 0) {}
+
+    std::size_t PeepholeStats::count(const std::string_view rule) const {
+        const auto it = std::ranges::find(details::RULES, rule, &PeepholeRule::name);
+        if (it == details::RULES.end()) {
+            die("unknown peephole rule: {}", rule);
+        }
+
+        return m_counts[static_cast<std::size_t>(std::distance(details::RULES.begin(), it))];
+    }
+
+    std::size_t PeepholeStats::total() const noexcept {
+        return std::accumulate(m_counts.begin(), m_counts.end(), std::size_t{0});
+    }
+
+    PeepholeStats& PeepholeStats::operator+=(const PeepholeStats& other) noexcept {
+        for (std::size_t idx = 0; idx < m_counts.size(); ++idx) {
+            m_counts[idx] += other.m_counts[idx];
+        }
+
+        return *this;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const PeepholeStats& stats) {
+        for (std::size_t idx = 0; idx < details::RULES.size(); ++idx) {
+            if (idx > 0) {
+                os << std::endl;
+            }
+
+            os << details::RULES[idx].name << ": " << stats.m_counts[idx];
+        }
+
+        return os;
+    }
+
+    PeepholeStats Peephole::run(std::vector<X64Instruction>& instructions, std::vector<std::uint32_t>& label_table) {
+        PeepholeStats stats;
+        for (auto changed = true; changed;) {
+            details::PeepholeWindow window(instructions, label_table);
+            for (std::size_t idx = 0; idx < instructions.size(); ++idx) {
+                if (window.is_removed(idx)) {
+                    continue;
+                }
+
+                window.move_to(idx);
+                for (std::size_t rule_idx = 0; rule_idx < details::RULES.size(); ++rule_idx) {
+                    if (details::RULES[rule_idx].apply(window)) {
+                        stats.add(rule_idx);
+                        break;
+                    }
+                }
+            }
+
+            changed = window.changed();
+            if (changed) {
+                window.compact(label_table);
+            }
+        }
+
+        return stats;
+    }
+
+    std::span<const PeepholeRule> Peephole::rules() noexcept {
+        return details::RULES;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "instruction/X64Instruction.h"
+
+namespace aasm {
+    namespace details {
+        class PeepholeWindow;
+    }
+
+    /**
+     * Rewrites a short sequence of instructions starting at the current position of the window.
+     * Returns true if the rule changed the instructions.
+     */
+    struct PeepholeRule final {
+        std::string_view name;
+        bool (*apply)(details::PeepholeWindow& window);
+    };
+
+    /**
+     * Counts how many times each peephole rule fired.
+     */
+    class PeepholeStats final {
+    public:
+        PeepholeStats();
+
+        void add(const std::size_t rule_idx) {
+            m_counts[rule_idx] += 1;
+        }
+
+        /** @return number of times the rule with the given name fired **/
+        [[nodiscard]]
+        std::size_t count(std::string_view rule) const;
+
+        /** @return number of times all rules fired **/
+        [[nodiscard]]
+        std::size_t total() const noexcept;
+
+        PeepholeStats& operator+=(const PeepholeStats& other) noexcept;
+
+        friend std::ostream& operator<<(std::ostream& os, const PeepholeStats& stats);
+
+    private:
+        std::vector<std::size_t> m_counts;
+    };
+
+    /**
+     * Pattern-driven peephole optimizer over the instructions of the function.
+     * Rules are tried in the table order at every instruction, the pass repeats until no rule fires.
+     * Removed instructions are compacted away and the label table is remapped to the new indices.
+     */
+    class Peephole final {
+    public:
+        static PeepholeStats run(std::vector<X64Instruction>& instructions, std::vector<std::uint32_t>& label_table);
+
+        /** @return the rule table **/
+        [[nodiscard]]
+        static std::span<const PeepholeRule> rules() noexcept;
+    };
+}
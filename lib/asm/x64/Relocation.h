@@ -39,6 +39,12 @@ namespace aasm {
         [[nodiscard]]
         RelType type() const noexcept { return m_type; }
 
+        /** Returns the same relocation for the code moved by 'delta' bytes. */
+        [[nodiscard]]
+        Relocation shift(const std::int32_t delta) const noexcept {
+            return Relocation(m_type, m_offset + delta, m_displacement + delta, m_symbol);
+        }
+
     private:
         RelType m_type;
         std::int32_t m_offset;
@@ -86,6 +86,20 @@ namespace aasm {
             return std::visit(vis, m_address);
         }
 
+        /**
+         * Returns true if the register takes part in computing the address.
+         */
+        [[nodiscard]]
+        bool uses(const GPReg reg) const noexcept {
+            if (base() == reg) {
+                return true;
+            }
+            if (const auto as_index_scale = as<AddressIndexScale>()) {
+                return as_index_scale->index() == reg;
+            }
+            return false;
+        }
+
     private:
         [[nodiscard]]
         std::optional<GPReg> base() const noexcept {
@@ -18,7 +18,8 @@ namespace aasm {
             RelType rel_type;
             switch (const auto bind = m_symbol->bind()) {
                 case BindAttribute::EXTERNAL: rel_type = RelType::X86_64_PLT32; break;
-                case BindAttribute::INTERNAL: rel_type = RelType::X86_64_PC32; break;
+                case BindAttribute::INTERNAL: [[fallthrough]];
+                case BindAttribute::DEFAULT:  rel_type = RelType::X86_64_PC32; break;
                 default: die("Unsupported linkage type for AddressLiteral: {}", static_cast<std::uint8_t>(bind));
             }
             return Relocation(rel_type, buffer.size()-sizeof(std::int32_t), buffer.size()+offset_to_end-m_displacement, m_symbol);
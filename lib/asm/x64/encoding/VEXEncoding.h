@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+
+#include "asm/x64/Common.h"
+#include "asm/x64/address/Address.h"
+#include "asm/x64/reg/GPReg.h"
+#include "asm/x64/reg/XmmReg.h"
+
+namespace aasm::details {
+    enum class VexMap: std::uint8_t {
+        MAP_0F   = 0x01,
+        MAP_0F38 = 0x02,
+        MAP_0F3A = 0x03,
+    };
+
+    enum class VexPrefix: std::uint8_t {
+        NONE = 0x00,
+        P66  = 0x01,
+        PF3  = 0x02,
+        PF2  = 0x03,
+    };
+
+    /**
+     * Implied legacy prefix, opcode map, VEX.W bit and opcode byte of the VEX encoded instruction.
+     */
+    struct VexOpcode final {
+        VexPrefix pp;
+        VexMap map;
+        bool w;
+        std::uint8_t opcode;
+    };
+
+    /**
+     * Emits VEX encoded instructions. Operand size 16 selects xmm registers (VEX.L = 0), 32 selects ymm registers (VEX.L = 1).
+     * The two byte form is used when neither VEX.X, VEX.B nor VEX.W is needed and the opcode is in the 0F map.
+     */
+    template<CodeBuffer Buffer>
+    class VEXEncoder final {
+        static constexpr std::uint8_t VEX2 = 0xC5;
+        static constexpr std::uint8_t VEX3 = 0xC4;
+        static constexpr std::uint8_t NO_VVVV = 0;
+
+    public:
+        explicit constexpr VEXEncoder(Buffer& buffer, const VexOpcode& opcode, const std::uint8_t size) noexcept:
+            m_buffer(buffer),
+            m_opcode(opcode),
+            m_size(size) {}
+
+        /**
+         * reg := src1 op rm
+         */
+        template<typename Op>
+        requires std::is_same_v<Op, Address> || std::is_same_v<Op, XmmReg>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> encode_RVM(const XmmReg reg, const XmmReg src1, const Op& rm) {
+            emit_prefix(reg, index(src1), rm);
+            m_buffer.emit8(m_opcode.opcode);
+            return emit_operands(reg, rm, 0);
+        }
+
+        /**
+         * reg := src1 op rm, imm8
+         */
+        template<typename Op>
+        requires std::is_same_v<Op, Address> || std::is_same_v<Op, XmmReg>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> encode_RVMI(const XmmReg reg, const XmmReg src1, const Op& rm, const std::uint8_t imm) {
+            emit_prefix(reg, index(src1), rm);
+            m_buffer.emit8(m_opcode.opcode);
+            const auto reloc = emit_operands(reg, rm, sizeof(std::uint8_t));
+            m_buffer.emit8(imm);
+            return reloc;
+        }
+
+        /**
+         * reg := op rm
+         */
+        template<typename Op>
+        requires std::is_same_v<Op, Address> || std::is_same_v<Op, XmmReg> || std::is_same_v<Op, GPReg>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> encode_RM(const XmmReg reg, const Op& rm) {
+            emit_prefix(reg, NO_VVVV, rm);
+            m_buffer.emit8(m_opcode.opcode);
+            return emit_operands(reg, rm, 0);
+        }
+
+        /**
+         * rm := reg
+         */
+        [[nodiscard]]
+        constexpr std::optional<Relocation> encode_MR(const XmmReg reg, const Address& rm) {
+            return encode_RM(reg, rm);
+        }
+
+    private:
+        static constexpr std::uint8_t index(const XmmReg reg) noexcept {
+            return reg.code() - xmm0.code();
+        }
+
+        template<typename Op>
+        constexpr void emit_prefix(const XmmReg reg, const std::uint8_t vvvv, const Op& rm) {
+            bool x = false;
+            bool b = false;
+            if constexpr (std::is_same_v<Op, Address>) {
+                x = X(rm) != 0;
+                if (const auto base = rm.base(); base.has_value()) {
+                    b = base.value().is_64_bit_reg();
+                }
+
+            } else {
+                b = rm.is_64_bit_reg();
+            }
+
+            const auto r = reg.is_64_bit_reg();
+            const auto tail = static_cast<std::uint8_t>((~vvvv & 0xF) << 3 | (m_size == 32) << 2 | static_cast<std::uint8_t>(m_opcode.pp));
+            if (!x && !b && !m_opcode.w && m_opcode.map == VexMap::MAP_0F) {
+                m_buffer.emit8(VEX2);
+                m_buffer.emit8(!r << 7 | tail);
+                return;
+            }
+
+            m_buffer.emit8(VEX3);
+            m_buffer.emit8(!r << 7 | !x << 6 | !b << 5 | static_cast<std::uint8_t>(m_opcode.map));
+            m_buffer.emit8(m_opcode.w << 7 | tail);
+        }
+
+        template<typename Op>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit_operands(const XmmReg reg, const Op& rm, const std::int32_t imm_size) {
+            if constexpr (std::is_same_v<Op, Address>) {
+                return rm.encode(m_buffer, reg.encode(), imm_size);
+
+            } else {
+                m_buffer.emit8(0xC0 | reg.encode() << 3 | rm.encode());
+                return std::nullopt;
+            }
+        }
+
+        Buffer& m_buffer;
+        const VexOpcode& m_opcode;
+        const std::uint8_t m_size;
+    };
+}
@@ -13,8 +13,8 @@ namespace aasm::details {
         template<CodeBuffer Buffer>
         [[nodiscard]]
         constexpr std::optional<Relocation> emit(Buffer& buffer) const {
-            static constexpr std::array<std::uint8_t, 1> AND = {0x20};
-            static constexpr std::array<std::uint8_t, 1> AND_8 = {0x21};
+            static constexpr std::array<std::uint8_t, 1> AND = {0x21};
+            static constexpr std::array<std::uint8_t, 1> AND_8 = {0x20};
             Encoder enc(buffer, AND_8, AND);
             return enc.encode_MR(m_size, m_src, m_dst);
         }
@@ -93,9 +93,9 @@ namespace aasm::details {
         template<CodeBuffer Buffer>
         [[nodiscard]]
         constexpr std::optional<Relocation> emit(Buffer& buffer) const {
-            static constexpr std::array<std::uint8_t, 1> ADD_RM = {0x22};
-            static constexpr std::array<std::uint8_t, 1> ADD_RM_8 = {0x23};
-            Encoder enc(buffer, ADD_RM_8, ADD_RM);
+            static constexpr std::array<std::uint8_t, 1> AND_RM = {0x23};
+            static constexpr std::array<std::uint8_t, 1> AND_RM_8 = {0x22};
+            Encoder enc(buffer, AND_RM_8, AND_RM);
             return enc.encode_RM(m_size, m_src, m_dst);
         }
 
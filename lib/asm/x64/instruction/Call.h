@@ -55,4 +55,28 @@ namespace aasm::details {
     private:
         Address m_addr;
     };
+
+    class CallR final {
+    public:
+        explicit constexpr CallR(const GPReg reg) noexcept:
+            m_reg(reg) {}
+
+        friend std::ostream &operator<<(std::ostream &os, const CallR &call);
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            static constexpr std::uint8_t CALL = 0xFF;
+            if (const auto rex = constants::REX | B(m_reg); rex != constants::REX) {
+                buffer.emit8(rex);
+            }
+
+            buffer.emit8(CALL);
+            buffer.emit8(0xC0 | 2 << 3 | m_reg.encode());
+            return std::nullopt;
+        }
+
+    private:
+        GPReg m_reg;
+    };
 }
\ No newline at end of file
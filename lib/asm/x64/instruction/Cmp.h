@@ -58,6 +58,21 @@ namespace aasm::details {
             return enc.encode_MI32(7, m_size, m_imm, m_dst);
         }
 
+        [[nodiscard]]
+        constexpr std::uint8_t size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]]
+        constexpr std::int32_t imm() const noexcept {
+            return m_imm;
+        }
+
+        [[nodiscard]]
+        constexpr const DST& dst() const noexcept {
+            return m_dst;
+        }
+
     protected:
         std::int32_t m_imm;
         std::uint8_t m_size;
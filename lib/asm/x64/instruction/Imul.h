@@ -0,0 +1,135 @@
+#pragma once
+
+namespace aasm::details {
+    template<typename SRC>
+    class Imul {
+    public:
+        template<typename S = SRC>
+        explicit constexpr Imul(const std::uint8_t size, S&& src, const GPReg dst) noexcept:
+            m_size(size),
+            m_src(std::forward<S>(src)),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            static constexpr std::array<std::uint8_t, 2> IMUL_RM = {0x0F, 0xAF};
+            EncodeUtils::emit_op_prologue(buffer, m_size, m_dst, m_src);
+            switch (m_size) {
+                case 2: [[fallthrough]];
+                case 4: [[fallthrough]];
+                case 8: EncodeUtils::emit_opcodes(buffer, IMUL_RM); break;
+                default: die("Invalid size for imul instruction: {}", m_size);
+            }
+
+            if constexpr (std::is_same_v<SRC, GPReg>) {
+                buffer.emit8(0xC0 | m_dst.encode() << 3 | m_src.encode());
+                return std::nullopt;
+
+            } else if constexpr (std::is_same_v<SRC, Address>) {
+                return m_src.encode(buffer, m_dst.encode(), 0);
+
+            } else {
+                static_assert(false, "Unsupported source type for imul instruction");
+                std::unreachable();
+            }
+        }
+
+    protected:
+        std::uint8_t m_size;
+        SRC m_src;
+        GPReg m_dst;
+    };
+
+    class ImulRR final: public Imul<GPReg> {
+    public:
+        explicit constexpr ImulRR(const std::uint8_t size, const GPReg src, const GPReg dst) noexcept:
+            Imul(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const ImulRR& imul);
+    };
+
+    class ImulRM final: public Imul<Address> {
+    public:
+        explicit constexpr ImulRM(const std::uint8_t size, const Address& src, const GPReg dst) noexcept:
+            Imul(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const ImulRM& imul);
+    };
+
+    /**
+     * Three-operand form: dst = src * imm.
+     * The short encoding with a sign-extended 8-bit immediate is chosen when the value fits.
+     */
+    template<typename SRC>
+    class ImulI {
+    public:
+        template<typename S = SRC>
+        explicit constexpr ImulI(const std::uint8_t size, const std::int32_t imm, S&& src, const GPReg dst) noexcept:
+            m_size(size),
+            m_imm(imm),
+            m_src(std::forward<S>(src)),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            static constexpr std::uint8_t IMUL_RMI8 = 0x6B;
+            static constexpr std::uint8_t IMUL_RMI = 0x69;
+            EncodeUtils::emit_op_prologue(buffer, m_size, m_dst, m_src);
+
+            const auto is_imm8 = std::in_range<std::int8_t>(m_imm);
+            std::uint8_t imm_size;
+            switch (m_size) {
+                case 2: imm_size = is_imm8 ? 1 : 2; break;
+                case 4: [[fallthrough]];
+                case 8: imm_size = is_imm8 ? 1 : 4; break;
+                default: die("Invalid size for imul instruction: {}", m_size);
+            }
+            buffer.emit8(is_imm8 ? IMUL_RMI8 : IMUL_RMI);
+
+            std::optional<Relocation> reloc{};
+            if constexpr (std::is_same_v<SRC, GPReg>) {
+                buffer.emit8(0xC0 | m_dst.encode() << 3 | m_src.encode());
+
+            } else if constexpr (std::is_same_v<SRC, Address>) {
+                reloc = m_src.encode(buffer, m_dst.encode(), imm_size);
+
+            } else {
+                static_assert(false, "Unsupported source type for imul instruction");
+                std::unreachable();
+            }
+
+            switch (imm_size) {
+                case 1: buffer.emit8(checked_cast<std::int8_t>(m_imm)); break;
+                case 2: buffer.emit16(checked_cast<std::int16_t>(m_imm)); break;
+                case 4: buffer.emit32(m_imm); break;
+                default: std::unreachable();
+            }
+
+            return reloc;
+        }
+
+    protected:
+        std::uint8_t m_size;
+        std::int32_t m_imm;
+        SRC m_src;
+        GPReg m_dst;
+    };
+
+    class ImulRRI final: public ImulI<GPReg> {
+    public:
+        explicit constexpr ImulRRI(const std::uint8_t size, const std::int32_t imm, const GPReg src, const GPReg dst) noexcept:
+            ImulI(size, imm, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const ImulRRI& imul);
+    };
+
+    class ImulRMI final: public ImulI<Address> {
+    public:
+        explicit constexpr ImulRMI(const std::uint8_t size, const std::int32_t imm, const Address& src, const GPReg dst) noexcept:
+            ImulI(size, imm, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const ImulRMI& imul);
+    };
+}
@@ -9,33 +9,42 @@ namespace aasm::details {
 
         friend std::ostream& operator<<(std::ostream &os, const Jcc& jcc);
 
+        static constexpr std::uint8_t SHORT_SIZE = 2;
+        static constexpr std::uint8_t LONG_SIZE = 6;
+
+        /**
+         * Returns true if the jump by 'offset' bytes from its first byte fits the rel8 form.
+         */
+        [[nodiscard]]
+        static constexpr bool is_short(const std::int64_t offset) noexcept {
+            return std::in_range<std::int8_t>(offset - SHORT_SIZE);
+        }
+
         template<CodeBuffer Buffer>
         constexpr std::optional<Relocation> emit(Buffer& buffer, const std::int32_t offset) const {
-            if (std::in_range<std::int8_t>(offset)) {
+            if (is_short(offset)) {
                 buffer.emit8(static_cast<std::uint8_t>(m_type) | JCC_REL8);
-                buffer.emit8(static_cast<std::int8_t>(offset) - 2);
+                buffer.emit8(static_cast<std::uint8_t>(offset - SHORT_SIZE));
 
             } else {
                 buffer.emit8(JCC_REL32);
                 buffer.emit8(static_cast<std::uint8_t>(m_type) | 0x80);
-                buffer.emit32(offset - 6);
+                buffer.emit32(offset - LONG_SIZE);
             }
 
             return std::nullopt;
         }
 
-        template<CodeBuffer Buffer>
-        constexpr void emit_unresolved32(Buffer& buffer) const {
-            buffer.emit8(JCC_REL32);
-            buffer.emit8(static_cast<std::uint8_t>(m_type) | 0x80);
-            buffer.emit32(INT32_MAX);
-        }
-
         [[nodiscard]]
         constexpr const Label& label() const noexcept {
             return m_label;
         }
 
+        [[nodiscard]]
+        constexpr CondType type() const noexcept {
+            return m_type;
+        }
+
     private:
         static constexpr std::uint8_t JCC_REL8 = 0x70;
         static constexpr std::uint8_t JCC_REL32 = 0x0F;
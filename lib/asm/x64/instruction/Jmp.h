@@ -11,27 +11,31 @@ namespace aasm::details {
         static constexpr std::uint8_t JMP = 0xE9;
         static constexpr std::uint8_t JMP_8 = 0xEB;
 
-        template<CodeBuffer Buffer>
+        static constexpr std::uint8_t SHORT_SIZE = 2;
+        static constexpr std::uint8_t LONG_SIZE = 5;
+
+        /**
+         * Returns true if the jump by 'offset' bytes from its first byte fits the rel8 form.
+         */
         [[nodiscard]]
+        static constexpr bool is_short(const std::int64_t offset) noexcept {
+            return std::in_range<std::int8_t>(offset - SHORT_SIZE);
+        }
+
+        template<CodeBuffer Buffer>
         constexpr std::optional<Relocation> emit(Buffer& buffer, const std::int32_t offset) const {
-            if (std::in_range<std::int8_t>(offset)) {
+            if (is_short(offset)) {
                 buffer.emit8(JMP_8);
-                buffer.emit8(static_cast<std::int8_t>(offset) - 2);
+                buffer.emit8(static_cast<std::uint8_t>(offset - SHORT_SIZE));
 
             } else {
                 buffer.emit8(JMP);
-                buffer.emit32(offset - 5);
+                buffer.emit32(offset - LONG_SIZE);
             }
 
             return std::nullopt;
         }
 
-        template<CodeBuffer Buffer>
-        constexpr void emit_unresolved32(Buffer& buffer) const {
-            buffer.emit8(JMP);
-            buffer.emit32(INT32_MAX);
-        }
-
         [[nodiscard]]
         constexpr const Label& label() const noexcept {
             return m_label;
@@ -40,4 +44,23 @@ namespace aasm::details {
     private:
         const Label m_label;
     };
-}
\ No newline at end of file
+
+    class JmpM final {
+    public:
+        explicit constexpr JmpM(const Address& addr) noexcept:
+            m_addr(addr) {}
+
+        friend std::ostream &operator<<(std::ostream &os, const JmpM &jmp);
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            static constexpr std::array<std::uint8_t, 1> JMP = {0xFF};
+            Encoder enc(buffer, JMP, JMP);
+            return enc.encode_M_without_REXW(4, 8, m_addr);
+        }
+
+    private:
+        Address m_addr;
+    };
+}
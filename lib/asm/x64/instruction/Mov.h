@@ -17,6 +17,21 @@ namespace aasm::details {
             return enc.encode_MR(m_size, m_src, m_dest);
         }
 
+        [[nodiscard]]
+        constexpr std::uint8_t size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]]
+        constexpr GPReg src() const noexcept {
+            return m_src;
+        }
+
+        [[nodiscard]]
+        constexpr GPReg dst() const noexcept {
+            return m_dest;
+        }
+
     private:
         std::uint8_t m_size;
         GPReg m_src;
@@ -38,6 +53,21 @@ namespace aasm::details {
             return enc.encode_RI64(m_size, m_src, m_dest);
         }
 
+        [[nodiscard]]
+        constexpr std::uint8_t size() const noexcept {
+            return m_size;
+        }
+
+        [[nodiscard]]
+        constexpr std::int64_t imm() const noexcept {
+            return m_src;
+        }
+
+        [[nodiscard]]
+        constexpr GPReg dst() const noexcept {
+            return m_dest;
+        }
+
     private:
         std::uint8_t m_size;
         std::int64_t m_src;
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr std::array<std::uint8_t, 1> NOT_R_8 = {0xF6};
+    static constexpr std::array<std::uint8_t, 1> NOT_R = {0xF7};
+
+    template<typename SRC>
+    class Not {
+    public:
+        template<typename S = SRC>
+        explicit constexpr Not(const std::uint8_t size, S&& reg) noexcept:
+            m_size(size),
+            m_src(std::forward<S>(reg)) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer &buffer) const {
+            Encoder enc(buffer, NOT_R_8, NOT_R);
+            switch (m_size) {
+                case 1: [[fallthrough]];
+                case 2: [[fallthrough]];
+                case 4: [[fallthrough]];
+                case 8: return enc.encode_M(2, m_size, m_src);
+                default: die("Invalid size for not instruction: {}", m_size);
+            }
+        }
+
+    protected:
+        std::uint8_t m_size;
+        SRC m_src;
+    };
+
+    class NotR final: public Not<GPReg> {
+    public:
+        explicit constexpr NotR(const std::uint8_t size, const GPReg reg) noexcept:
+            Not(size, reg) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const NotR& notr);
+    };
+
+    class NotM final: public Not<Address> {
+    public:
+        explicit constexpr NotM(const std::uint8_t size, const Address& addr) noexcept:
+            Not(size, addr) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const NotM& notm);
+    };
+}
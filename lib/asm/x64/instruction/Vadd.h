@@ -0,0 +1,72 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VADDPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x58};
+    static constexpr VexOpcode VADDPD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x58};
+    static constexpr VexOpcode VPADDD = {VexPrefix::P66, VexMap::MAP_0F, false, 0xFE};
+    static constexpr VexOpcode VPADDQ = {VexPrefix::P66, VexMap::MAP_0F, false, 0xD4};
+
+    class VaddpsRR final: public VexRVM_Base<XmmReg, VADDPS> {
+    public:
+        explicit constexpr VaddpsRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VaddpsRR& rr);
+    };
+
+    class VaddpsRM final: public VexRVM_Base<Address, VADDPS> {
+    public:
+        explicit constexpr VaddpsRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VaddpsRM& rm);
+    };
+
+    class VaddpdRR final: public VexRVM_Base<XmmReg, VADDPD> {
+    public:
+        explicit constexpr VaddpdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VaddpdRR& rr);
+    };
+
+    class VaddpdRM final: public VexRVM_Base<Address, VADDPD> {
+    public:
+        explicit constexpr VaddpdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VaddpdRM& rm);
+    };
+
+    class VpadddRR final: public VexRVM_Base<XmmReg, VPADDD> {
+    public:
+        explicit constexpr VpadddRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpadddRR& rr);
+    };
+
+    class VpadddRM final: public VexRVM_Base<Address, VPADDD> {
+    public:
+        explicit constexpr VpadddRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpadddRM& rm);
+    };
+
+    class VpaddqRR final: public VexRVM_Base<XmmReg, VPADDQ> {
+    public:
+        explicit constexpr VpaddqRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpaddqRR& rr);
+    };
+
+    class VpaddqRM final: public VexRVM_Base<Address, VPADDQ> {
+    public:
+        explicit constexpr VpaddqRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpaddqRM& rm);
+    };
+}
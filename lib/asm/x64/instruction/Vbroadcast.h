@@ -0,0 +1,73 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VBROADCASTSS = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x18};
+    // Only the 256 bit form exists.
+    static constexpr VexOpcode VBROADCASTSD = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x19};
+    static constexpr VexOpcode VPBROADCASTD = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x58};
+    static constexpr VexOpcode VPBROADCASTQ = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x59};
+
+    class VbroadcastssRR final: public VexRM_Base<XmmReg, VBROADCASTSS> {
+    public:
+        explicit constexpr VbroadcastssRR(const std::uint8_t size, const XmmReg src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VbroadcastssRR& rr);
+    };
+
+    class VbroadcastssRM final: public VexRM_Base<Address, VBROADCASTSS> {
+    public:
+        explicit constexpr VbroadcastssRM(const std::uint8_t size, const Address& src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VbroadcastssRM& rm);
+    };
+
+    class VbroadcastsdRR final: public VexRM_Base<XmmReg, VBROADCASTSD> {
+    public:
+        explicit constexpr VbroadcastsdRR(const std::uint8_t size, const XmmReg src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VbroadcastsdRR& rr);
+    };
+
+    class VbroadcastsdRM final: public VexRM_Base<Address, VBROADCASTSD> {
+    public:
+        explicit constexpr VbroadcastsdRM(const std::uint8_t size, const Address& src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VbroadcastsdRM& rm);
+    };
+
+    class VpbroadcastdRR final: public VexRM_Base<XmmReg, VPBROADCASTD> {
+    public:
+        explicit constexpr VpbroadcastdRR(const std::uint8_t size, const XmmReg src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpbroadcastdRR& rr);
+    };
+
+    class VpbroadcastdRM final: public VexRM_Base<Address, VPBROADCASTD> {
+    public:
+        explicit constexpr VpbroadcastdRM(const std::uint8_t size, const Address& src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpbroadcastdRM& rm);
+    };
+
+    class VpbroadcastqRR final: public VexRM_Base<XmmReg, VPBROADCASTQ> {
+    public:
+        explicit constexpr VpbroadcastqRR(const std::uint8_t size, const XmmReg src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpbroadcastqRR& rr);
+    };
+
+    class VpbroadcastqRM final: public VexRM_Base<Address, VPBROADCASTQ> {
+    public:
+        explicit constexpr VpbroadcastqRM(const std::uint8_t size, const Address& src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpbroadcastqRM& rm);
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+namespace aasm {
+    /**
+     * Comparison predicate of the vcmpps and vcmppd instructions.
+     */
+    enum class VcmpPredicate: std::uint8_t {
+        EQ_OQ  = 0x00,
+        LT_OS  = 0x01,
+        LE_OS  = 0x02,
+        NEQ_UQ = 0x04,
+        GE_OS  = 0x0D,
+        GT_OS  = 0x0E,
+    };
+}
+
+namespace aasm::details {
+    static constexpr VexOpcode VCMPPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0xC2};
+    static constexpr VexOpcode VCMPPD = {VexPrefix::P66, VexMap::MAP_0F, false, 0xC2};
+
+    class VcmppsRR final: public VexRVMI_Base<XmmReg, VCMPPS> {
+    public:
+        explicit constexpr VcmppsRR(const std::uint8_t size, const std::uint8_t imm, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VcmppsRR& rr);
+    };
+
+    class VcmppsRM final: public VexRVMI_Base<Address, VCMPPS> {
+    public:
+        explicit constexpr VcmppsRM(const std::uint8_t size, const std::uint8_t imm, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VcmppsRM& rm);
+    };
+
+    class VcmppdRR final: public VexRVMI_Base<XmmReg, VCMPPD> {
+    public:
+        explicit constexpr VcmppdRR(const std::uint8_t size, const std::uint8_t imm, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VcmppdRR& rr);
+    };
+
+    class VcmppdRM final: public VexRVMI_Base<Address, VCMPPD> {
+    public:
+        explicit constexpr VcmppdRM(const std::uint8_t size, const std::uint8_t imm, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VcmppdRM& rm);
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VDIVPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x5E};
+    static constexpr VexOpcode VDIVPD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x5E};
+
+    class VdivpsRR final: public VexRVM_Base<XmmReg, VDIVPS> {
+    public:
+        explicit constexpr VdivpsRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VdivpsRR& rr);
+    };
+
+    class VdivpsRM final: public VexRVM_Base<Address, VDIVPS> {
+    public:
+        explicit constexpr VdivpsRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VdivpsRM& rm);
+    };
+
+    class VdivpdRR final: public VexRVM_Base<XmmReg, VDIVPD> {
+    public:
+        explicit constexpr VdivpdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VdivpdRR& rr);
+    };
+
+    class VdivpdRM final: public VexRVM_Base<Address, VDIVPD> {
+    public:
+        explicit constexpr VdivpdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VdivpdRM& rm);
+    };
+}
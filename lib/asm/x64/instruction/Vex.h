@@ -0,0 +1,84 @@
+#pragma once
+
+namespace aasm::details {
+    /**
+     * Packed three operand instruction: dst := src1 op src2.
+     */
+    template<typename SRC, VexOpcode OPCODE>
+    class VexRVM_Base {
+    public:
+        template<typename S = SRC>
+        explicit constexpr VexRVM_Base(const std::uint8_t size, S&& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            m_size(size),
+            m_src2(std::forward<S>(src2)),
+            m_src1(src1),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            VEXEncoder encoder(buffer, OPCODE, m_size);
+            return encoder.encode_RVM(m_dst, m_src1, m_src2);
+        }
+
+    protected:
+        std::uint8_t m_size;
+        SRC m_src2;
+        XmmReg m_src1;
+        XmmReg m_dst;
+    };
+
+    /**
+     * Packed three operand instruction with an immediate byte: dst := op(src1, src2, imm8).
+     */
+    template<typename SRC, VexOpcode OPCODE>
+    class VexRVMI_Base {
+    public:
+        template<typename S = SRC>
+        explicit constexpr VexRVMI_Base(const std::uint8_t size, const std::uint8_t imm, S&& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            m_size(size),
+            m_imm(imm),
+            m_src2(std::forward<S>(src2)),
+            m_src1(src1),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            VEXEncoder encoder(buffer, OPCODE, m_size);
+            return encoder.encode_RVMI(m_dst, m_src1, m_src2, m_imm);
+        }
+
+    protected:
+        std::uint8_t m_size;
+        std::uint8_t m_imm;
+        SRC m_src2;
+        XmmReg m_src1;
+        XmmReg m_dst;
+    };
+
+    /**
+     * Packed two operand instruction: dst := op src.
+     */
+    template<typename SRC, VexOpcode OPCODE>
+    class VexRM_Base {
+    public:
+        template<typename S = SRC>
+        explicit constexpr VexRM_Base(const std::uint8_t size, S&& src, const XmmReg dst) noexcept:
+            m_size(size),
+            m_src(std::forward<S>(src)),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            VEXEncoder encoder(buffer, OPCODE, m_size);
+            return encoder.encode_RM(m_dst, m_src);
+        }
+
+    protected:
+        std::uint8_t m_size;
+        SRC m_src;
+        XmmReg m_dst;
+    };
+}
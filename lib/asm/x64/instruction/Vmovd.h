@@ -0,0 +1,25 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VMOVD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x6E};
+    static constexpr VexOpcode VMOVQ = {VexPrefix::P66, VexMap::MAP_0F, true, 0x6E};
+
+    /**
+     * Moves the general purpose register to the lowest element of the xmm register.
+     */
+    class VmovdRR final: public VexRM_Base<GPReg, VMOVD> {
+    public:
+        explicit constexpr VmovdRR(const GPReg src, const XmmReg dst) noexcept:
+            VexRM_Base(16, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmovdRR& rr);
+    };
+
+    class VmovqRR final: public VexRM_Base<GPReg, VMOVQ> {
+    public:
+        explicit constexpr VmovqRR(const GPReg src, const XmmReg dst) noexcept:
+            VexRM_Base(16, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmovqRR& rr);
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VMOVUPS_RM = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x10};
+    static constexpr VexOpcode VMOVUPS_MR = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x11};
+
+    class VmovupsRR final: public VexRM_Base<XmmReg, VMOVUPS_RM> {
+    public:
+        explicit constexpr VmovupsRR(const std::uint8_t size, const XmmReg src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmovupsRR& rr);
+    };
+
+    class VmovupsRM final: public VexRM_Base<Address, VMOVUPS_RM> {
+    public:
+        explicit constexpr VmovupsRM(const std::uint8_t size, const Address& src, const XmmReg dst) noexcept:
+            VexRM_Base(size, src, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmovupsRM& rm);
+    };
+
+    class VmovupsMR final {
+    public:
+        explicit constexpr VmovupsMR(const std::uint8_t size, const XmmReg src, const Address& dst) noexcept:
+            m_size(size),
+            m_src(src),
+            m_dst(dst) {}
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            VEXEncoder encoder(buffer, VMOVUPS_MR, m_size);
+            return encoder.encode_MR(m_src, m_dst);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const VmovupsMR& mr);
+
+    private:
+        std::uint8_t m_size;
+        XmmReg m_src;
+        Address m_dst;
+    };
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VMULPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x59};
+    static constexpr VexOpcode VMULPD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x59};
+    static constexpr VexOpcode VPMULLD = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x40};
+
+    class VmulpsRR final: public VexRVM_Base<XmmReg, VMULPS> {
+    public:
+        explicit constexpr VmulpsRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmulpsRR& rr);
+    };
+
+    class VmulpsRM final: public VexRVM_Base<Address, VMULPS> {
+    public:
+        explicit constexpr VmulpsRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmulpsRM& rm);
+    };
+
+    class VmulpdRR final: public VexRVM_Base<XmmReg, VMULPD> {
+    public:
+        explicit constexpr VmulpdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmulpdRR& rr);
+    };
+
+    class VmulpdRM final: public VexRVM_Base<Address, VMULPD> {
+    public:
+        explicit constexpr VmulpdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VmulpdRM& rm);
+    };
+
+    class VpmulldRR final: public VexRVM_Base<XmmReg, VPMULLD> {
+    public:
+        explicit constexpr VpmulldRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpmulldRR& rr);
+    };
+
+    class VpmulldRM final: public VexRVM_Base<Address, VPMULLD> {
+    public:
+        explicit constexpr VpmulldRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpmulldRM& rm);
+    };
+}
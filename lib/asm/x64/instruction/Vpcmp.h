@@ -0,0 +1,72 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VPCMPEQD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x76};
+    static constexpr VexOpcode VPCMPEQQ = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x29};
+    static constexpr VexOpcode VPCMPGTD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x66};
+    static constexpr VexOpcode VPCMPGTQ = {VexPrefix::P66, VexMap::MAP_0F38, false, 0x37};
+
+    class VpcmpeqdRR final: public VexRVM_Base<XmmReg, VPCMPEQD> {
+    public:
+        explicit constexpr VpcmpeqdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpeqdRR& rr);
+    };
+
+    class VpcmpeqdRM final: public VexRVM_Base<Address, VPCMPEQD> {
+    public:
+        explicit constexpr VpcmpeqdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpeqdRM& rm);
+    };
+
+    class VpcmpeqqRR final: public VexRVM_Base<XmmReg, VPCMPEQQ> {
+    public:
+        explicit constexpr VpcmpeqqRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpeqqRR& rr);
+    };
+
+    class VpcmpeqqRM final: public VexRVM_Base<Address, VPCMPEQQ> {
+    public:
+        explicit constexpr VpcmpeqqRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpeqqRM& rm);
+    };
+
+    class VpcmpgtdRR final: public VexRVM_Base<XmmReg, VPCMPGTD> {
+    public:
+        explicit constexpr VpcmpgtdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpgtdRR& rr);
+    };
+
+    class VpcmpgtdRM final: public VexRVM_Base<Address, VPCMPGTD> {
+    public:
+        explicit constexpr VpcmpgtdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpgtdRM& rm);
+    };
+
+    class VpcmpgtqRR final: public VexRVM_Base<XmmReg, VPCMPGTQ> {
+    public:
+        explicit constexpr VpcmpgtqRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpgtqRR& rr);
+    };
+
+    class VpcmpgtqRM final: public VexRVM_Base<Address, VPCMPGTQ> {
+    public:
+        explicit constexpr VpcmpgtqRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpcmpgtqRM& rm);
+    };
+}
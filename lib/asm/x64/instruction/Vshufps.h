@@ -0,0 +1,21 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VSHUFPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0xC6};
+
+    class VshufpsRR final: public VexRVMI_Base<XmmReg, VSHUFPS> {
+    public:
+        explicit constexpr VshufpsRR(const std::uint8_t size, const std::uint8_t imm, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VshufpsRR& rr);
+    };
+
+    class VshufpsRM final: public VexRVMI_Base<Address, VSHUFPS> {
+    public:
+        explicit constexpr VshufpsRM(const std::uint8_t size, const std::uint8_t imm, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVMI_Base(size, imm, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VshufpsRM& rm);
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VSUBPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x5C};
+    static constexpr VexOpcode VSUBPD = {VexPrefix::P66, VexMap::MAP_0F, false, 0x5C};
+    static constexpr VexOpcode VPSUBD = {VexPrefix::P66, VexMap::MAP_0F, false, 0xFA};
+    static constexpr VexOpcode VPSUBQ = {VexPrefix::P66, VexMap::MAP_0F, false, 0xFB};
+
+    class VsubpsRR final: public VexRVM_Base<XmmReg, VSUBPS> {
+    public:
+        explicit constexpr VsubpsRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VsubpsRR& rr);
+    };
+
+    class VsubpsRM final: public VexRVM_Base<Address, VSUBPS> {
+    public:
+        explicit constexpr VsubpsRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VsubpsRM& rm);
+    };
+
+    class VsubpdRR final: public VexRVM_Base<XmmReg, VSUBPD> {
+    public:
+        explicit constexpr VsubpdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VsubpdRR& rr);
+    };
+
+    class VsubpdRM final: public VexRVM_Base<Address, VSUBPD> {
+    public:
+        explicit constexpr VsubpdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VsubpdRM& rm);
+    };
+
+    class VpsubdRR final: public VexRVM_Base<XmmReg, VPSUBD> {
+    public:
+        explicit constexpr VpsubdRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpsubdRR& rr);
+    };
+
+    class VpsubdRM final: public VexRVM_Base<Address, VPSUBD> {
+    public:
+        explicit constexpr VpsubdRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpsubdRM& rm);
+    };
+
+    class VpsubqRR final: public VexRVM_Base<XmmReg, VPSUBQ> {
+    public:
+        explicit constexpr VpsubqRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpsubqRR& rr);
+    };
+
+    class VpsubqRM final: public VexRVM_Base<Address, VPSUBQ> {
+    public:
+        explicit constexpr VpsubqRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VpsubqRM& rm);
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace aasm::details {
+    static constexpr VexOpcode VXORPS = {VexPrefix::NONE, VexMap::MAP_0F, false, 0x57};
+
+    class VxorpsRR final: public VexRVM_Base<XmmReg, VXORPS> {
+    public:
+        explicit constexpr VxorpsRR(const std::uint8_t size, const XmmReg src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VxorpsRR& rr);
+    };
+
+    class VxorpsRM final: public VexRVM_Base<Address, VXORPS> {
+    public:
+        explicit constexpr VxorpsRM(const std::uint8_t size, const Address& src2, const XmmReg src1, const XmmReg dst) noexcept:
+            VexRVM_Base(size, src2, src1, dst) {}
+
+        friend std::ostream& operator<<(std::ostream& os, const VxorpsRM& rm);
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace aasm::details {
+    class Vzeroupper final {
+    public:
+        constexpr Vzeroupper() noexcept = default;
+
+        friend std::ostream &operator<<(std::ostream &os, const Vzeroupper &vzeroupper);
+
+        template<CodeBuffer Buffer>
+        [[nodiscard]]
+        constexpr std::optional<Relocation> emit(Buffer& buffer) const {
+            buffer.emit8(0xC5);
+            buffer.emit8(0xF8);
+            buffer.emit8(0x77);
+            return std::nullopt;
+        }
+    };
+}
@@ -55,6 +55,39 @@ namespace aasm::details {
         return os << name << " %" << reg.name(16) << ", " << addr;
     }
 
+    static std::ostream& print_vex_operand(std::ostream& os, const std::size_t size, const XmmReg reg) {
+        return os << '%' << reg.name(size);
+    }
+
+    static std::ostream& print_vex_operand(std::ostream& os, const std::size_t size, const GPReg reg) {
+        return os << '%' << reg.name(size);
+    }
+
+    static std::ostream& print_vex_operand(std::ostream& os, const std::size_t, const Address& addr) {
+        return os << addr;
+    }
+
+    template<typename Src, typename Dst>
+    static std::ostream& print_vex_to(std::ostream& os, const std::string_view name, const std::size_t src_size, const Src& src, const std::size_t dst_size, const Dst& dst) {
+        os << name << ' ';
+        print_vex_operand(os, src_size, src) << ", ";
+        return print_vex_operand(os, dst_size, dst);
+    }
+
+    template<typename Src>
+    static std::ostream& print_vex_to(std::ostream& os, const std::string_view name, const std::size_t size, const Src& src2, const XmmReg src1, const XmmReg dst) {
+        os << name << ' ';
+        print_vex_operand(os, size, src2) << ", ";
+        return os << '%' << src1.name(size) << ", %" << dst.name(size);
+    }
+
+    template<typename Src>
+    static std::ostream& print_vex_to(std::ostream& os, const std::string_view name, const std::size_t size, const std::uint8_t imm, const Src& src2, const XmmReg src1, const XmmReg dst) {
+        os << name << " $" << static_cast<unsigned>(imm) << ", ";
+        print_vex_operand(os, size, src2) << ", ";
+        return os << '%' << src1.name(size) << ", %" << dst.name(size);
+    }
+
     std::ostream& operator<<(std::ostream &os, const Lea &lea) {
         return print_to(os, "lea", 8, lea.m_src, lea.m_dst);
     }
@@ -75,6 +108,30 @@ namespace aasm::details {
         return print_to(os, "neg", negm.m_size, negm.m_src);
     }
 
+    std::ostream& operator<<(std::ostream& os, const NotR& notr) {
+        return print_to(os, "not", notr.m_size, notr.m_src);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const NotM& notm) {
+        return print_to(os, "not", notm.m_size, notm.m_src);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ImulRR& imul) {
+        return print_to(os, "imul", imul.m_size, imul.m_src, imul.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ImulRM& imul) {
+        return print_to(os, "imul", imul.m_size, imul.m_src, imul.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ImulRRI& imul) {
+        return os << "imul" << prefix_size(imul.m_size) << " $" << imul.m_imm << ", %" << imul.m_src.name(imul.m_size) << ", %" << imul.m_dst.name(imul.m_size);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ImulRMI& imul) {
+        return os << "imul" << prefix_size(imul.m_size) << " $" << imul.m_imm << ", " << imul.m_src << ", %" << imul.m_dst.name(imul.m_size);
+    }
+
     std::ostream& operator<<(std::ostream &os, const UDivR& idiv) {
         return print_to(os, "div", idiv.m_size, idiv.m_divisor);
     }
@@ -267,6 +324,10 @@ namespace aasm::details {
         return os << "jmp " << jmp.m_label;
     }
 
+    std::ostream &operator<<(std::ostream &os, const JmpM &jmp) {
+        return os << "jmp *" << jmp.m_addr;
+    }
+
     std::ostream & operator<<(std::ostream &os, const Jcc &jcc) {
         return os << "j" << jcc.m_type << ' ' << jcc.m_label;
     }
@@ -283,6 +344,10 @@ namespace aasm::details {
         return os << "call " << call.m_addr;
     }
 
+    std::ostream & operator<<(std::ostream &os, const CallR &call) {
+        return os << "call *%" << call.m_reg.name(8);
+    }
+
     std::ostream &operator<<(std::ostream &os, const Leave &) {
         return os << "leave";
     }
@@ -537,6 +602,230 @@ namespace aasm::details {
     std::ostream& operator<<(std::ostream& os, const DivsdRM& rr) {
         return print_to(os, "divsd", rr.m_src, rr.m_dst);
     }
+
+    std::ostream& operator<<(std::ostream& os, const VmovupsRR& rr) {
+        return print_vex_to(os, "vmovups", rr.m_size, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmovupsRM& rm) {
+        return print_vex_to(os, "vmovups", rm.m_size, rm.m_src, rm.m_size, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmovupsMR& mr) {
+        return print_vex_to(os, "vmovups", mr.m_size, mr.m_src, mr.m_size, mr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmovdRR& rr) {
+        return print_vex_to(os, "vmovd", 4, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmovqRR& rr) {
+        return print_vex_to(os, "vmovq", 8, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VaddpsRR& rr) {
+        return print_vex_to(os, "vaddps", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VaddpsRM& rm) {
+        return print_vex_to(os, "vaddps", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VaddpdRR& rr) {
+        return print_vex_to(os, "vaddpd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VaddpdRM& rm) {
+        return print_vex_to(os, "vaddpd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpadddRR& rr) {
+        return print_vex_to(os, "vpaddd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpadddRM& rm) {
+        return print_vex_to(os, "vpaddd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpaddqRR& rr) {
+        return print_vex_to(os, "vpaddq", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpaddqRM& rm) {
+        return print_vex_to(os, "vpaddq", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VsubpsRR& rr) {
+        return print_vex_to(os, "vsubps", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VsubpsRM& rm) {
+        return print_vex_to(os, "vsubps", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VsubpdRR& rr) {
+        return print_vex_to(os, "vsubpd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VsubpdRM& rm) {
+        return print_vex_to(os, "vsubpd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpsubdRR& rr) {
+        return print_vex_to(os, "vpsubd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpsubdRM& rm) {
+        return print_vex_to(os, "vpsubd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpsubqRR& rr) {
+        return print_vex_to(os, "vpsubq", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpsubqRM& rm) {
+        return print_vex_to(os, "vpsubq", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmulpsRR& rr) {
+        return print_vex_to(os, "vmulps", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmulpsRM& rm) {
+        return print_vex_to(os, "vmulps", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmulpdRR& rr) {
+        return print_vex_to(os, "vmulpd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VmulpdRM& rm) {
+        return print_vex_to(os, "vmulpd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpmulldRR& rr) {
+        return print_vex_to(os, "vpmulld", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpmulldRM& rm) {
+        return print_vex_to(os, "vpmulld", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VdivpsRR& rr) {
+        return print_vex_to(os, "vdivps", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VdivpsRM& rm) {
+        return print_vex_to(os, "vdivps", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VdivpdRR& rr) {
+        return print_vex_to(os, "vdivpd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VdivpdRM& rm) {
+        return print_vex_to(os, "vdivpd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VxorpsRR& rr) {
+        return print_vex_to(os, "vxorps", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VxorpsRM& rm) {
+        return print_vex_to(os, "vxorps", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpeqdRR& rr) {
+        return print_vex_to(os, "vpcmpeqd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpeqdRM& rm) {
+        return print_vex_to(os, "vpcmpeqd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpeqqRR& rr) {
+        return print_vex_to(os, "vpcmpeqq", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpeqqRM& rm) {
+        return print_vex_to(os, "vpcmpeqq", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpgtdRR& rr) {
+        return print_vex_to(os, "vpcmpgtd", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpgtdRM& rm) {
+        return print_vex_to(os, "vpcmpgtd", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpgtqRR& rr) {
+        return print_vex_to(os, "vpcmpgtq", rr.m_size, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpcmpgtqRM& rm) {
+        return print_vex_to(os, "vpcmpgtq", rm.m_size, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VcmppsRR& rr) {
+        return print_vex_to(os, "vcmpps", rr.m_size, rr.m_imm, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VcmppsRM& rm) {
+        return print_vex_to(os, "vcmpps", rm.m_size, rm.m_imm, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VcmppdRR& rr) {
+        return print_vex_to(os, "vcmppd", rr.m_size, rr.m_imm, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VcmppdRM& rm) {
+        return print_vex_to(os, "vcmppd", rm.m_size, rm.m_imm, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VshufpsRR& rr) {
+        return print_vex_to(os, "vshufps", rr.m_size, rr.m_imm, rr.m_src2, rr.m_src1, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VshufpsRM& rm) {
+        return print_vex_to(os, "vshufps", rm.m_size, rm.m_imm, rm.m_src2, rm.m_src1, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VbroadcastssRR& rr) {
+        return print_vex_to(os, "vbroadcastss", 16, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VbroadcastssRM& rm) {
+        return print_vex_to(os, "vbroadcastss", 16, rm.m_src, rm.m_size, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VbroadcastsdRR& rr) {
+        return print_vex_to(os, "vbroadcastsd", 16, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VbroadcastsdRM& rm) {
+        return print_vex_to(os, "vbroadcastsd", 16, rm.m_src, rm.m_size, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpbroadcastdRR& rr) {
+        return print_vex_to(os, "vpbroadcastd", 16, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpbroadcastdRM& rm) {
+        return print_vex_to(os, "vpbroadcastd", 16, rm.m_src, rm.m_size, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpbroadcastqRR& rr) {
+        return print_vex_to(os, "vpbroadcastq", 16, rr.m_src, rr.m_size, rr.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VpbroadcastqRM& rm) {
+        return print_vex_to(os, "vpbroadcastq", 16, rm.m_src, rm.m_size, rm.m_dst);
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Vzeroupper&) {
+        return os << "vzeroupper";
+    }
 }
 
 namespace aasm {
@@ -7,6 +7,7 @@
 #include "asm/symbol/Symbol.h"
 #include "asm/x64/encoding/Encoding.h"
 #include "asm/x64/encoding/SSEEncoding.h"
+#include "asm/x64/encoding/VEXEncoding.h"
 #include "asm/Label.h"
 #include "asm/x64/reg/XmmReg.h"
 #include "asm/x64/CondType.h"
@@ -30,6 +31,8 @@
 #include "Movsx.h"
 #include "Movsxd.h"
 #include "Neg.h"
+#include "Not.h"
+#include "Imul.h"
 #include "Div.h"
 #include "Cdq.h"
 #include "Movss.h"
@@ -50,6 +53,19 @@
 #include "Test.h"
 #include "Or.h"
 #include "Divss.h"
+#include "Vex.h"
+#include "Vmovups.h"
+#include "Vmovd.h"
+#include "Vadd.h"
+#include "Vsub.h"
+#include "Vmul.h"
+#include "Vdiv.h"
+#include "Vxorps.h"
+#include "Vcmp.h"
+#include "Vpcmp.h"
+#include "Vshufps.h"
+#include "Vbroadcast.h"
+#include "Vzeroupper.h"
 
 namespace aasm {
     using X64Instruction = std::variant<
@@ -57,6 +73,8 @@ namespace aasm {
         details::Lea,
         details::PopR, details::PopM,
         details::NegR, details::NegM,
+        details::NotR, details::NotM,
+        details::ImulRR, details::ImulRM, details::ImulRRI, details::ImulRMI,
         details::IdivR, details::IdivM,
         details::UDivR, details::UDivM,
         details::PushR, details::PushM, details::PushI,
@@ -73,9 +91,9 @@ namespace aasm {
         details::MovzxRR, details::MovzxRM,
         details::MovsxRR, details::MovsxRM,
         details::MovsxdRR, details::MovsxdRM,
-        details::Jmp, details::Jcc,
+        details::Jmp, details::JmpM, details::Jcc,
         details::SetCCR,
-        details::Call, details::CallM,
+        details::Call, details::CallM, details::CallR,
         details::Leave,
         details::SalRI, details::SalMI, details::SalRR,
         details::SarRI, details::SarMI, details::SarRR,
@@ -98,7 +116,36 @@ namespace aasm {
         details::Cvtss2siRR, details::Cvtss2siRM,
         details::Cvtsd2siRR, details::Cvtsd2siRM,
         details::Cvtsi2ssRR, details::Cvtsi2ssRM,
-        details::Cvtsi2sdRR, details::Cvtsi2sdRM
+        details::Cvtsi2sdRR, details::Cvtsi2sdRM,
+        // AVX Instructions
+        details::VmovupsRR, details::VmovupsRM, details::VmovupsMR,
+        details::VmovdRR, details::VmovqRR,
+        details::VaddpsRR, details::VaddpsRM,
+        details::VaddpdRR, details::VaddpdRM,
+        details::VpadddRR, details::VpadddRM,
+        details::VpaddqRR, details::VpaddqRM,
+        details::VsubpsRR, details::VsubpsRM,
+        details::VsubpdRR, details::VsubpdRM,
+        details::VpsubdRR, details::VpsubdRM,
+        details::VpsubqRR, details::VpsubqRM,
+        details::VmulpsRR, details::VmulpsRM,
+        details::VmulpdRR, details::VmulpdRM,
+        details::VpmulldRR, details::VpmulldRM,
+        details::VdivpsRR, details::VdivpsRM,
+        details::VdivpdRR, details::VdivpdRM,
+        details::VxorpsRR, details::VxorpsRM,
+        details::VcmppsRR, details::VcmppsRM,
+        details::VcmppdRR, details::VcmppdRM,
+        details::VpcmpeqdRR, details::VpcmpeqdRM,
+        details::VpcmpeqqRR, details::VpcmpeqqRM,
+        details::VpcmpgtdRR, details::VpcmpgtdRM,
+        details::VpcmpgtqRR, details::VpcmpgtqRM,
+        details::VshufpsRR, details::VshufpsRM,
+        details::VbroadcastssRR, details::VbroadcastssRM,
+        details::VbroadcastsdRR, details::VbroadcastsdRM,
+        details::VpbroadcastdRR, details::VpbroadcastdRM,
+        details::VpbroadcastqRR, details::VpbroadcastqRM,
+        details::Vzeroupper
     >;
 
     std::ostream &operator<<(std::ostream &os, const X64Instruction &inst);
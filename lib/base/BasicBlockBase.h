@@ -5,6 +5,7 @@
 #include <ostream>
 #include <utility>
 
+#include "utility/Arena.h"
 #include "utility/Error.h"
 #include "utility/OrderedSet.h"
 
@@ -103,6 +104,9 @@ public:
     }
 
 protected:
+    explicit BasicBlockBase(Arena& arena) noexcept:
+        m_arena(&arena) {}
+
     void set_id(const std::size_t id) noexcept {
         assertion(std::in_range<std::uint32_t>(id), "id={} is out of range", id);
         m_id = id;
@@ -115,6 +119,7 @@ protected:
         }
     }
 
+    Arena* m_arena;
     std::size_t m_id{NO_ID};
     std::vector<Derived *> m_predecessors;
     OrderedSet<Inst> m_instructions;
@@ -34,6 +34,11 @@ protected:
         m_owner = owner;
     }
 
+    void disconnect() noexcept {
+        m_id = NO_ID;
+        m_owner = nullptr;
+    }
+
     BB* m_owner{};
     std::size_t m_id{NO_ID};
 };
\ No newline at end of file
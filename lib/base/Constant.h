@@ -5,5 +5,7 @@ namespace cst {
     constexpr std::size_t WORD_SIZE  = 2;
     constexpr std::size_t DWORD_SIZE = 4;
     constexpr std::size_t QWORD_SIZE = 8;
+    constexpr std::size_t XMMWORD_SIZE = 16;
+    constexpr std::size_t YMMWORD_SIZE = 32;
     constexpr std::size_t POINTER_SIZE = QWORD_SIZE;
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * Measured execution counts of the control flow edges of a function.
+ * Edges are keyed by the ids of their blocks, so the profile stays valid only while the block ids do.
+ */
+class EdgeProfile final {
+public:
+    void add(const std::size_t from, const std::size_t to, const std::uint64_t count = 1) {
+        m_counts[key(from, to)] += count;
+    }
+
+    /** @return the number of times the edge was taken, zero for an edge which was never recorded **/
+    [[nodiscard]]
+    std::uint64_t count(const std::size_t from, const std::size_t to) const {
+        const auto it = m_counts.find(key(from, to));
+        return it != m_counts.end() ? it->second : 0;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return m_counts.empty();
+    }
+
+    void clear() noexcept {
+        m_counts.clear();
+    }
+
+    /**
+     * Calls 'fn(from, to, count)' for every recorded edge.
+     */
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& [edge, count]: m_counts) {
+            fn(static_cast<std::size_t>(edge >> 32), static_cast<std::size_t>(edge & 0xFFFFFFFF), count);
+        }
+    }
+
+private:
+    static std::uint64_t key(const std::size_t from, const std::size_t to) noexcept {
+        return (static_cast<std::uint64_t>(from) << 32) | (static_cast<std::uint64_t>(to) & 0xFFFFFFFF);
+    }
+
+    std::unordered_map<std::uint64_t, std::uint64_t> m_counts;
+};
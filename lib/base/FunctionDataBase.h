@@ -1,11 +1,16 @@
 #pragma once
 
+#include <memory>
+
 #include "Constrains.h"
+#include "EdgeProfile.h"
+#include "utility/Arena.h"
 #include "utility/OrderedSet.h"
 
 
 /**
  * Base class for function data in MIR and LIR.
+ * Blocks and instructions of the function live in its arena, they are freed together with the function.
  *
  * @tparam BB The type of code block (BasicBlock or LIRBlock).
  * @tparam Arg The type of argument (e.g., LIRArg).
@@ -18,12 +23,15 @@ public:
 
     explicit FunctionDataBase(const std::size_t uid, std::vector<arg_type>&& args) noexcept:
         m_uid(uid),
-        m_args(std::move(args)) {}
+        m_args(std::move(args)),
+        m_arena(std::make_unique<Arena>()) {}
 
     FunctionDataBase(FunctionDataBase&& other) noexcept:
         m_uid(other.m_uid),
         m_args(std::move(other.m_args)),
-        m_basic_blocks(std::move(other.m_basic_blocks)) {}
+        m_arena(std::move(other.m_arena)),
+        m_basic_blocks(std::move(other.m_basic_blocks)),
+        m_edge_profile(std::move(other.m_edge_profile)) {}
 
     /**
      * Returns begin block of the function.
@@ -51,19 +59,54 @@ public:
         return m_basic_blocks.size();
     }
 
+    /**
+     * Returns the upper bound of the block ids. It exceeds @ref size when blocks were removed.
+     */
+    [[nodiscard]]
+    std::size_t id_bound() const noexcept {
+        return m_basic_blocks.id_bound();
+    }
+
     [[nodiscard]]
     const OrderedSet<BB>& basic_blocks() const noexcept {
         return m_basic_blocks;
     }
 
-    std::unique_ptr<code_block_type> remove(const code_block_type* bb) {
+    /**
+     * Returns measured edge counts of the function. It is empty unless the function was profiled.
+     */
+    [[nodiscard]]
+    const EdgeProfile& edge_profile() const noexcept {
+        return m_edge_profile;
+    }
+
+    [[nodiscard]]
+    EdgeProfile& edge_profile() noexcept {
+        return m_edge_profile;
+    }
+
+    /**
+     * Constructs the element in the arena of the function without inserting it anywhere.
+     */
+    template<typename T, typename Fn>
+    T* make(Deferred<T, Fn>&& element) {
+        return std::move(element)(*m_arena);
+    }
+
+    /**
+     * Unlinks the block from the function. It stays in the arena until the function is destroyed.
+     */
+    code_block_type* remove(const code_block_type* bb) {
         return m_basic_blocks.remove(bb->id());
     }
 
 protected:
     std::size_t m_uid;
     std::vector<arg_type> m_args;
+    // Owns the blocks and instructions, so it is destroyed after the lists linking them.
+    std::unique_ptr<Arena> m_arena;
     OrderedSet<code_block_type> m_basic_blocks;
+    EdgeProfile m_edge_profile;
 };
 
 
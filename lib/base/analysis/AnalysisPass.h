@@ -1,16 +1,74 @@
 #pragma once
 
+#include <bitset>
+#include <cstddef>
+
 enum class AnalysisType {
     PreOrderTraverse,
     PostOrderTraverse,
     BFSTraverse,
     DominatorTree,
+    DominanceFrontier,
+    LoopInfo,
     LivenessAnalysis,
     LiveIntervalsEval,
     LiveIntervalsGroups,
     Max
 };
 
+/**
+ * Set of analyses which stay valid after a transformation pass.
+ * Everything outside the set is dropped from the cache and recomputed on the next request.
+ */
+class PreservedAnalyses final {
+    constexpr static auto MAX_ANALYSIS_PASSES = static_cast<std::size_t>(AnalysisType::Max);
+
+public:
+    static PreservedAnalyses all() noexcept {
+        PreservedAnalyses preserved;
+        preserved.m_preserved.set();
+        return preserved;
+    }
+
+    static PreservedAnalyses none() noexcept {
+        return {};
+    }
+
+    /** Analyses which only depend on the control flow graph. */
+    static PreservedAnalyses cfg() noexcept {
+        return none()
+            .preserve(AnalysisType::PreOrderTraverse)
+            .preserve(AnalysisType::PostOrderTraverse)
+            .preserve(AnalysisType::BFSTraverse)
+            .preserve(AnalysisType::DominatorTree)
+            .preserve(AnalysisType::DominanceFrontier)
+            .preserve(AnalysisType::LoopInfo);
+    }
+
+    PreservedAnalyses& preserve(const AnalysisType type) noexcept {
+        m_preserved.set(static_cast<std::size_t>(type));
+        return *this;
+    }
+
+    PreservedAnalyses& intersect(const PreservedAnalyses& other) noexcept {
+        m_preserved &= other.m_preserved;
+        return *this;
+    }
+
+    [[nodiscard]]
+    bool is_preserved(const AnalysisType type) const noexcept {
+        return m_preserved.test(static_cast<std::size_t>(type));
+    }
+
+    [[nodiscard]]
+    bool all_preserved() const noexcept {
+        return m_preserved.all();
+    }
+
+private:
+    std::bitset<MAX_ANALYSIS_PASSES> m_preserved{};
+};
+
 class AnalysisPassResult {
 public:
     virtual ~AnalysisPassResult() = default;
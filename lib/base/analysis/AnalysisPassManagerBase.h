@@ -1,11 +1,18 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <memory>
+#include <vector>
 
 #include "AnalysisPass.h"
 #include "base/FunctionDataBase.h"
 
+/**
+ * Lazily computes and caches analysis results of a single function.
+ * Analyses requested while another one is created are recorded as its dependencies,
+ * so invalidating an analysis drops every cached result built on top of it.
+ */
 template<Function FD>
 class AnalysisPassManagerBase final {
     constexpr static auto MAX_ANALYSIS_PASSES = static_cast<std::size_t>(AnalysisType::Max);
@@ -15,18 +22,83 @@ public:
     A::result_type* analyze(const FD* data) {
         using result_type = A::result_type;
         constexpr auto idx = static_cast<std::size_t>(A::analysis_kind);
+        if (!m_computing.empty()) {
+            m_dependents[idx].set(m_computing.back());
+        }
 
         auto& pass_res = m_passes[idx];
         if (pass_res != nullptr) {
             return static_cast<result_type*>(pass_res.get());
         }
 
+        m_computing.push_back(idx);
         auto a = A::create(this, data);
         a.run();
+        m_computing.pop_back();
+
         pass_res = a.result();
         return static_cast<result_type*>(pass_res.get());
     }
 
+    template <Analysis A>
+    [[nodiscard]]
+    bool is_cached() const noexcept {
+        return is_cached(A::analysis_kind);
+    }
+
+    [[nodiscard]]
+    bool is_cached(const AnalysisType type) const noexcept {
+        return m_passes[static_cast<std::size_t>(type)] != nullptr;
+    }
+
+    template <Analysis A>
+    void invalidate() {
+        invalidate(A::analysis_kind);
+    }
+
+    void invalidate(const AnalysisType type) {
+        drop(static_cast<std::size_t>(type));
+    }
+
+    /**
+     * Drops every analysis which is not in the preserved set, together with the analyses depending on it.
+     */
+    void invalidate(const PreservedAnalyses& preserved) {
+        if (preserved.all_preserved()) {
+            return;
+        }
+
+        for (std::size_t idx{}; idx < MAX_ANALYSIS_PASSES; ++idx) {
+            if (!preserved.is_preserved(static_cast<AnalysisType>(idx))) {
+                drop(idx);
+            }
+        }
+    }
+
+    void invalidate_all() {
+        for (auto& pass: m_passes) {
+            pass.reset();
+        }
+        for (auto& dependents: m_dependents) {
+            dependents.reset();
+        }
+    }
+
 private:
+    void drop(const std::size_t idx) {
+        const auto dependents = m_dependents[idx];
+        m_dependents[idx].reset();
+        m_passes[idx].reset();
+        for (std::size_t dep{}; dep < MAX_ANALYSIS_PASSES; ++dep) {
+            if (dependents.test(dep)) {
+                drop(dep);
+            }
+        }
+    }
+
     std::array<std::unique_ptr<AnalysisPassResult>, MAX_ANALYSIS_PASSES> m_passes{};
-};
\ No newline at end of file
+    // For each analysis, the analyses whose results were built from it.
+    std::array<std::bitset<MAX_ANALYSIS_PASSES>, MAX_ANALYSIS_PASSES> m_dependents{};
+    // Analyses being created at the moment, the innermost one is the last.
+    std::vector<std::size_t> m_computing;
+};
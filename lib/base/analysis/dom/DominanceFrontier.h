@@ -0,0 +1,33 @@
+#pragma once
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "base/analysis/AnalysisPass.h"
+#include "base/Constrains.h"
+
+/**
+ * Dominance frontier of each reachable block:
+ * the set of blocks where the dominance of the block ends.
+ */
+template<CodeBlock BB>
+class DominanceFrontier final: public AnalysisPassResult {
+public:
+    explicit DominanceFrontier(std::unordered_map<const BB*, std::vector<BB*>>&& frontier) noexcept:
+        m_frontier(std::move(frontier)) {}
+
+    /** @return dominance frontier of the block. It is empty if the block has no frontier **/
+    [[nodiscard]]
+    std::span<BB* const> frontier(const BB* bb) const {
+        const auto it = m_frontier.find(bb);
+        if (it == m_frontier.end()) {
+            return {};
+        }
+
+        return it->second;
+    }
+
+private:
+    std::unordered_map<const BB*, std::vector<BB*>> m_frontier;
+};
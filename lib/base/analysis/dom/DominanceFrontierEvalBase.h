@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "DominanceFrontier.h"
+#include "DominatorTreeEvalBase.h"
+#include "base/analysis/AnalysisPass.h"
+#include "base/analysis/traverse/PreorderTraverseBase.h"
+
+/**
+ * Evaluates dominance frontiers using the algorithm from
+ * Cooper, Harvey, Kennedy "A Simple, Fast Dominance Algorithm".
+ */
+template<Function FD>
+class DominanceFrontierEvalBase final {
+public:
+    using basic_block = FD::code_block_type;
+    using result_type = DominanceFrontier<basic_block>;
+
+private:
+    explicit DominanceFrontierEvalBase(const Ordering<basic_block>& preorder, const DominatorTree<basic_block>& dom_tree) noexcept:
+        m_preorder(preorder),
+        m_dom_tree(dom_tree) {}
+
+public:
+    static constexpr auto analysis_kind = AnalysisType::DominanceFrontier;
+
+    void run() {
+        for (const auto bb: m_preorder) {
+            const auto preds = bb->predecessors();
+            if (preds.size() < 2) {
+                continue;
+            }
+
+            const auto idom = m_dom_tree.idom(bb);
+            for (const auto pred: preds) {
+                if (!m_dom_tree.contains(pred)) {
+                    // Unreachable predecessor.
+                    continue;
+                }
+
+                for (const basic_block* runner = pred; runner != idom; runner = m_dom_tree.idom(runner)) {
+                    auto& frontier = m_frontier[runner];
+                    if (std::ranges::contains(frontier, bb)) {
+                        continue;
+                    }
+
+                    frontier.push_back(const_cast<basic_block*>(bb));
+                }
+            }
+        }
+    }
+
+    static DominanceFrontierEvalBase create(AnalysisPassManagerBase<FD> *cache, const FD *data) {
+        const auto preorder = cache->template analyze<PreorderTraverseBase<FD>>(data);
+        const auto dom_tree = cache->template analyze<DominatorTreeEvalBase<FD>>(data);
+        return DominanceFrontierEvalBase(*preorder, *dom_tree);
+    }
+
+    std::unique_ptr<result_type> result() noexcept {
+        return std::make_unique<result_type>(std::move(m_frontier));
+    }
+
+private:
+    const Ordering<basic_block>& m_preorder;
+    const DominatorTree<basic_block>& m_dom_tree;
+    std::unordered_map<const basic_block*, std::vector<basic_block*>> m_frontier{};
+};
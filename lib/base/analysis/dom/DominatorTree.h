@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <ostream>
+#include <ranges>
 #include <unordered_map>
 #include <vector>
 
@@ -83,6 +84,26 @@ public:
         return false;
     }
 
+    /** @return true if the block is reachable from the entry and has a node in the tree **/
+    [[nodiscard]]
+    bool contains(const BB* target) const {
+        return dominator_tree.contains(target);
+    }
+
+    /** @return immediate dominator of the block or nullptr for the entry block **/
+    [[nodiscard]]
+    const BB* idom(const BB* target) const {
+        const auto idom = dominator_tree.at(target)->idom;
+        return idom != nullptr ? idom->m_me : nullptr;
+    }
+
+    /** @return blocks immediately dominated by the given one **/
+    [[nodiscard]]
+    auto children(const BB* target) const {
+        const auto to_block = [](const DominatorTreeNode<BB>* node) { return node->m_me; };
+        return dominator_tree.at(target)->children | std::views::transform(to_block);
+    }
+
     /** @return strict dominators **/
     Dominators dominators(const BB* target) const {
         return Dominators(dominator_tree.at(const_cast<BB*>(target)).get()->idom);
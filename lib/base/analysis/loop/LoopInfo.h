@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/analysis/AnalysisPass.h"
+#include "base/Constrains.h"
+#include "base/FunctionDataBase.h"
+
+/**
+ * Natural loop: the header together with the blocks which reach a back edge to it without passing through the header.
+ * Back edges which target the same header form a single loop.
+ */
+template<CodeBlock BB>
+class Loop final {
+public:
+    explicit Loop(const BB* header) noexcept:
+        m_header(header) {}
+
+    [[nodiscard]]
+    const BB* header() const noexcept {
+        return m_header;
+    }
+
+    /** @return blocks of the loop in preorder, the header is the first one **/
+    [[nodiscard]]
+    std::span<const BB* const> blocks() const noexcept {
+        return m_blocks;
+    }
+
+    /** @return blocks of the loop which jump back to the header **/
+    [[nodiscard]]
+    std::span<const BB* const> latches() const noexcept {
+        return m_latches;
+    }
+
+    /** @return blocks outside the loop which are targets of its blocks **/
+    [[nodiscard]]
+    std::span<const BB* const> exits() const noexcept {
+        return m_exits;
+    }
+
+    /** @return the only block outside the loop which jumps to the header, if it has no other successors, or nullptr **/
+    [[nodiscard]]
+    const BB* preheader() const noexcept {
+        return m_preheader;
+    }
+
+    /** @return the innermost enclosing loop or nullptr for an outermost loop **/
+    [[nodiscard]]
+    const Loop* parent() const noexcept {
+        return m_parent;
+    }
+
+    /** @return nesting depth, outermost loops have depth 1 **/
+    [[nodiscard]]
+    std::size_t depth() const noexcept {
+        return m_parent == nullptr ? 1 : m_parent->depth() + 1;
+    }
+
+    [[nodiscard]]
+    bool contains(const BB* bb) const noexcept {
+        return m_members.contains(bb);
+    }
+
+private:
+    template<Function FD>
+    friend class LoopInfoEvalBase;
+
+    const BB* m_header;
+    const BB* m_preheader{};
+    const Loop* m_parent{};
+    std::vector<const BB*> m_blocks;
+    std::vector<const BB*> m_latches;
+    std::vector<const BB*> m_exits;
+    std::unordered_set<const BB*> m_members;
+};
+
+template<CodeBlock BB>
+class LoopInfo final: public AnalysisPassResult {
+public:
+    explicit LoopInfo(std::vector<std::unique_ptr<Loop<BB>>>&& loops, std::unordered_map<const BB*, const Loop<BB>*>&& innermost) noexcept:
+        m_loops(std::move(loops)),
+        m_innermost(std::move(innermost)) {}
+
+    /** @return every loop of the function, enclosing loops precede the nested ones **/
+    [[nodiscard]]
+    std::span<const std::unique_ptr<Loop<BB>>> loops() const noexcept {
+        return m_loops;
+    }
+
+    /** @return the innermost loop containing the block or nullptr if the block is not in a loop **/
+    [[nodiscard]]
+    const Loop<BB>* loop_of(const BB* bb) const {
+        const auto loop = m_innermost.find(bb);
+        return loop != m_innermost.end() ? loop->second : nullptr;
+    }
+
+    /** @return the number of loops containing the block **/
+    [[nodiscard]]
+    std::size_t depth(const BB* bb) const {
+        const auto loop = loop_of(bb);
+        return loop != nullptr ? loop->depth() : 0;
+    }
+
+private:
+    std::vector<std::unique_ptr<Loop<BB>>> m_loops;
+    std::unordered_map<const BB*, const Loop<BB>*> m_innermost;
+};
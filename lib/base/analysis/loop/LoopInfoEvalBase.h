@@ -0,0 +1,154 @@
+#pragma once
+
+#include <memory>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+#include "LoopInfo.h"
+#include "base/analysis/AnalysisPass.h"
+#include "base/analysis/dom/DominatorTreeEvalBase.h"
+#include "base/analysis/traverse/PreorderTraverseBase.h"
+
+/**
+ * Finds natural loops. An edge is a back edge when its target dominates its source.
+ * Blocks are visited in preorder, so a loop header is found before the headers of the loops nested into it.
+ * Irreducible cycles have no dominating header and are not reported.
+ */
+template<Function FD>
+class LoopInfoEvalBase final {
+public:
+    using basic_block = FD::code_block_type;
+    using result_type = LoopInfo<basic_block>;
+
+private:
+    explicit LoopInfoEvalBase(const Ordering<basic_block>& preorder, DominatorTree<basic_block>& dom_tree) noexcept:
+        m_preorder(preorder),
+        m_dom_tree(dom_tree) {}
+
+public:
+    static constexpr auto analysis_kind = AnalysisType::LoopInfo;
+
+    void run() {
+        for (const auto header: m_preorder) {
+            auto latches = find_latches(header);
+            if (latches.empty()) {
+                continue;
+            }
+
+            auto loop = std::make_unique<Loop<basic_block>>(header);
+            loop->m_latches = std::move(latches);
+            collect_blocks(*loop);
+            find_parent(*loop);
+            find_exits(*loop);
+            find_preheader(*loop);
+            m_loops.push_back(std::move(loop));
+        }
+
+        // Nested loops come later, so they overwrite the enclosing ones.
+        for (const auto& loop: m_loops) {
+            for (const auto bb: loop->blocks()) {
+                m_innermost[bb] = loop.get();
+            }
+        }
+    }
+
+    std::unique_ptr<result_type> result() noexcept {
+        return std::make_unique<result_type>(std::move(m_loops), std::move(m_innermost));
+    }
+
+    static LoopInfoEvalBase create(AnalysisPassManagerBase<FD>* cache, const FD* data) {
+        const auto preorder = cache->template analyze<PreorderTraverseBase<FD>>(data);
+        const auto dom_tree = cache->template analyze<DominatorTreeEvalBase<FD>>(data);
+        return LoopInfoEvalBase(*preorder, *dom_tree);
+    }
+
+private:
+    std::vector<const basic_block*> find_latches(const basic_block* header) {
+        std::vector<const basic_block*> latches;
+        for (const auto pred: header->predecessors()) {
+            if (!m_dom_tree.contains(pred)) {
+                // Unreachable blocks are not a part of any loop.
+                continue;
+            }
+            if (pred == header || m_dom_tree.dominates(header, pred)) {
+                latches.push_back(pred);
+            }
+        }
+
+        return latches;
+    }
+
+    /**
+     * Walks the predecessors backwards from the latches, the header stops the walk.
+     */
+    void collect_blocks(Loop<basic_block>& loop) const {
+        auto& members = loop.m_members;
+        members.insert(loop.header());
+
+        std::vector<const basic_block*> worklist;
+        for (const auto latch: loop.latches()) {
+            if (members.insert(latch).second) {
+                worklist.push_back(latch);
+            }
+        }
+
+        while (!worklist.empty()) {
+            const auto bb = worklist.back();
+            worklist.pop_back();
+            for (const auto pred: bb->predecessors()) {
+                if (m_dom_tree.contains(pred) && members.insert(pred).second) {
+                    worklist.push_back(pred);
+                }
+            }
+        }
+
+        for (const auto bb: m_preorder) {
+            if (members.contains(bb)) {
+                loop.m_blocks.push_back(bb);
+            }
+        }
+    }
+
+    void find_parent(Loop<basic_block>& loop) const {
+        for (const auto& outer: m_loops | std::views::reverse) {
+            if (outer->contains(loop.header())) {
+                loop.m_parent = outer.get();
+                return;
+            }
+        }
+    }
+
+    static void find_exits(Loop<basic_block>& loop) {
+        for (const auto bb: loop.blocks()) {
+            for (const auto succ: bb->successors()) {
+                if (!loop.contains(succ) && !std::ranges::contains(loop.m_exits, succ)) {
+                    loop.m_exits.push_back(succ);
+                }
+            }
+        }
+    }
+
+    static void find_preheader(Loop<basic_block>& loop) {
+        const basic_block* preheader{};
+        for (const auto pred: loop.header()->predecessors()) {
+            if (loop.contains(pred)) {
+                continue;
+            }
+            if (preheader != nullptr && preheader != pred) {
+                return;
+            }
+
+            preheader = pred;
+        }
+
+        if (preheader != nullptr && preheader->successors().size() == 1) {
+            loop.m_preheader = preheader;
+        }
+    }
+
+    const Ordering<basic_block>& m_preorder;
+    DominatorTree<basic_block>& m_dom_tree;
+    std::vector<std::unique_ptr<Loop<basic_block>>> m_loops;
+    std::unordered_map<const basic_block*, const Loop<basic_block>*> m_innermost;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+
+enum class GValueKind : std::uint8_t {
+    CONSTANT,
+    VARIABLE,
+};
+
+inline std::string_view to_string(const GValueKind kind) {
+    switch (kind) {
+        case GValueKind::CONSTANT: return "constant";
+        case GValueKind::VARIABLE: return "variable";
+        default: std::unreachable();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#include "TransformPass.h"
+
+/**
+ * Ordered list of transformation passes applied to a single function.
+ * Analyses are shared between the passes through the cache and recomputed only after a pass invalidates them.
+ */
+template<Function FD>
+class FunctionPassPipelineBase final {
+    using pass_fn = PreservedAnalyses(*)(AnalysisPassManagerBase<FD>*, FD*);
+
+public:
+    template<typename P>
+    requires TransformPass<P, FD>
+    FunctionPassPipelineBase& add() {
+        m_passes.push_back(&run_pass<P>);
+        return *this;
+    }
+
+    /**
+     * Runs every pass in order.
+     * @return Analyses preserved by all the passes.
+     */
+    PreservedAnalyses run(AnalysisPassManagerBase<FD>& cache, FD* data) const {
+        auto preserved = PreservedAnalyses::all();
+        for (const auto pass: m_passes) {
+            const auto pass_preserved = pass(&cache, data);
+            cache.invalidate(pass_preserved);
+            preserved.intersect(pass_preserved);
+        }
+
+        return preserved;
+    }
+
+    [[nodiscard]]
+    bool empty() const noexcept {
+        return m_passes.empty();
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_passes.size();
+    }
+
+private:
+    template<typename P>
+    static PreservedAnalyses run_pass(AnalysisPassManagerBase<FD>* cache, FD* data) {
+        auto pass = P::create(cache, data);
+        return pass.run();
+    }
+
+    std::vector<pass_fn> m_passes;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <concepts>
+
+#include "base/analysis/AnalysisPassManagerBase.h"
+
+/**
+ * Pass which rewrites the function in place.
+ * 'run' reports the analyses which are still valid afterwards, the rest is dropped from the cache.
+ */
+template<typename P, typename FD>
+concept TransformPass = Function<FD> && requires(P p, AnalysisPassManagerBase<FD>* cache, FD* data)
+{
+    { P::create(cache, data) } -> std::same_as<P>;
+    { p.run() } -> std::same_as<PreservedAnalyses>;
+};
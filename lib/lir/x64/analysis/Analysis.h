@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base/analysis/dom/DominatorTreeEvalBase.h"
+#include "base/analysis/loop/LoopInfoEvalBase.h"
 #include "base/analysis/traverse/BFSOrderTraverseBase.h"
 #include "base/analysis/traverse/PostOrderTraverseBase.h"
 #include "base/analysis/traverse/PreorderTraverseBase.h"
@@ -15,11 +16,13 @@ using BFSOrderTraverseLIR = BFSOrderTraverseBase<LIRFuncData>;
 using PostOrderTraverseLIR = PostOrderTraverseBase<LIRFuncData>;
 using PreorderTraverseLIR = PreorderTraverseBase<LIRFuncData>;
 using DominatorTreeEvalLIR = DominatorTreeEvalBase<LIRFuncData>;
+using LoopInfoEvalLIR = LoopInfoEvalBase<LIRFuncData>;
 
 static_assert(Analysis<BFSOrderTraverseLIR>);
 static_assert(Analysis<PostOrderTraverseLIR>);
 static_assert(Analysis<PreorderTraverseLIR>);
 static_assert(Analysis<DominatorTreeEvalLIR>);
+static_assert(Analysis<LoopInfoEvalLIR>);
 static_assert(Analysis<LivenessAnalysis>);
 static_assert(Analysis<LiveIntervalsEval>);
 static_assert(Analysis<LiveIntervalsJoinEval>);
@@ -7,9 +7,12 @@ enum class IntervalHint: std::uint8_t {
     CALL_LIVE_OUT
 };
 
+/**
+ * Values joined into one interval share the register, so the interval crosses a call when any of them does.
+ */
 [[maybe_unused]]
 static IntervalHint join_hints(const IntervalHint lhs, const IntervalHint rhs) noexcept {
-    if (lhs == IntervalHint::CALL_LIVE_OUT && rhs == IntervalHint::CALL_LIVE_OUT) {
+    if (lhs == IntervalHint::CALL_LIVE_OUT || rhs == IntervalHint::CALL_LIVE_OUT) {
         return IntervalHint::CALL_LIVE_OUT;
     }
 
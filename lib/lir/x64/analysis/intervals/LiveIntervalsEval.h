@@ -80,6 +80,10 @@ private:
             const auto call_terminator = bb->last()->isa(call());
 
             for (const auto& lir_val: m_liveness.live_out(bb)) {
+                if (call_terminator) {
+                    m_call_live_out.emplace(lir_val);
+                }
+
                 auto& live_range = m_intervals.at(lir_val);
                 const auto interval = live_range.find(bb);
                 if (interval == live_range.end()) {
@@ -87,10 +91,6 @@ private:
                     continue;
                 }
 
-                if (call_terminator) {
-                    m_call_live_out.emplace(lir_val);
-                }
-
                 interval->second.propagate(start + bb->size());
             }
 
@@ -176,7 +176,7 @@ LiveInterval LiveIntervalsJoinEval::create_live_intervals(const std::span<LIRVal
     std::vector<LiveRange> new_intervals;
     new_intervals.reserve(lir_values.size());
 
-    auto acc = IntervalHint::CALL_LIVE_OUT;
+    auto acc = IntervalHint::NOTHING;
     for (const auto& lir_val: lir_values) {
         const auto& intervals = m_intervals.intervals(lir_val);
         acc = join_hints(acc, intervals.hint());
@@ -1,57 +1,140 @@
 #pragma once
 
+#include <ranges>
+
 #include "base/analysis/AnalysisPass.h"
 
 #include "lir/x64/module/LIRBlock.h"
 #include "lir/x64/operand/LIRValMap.h"
+#include "utility/DenseBitSet.h"
+
+/**
+ * Set of live values of a block. Values are stored as bits of their dense numbers.
+ */
+class LiveSet final {
+public:
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = LIRVal;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() noexcept = default;
+
+        const_iterator(const DenseBitSet::const_iterator it, const std::vector<LIRVal>* values) noexcept:
+            m_it(it),
+            m_values(values) {}
+
+        const LIRVal& operator*() const noexcept {
+            return (*m_values)[*m_it];
+        }
+
+        const_iterator& operator++() noexcept {
+            ++m_it;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            const auto tmp = *this;
+            ++m_it;
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept {
+            return m_it == other.m_it;
+        }
 
+    private:
+        DenseBitSet::const_iterator m_it{};
+        const std::vector<LIRVal>* m_values{};
+    };
+
+    LiveSet(const DenseBitSet& bits, const std::vector<LIRVal>& values, const LIRValMap<std::uint32_t>& numbering) noexcept:
+        m_bits(bits),
+        m_values(values),
+        m_numbering(numbering) {}
+
+    [[nodiscard]]
+    bool contains(const LIRVal& lir_val) const noexcept {
+        const auto it = m_numbering.find(lir_val);
+        return it != m_numbering.end() && m_bits.test(it->second);
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_bits.count();
+    }
+
+    [[nodiscard]]
+    const_iterator begin() const noexcept {
+        return {m_bits.begin(), &m_values};
+    }
+
+    [[nodiscard]]
+    const_iterator end() const noexcept {
+        return {m_bits.end(), &m_values};
+    }
+
+private:
+    const DenseBitSet& m_bits;
+    const std::vector<LIRVal>& m_values;
+    const LIRValMap<std::uint32_t>& m_numbering;
+};
 
 class LiveInfo final {
 public:
-    LiveInfo(LIRValSet&& live_in, LIRValSet&& live_out):
+    LiveInfo(DenseBitSet&& live_in, DenseBitSet&& live_out) noexcept:
         m_live_in(std::move(live_in)),
         m_live_out(std::move(live_out)) {}
 
-    const LIRValSet& live_in() const noexcept {
+    [[nodiscard]]
+    const DenseBitSet& live_in() const noexcept {
         return m_live_in;
     }
 
-    const LIRValSet& live_out() const noexcept {
+    [[nodiscard]]
+    const DenseBitSet& live_out() const noexcept {
         return m_live_out;
     }
 
 private:
-    const LIRValSet m_live_in;
-    const LIRValSet m_live_out;
+    DenseBitSet m_live_in;
+    DenseBitSet m_live_out;
 };
 
 
 class LivenessAnalysisInfo final: public AnalysisPassResult {
 public:
-    explicit LivenessAnalysisInfo(std::unordered_map<const LIRBlock*, LiveInfo>&& liveness) noexcept:
+    explicit LivenessAnalysisInfo(std::vector<LIRVal>&& values, LIRValMap<std::uint32_t>&& numbering, std::unordered_map<const LIRBlock*, LiveInfo>&& liveness) noexcept:
+        m_values(std::move(values)),
+        m_numbering(std::move(numbering)),
         m_liveness(std::move(liveness)) {}
 
-    const LIRValSet& live_in(const LIRBlock* bb) const noexcept {
-        return m_liveness.at(bb).live_in();
+    [[nodiscard]]
+    LiveSet live_in(const LIRBlock* bb) const noexcept {
+        return {m_liveness.at(bb).live_in(), m_values, m_numbering};
     }
 
-    const LIRValSet& live_out(const LIRBlock* bb) const noexcept {
-        return m_liveness.at(bb).live_out();
+    [[nodiscard]]
+    LiveSet live_out(const LIRBlock* bb) const noexcept {
+        return {m_liveness.at(bb).live_out(), m_values, m_numbering};
     }
 
     friend std::ostream& operator<<(std::ostream& os, const LivenessAnalysisInfo& info);
 private:
+    std::vector<LIRVal> m_values;
+    LIRValMap<std::uint32_t> m_numbering;
     std::unordered_map<const LIRBlock*, LiveInfo> m_liveness;
 };
 
 inline std::ostream & operator<<(std::ostream &os, const LivenessAnalysisInfo &info) {
-    for (const auto& [bb, live_info]: info.m_liveness) {
+    for (const auto& bb: info.m_liveness | std::views::keys) {
         os << "Block " << bb->id() << ": Live In: ";
-        for (const auto& reg: live_info.live_in()) {
+        for (const auto& reg: info.live_in(bb)) {
             os << reg << " ";
         }
         os << "Live Out: ";
-        for (const auto& reg: live_info.live_out()) {
+        for (const auto& reg: info.live_out(bb)) {
             os << reg << " ";
         }
     }
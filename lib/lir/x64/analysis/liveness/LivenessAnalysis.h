@@ -2,12 +2,13 @@
 
 #include "LiveInfo.h"
 #include "base/analysis/AnalysisPassManagerBase.h"
-#include "base/analysis/traverse/PreorderTraverseBase.h"
+#include "base/analysis/traverse/PostOrderTraverseBase.h"
 
 #include "lir/x64/module/LIRBlock.h"
 #include "lir/x64/instruction/Matcher.h"
 #include "lir/x64/module/LIRFuncData.h"
 #include "lir/x64/operand/LIRValMap.h"
+#include "utility/DenseBitSet.h"
 
 
 class LivenessAnalysis final {
@@ -17,8 +18,15 @@ public:
     static constexpr auto analysis_kind = AnalysisType::LivenessAnalysis;
 
 private:
-    explicit LivenessAnalysis(const Ordering<LIRBlock> &ordering):
-        m_ordering(ordering) {}
+    struct BlockLiveness final {
+        DenseBitSet m_gen{};
+        DenseBitSet m_kill{};
+        DenseBitSet m_live_in{};
+        DenseBitSet m_live_out{};
+    };
+
+    explicit LivenessAnalysis(const Ordering<LIRBlock> &postorder):
+        m_postorder(postorder) {}
 
 public:
     void run() {
@@ -29,25 +37,40 @@ public:
 
     std::unique_ptr<result_type> result() noexcept {
         std::unordered_map<const LIRBlock*, LiveInfo> liveness;
-        liveness.reserve(m_liveness.size());
-        for (auto& [bb, live_info] : m_liveness) {
-            liveness.emplace(bb, LiveInfo(std::move(live_info.first), std::move(live_info.second)));
+        liveness.reserve(m_blocks.size());
+        for (auto&& [bb, block_liveness] : std::views::zip(m_postorder, m_blocks)) {
+            liveness.emplace(bb, LiveInfo(std::move(block_liveness.m_live_in), std::move(block_liveness.m_live_out)));
         }
 
-        return std::make_unique<result_type>(std::move(liveness));
+        return std::make_unique<result_type>(std::move(m_values), std::move(m_numbering), std::move(liveness));
     }
 
     static LivenessAnalysis create(AnalysisPassManagerBase<LIRFuncData> *cache, const LIRFuncData *data) {
-        const auto ordering = cache->analyze<PreorderTraverseBase<LIRFuncData>>(data);
-        return LivenessAnalysis(*ordering);
+        const auto postorder = cache->analyze<PostOrderTraverseBase<LIRFuncData>>(data);
+        return LivenessAnalysis(*postorder);
     }
 
 private:
+    /**
+     * Returns the dense number of the value, the first occurrence assigns it.
+     */
+    std::uint32_t number(const LIRVal& lir_val) {
+        const auto [it, inserted] = m_numbering.try_emplace(lir_val, static_cast<std::uint32_t>(m_values.size()));
+        if (inserted) {
+            m_values.push_back(lir_val);
+        }
+
+        return it->second;
+    }
+
     void compute_local_live_set() {
-        for (const auto bb: m_ordering) {
-            LIRValSet gen;
-            LIRValSet kill;
+        std::vector<std::vector<std::uint32_t>> gens(m_postorder.size());
+        std::vector<std::vector<std::uint32_t>> kills(m_postorder.size());
+        for (const auto& [idx, bb]: std::views::enumerate(m_postorder)) {
+            m_block_index.emplace(bb, idx);
 
+            // Indices are not known until every value is numbered, collect them first.
+            std::unordered_set<std::uint32_t> kill;
             for (const auto& inst: bb->instructions()) {
                 if (!inst.isa(parallel_copy())) {
                     for (auto& in: inst.inputs()) {
@@ -56,62 +79,78 @@ private:
                             continue;
                         }
 
-                        if (kill.contains(lir_val.value())) {
-                            continue;
+                        if (const auto num = number(lir_val.value()); !kill.contains(num)) {
+                            gens[idx].push_back(num);
                         }
-
-                        gen.insert(lir_val.value());
                     }
                 }
 
                 for (const auto& out: LIRVal::defs(&inst)) {
-                    kill.insert(out);
+                    const auto num = number(out);
+                    kill.emplace(num);
+                    kills[idx].push_back(num);
                 }
             }
+        }
 
-            m_kill_gen_set.emplace(bb, std::pair(kill, gen));
+        m_blocks.resize(m_postorder.size());
+        for (auto&& [block, gen, kill]: std::views::zip(m_blocks, gens, kills)) {
+            block.m_gen.resize(m_values.size());
+            block.m_kill.resize(m_values.size());
+            for (const auto num: gen) {
+                block.m_gen.set(num);
+            }
+            for (const auto num: kill) {
+                block.m_kill.set(num);
+            }
         }
     }
 
+    void setup_liveness() {
+        for (auto& block: m_blocks) {
+            block.m_live_in = block.m_gen;
+            block.m_live_out.resize(m_values.size());
+        }
+    }
+
+    /**
+     * Solves the backward dataflow problem with a worklist of blocks in postorder,
+     * so successors are usually processed before their predecessors.
+     */
     void compute_global_live_set() {
-        auto changed = false;
-        do {
-            changed = false;
-            for (const auto& bb: std::ranges::reverse_view(m_ordering)) {
-                auto& [live_in, live_out] = m_liveness.at(bb);
+        DenseBitSet pending(m_blocks.size());
+        for (std::size_t idx = 0; idx < m_blocks.size(); ++idx) {
+            pending.set(idx);
+        }
 
-                for (const auto succ: bb->successors()) {
-                    // live_out = b.live_out ∪ succ.live_in
-                    for (const auto& reg: m_liveness.at(succ).first) {
-                        changed |= live_out.insert(reg).second;
-                    }
-                }
+        while (!pending.none()) {
+            for (const auto idx: pending) {
+                pending.reset(idx);
+                const auto bb = m_postorder[idx];
+                auto& block = m_blocks[idx];
 
-                // union = (b.old_live_in ∪ b.old_live_out
-                // live_in = (union – b.live_kill) ∪ b.live_gen
-                for (const auto live_out_v: live_out) {
-                    live_in.insert(live_out_v);
+                // live_out = ∪ succ.live_in
+                for (const auto succ: bb->successors()) {
+                    block.m_live_out.unite(m_blocks[m_block_index.at(succ)].m_live_in);
                 }
 
-                auto& [kill, gen] = m_kill_gen_set.at(bb);
-                for (const auto& kill_reg: kill) {
-                    live_in.erase(kill_reg);
+                // live_in = (live_out - kill) ∪ gen
+                if (!block.m_live_in.assign_difference_union(block.m_live_out, block.m_kill, block.m_gen)) {
+                    continue;
                 }
 
-                for (const auto& gen_reg: gen) {
-                    live_in.insert(gen_reg);
+                for (const auto pred: bb->predecessors()) {
+                    if (const auto it = m_block_index.find(pred); it != m_block_index.end()) {
+                        pending.set(it->second);
+                    }
                 }
             }
-        } while (changed);
-    }
-
-    void setup_liveness() {
-        for (const auto& bb: m_ordering) {
-            m_liveness.emplace(bb, std::pair<LIRValSet, LIRValSet>{});
         }
     }
 
-    const Ordering<LIRBlock>& m_ordering;
-    std::unordered_map<const basic_block*, std::pair<LIRValSet, LIRValSet>> m_kill_gen_set{};
-    std::unordered_map<const basic_block*, std::pair<LIRValSet, LIRValSet>> m_liveness{};
-};
\ No newline at end of file
+    const Ordering<LIRBlock>& m_postorder;
+    std::vector<LIRVal> m_values{};
+    LIRValMap<std::uint32_t> m_numbering{};
+    std::unordered_map<const basic_block*, std::size_t> m_block_index{};
+    std::vector<BlockLiveness> m_blocks{};
+};
@@ -2,6 +2,7 @@
 
 #include "ShiftKind.h"
 #include "lir/x64/asm/FcmpOrdering.h"
+#include "lir/x64/asm/VecLane.h"
 #include "lir/x64/asm/operand/XVReg.h"
 #include "asm/x64/asm.h"
 #include "lir/x64/asm/operand/Constrains.h"
@@ -84,7 +85,7 @@ public:
     void lea(const aasm::Address&, const aasm::GPReg) {}
 
     template<typename Op>
-    requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, std::int32_t>
+    requires GPVRegVariant<Op> || std::is_same_v<Op, std::int32_t>
     void cmp(const std::uint8_t, const Op&, const aasm::GPReg) {}
 
     template<typename Op>
@@ -92,13 +93,14 @@ public:
     void cmp(const std::uint8_t, const Op&, const aasm::Address) {}
 
     template<typename Op>
-    requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, std::int32_t>
+    requires GPVRegVariant<Op> || std::is_same_v<Op, std::int32_t>
     void xxor(const std::uint8_t, const Op&, const aasm::GPReg) {}
 
     void xxor(const std::uint8_t, const aasm::GPReg, const aasm::Address&) {}
 
     void call(const aasm::Symbol*) { }
     void call(const aasm::Address&) { }
+    void call(const aasm::GPReg) { }
 
     template<typename Op>
     requires std::is_same_v<Op, aasm::Address> || std::is_same_v<Op, aasm::GPReg>
@@ -112,6 +114,15 @@ public:
     requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, aasm::Address>
     constexpr void neg(const std::uint8_t, const Op &) {}
 
+    template<GPVRegVariant Op>
+    constexpr void nnot(const std::uint8_t, const Op &) {}
+
+    template<GPVRegVariant Op>
+    constexpr void imul(const std::uint8_t, const Op&, const aasm::GPReg) {}
+
+    template<GPVRegVariant Op>
+    constexpr void imul(const std::uint8_t, const std::int32_t, const Op&, const aasm::GPReg) {}
+
     // IDIV — Signed Divide
     template<typename Op>
     requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, aasm::Address>
@@ -146,6 +157,32 @@ public:
     template<GPVRegVariant Op>
     constexpr void cvtsi2fp(const std::uint8_t, const std::uint8_t, const Op&, const aasm::XmmReg) {}
 
+    template<XVRegVariant Op>
+    constexpr void vaddp(const VecLane, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vsubp(const VecLane, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vmulp(const VecLane, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vdivp(const VecLane, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vxorp(const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vcmpp(const VecLane, const VecPredicate, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vshufp(const VecLane, const std::uint8_t, const std::uint8_t, const Op&, const aasm::XmmReg, const aasm::XmmReg) {}
+
+    template<XVRegVariant Op>
+    constexpr void vbroadcast(const VecLane, const std::uint8_t, const Op&, const aasm::XmmReg) {}
+
+    constexpr void vmovd(const std::uint8_t, const aasm::GPReg, const aasm::XmmReg) {}
+
     constexpr void cdq(const std::uint8_t) {}
     void leave() { }
 
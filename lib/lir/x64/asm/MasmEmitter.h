@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FcmpOrdering.h"
+#include "VecLane.h"
 #include "ShiftKind.h"
 #include "asm/x64/asm.h"
 
@@ -74,6 +75,10 @@ public:
         m_asm.add(size, src, dst);
     }
 
+    void add(const std::uint8_t size, const std::int32_t src, const aasm::Address& dst) {
+        m_asm.add(size, src, dst);
+    }
+
     void test(const std::uint8_t size, const aasm::GPReg src, const aasm::Address& dst) {
         m_asm.test(size, src, dst);
     }
@@ -163,7 +168,7 @@ public:
     }
 
     template<typename Op>
-    requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, std::int32_t>
+    requires GPVRegVariant<Op> || std::is_same_v<Op, std::int32_t>
     void cmp(const std::uint8_t size, const Op& src, const aasm::GPReg dst) {
         m_asm.cmp(size, src, dst);
     }
@@ -175,7 +180,7 @@ public:
     }
 
     template<typename Op>
-    requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, std::int32_t>
+    requires GPVRegVariant<Op> || std::is_same_v<Op, std::int32_t>
     void xxor(const std::uint8_t size, const Op& src, const aasm::GPReg dst) {
         m_asm.xxor(size, src, dst);
     }
@@ -186,6 +191,7 @@ public:
 
     void call(const aasm::Symbol* name) { m_asm.call(name); }
     void call(const aasm::Address& addr) { m_asm.call(addr); }
+    void call(const aasm::GPReg reg) { m_asm.call(reg); }
 
     // Move With Zero-Extend
     void movzx(const std::uint8_t src_size, const std::uint8_t dst_size, const aasm::GPReg src, const aasm::GPReg dst) {
@@ -224,6 +230,24 @@ public:
         m_asm.neg(size, r);
     }
 
+    // One's Complement Negation
+    template<GPVRegVariant Op>
+    constexpr void nnot(const std::uint8_t size, const Op& r) {
+        m_asm.nnot(size, r);
+    }
+
+    // IMUL — Signed Multiply. There is no byte form, the low byte of the 32-bit product is the same,
+    // so byte memory operands must be loaded into a register first.
+    template<GPVRegVariant Op>
+    constexpr void imul(const std::uint8_t size, const Op& src, const aasm::GPReg dst) {
+        m_asm.imul(size == cst::BYTE_SIZE ? cst::DWORD_SIZE : size, src, dst);
+    }
+
+    template<GPVRegVariant Op>
+    constexpr void imul(const std::uint8_t size, const std::int32_t imm, const Op& src, const aasm::GPReg dst) {
+        m_asm.imul(size == cst::BYTE_SIZE ? cst::DWORD_SIZE : size, imm, src, dst);
+    }
+
     // IDIV — Signed Divide
     template<typename Op>
     requires std::is_same_v<Op, aasm::GPReg> || std::is_same_v<Op, aasm::Address>
@@ -242,6 +266,8 @@ public:
         switch (size) {
             case cst::DWORD_SIZE: m_asm.movss(src, dst); break;
             case cst::QWORD_SIZE: m_asm.movsd(src, dst); break;
+            case cst::XMMWORD_SIZE: [[fallthrough]];
+            case cst::YMMWORD_SIZE: m_asm.vmovups(size, src, dst); break;
             default: std::unreachable();
         }
     }
@@ -250,6 +276,8 @@ public:
         switch (size) {
             case cst::DWORD_SIZE: m_asm.movss(src, dst); break;
             case cst::QWORD_SIZE: m_asm.movsd(src, dst); break;
+            case cst::XMMWORD_SIZE: [[fallthrough]];
+            case cst::YMMWORD_SIZE: m_asm.vmovups(size, src, dst); break;
             default: std::unreachable();
         }
     }
@@ -259,6 +287,8 @@ public:
         switch (size) {
             case cst::DWORD_SIZE: m_asm.movss(src, dst); break;
             case cst::QWORD_SIZE: m_asm.movsd(src, dst); break;
+            case cst::XMMWORD_SIZE: [[fallthrough]];
+            case cst::YMMWORD_SIZE: m_asm.vmovups(size, src, dst); break;
             default: std::unreachable();
         }
     }
@@ -295,6 +325,8 @@ public:
         switch (size) {
             case cst::DWORD_SIZE: m_asm.xorps(src, dst); break;
             case cst::QWORD_SIZE: m_asm.xorpd(src, dst); break;
+            case cst::XMMWORD_SIZE: [[fallthrough]];
+            case cst::YMMWORD_SIZE: m_asm.vxorps(size, src, dst, dst); break;
             default: std::unreachable();
         }
     }
@@ -317,6 +349,117 @@ public:
         }
     }
 
+    template<XVRegVariant Op>
+    constexpr void vaddp(const VecLane lane, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vaddps(size, src2, src1, dst); break;
+            case VecLane::F64: m_asm.vaddpd(size, src2, src1, dst); break;
+            case VecLane::I32: m_asm.vpaddd(size, src2, src1, dst); break;
+            case VecLane::I64: m_asm.vpaddq(size, src2, src1, dst); break;
+            default: std::unreachable();
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vsubp(const VecLane lane, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vsubps(size, src2, src1, dst); break;
+            case VecLane::F64: m_asm.vsubpd(size, src2, src1, dst); break;
+            case VecLane::I32: m_asm.vpsubd(size, src2, src1, dst); break;
+            case VecLane::I64: m_asm.vpsubq(size, src2, src1, dst); break;
+            default: std::unreachable();
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vmulp(const VecLane lane, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vmulps(size, src2, src1, dst); break;
+            case VecLane::F64: m_asm.vmulpd(size, src2, src1, dst); break;
+            case VecLane::I32: m_asm.vpmulld(size, src2, src1, dst); break;
+            case VecLane::I64: die("AVX2 has no packed 64-bit multiply, the verifier rejects it");
+            default: std::unreachable();
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vdivp(const VecLane lane, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vdivps(size, src2, src1, dst); break;
+            case VecLane::F64: m_asm.vdivpd(size, src2, src1, dst); break;
+            default: die("AVX2 has no packed integer division: lane={}", to_string(lane));
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vxorp(const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        m_asm.vxorps(size, src2, src1, dst);
+    }
+
+    /**
+     * Float lanes take any predicate, integer lanes only EQ and GT.
+     * The lowering swaps the operands of LT and negates NE, LE and GE.
+     */
+    template<XVRegVariant Op>
+    constexpr void vcmpp(const VecLane lane, const VecPredicate predicate, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vcmpps(size, to_vcmp_predicate(predicate), src2, src1, dst); break;
+            case VecLane::F64: m_asm.vcmppd(size, to_vcmp_predicate(predicate), src2, src1, dst); break;
+            case VecLane::I32: {
+                switch (predicate) {
+                    case VecPredicate::EQ: m_asm.vpcmpeqd(size, src2, src1, dst); break;
+                    case VecPredicate::GT: m_asm.vpcmpgtd(size, src2, src1, dst); break;
+                    default: die("Unsupported predicate for integer lanes: {}", to_string(predicate));
+                }
+                break;
+            }
+            case VecLane::I64: {
+                switch (predicate) {
+                    case VecPredicate::EQ: m_asm.vpcmpeqq(size, src2, src1, dst); break;
+                    case VecPredicate::GT: m_asm.vpcmpgtq(size, src2, src1, dst); break;
+                    default: die("Unsupported predicate for integer lanes: {}", to_string(predicate));
+                }
+                break;
+            }
+            default: std::unreachable();
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vshufp(const VecLane lane, const std::uint8_t control, const std::uint8_t size, const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: [[fallthrough]];
+            case VecLane::I32: m_asm.vshufps(size, control, src2, src1, dst); break;
+            default: die("Unsupported lane for shuffle: {}", to_string(lane));
+        }
+    }
+
+    template<XVRegVariant Op>
+    constexpr void vbroadcast(const VecLane lane, const std::uint8_t size, const Op& src, const aasm::XmmReg dst) {
+        switch (lane) {
+            case VecLane::F32: m_asm.vbroadcastss(size, src, dst); break;
+            case VecLane::F64: {
+                if (size == cst::YMMWORD_SIZE) {
+                    m_asm.vbroadcastsd(size, src, dst);
+                } else {
+                    m_asm.vpbroadcastq(size, src, dst);
+                }
+                break;
+            }
+            case VecLane::I32: m_asm.vpbroadcastd(size, src, dst); break;
+            case VecLane::I64: m_asm.vpbroadcastq(size, src, dst); break;
+            default: std::unreachable();
+        }
+    }
+
+    constexpr void vmovd(const std::uint8_t size, const aasm::GPReg src, const aasm::XmmReg dst) {
+        m_asm.vmovd(size, src, dst);
+    }
+
+    constexpr void vzeroupper() {
+        m_asm.vzeroupper();
+    }
+
     constexpr void cdq(const std::uint8_t size) {
         m_asm.cdq(size);
     }
@@ -350,6 +493,18 @@ public:
     }
 
 private:
+    static constexpr aasm::VcmpPredicate to_vcmp_predicate(const VecPredicate predicate) noexcept {
+        switch (predicate) {
+            case VecPredicate::EQ: return aasm::VcmpPredicate::EQ_OQ;
+            case VecPredicate::NE: return aasm::VcmpPredicate::NEQ_UQ;
+            case VecPredicate::LT: return aasm::VcmpPredicate::LT_OS;
+            case VecPredicate::LE: return aasm::VcmpPredicate::LE_OS;
+            case VecPredicate::GT: return aasm::VcmpPredicate::GT_OS;
+            case VecPredicate::GE: return aasm::VcmpPredicate::GE_OS;
+            default: std::unreachable();
+        }
+    }
+
     template<XVRegVariant Op>
     constexpr void unord_cmpfp(const std::uint8_t size, const Op& src, const aasm::XmmReg dst) {
         switch (size) {
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+/**
+ * Element type of the packed vector operand.
+ */
+enum class VecLane: std::uint8_t {
+    F32,
+    F64,
+    I32,
+    I64,
+};
+
+/**
+ * Lane-wise comparison of packed vectors. Float lanes compare ordered, except NE which is true for unordered lanes.
+ * Integer lanes compare signed.
+ */
+enum class VecPredicate: std::uint8_t {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+};
+
+constexpr std::string_view to_string(const VecLane lane) noexcept {
+    switch (lane) {
+        case VecLane::F32: return "f32";
+        case VecLane::F64: return "f64";
+        case VecLane::I32: return "i32";
+        case VecLane::I64: return "i64";
+        default: std::unreachable();
+    }
+}
+
+constexpr std::string_view to_string(const VecPredicate predicate) noexcept {
+    switch (predicate) {
+        case VecPredicate::EQ: return "eq";
+        case VecPredicate::NE: return "ne";
+        case VecPredicate::LT: return "lt";
+        case VecPredicate::LE: return "le";
+        case VecPredicate::GT: return "gt";
+        case VecPredicate::GE: return "ge";
+        default: std::unreachable();
+    }
+}
+
+/**
+ * Size of the lane element in bytes.
+ */
+constexpr std::uint8_t lane_size(const VecLane lane) noexcept {
+    switch (lane) {
+        case VecLane::F32: [[fallthrough]];
+        case VecLane::I32: return 4;
+        case VecLane::F64: [[fallthrough]];
+        case VecLane::I64: return 8;
+        default: std::unreachable();
+    }
+}
+
+constexpr bool is_float_lane(const VecLane lane) noexcept {
+    return lane == VecLane::F32 || lane == VecLane::F64;
+}
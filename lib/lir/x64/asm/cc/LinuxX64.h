@@ -82,7 +82,7 @@ namespace call_conv {
                 aasm::rdi,
                 aasm::rsi,
                 //aasm::rbp, Exclude rbp from the available registers, it is used for stack frame pointer.
-                aasm::rsp,
+                //aasm::rsp, Exclude rsp from the available registers, it is the stack pointer.
                 aasm::r8,
                 aasm::r9,
                 aasm::r10,
@@ -1,42 +1,281 @@
 #include "Elf.h"
 
-#include "asm/x64/SizeEvaluator.h"
-#include "lir/x64/asm/jit/OpCodeBuffer.h"
-#include "lir/x64/asm/jit/JitDataBlob.h"
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
 
-Elf Elf::collect(const aasm::AsmModule &module) {
-    elf::elfio writer;
-
-    writer.set_os_abi(ELFOSABI_LINUX);
-    writer.set_type(ET_REL);
-    writer.set_machine(EM_X86_64);
-
-    elf::section* text_sec = writer.sections.add(".text");
-    text_sec->set_type(SHT_PROGBITS);
-    text_sec->set_flags(SHF_ALLOC | SHF_EXECINSTR);
-    text_sec->set_addr_align( 0x10 );
-
-    // Create string table section
-    elf::section* str_sec = writer.sections.add(".strtab");
-    str_sec->set_type( SHT_STRTAB );
-
-    // Create symbol table section
-    elf::section* sym_sec = writer.sections.add(".symtab");
-    sym_sec->set_type(SHT_SYMTAB);
-    sym_sec->set_info(1);
-    sym_sec->set_addr_align(0x4);
-    sym_sec->set_entry_size(elf::elfio::get_default_entry_size(SHT_SYMTAB));
-    sym_sec->set_link(str_sec->get_index());
-
-    std::vector<uint8_t> code_buffer;
-    code_buffer.resize(aasm::ModuleSizeEvaluator::module_size_eval(module));
-    OpCodeBuffer assembler{code_buffer};
-    for (const auto &asm_buffer: module.m_asm_buffers | std::views::values) {
-        asm_buffer.emit(assembler);
-    }
-    text_sec->set_data(reinterpret_cast<const char*>(code_buffer.data()), code_buffer.size());
+#include "asm/x64/AssembledModule.h"
+
+namespace {
+    enum class SectionKind: std::uint8_t {
+        TEXT,
+        RODATA,
+        DATA_REL_RO,
+        DATA,
+        BSS,
+    };
+
+    constexpr std::size_t SECTION_KINDS = 5;
+    constexpr std::size_t DATA_ALIGNMENT = aasm::AssembledModule::DATA_ALIGNMENT;
+
+    struct SectionDesc final {
+        const char* name;
+        elf::Elf_Word type;
+        elf::Elf_Xword flags;
+        elf::Elf_Xword align;
+    };
+
+    constexpr std::array<SectionDesc, SECTION_KINDS> SECTIONS = {{
+        {".text",        SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16},
+        {".rodata",      SHT_PROGBITS, SHF_ALLOC,                 DATA_ALIGNMENT},
+        {".data.rel.ro", SHT_PROGBITS, SHF_ALLOC | SHF_WRITE,     DATA_ALIGNMENT},
+        {".data",        SHT_PROGBITS, SHF_ALLOC | SHF_WRITE,     DATA_ALIGNMENT},
+        {".bss",         SHT_NOBITS,   SHF_ALLOC | SHF_WRITE,     DATA_ALIGNMENT},
+    }};
+
+    struct DefinedSymbol final {
+        const aasm::Symbol* symbol;
+        SectionKind section;
+        std::size_t offset;
+        std::size_t size;
+        unsigned char bind;
+        unsigned char type;
+    };
+
+    /** Relocation of the assembler together with the offset of the patched field in its section. */
+    struct PendingRelocation final {
+        aasm::Relocation reloc;
+        std::size_t offset;
+    };
+
+    class ObjectBuilder final {
+    public:
+        explicit ObjectBuilder(const aasm::AsmModule& module):
+            m_directives(module.m_global_slots),
+            m_module(aasm::AssembledModule::assemble(module)) {}
+
+        elf::elfio build() {
+            place_functions();
+            place_directives();
+
+            elf::elfio writer;
+            writer.set_os_abi(ELFOSABI_LINUX);
+            writer.set_type(ET_REL);
+            writer.set_machine(EM_X86_64);
+
+            add_sections(writer);
+            const auto symtab = add_symbols(writer);
+            add_relocations(writer, symtab);
+
+            // Objects without this note make the linker assume an executable stack.
+            const auto note = writer.sections.add(".note.GNU-stack");
+            note->set_type(SHT_PROGBITS);
+            note->set_addr_align(1);
+            return writer;
+        }
+
+    private:
+        aasm::ByteBuffer& section(const SectionKind kind) noexcept {
+            return m_sections[static_cast<std::size_t>(kind)];
+        }
+
+        void place_functions() {
+            const auto& text = m_module.text();
+            section(SectionKind::TEXT).append(text.bytes());
+            for (const auto& reloc: text.relocations()) {
+                m_relocations[static_cast<std::size_t>(SectionKind::TEXT)].emplace_back(reloc, reloc.offset());
+            }
+
+            for (const auto& chunk: text.chunks()) {
+                const unsigned char bind = chunk.symbol->bind() == aasm::BindAttribute::INTERNAL ? STB_LOCAL : STB_GLOBAL;
+                m_defined.emplace(chunk.symbol, DefinedSymbol{chunk.symbol, SectionKind::TEXT, chunk.offset, chunk.size, bind, STT_FUNC});
+            }
+        }
+
+        /**
+         * Moves every global slot to the section matching its kind and content.
+         */
+        void place_directives() {
+            const auto& data = m_module.data();
+            for (const auto& chunk: data.chunks()) {
+                const auto& directive = m_directives.at(chunk.symbol);
+                const auto content = data.bytes(chunk);
+                const auto relocations = data.relocations(chunk);
+                const auto kind = directive_section(directive, content, relocations);
+
+                auto& target = section(kind);
+                target.align(DATA_ALIGNMENT);
+                const auto start = target.size();
+                target.append(content);
+                for (const auto& reloc: relocations) {
+                    m_relocations[static_cast<std::size_t>(kind)].emplace_back(reloc, start + (reloc.offset() - chunk.offset));
+                }
+
+                const unsigned char bind = directive.kind() == GValueKind::CONSTANT ? STB_LOCAL : STB_GLOBAL;
+                m_defined.emplace(chunk.symbol, DefinedSymbol{chunk.symbol, kind, start, chunk.size, bind, STT_OBJECT});
+            }
+        }
+
+        static SectionKind directive_section(const aasm::Directive& directive, const std::span<const std::uint8_t> content, const std::span<const aasm::Relocation> relocations) noexcept {
+            switch (directive.kind()) {
+                case GValueKind::CONSTANT: return relocations.empty() ? SectionKind::RODATA : SectionKind::DATA_REL_RO;
+                case GValueKind::VARIABLE: return relocations.empty() && std::ranges::all_of(content, [](const std::uint8_t byte) { return byte == 0; }) ? SectionKind::BSS : SectionKind::DATA;
+                default: std::unreachable();
+            }
+        }
+
+        void add_sections(elf::elfio& writer) {
+            for (std::size_t idx{}; idx < SECTION_KINDS; ++idx) {
+                const auto& desc = SECTIONS[idx];
+                const auto& content = m_sections[idx];
+                if (idx != static_cast<std::size_t>(SectionKind::TEXT) && content.size() == 0) {
+                    continue;
+                }
 
-    return Elf(std::move(writer));
+                const auto sec = writer.sections.add(desc.name);
+                sec->set_type(desc.type);
+                sec->set_flags(desc.flags);
+                sec->set_addr_align(desc.align);
+                if (desc.type == SHT_NOBITS) {
+                    sec->set_size(content.size());
+                } else {
+                    sec->set_data(reinterpret_cast<const char*>(content.bytes().data()), content.size());
+                }
+
+                m_section_index[idx] = sec->get_index();
+            }
+        }
+
+        /**
+         * Writes the symbol table. Local symbols must precede the global ones.
+         * Symbols referenced by relocations but not defined in the module become undefined globals.
+         */
+        elf::section* add_symbols(elf::elfio& writer) {
+            const auto str_sec = writer.sections.add(".strtab");
+            str_sec->set_type(SHT_STRTAB);
+            str_sec->set_addr_align(1);
+
+            const auto sym_sec = writer.sections.add(".symtab");
+            sym_sec->set_type(SHT_SYMTAB);
+            sym_sec->set_addr_align(0x8);
+            sym_sec->set_entry_size(elf::elfio::get_default_entry_size(SHT_SYMTAB));
+            sym_sec->set_link(str_sec->get_index());
+
+            std::vector<const DefinedSymbol*> locals;
+            std::vector<const DefinedSymbol*> globals;
+            for (const auto& defined: m_defined | std::views::values) {
+                (defined.bind == STB_LOCAL ? locals : globals).push_back(&defined);
+            }
+
+            const auto by_name = [](const DefinedSymbol* defined) { return defined->symbol->name(); };
+            std::ranges::sort(locals, {}, by_name);
+            std::ranges::sort(globals, {}, by_name);
+
+            std::vector<const aasm::Symbol*> undefined;
+            for (const auto& relocations: m_relocations) {
+                for (const auto& pending: relocations) {
+                    const auto symbol = pending.reloc.symbol();
+                    if (!m_defined.contains(symbol) && std::ranges::find(undefined, symbol) == undefined.end()) {
+                        undefined.push_back(symbol);
+                    }
+                }
+            }
+            std::ranges::sort(undefined, {}, [](const aasm::Symbol* symbol) { return symbol->name(); });
+
+            elf::string_section_accessor strings(str_sec);
+            elf::symbol_section_accessor symbols(writer, sym_sec);
+            const auto add_defined = [&](const DefinedSymbol* defined) {
+                const auto shndx = m_section_index[static_cast<std::size_t>(defined->section)];
+                const auto index = symbols.add_symbol(strings, std::string(defined->symbol->name()).c_str(), defined->offset, defined->size, defined->bind, defined->type, STV_DEFAULT, shndx);
+                m_symbol_index.emplace(defined->symbol, index);
+            };
+
+            std::ranges::for_each(locals, add_defined);
+            // Index of the first non-local symbol, the null symbol is local too.
+            sym_sec->set_info(static_cast<elf::Elf_Word>(locals.size() + 1));
+            std::ranges::for_each(globals, add_defined);
+
+            for (const auto symbol: undefined) {
+                const auto index = symbols.add_symbol(strings, std::string(symbol->name()).c_str(), 0, 0, STB_GLOBAL, STT_NOTYPE, STV_DEFAULT, SHN_UNDEF);
+                m_symbol_index.emplace(symbol, index);
+            }
+
+            return sym_sec;
+        }
+
+        void add_relocations(elf::elfio& writer, const elf::section* symtab) {
+            for (std::size_t idx{}; idx < SECTION_KINDS; ++idx) {
+                const auto& desc = SECTIONS[idx];
+                const auto& relocations = m_relocations[idx];
+                if (relocations.empty()) {
+                    continue;
+                }
+
+                const auto rela_sec = writer.sections.add(std::string(".rela") + desc.name);
+                rela_sec->set_type(SHT_RELA);
+                rela_sec->set_flags(SHF_INFO_LINK);
+                rela_sec->set_info(m_section_index[idx]);
+                rela_sec->set_link(symtab->get_index());
+                rela_sec->set_addr_align(0x8);
+                rela_sec->set_entry_size(elf::elfio::get_default_entry_size(SHT_RELA));
+
+                elf::relocation_section_accessor accessor(writer, rela_sec);
+                for (const auto& [reloc, offset]: relocations) {
+                    if (reloc.type() == RelType::X86_64_NONE) {
+                        continue;
+                    }
+
+                    const auto symbol = m_symbol_index.at(reloc.symbol());
+                    accessor.add_entry(offset, symbol, elf_relocation_type(reloc), addend(reloc));
+                }
+            }
+        }
+
+        /**
+         * Maps the relocation of the assembler to the ELF one.
+         * PLT32 of the assembler is a rip-relative load from the table of external addresses, which is the GOT in the object file.
+         */
+        [[nodiscard]]
+        unsigned elf_relocation_type(const aasm::Relocation& reloc) const {
+            switch (reloc.type()) {
+                case RelType::X86_64_PC32: {
+                    const auto defined = m_defined.find(reloc.symbol());
+                    const auto is_data = defined != m_defined.end() && defined->second.type == STT_OBJECT;
+                    return is_data ? R_X86_64_PC32 : R_X86_64_PLT32;
+                }
+                case RelType::X86_64_PLT32:    return R_X86_64_GOTPCREL;
+                case RelType::X86_64_GLOB_DAT: return R_X86_64_64;
+                default: die("Unsupported relocation type: {}", static_cast<std::uint8_t>(reloc.type()));
+            }
+        }
+
+        /**
+         * The assembler resolves 'target - (start + displacement)', so the addend is the distance from the end of the instruction to the patched field.
+         */
+        [[nodiscard]]
+        static elf::Elf_Sxword addend(const aasm::Relocation& reloc) noexcept {
+            if (reloc.type() == RelType::X86_64_GLOB_DAT) {
+                return 0;
+            }
+
+            return static_cast<elf::Elf_Sxword>(reloc.offset()) - reloc.displacement();
+        }
+
+        const std::unordered_map<const aasm::Symbol*, aasm::Directive>& m_directives;
+        const aasm::AssembledModule m_module;
+        std::array<aasm::ByteBuffer, SECTION_KINDS> m_sections{};
+        std::array<std::vector<PendingRelocation>, SECTION_KINDS> m_relocations{};
+        std::array<elf::Elf_Half, SECTION_KINDS> m_section_index{};
+        std::unordered_map<const aasm::Symbol*, DefinedSymbol> m_defined;
+        std::unordered_map<const aasm::Symbol*, elf::Elf_Word> m_symbol_index;
+    };
+}
+
+Elf Elf::collect(const aasm::AsmModule &module) {
+    ObjectBuilder builder(module);
+    return Elf(builder.build());
 }
 
 void Elf::save(const std::string_view path) {
@@ -3,6 +3,12 @@
 #include "asm/elf/elfio.hpp"
 #include "asm/x64/AsmModule.h"
 
+/**
+ * Relocatable x86-64 ELF object built from an assembled module.
+ * Functions go to '.text', constants to '.rodata' or '.data.rel.ro', variables to '.data' or '.bss'.
+ * Internal functions and constants are local symbols, the rest are global.
+ * Every relocation produced by the assembler is kept in the matching '.rela' section, so the object links with the system linker.
+ */
 class Elf final {
 public:
     void save(std::string_view path);
@@ -28,23 +28,34 @@ private:
         }
     }
 
-    void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
-        unimplemented();
-    }
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::Address &in2) override {
+        if (in1 == out) {
+            m_as.add(m_size, in2, out);
 
-    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
-        if (in2 == out) {
-            m_as.add(m_size, in1, out);
+        } else if (!in2.uses(out)) {
+            m_as.copy(m_size, in1, out);
+            m_as.add(m_size, in2, out);
 
         } else {
-            m_as.copy(m_size, in2, out);
+            // The output register addresses the operand, so it is read first.
+            m_as.mov(m_size, in2, out);
             m_as.add(m_size, in1, out);
         }
     }
 
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
+        emit(out, in2, in1);
+    }
+
     void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
-        m_as.mov(m_size, in1, out);
-        m_as.add(m_size, in2, out);
+        if (in2.uses(out)) {
+            m_as.mov(m_size, in2, out);
+            m_as.add(m_size, in1, out);
+
+        } else {
+            m_as.mov(m_size, in1, out);
+            m_as.add(m_size, in2, out);
+        }
     }
 
     void emit(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t in2) override {
@@ -63,8 +74,8 @@ private:
     void emit(aasm::GPReg out, std::int64_t in1, std::int64_t in2) override  {
         unimplemented();
     }
-    void emit(aasm::GPReg out, std::int64_t in1, const aasm::Address &in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::Address &in2) override {
+        emit(out, in2, in1);
     }
 
     void emit(const aasm::GPReg out, const aasm::Address &in1, const std::int64_t in2) override {
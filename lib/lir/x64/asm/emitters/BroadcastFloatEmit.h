@@ -0,0 +1,55 @@
+#pragma once
+
+template<typename TemporalRegStorage, typename AsmEmit>
+class BroadcastFloatEmit final: public XUnaryOutVisitor {
+public:
+    explicit BroadcastFloatEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const VecLane lane, const std::uint8_t size) noexcept:
+        m_lane(lane),
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(temporal_regs) {}
+
+    void apply(const XVReg& out, const XOp& in) {
+        dispatch(*this, out, in);
+    }
+
+private:
+    friend class XUnaryOutVisitor;
+
+    void emit(const aasm::XmmReg out, const aasm::XmmReg in) override {
+        m_as.vbroadcast(m_lane, m_size, in, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::Address &in) override {
+        m_as.vbroadcast(m_lane, m_size, in, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::XmmReg in) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.vbroadcast(m_lane, m_size, in, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.vbroadcast(m_lane, m_size, in, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::XmmReg out, const std::int64_t in) override {
+        assertion(in == 0, "invariant");
+        m_as.xorfp(m_size, out, out);
+    }
+
+    void emit(const aasm::Address &out, const std::int64_t in) override {
+        assertion(in == 0, "invariant");
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.xorfp(m_size, temp1, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    const VecLane m_lane;
+    const std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
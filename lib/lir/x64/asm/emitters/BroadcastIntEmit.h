@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * Broadcasts the scalar from the general purpose register through the low lane of the vector register.
+ */
+template<typename TemporalRegStorage, typename AsmEmit>
+class BroadcastIntEmit final: public GPUnaryXmmOutVisitor {
+public:
+    explicit BroadcastIntEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const VecLane lane, const std::uint8_t size) noexcept:
+        m_lane(lane),
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(temporal_regs) {}
+
+    void apply(const XVReg& out, const GPOp& in) {
+        dispatch(*this, out, in);
+    }
+
+private:
+    friend class GPUnaryXmmOutVisitor;
+
+    void broadcast(const aasm::GPReg in, const aasm::XmmReg out) {
+        m_as.vmovd(lane_size(m_lane), in, out);
+        m_as.vbroadcast(m_lane, m_size, out, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::GPReg in) override {
+        broadcast(in, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::Address &in) override {
+        m_as.vbroadcast(m_lane, m_size, in, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::GPReg in) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        broadcast(in, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.vbroadcast(m_lane, m_size, in, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::XmmReg out, const std::int64_t in) override {
+        if (in == 0) {
+            m_as.xorfp(m_size, out, out);
+            return;
+        }
+
+        const auto gp_temp1 = m_temporal_regs.gp_temp1();
+        m_as.mov(lane_size(m_lane), in, gp_temp1);
+        broadcast(gp_temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const std::int64_t in) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        if (in == 0) {
+            m_as.xorfp(m_size, temp1, temp1);
+
+        } else {
+            const auto gp_temp1 = m_temporal_regs.gp_temp1();
+            m_as.mov(lane_size(m_lane), in, gp_temp1);
+            broadcast(gp_temp1, temp1);
+        }
+
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    const VecLane m_lane;
+    const std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
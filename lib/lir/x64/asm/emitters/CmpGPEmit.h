@@ -19,8 +19,8 @@ private:
         m_as.cmp(m_size, in, out);
     }
 
-    void emit(aasm::GPReg out, const aasm::Address &in) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::Address &in) override {
+        m_as.cmp(m_size, in, out);
     }
 
     void emit(const aasm::Address &out, aasm::GPReg in) override {
@@ -28,8 +28,9 @@ private:
     }
 
     void emit(const aasm::Address &out, const aasm::Address &in) override {
-        m_as.mov(m_size, in, m_temporal_regs.gp_temp1());
-        m_as.cmp(m_size, m_temporal_regs.gp_temp1(), out);
+        // The left operand may be addressed through the temporal register, it is read before the register is reused.
+        m_as.mov(m_size, out, m_temporal_regs.gp_temp1());
+        m_as.cmp(m_size, in, m_temporal_regs.gp_temp1());
     }
 
     void emit(const aasm::GPReg out, const std::int64_t in) override {
@@ -3,8 +3,9 @@
 template<typename TemporalRegStorage, typename AsmEmit>
 class LoadByIdxFloatEmit final: public XBinaryVisitorXOut {
 public:
-    explicit LoadByIdxFloatEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+    explicit LoadByIdxFloatEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size, const std::int32_t disp) noexcept:
         m_size(size),
+        m_disp(disp),
         m_as(as),
         m_temporal_regs(temporal_regs) {}
 
@@ -15,8 +16,8 @@ public:
 private:
     friend class XBinaryVisitorXOut;
 
-    void emit(aasm::XmmReg out, aasm::GPReg in1, aasm::GPReg in2) override {
-        unimplemented();
+    void emit(const aasm::XmmReg out, const aasm::GPReg in1, const aasm::GPReg in2) override {
+        m_as.movfp(m_size, aasm::Address(in1, in2, m_size, m_disp), out);
     }
 
     void emit(aasm::XmmReg out, aasm::GPReg in1, const aasm::Address &in2) override {
@@ -25,15 +26,17 @@ private:
 
     void emit(aasm::XmmReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
         m_as.mov(cst::POINTER_SIZE, in1, m_temporal_regs.gp_temp1());
-        m_as.movfp(m_size, aasm::Address(m_temporal_regs.gp_temp1(), in2, m_size, 0), out);
+        m_as.movfp(m_size, aasm::Address(m_temporal_regs.gp_temp1(), in2, m_size, m_disp), out);
     }
 
     void emit(aasm::XmmReg out, const aasm::Address &in1, const aasm::Address &in2) override {
         unimplemented();
     }
 
-    void emit(aasm::XmmReg out, aasm::GPReg in1, std::int64_t in2) override {
-        unimplemented();
+    void emit(const aasm::XmmReg out, const aasm::GPReg in1, const std::int64_t in2) override {
+        const auto offset = static_cast<std::int64_t>(m_size) * in2 + m_disp;
+        assertion(std::in_range<std::int32_t>(offset), "Offset out of range");
+        m_as.movfp(m_size, aasm::Address(in1, static_cast<std::int32_t>(offset)), out);
     }
 
     void emit(aasm::XmmReg out, std::int64_t in1, aasm::GPReg in2) override {
@@ -89,6 +92,7 @@ private:
     }
 
     std::uint8_t m_size;
+    std::int32_t m_disp;
     AsmEmit& m_as;
     const TemporalRegStorage& m_temporal_regs;
 };
\ No newline at end of file
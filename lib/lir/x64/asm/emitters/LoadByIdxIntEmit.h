@@ -3,8 +3,9 @@
 template<typename TemporalRegStorage, typename AsmEmit>
 class LoadByIdxIntEmit final: public GPBinaryVisitor {
 public:
-    explicit LoadByIdxIntEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+    explicit LoadByIdxIntEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size, const std::int32_t disp) noexcept:
         m_size(size),
+        m_disp(disp),
         m_as(as),
         m_temporal_regs(temporal_regs) {}
 
@@ -16,7 +17,7 @@ private:
     friend class GPBinaryVisitor;
 
     void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::GPReg in2) override {
-        m_as.mov(m_size, aasm::Address(in1, in2, m_size, 0), out);
+        m_as.mov(m_size, aasm::Address(in1, in2, m_size, m_disp), out);
     }
 
     void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
@@ -25,17 +26,17 @@ private:
 
     void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
         m_as.mov(cst::POINTER_SIZE, in1, m_temporal_regs.gp_temp1());
-        m_as.mov(m_size, aasm::Address(m_temporal_regs.gp_temp1(), in2, m_size, 0), out);
+        m_as.mov(m_size, aasm::Address(m_temporal_regs.gp_temp1(), in2, m_size, m_disp), out);
     }
 
     void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
         m_as.mov(cst::POINTER_SIZE, in2, m_temporal_regs.gp_temp1());
         m_as.mov(cst::POINTER_SIZE, in1, m_temporal_regs.gp_temp2());
-        m_as.mov(m_size, aasm::Address(m_temporal_regs.gp_temp2(), m_temporal_regs.gp_temp1(), m_size, 0), out);
+        m_as.mov(m_size, aasm::Address(m_temporal_regs.gp_temp2(), m_temporal_regs.gp_temp1(), m_size, m_disp), out);
     }
 
     void emit(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t in2) override {
-        const auto offset = m_size * in2;
+        const auto offset = m_size * in2 + m_disp;
         assertion(std::in_range<std::int32_t>(offset), "Offset out of range");
         m_as.mov(m_size, aasm::Address(in1, static_cast<std::int32_t>(offset)), out);
     }
@@ -93,6 +94,7 @@ private:
     }
 
     std::uint8_t m_size;
+    std::int32_t m_disp;
     AsmEmit& m_as;
     const TemporalRegStorage& m_temporal_regs;
 };
@@ -3,8 +3,9 @@
 template<typename TempRegStorage, typename AsmEmit>
 class MovByIdxFloatEmit final: public XBinaryVisitorWithGp {
 public:
-    explicit MovByIdxFloatEmit(const TempRegStorage& m_temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+    explicit MovByIdxFloatEmit(const TempRegStorage& m_temporal_regs, AsmEmit& as, const std::uint8_t size, const std::int32_t disp) noexcept:
         m_size(size),
+        m_disp(disp),
         m_as(as),
         m_temporal_regs(m_temporal_regs) {}
 
@@ -15,8 +16,8 @@ public:
 private:
     friend class XBinaryVisitorWithGp;
 
-    void emit(aasm::GPReg out, aasm::GPReg in1, aasm::XmmReg in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::XmmReg in2) override {
+        m_as.movfp(m_size, in2, aasm::Address(out, in1, m_size, m_disp));
     }
 
     void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
@@ -35,8 +36,10 @@ private:
         unimplemented();
     }
 
-    void emit(aasm::GPReg out, std::int64_t in1, aasm::XmmReg in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::XmmReg in2) override {
+        const auto offset = static_cast<std::int64_t>(m_size) * in1 + m_disp;
+        assertion(std::in_range<std::int32_t>(offset), "Offset out of range for mov by idx");
+        m_as.movfp(m_size, in2, aasm::Address(out, static_cast<std::int32_t>(offset)));
     }
 
     void emit(aasm::GPReg out, std::int64_t in1, std::int64_t in2) override {
@@ -53,13 +56,13 @@ private:
 
     void emit(const aasm::Address &out, const aasm::GPReg in1, const aasm::XmmReg in2) override {
         m_as.mov(cst::POINTER_SIZE, out, m_temporal_regs.gp_temp1());
-        m_as.movfp(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, 0));
+        m_as.movfp(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, m_disp));
     }
 
     void emit(const aasm::Address &out, const aasm::GPReg in1, const aasm::Address &in2) override {
         m_as.mov(cst::POINTER_SIZE, out, m_temporal_regs.gp_temp1());
         m_as.mov(m_size, in2, m_temporal_regs.gp_temp2());
-        m_as.mov(m_size, m_temporal_regs.gp_temp2(), aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, 0));
+        m_as.mov(m_size, m_temporal_regs.gp_temp2(), aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, m_disp));
     }
 
     void emit(const aasm::Address &out, const aasm::Address &in1, aasm::XmmReg in2) override {
@@ -91,6 +94,7 @@ private:
     }
 
     std::uint8_t m_size;
+    std::int32_t m_disp;
     AsmEmit& m_as;
     const TempRegStorage& m_temporal_regs;
 };
\ No newline at end of file
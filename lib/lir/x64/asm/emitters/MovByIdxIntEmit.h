@@ -3,8 +3,9 @@
 template<typename TempRegStorage, typename AsmEmit>
 class MovByIdxIntEmit final: public GPBinaryVisitor {
 public:
-    explicit MovByIdxIntEmit(const TempRegStorage& m_temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+    explicit MovByIdxIntEmit(const TempRegStorage& m_temporal_regs, AsmEmit& as, const std::uint8_t size, const std::int32_t disp) noexcept:
         m_size(size),
+        m_disp(disp),
         m_as(as),
         m_temporal_regs(m_temporal_regs) {}
 
@@ -16,7 +17,7 @@ private:
     friend class GPBinaryVisitor;
 
     void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::GPReg in2) override {
-        m_as.mov(m_size, in2, aasm::Address(out, in1, m_size, 0));
+        m_as.mov(m_size, in2, aasm::Address(out, in1, m_size, m_disp));
     }
 
     void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
@@ -36,13 +37,13 @@ private:
     }
 
     void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::GPReg in2) override {
-        const auto offset = static_cast<std::int64_t>(m_size) * in1;
+        const auto offset = static_cast<std::int64_t>(m_size) * in1 + m_disp;
         assertion(std::in_range<std::int32_t>(offset), "Offset out of range for mov by idx");
         m_as.mov(m_size, in2, aasm::Address(out, offset));
     }
 
     void emit(const aasm::GPReg out, const std::int64_t in1, const std::int64_t in2) override {
-        const auto offset = static_cast<std::int64_t>(m_size) * in1;
+        const auto offset = static_cast<std::int64_t>(m_size) * in1 + m_disp;
         assertion(std::in_range<std::int32_t>(offset), "Offset out of range for mov by idx");
 
         if (std::in_range<std::int32_t>(in2)) {
@@ -64,19 +65,19 @@ private:
 
     void emit(const aasm::Address &out, const aasm::GPReg in1, aasm::GPReg in2) override {
         m_as.mov(cst::POINTER_SIZE, out, m_temporal_regs.gp_temp1());
-        m_as.mov(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, 0));
+        m_as.mov(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, m_disp));
     }
 
     void emit(const aasm::Address &out, const aasm::GPReg in1, const aasm::Address &in2) override {
         m_as.mov(cst::POINTER_SIZE, out, m_temporal_regs.gp_temp1());
         m_as.mov(m_size, in2, m_temporal_regs.gp_temp2());
-        m_as.mov(m_size, m_temporal_regs.gp_temp2(), aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, 0));
+        m_as.mov(m_size, m_temporal_regs.gp_temp2(), aasm::Address(m_temporal_regs.gp_temp1(), in1, m_size, m_disp));
     }
 
     void emit(const aasm::Address &out, const aasm::Address &in1, aasm::GPReg in2) override {
         m_as.mov(cst::POINTER_SIZE, out, m_temporal_regs.gp_temp1());
         m_as.mov(cst::POINTER_SIZE, in1, m_temporal_regs.gp_temp2());
-        m_as.mov(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), m_temporal_regs.gp_temp2(), m_size, 0));
+        m_as.mov(m_size, in2, aasm::Address(m_temporal_regs.gp_temp1(), m_temporal_regs.gp_temp2(), m_size, m_disp));
     }
 
     void emit(const aasm::Address &out, const aasm::Address &in1, const aasm::Address &in2) override {
@@ -104,6 +105,7 @@ private:
     }
 
     std::uint8_t m_size;
+    std::int32_t m_disp;
     AsmEmit& m_as;
     const TempRegStorage& m_temporal_regs;
 };
\ No newline at end of file
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <bit>
+
+template<typename TemporalRegStorage, typename AsmEmit>
+class MulIntEmit final: public GPBinaryVisitor {
+public:
+    explicit MulIntEmit(const TemporalRegStorage& reg_storage, AsmEmit& as, const std::uint8_t size) noexcept:
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(reg_storage) {}
+
+    void apply(const GPVReg& out, const GPOp& in1, const GPOp& in2) {
+        dispatch(*this, out, in1, in2);
+    }
+
+private:
+    friend class GPBinaryVisitor;
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::GPReg in2) override {
+        if (out == in1) {
+            m_as.imul(m_size, in2, out);
+
+        } else if (out == in2) {
+            m_as.imul(m_size, in1, out);
+
+        } else {
+            m_as.copy(m_size, in1, out);
+            m_as.imul(m_size, in2, out);
+        }
+    }
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::Address &in2) override {
+        if (m_size != cst::BYTE_SIZE) {
+            m_as.copy(m_size, in1, out);
+            m_as.imul(m_size, in2, out);
+            return;
+        }
+
+        // The multiplication is done in 32 bits, so the byte operand must be loaded into a register.
+        if (out == in1) {
+            const auto temp = m_temporal_regs.gp_temp1();
+            m_as.mov(m_size, in2, temp);
+            m_as.imul(m_size, temp, out);
+
+        } else {
+            m_as.mov(m_size, in2, out);
+            m_as.imul(m_size, in1, out);
+        }
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
+        m_as.mov(m_size, in1, out);
+        emit(out, out, in2);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t in2) override {
+        const auto imm = sign_extend(in2);
+        if (try_strength_reduce(out, in1, imm)) {
+            return;
+        }
+
+        if (std::in_range<std::int32_t>(imm)) {
+            m_as.imul(m_size, static_cast<std::int32_t>(imm), in1, out);
+            return;
+        }
+
+        // There is no 64-bit immediate form, so the constant goes through a temporary register.
+        const auto temp = m_temporal_regs.gp_temp1();
+        m_as.copy(m_size, imm, temp);
+        emit(out, in1, temp);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::GPReg in2) override  {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const std::int64_t in2) override  {
+        // The product wraps around, so it is computed on unsigned values.
+        const auto product = static_cast<std::uint64_t>(in1) * static_cast<std::uint64_t>(in2);
+        m_as.copy(m_size, sign_extend(static_cast<std::int64_t>(product)), out);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::Address &in2) override {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const std::int64_t in2) override {
+        const auto imm = sign_extend(in2);
+        if (m_size != cst::BYTE_SIZE && !is_cheap_constant(imm) && std::in_range<std::int32_t>(imm)) {
+            m_as.imul(m_size, static_cast<std::int32_t>(imm), in1, out);
+            return;
+        }
+
+        m_as.mov(m_size, in1, out);
+        emit(out, out, in2);
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    /**
+     * Only the low 'm_size' bytes of the product are observable, so the constant is reduced to the operand size.
+     */
+    [[nodiscard]]
+    std::int64_t sign_extend(const std::int64_t imm) const noexcept {
+        switch (m_size) {
+            case 1: return static_cast<std::int8_t>(imm);
+            case 2: return static_cast<std::int16_t>(imm);
+            case 4: return static_cast<std::int32_t>(imm);
+            case 8: return imm;
+            default: std::unreachable();
+        }
+    }
+
+    [[nodiscard]]
+    static bool is_cheap_constant(const std::int64_t imm) noexcept {
+        switch (imm) {
+            case -1: [[fallthrough]];
+            case 0: [[fallthrough]];
+            case 1: [[fallthrough]];
+            case 3: [[fallthrough]];
+            case 5: [[fallthrough]];
+            case 9: return true;
+            default: return imm > 0 && std::has_single_bit(static_cast<std::uint64_t>(imm));
+        }
+    }
+
+    /**
+     * Replaces the multiplication by a constant with a move, a negation, a shift or a lea when it is cheaper than imul.
+     * Returns false if the constant has no cheaper form.
+     */
+    bool try_strength_reduce(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t imm) {
+        if (!is_cheap_constant(imm)) {
+            return false;
+        }
+
+        switch (imm) {
+            case 0: m_as.copy(m_size, 0L, out); break;
+            case 1: m_as.copy(m_size, in1, out); break;
+            case -1: {
+                m_as.copy(m_size, in1, out);
+                m_as.neg(m_size, out);
+                break;
+            }
+            case 3: [[fallthrough]];
+            case 5: [[fallthrough]];
+            case 9: {
+                // x * (2^n + 1) = x + x * 2^n
+                const auto scale = static_cast<std::uint8_t>(imm - 1);
+                m_as.lea(aasm::Address(in1, in1, scale), out);
+                break;
+            }
+            default: {
+                m_as.copy(m_size, in1, out);
+                const auto count = std::countr_zero(static_cast<std::uint64_t>(imm));
+                m_as.shift(m_size, ShiftKind::SAL, static_cast<std::size_t>(count), out);
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+template<typename TemporalRegStorage, typename AsmEmit>
+class NegIntEmit final: public GPUnaryOutVisitor {
+public:
+    explicit NegIntEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(temporal_regs) {}
+
+    void apply(const GPVReg& out, const GPOp& in) {
+        dispatch(*this, out, in);
+    }
+
+private:
+    friend class GPUnaryOutVisitor;
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in) override {
+        m_as.copy(m_size, in, out);
+        m_as.neg(m_size, out);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in) override {
+        m_as.mov(m_size, in, out);
+        m_as.neg(m_size, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::GPReg in) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in) override {
+        m_as.copy(m_size, -in, out);
+    }
+
+    void emit(const aasm::Address &out, const std::int64_t in) override {
+        unimplemented();
+    }
+
+    std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
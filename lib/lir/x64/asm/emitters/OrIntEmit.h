@@ -0,0 +1,134 @@
+#pragma once
+
+template<typename TemporalRegStorage, typename AsmEmit>
+class OrIntEmit final: public GPBinaryVisitor {
+public:
+    explicit OrIntEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const std::uint8_t size) noexcept:
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(temporal_regs) {}
+
+    void apply(const GPVReg& out, const GPOp& in1, const GPOp& in2) {
+        dispatch(*this, out, in1, in2);
+    }
+
+private:
+    friend class GPBinaryVisitor;
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::GPReg in2) override {
+        if (out == in1) {
+            m_as.oor(m_size, in2, out);
+            return;
+        }
+
+        if (out == in2) {
+            m_as.oor(m_size, in1, out);
+            return;
+        }
+
+        m_as.copy(m_size, in1, out);
+        m_as.oor(m_size, in2, out);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::Address &in2) override {
+        if (out == in1) {
+            m_as.oor(m_size, in2, out);
+            return;
+        }
+
+        if (in2.uses(out)) {
+            // The output register addresses the operand, so it is read first.
+            m_as.mov(m_size, in2, out);
+            m_as.oor(m_size, in1, out);
+            return;
+        }
+
+        m_as.copy(m_size, in1, out);
+        m_as.oor(m_size, in2, out);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
+        if (in2.uses(out)) {
+            m_as.mov(m_size, in2, out);
+            m_as.oor(m_size, in1, out);
+            return;
+        }
+
+        m_as.mov(m_size, in1, out);
+        m_as.oor(m_size, in2, out);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t in2) override {
+        if (std::in_range<std::int32_t>(in2)) {
+            m_as.copy(m_size, in1, out);
+            m_as.oor(m_size, checked_cast<std::int32_t>(in2), out);
+            return;
+        }
+
+        // There is no 64-bit immediate form, so the constant goes through a temporary register.
+        const auto temp = m_temporal_regs.gp_temp1();
+        m_as.copy(m_size, in2, temp);
+        emit(out, in1, temp);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::GPReg in2) override  {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const std::int64_t in2) override  {
+        m_as.copy(m_size, in1 | in2, out);
+    }
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::Address &in2) override {
+        emit(out, in2, in1);
+    }
+
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const std::int64_t in2) override {
+        m_as.mov(m_size, in1, out);
+        emit(out, out, in2);
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, aasm::GPReg in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, aasm::GPReg in2) override {
+        unimplemented();
+    }
+
+    std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+/**
+ * Emits three operand AVX instructions: out := in1 op in2.
+ * Only the first source has to be in a register, so memory operands are loaded into the temporal register.
+ */
+template<typename TemporalRegStorage, typename AsmEmit>
+class PackedBinaryEmit final: public XBinaryVisitor {
+public:
+    explicit PackedBinaryEmit(const TemporalRegStorage& temporal_regs, AsmEmit& as, const LIRVecKind kind, const VecLane lane, const std::uint8_t size,
+        const VecPredicate predicate = VecPredicate::EQ, const std::uint8_t control = 0) noexcept:
+        m_kind(kind),
+        m_lane(lane),
+        m_predicate(predicate),
+        m_control(control),
+        m_size(size),
+        m_as(as),
+        m_temporal_regs(temporal_regs) {}
+
+    void apply(const XVReg& out, const XOp& in1, const XOp& in2) {
+        if (m_kind == LIRVecKind::Cmp && !is_float_lane(m_lane) && m_predicate == VecPredicate::LT) {
+            // There is no 'less than' for packed integers: a < b is b > a.
+            m_predicate = VecPredicate::GT;
+            dispatch(*this, out, in2, in1);
+            return;
+        }
+
+        dispatch(*this, out, in1, in2);
+    }
+
+private:
+    friend class XBinaryVisitor;
+
+    template<XVRegVariant Op>
+    void op(const Op& src2, const aasm::XmmReg src1, const aasm::XmmReg dst) {
+        switch (m_kind) {
+            case LIRVecKind::Add: m_as.vaddp(m_lane, m_size, src2, src1, dst); break;
+            case LIRVecKind::Sub: m_as.vsubp(m_lane, m_size, src2, src1, dst); break;
+            case LIRVecKind::Mul: m_as.vmulp(m_lane, m_size, src2, src1, dst); break;
+            case LIRVecKind::Div: m_as.vdivp(m_lane, m_size, src2, src1, dst); break;
+            case LIRVecKind::Cmp: m_as.vcmpp(m_lane, m_predicate, m_size, src2, src1, dst); break;
+            case LIRVecKind::Xor: m_as.vxorp(m_size, src2, src1, dst); break;
+            case LIRVecKind::Shuffle: m_as.vshufp(m_lane, m_control, m_size, src2, src1, dst); break;
+            default: die("Unexpected packed binary operation");
+        }
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::XmmReg in1, const aasm::XmmReg in2) override {
+        op(in2, in1, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::XmmReg in1, const aasm::Address &in2) override {
+        op(in2, in1, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::Address &in1, const aasm::XmmReg in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.movfp(m_size, in1, temp1);
+        op(in2, temp1, out);
+    }
+
+    void emit(const aasm::XmmReg out, const aasm::Address &in1, const aasm::Address &in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.movfp(m_size, in1, temp1);
+        op(in2, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::XmmReg in1, const aasm::XmmReg in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        op(in2, in1, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::XmmReg in1, const aasm::Address &in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        op(in2, in1, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, const aasm::XmmReg in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.movfp(m_size, in1, temp1);
+        op(in2, temp1, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, const aasm::Address &in2) override {
+        const auto temp1 = m_temporal_regs.xmm_temp1();
+        m_as.movfp(m_size, in1, temp1);
+        op(in2, temp1, temp1);
+        m_as.movfp(m_size, temp1, out);
+    }
+
+    void emit(aasm::XmmReg out, aasm::XmmReg in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(aasm::XmmReg out, std::int64_t in1, aasm::XmmReg in2) override {
+        unimplemented();
+    }
+
+    void emit(aasm::XmmReg out, std::int64_t in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(aasm::XmmReg out, std::int64_t in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(aasm::XmmReg out, const aasm::Address &in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, aasm::XmmReg in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, const aasm::Address &in1, std::int64_t in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, const aasm::Address &in2) override {
+        unimplemented();
+    }
+
+    void emit(const aasm::Address &out, std::int64_t in1, aasm::XmmReg in2) override {
+        unimplemented();
+    }
+
+    const LIRVecKind m_kind;
+    const VecLane m_lane;
+    VecPredicate m_predicate;
+    const std::uint8_t m_control;
+    const std::uint8_t m_size;
+    AsmEmit& m_as;
+    const TemporalRegStorage& m_temporal_regs;
+};
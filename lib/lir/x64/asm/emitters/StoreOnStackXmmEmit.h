@@ -56,8 +56,10 @@ private:
         m_as.mov(m_size, m_temporal_regs.gp_temp1(), out.add_offset(offset));
     }
 
-    void emit(const aasm::Address &out, std::int64_t in1, aasm::XmmReg in2) override {
-        unimplemented();
+    void emit(const aasm::Address &out, const std::int64_t in1, const aasm::XmmReg in2) override {
+        const auto offset = static_cast<std::int64_t>(m_size) * in1;
+        assertion(std::in_range<std::int32_t>(offset), "Offset out of range for store on stack");
+        m_as.movfp(m_size, in2, out.add_offset(offset));
     }
 
     std::uint8_t m_size;
@@ -31,8 +31,22 @@ private:
         m_as.sub(m_size, in2, out);
     }
 
-    void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::Address &in2) override {
+        if (out == in1) {
+            m_as.sub(m_size, in2, out);
+            return;
+        }
+
+        if (in2.uses(out)) {
+            // The output register addresses the operand, so it is read first.
+            m_as.mov(m_size, in2, out);
+            m_as.neg(m_size, out);
+            m_as.add(m_size, in1, out);
+            return;
+        }
+
+        m_as.copy(m_size, in1, out);
+        m_as.sub(m_size, in2, out);
     }
 
     void emit(aasm::GPReg out, const aasm::Address &in1, aasm::GPReg in2) override {
@@ -40,6 +54,13 @@ private:
     }
 
     void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
+        if (in2.uses(out)) {
+            m_as.mov(m_size, in2, out);
+            m_as.neg(m_size, out);
+            m_as.add(m_size, in1, out);
+            return;
+        }
+
         m_as.mov(m_size, in1, out);
         m_as.sub(m_size, in2, out);
     }
@@ -62,8 +83,11 @@ private:
         unimplemented();
     }
 
-    void emit(aasm::GPReg out, std::int64_t in1, const aasm::Address &in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::Address &in2) override {
+        assertion(std::in_range<std::int32_t>(in1), "Immediate value out of range for sub instruction");
+        m_as.mov(m_size, in2, out);
+        m_as.neg(m_size, out);
+        m_as.add(m_size, static_cast<std::int32_t>(in1), out);
     }
 
     void emit(aasm::GPReg out, const aasm::Address &in1, std::int64_t in2) override {
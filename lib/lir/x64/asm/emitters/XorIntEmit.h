@@ -30,34 +30,66 @@ private:
         m_as.xxor(m_size, in2, out);
     }
 
-    void emit(aasm::GPReg out, aasm::GPReg in1, const aasm::Address &in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::GPReg in1, const aasm::Address &in2) override {
+        if (out == in1) {
+            m_as.xxor(m_size, in2, out);
+            return;
+        }
+
+        if (in2.uses(out)) {
+            // The output register addresses the operand, so it is read first.
+            m_as.mov(m_size, in2, out);
+            m_as.xxor(m_size, in1, out);
+            return;
+        }
+
+        m_as.copy(m_size, in1, out);
+        m_as.xxor(m_size, in2, out);
     }
 
-    void emit(aasm::GPReg out, const aasm::Address &in1, aasm::GPReg in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::GPReg in2) override {
+        emit(out, in2, in1);
     }
 
-    void emit(aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const aasm::Address &in2) override {
+        if (in2.uses(out)) {
+            m_as.mov(m_size, in2, out);
+            m_as.xxor(m_size, in1, out);
+            return;
+        }
+
+        m_as.mov(m_size, in1, out);
+        m_as.xxor(m_size, in2, out);
     }
 
     void emit(const aasm::GPReg out, const aasm::GPReg in1, const std::int64_t in2) override {
-        unimplemented();
+        if (std::in_range<std::int32_t>(in2)) {
+            m_as.copy(m_size, in1, out);
+            m_as.xxor(m_size, checked_cast<std::int32_t>(in2), out);
+            return;
+        }
+
+        // There is no 64-bit immediate form, so the constant goes through a temporary register.
+        const auto temp = m_temporal_regs.gp_temp1();
+        m_as.copy(m_size, in2, temp);
+        emit(out, in1, temp);
     }
 
-    void emit(aasm::GPReg out, std::int64_t in1, aasm::GPReg in2) override  {
-        unimplemented();
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::GPReg in2) override  {
+        emit(out, in2, in1);
     }
-    void emit(aasm::GPReg out, std::int64_t in1, std::int64_t in2) override  {
-        unimplemented();
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const std::int64_t in2) override  {
+        m_as.copy(m_size, in1 ^ in2, out);
     }
-    void emit(aasm::GPReg out, std::int64_t in1, const aasm::Address &in2) override {
-        unimplemented();
+
+    void emit(const aasm::GPReg out, const std::int64_t in1, const aasm::Address &in2) override {
+        emit(out, in2, in1);
     }
 
-    void emit(aasm::GPReg out, const aasm::Address &in1, std::int64_t in2) override {
-        unimplemented();
+    void emit(const aasm::GPReg out, const aasm::Address &in1, const std::int64_t in2) override {
+        m_as.mov(m_size, in1, out);
+        emit(out, out, in2);
     }
 
     void emit(const aasm::Address &out, aasm::GPReg in1, aasm::GPReg in2) override {
@@ -0,0 +1,401 @@
+#include "CodeCache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <fstream>
+#include <ranges>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "JitComplation.h"
+#include "utility/Hash.h"
+
+namespace {
+    /*
+     * Entry layout, little endian:
+     *  header:   magic u64, compiler version u32, key u64
+     *  symbols:  count u32, then bind u8, name length u32, name bytes
+     *  sections: text then data, each is
+     *            size u64, bytes,
+     *            chunk count u32, then symbol u32, offset u64, size u64, first relocation u64, relocation count u64
+     *            relocation count u32, then type u8, offset i32, displacement i32, symbol u32
+     */
+    constexpr std::uint64_t MAGIC = 0x48434143594c4f50; // "POLYCACH"
+    constexpr std::uint32_t NO_SYMBOL = UINT32_MAX;
+
+    // The smallest encoded size of each record, a symbol name is never empty.
+    constexpr std::size_t SYMBOL_RECORD_SIZE = sizeof(std::uint8_t) + sizeof(std::uint32_t) + 1;
+    constexpr std::size_t CHUNK_RECORD_SIZE = sizeof(std::uint32_t) + 4 * sizeof(std::uint64_t);
+    constexpr std::size_t RELOCATION_RECORD_SIZE = sizeof(std::uint8_t) + 2 * sizeof(std::int32_t) + sizeof(std::uint32_t);
+
+    /** Number of bytes the relocation resolver writes at the relocation offset. */
+    constexpr std::size_t patch_size(const RelType type) noexcept {
+        return type == RelType::X86_64_GLOB_DAT ? sizeof(std::uint64_t) : sizeof(std::uint32_t);
+    }
+
+    class EntryWriter final {
+    public:
+        explicit EntryWriter(const std::uint64_t key) {
+            m_buffer.emit64(MAGIC);
+            m_buffer.emit32(CodeCache::COMPILER_VERSION);
+            m_buffer.emit64(key);
+        }
+
+        void write(const aasm::AssembledModule& module) {
+            collect_symbols(module.text());
+            collect_symbols(module.data());
+
+            m_buffer.emit32(m_symbols.size());
+            for (const auto symbol: m_symbols) {
+                m_buffer.emit8(static_cast<std::uint8_t>(symbol->bind()));
+                m_buffer.emit32(symbol->name().size());
+                m_buffer.append(std::span(reinterpret_cast<const std::uint8_t*>(symbol->name().data()), symbol->name().size()));
+            }
+
+            write(module.text());
+            write(module.data());
+        }
+
+        [[nodiscard]]
+        std::span<const std::uint8_t> bytes() const noexcept {
+            return m_buffer.bytes();
+        }
+
+    private:
+        void add_symbol(const aasm::Symbol* symbol) {
+            if (symbol == nullptr) {
+                return;
+            }
+
+            if (const auto [_, inserted] = m_symbol_index.emplace(symbol, m_symbols.size()); inserted) {
+                m_symbols.push_back(symbol);
+            }
+        }
+
+        void collect_symbols(const aasm::AssembledSection& section) {
+            for (const auto& chunk: section.chunks()) {
+                add_symbol(chunk.symbol);
+            }
+            for (const auto& reloc: section.relocations()) {
+                add_symbol(reloc.symbol());
+            }
+        }
+
+        [[nodiscard]]
+        std::uint32_t symbol_index(const aasm::Symbol* symbol) const {
+            if (symbol == nullptr) {
+                return NO_SYMBOL;
+            }
+
+            return m_symbol_index.at(symbol);
+        }
+
+        void write(const aasm::AssembledSection& section) {
+            m_buffer.emit64(section.size());
+            m_buffer.append(section.bytes());
+
+            m_buffer.emit32(section.chunks().size());
+            for (const auto& chunk: section.chunks()) {
+                m_buffer.emit32(symbol_index(chunk.symbol));
+                m_buffer.emit64(chunk.offset);
+                m_buffer.emit64(chunk.size);
+                m_buffer.emit64(chunk.first_relocation);
+                m_buffer.emit64(chunk.relocation_count);
+            }
+
+            m_buffer.emit32(section.relocations().size());
+            for (const auto& reloc: section.relocations()) {
+                m_buffer.emit8(static_cast<std::uint8_t>(reloc.type()));
+                m_buffer.emit32(reloc.offset());
+                m_buffer.emit32(reloc.displacement());
+                m_buffer.emit32(symbol_index(reloc.symbol()));
+            }
+        }
+
+        aasm::ByteBuffer m_buffer;
+        std::vector<const aasm::Symbol*> m_symbols;
+        std::unordered_map<const aasm::Symbol*, std::uint32_t> m_symbol_index;
+    };
+
+    /**
+     * Bounds checked reader over the mapped entry. Any read past the end marks the entry as damaged.
+     */
+    class EntryReader final {
+    public:
+        explicit EntryReader(const std::span<const std::uint8_t> bytes) noexcept:
+            m_bytes(bytes) {}
+
+        template<std::integral T>
+        T read() {
+            T value{};
+            if (const auto bytes = take(sizeof(T)); !bytes.empty()) {
+                std::memcpy(&value, bytes.data(), sizeof(T));
+            }
+
+            return value;
+        }
+
+        std::span<const std::uint8_t> take(const std::size_t size) {
+            if (m_failed || m_bytes.size() - m_pos < size) {
+                m_failed = true;
+                return {};
+            }
+
+            const auto bytes = m_bytes.subspan(m_pos, size);
+            m_pos += size;
+            return bytes;
+        }
+
+        /**
+         * Reads the number of the following records. A count that cannot fit in the rest
+         * of the entry fails the reader instead of sizing a vector from it.
+         */
+        std::uint32_t read_count(const std::size_t record_size) {
+            const auto count = read<std::uint32_t>();
+            if (m_failed || (m_bytes.size() - m_pos) / record_size < count) {
+                m_failed = true;
+                return 0;
+            }
+
+            return count;
+        }
+
+        std::optional<CachedModule> read_module(const std::uint64_t key) {
+            if (read<std::uint64_t>() != MAGIC || read<std::uint32_t>() != CodeCache::COMPILER_VERSION || read<std::uint64_t>() != key) {
+                return std::nullopt;
+            }
+
+            aasm::SymbolTable symbol_table;
+            std::vector<const aasm::Symbol*> symbols(read_count(SYMBOL_RECORD_SIZE));
+            if (m_failed) {
+                return std::nullopt;
+            }
+
+            for (auto& symbol: symbols) {
+                const auto bind = read<std::uint8_t>();
+                const auto name = take(read<std::uint32_t>());
+                if (m_failed || name.empty() || bind > static_cast<std::uint8_t>(aasm::BindAttribute::INTERNAL)) {
+                    return std::nullopt;
+                }
+
+                const auto name_view = std::string_view(reinterpret_cast<const char*>(name.data()), name.size());
+                symbol = symbol_table.add(name_view, static_cast<aasm::BindAttribute>(bind)).first;
+            }
+
+            auto text = read_section(symbols);
+            auto data = read_section(symbols);
+            if (!text.has_value() || !data.has_value() || m_pos != m_bytes.size()) {
+                return std::nullopt;
+            }
+
+            return CachedModule{std::move(symbol_table), aasm::AssembledModule::from_sections(std::move(text.value()), std::move(data.value()))};
+        }
+
+    private:
+        [[nodiscard]]
+        std::optional<const aasm::Symbol*> symbol(const std::span<const aasm::Symbol*> symbols, const std::uint32_t idx) const {
+            if (idx == NO_SYMBOL) {
+                return nullptr;
+            }
+            if (idx >= symbols.size()) {
+                return std::nullopt;
+            }
+
+            return symbols[idx];
+        }
+
+        std::optional<aasm::AssembledSection> read_section(const std::span<const aasm::Symbol*> symbols) {
+            aasm::ByteBuffer bytes;
+            const auto size = read<std::uint64_t>();
+            bytes.append(take(size));
+
+            std::vector<aasm::SymbolChunk> chunks(read_count(CHUNK_RECORD_SIZE));
+            if (m_failed) {
+                return std::nullopt;
+            }
+
+            for (auto& chunk: chunks) {
+                const auto chunk_symbol = symbol(symbols, read<std::uint32_t>());
+                chunk.offset = read<std::uint64_t>();
+                chunk.size = read<std::uint64_t>();
+                chunk.first_relocation = read<std::uint64_t>();
+                chunk.relocation_count = read<std::uint64_t>();
+                if (m_failed || !chunk_symbol.has_value() || chunk_symbol.value() == nullptr || chunk.offset > size || chunk.size > size - chunk.offset) {
+                    return std::nullopt;
+                }
+
+                chunk.symbol = chunk_symbol.value();
+            }
+
+            std::vector<aasm::Relocation> relocations;
+            const auto relocation_count = read_count(RELOCATION_RECORD_SIZE);
+            relocations.reserve(relocation_count);
+            for (std::uint32_t i = 0; i < relocation_count; ++i) {
+                const auto type = static_cast<RelType>(read<std::uint8_t>());
+                const auto offset = read<std::int32_t>();
+                const auto displacement = read<std::int32_t>();
+                const auto reloc_symbol = symbol(symbols, read<std::uint32_t>());
+                if (m_failed || !reloc_symbol.has_value() || reloc_symbol.value() == nullptr || offset < 0 || static_cast<std::uint64_t>(offset) + patch_size(type) > size) {
+                    return std::nullopt;
+                }
+
+                relocations.emplace_back(type, offset, displacement, reloc_symbol.value());
+            }
+
+            for (const auto& chunk: chunks) {
+                if (chunk.first_relocation > relocations.size() || chunk.relocation_count > relocations.size() - chunk.first_relocation) {
+                    return std::nullopt;
+                }
+            }
+
+            if (m_failed) {
+                return std::nullopt;
+            }
+
+            return aasm::AssembledSection(std::move(bytes), std::move(chunks), std::move(relocations));
+        }
+
+        std::span<const std::uint8_t> m_bytes;
+        std::size_t m_pos{};
+        bool m_failed{};
+    };
+
+    /**
+     * Read-only mapping of the entry file.
+     */
+    class MappedFile final {
+    public:
+        explicit MappedFile(const std::filesystem::path& path) noexcept {
+            const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return;
+            }
+
+            struct stat st{};
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                const auto size = static_cast<std::size_t>(st.st_size);
+                if (const auto addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED) {
+                    m_bytes = std::span(static_cast<const std::uint8_t*>(addr), size);
+                }
+            }
+
+            close(fd);
+        }
+
+        ~MappedFile() noexcept {
+            if (!m_bytes.empty()) {
+                munmap(const_cast<std::uint8_t*>(m_bytes.data()), m_bytes.size());
+            }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]]
+        std::span<const std::uint8_t> bytes() const noexcept {
+            return m_bytes;
+        }
+
+    private:
+        std::span<const std::uint8_t> m_bytes;
+    };
+}
+
+std::uint64_t CodeCache::key(const Module &module, const std::span<const std::string> external_symbols) {
+    std::vector<std::string_view> names(external_symbols.begin(), external_symbols.end());
+    std::ranges::sort(names);
+
+    Fnv1a hasher;
+    hasher.update(COMPILER_VERSION);
+    hasher.update(module.hash());
+    for (const auto& name: names) {
+        hasher.update(name.size());
+        hasher.update(name);
+    }
+
+    return hasher.digest();
+}
+
+std::filesystem::path CodeCache::entry_path(const std::uint64_t key) const {
+    return m_directory / std::format("{:016x}.bin", key);
+}
+
+std::optional<CachedModule> CodeCache::load(const std::uint64_t key) {
+    const MappedFile file(entry_path(key));
+    EntryReader reader(file.bytes());
+    auto cached = reader.read_module(key);
+    if (!cached.has_value()) {
+        m_misses += 1;
+        return std::nullopt;
+    }
+
+    m_hits += 1;
+    return cached;
+}
+
+bool CodeCache::store(const std::uint64_t key, const aasm::AssembledModule &module) const {
+    EntryWriter writer(key);
+    writer.write(module);
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    const auto path = entry_path(key);
+    auto tmp_path = path;
+    tmp_path += std::format(".{}.tmp", getpid());
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        const auto bytes = writer.bytes();
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) {
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    return true;
+}
+
+JitModule jit_compile_cached(CodeCache &cache, const Module &module, const std::unordered_map<std::string, std::size_t> &external_symbols, const bool verbose) {
+    std::vector<std::string> external_names;
+    external_names.reserve(external_symbols.size());
+    for (const auto& name: std::views::keys(external_symbols)) {
+        external_names.push_back(name);
+    }
+
+    const auto resolve_externals = [&](aasm::SymbolTable& symbol_table) {
+        std::unordered_map<const aasm::Symbol*, std::size_t> addresses;
+        addresses.reserve(external_symbols.size());
+        for (const auto& [name, address]: external_symbols) {
+            const auto [symbol, _] = symbol_table.add(name, aasm::BindAttribute::INTERNAL);
+            addresses.emplace(symbol, address);
+        }
+
+        return addresses;
+    };
+
+    const auto key = CodeCache::key(module, external_names);
+    if (auto cached = cache.load(key); cached.has_value()) {
+        const auto addresses = resolve_externals(cached->symbol_table);
+        return JitModule::assembly(addresses, std::move(cached->symbol_table), cached->module);
+    }
+
+    auto obj = jit_compile(module, verbose);
+    const auto addresses = resolve_externals(obj.m_symbol_table);
+    const auto assembled = aasm::AssembledModule::assemble(obj);
+    cache.store(key, assembled);
+    return JitModule::assembly(addresses, std::move(obj.m_symbol_table), assembled);
+}
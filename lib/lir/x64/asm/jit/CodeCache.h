@@ -0,0 +1,67 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "asm/symbol/SymbolTable.h"
+#include "asm/x64/AssembledModule.h"
+#include "lir/x64/asm/jit/JitModule.h"
+#include "mir/module/Module.h"
+
+/**
+ * Assembled module read back from the code cache together with the symbols its chunks and relocations refer to.
+ */
+struct CachedModule final {
+    aasm::SymbolTable symbol_table;
+    aasm::AssembledModule module;
+};
+
+/**
+ * Content addressed cache of assembled modules on disk.
+ * The key covers the module, the names of the external symbols and the compiler version, so a stale entry is never hit.
+ * Entries are written to a temporary file and renamed, so concurrent processes see either the whole entry or none.
+ * An unreadable or damaged entry is a miss.
+ */
+class CodeCache final {
+public:
+    /** Bump when code generation or the entry layout changes. */
+    static constexpr std::uint32_t COMPILER_VERSION = 1;
+
+    explicit CodeCache(std::filesystem::path directory) noexcept:
+        m_directory(std::move(directory)) {}
+
+    [[nodiscard]]
+    static std::uint64_t key(const Module& module, std::span<const std::string> external_symbols);
+
+    [[nodiscard]]
+    std::optional<CachedModule> load(std::uint64_t key);
+
+    /**
+     * Writes the entry. Returns false if the cache directory isn't writable, the cache stays usable.
+     */
+    bool store(std::uint64_t key, const aasm::AssembledModule& module) const;
+
+    [[nodiscard]]
+    std::filesystem::path entry_path(std::uint64_t key) const;
+
+    [[nodiscard]]
+    std::size_t hits() const noexcept { return m_hits; }
+
+    [[nodiscard]]
+    std::size_t misses() const noexcept { return m_misses; }
+
+private:
+    std::filesystem::path m_directory;
+    std::size_t m_hits{};
+    std::size_t m_misses{};
+};
+
+/**
+ * Takes the assembled module from the cache, on a miss compiles it and stores the result.
+ * Relocations are resolved on every call, so the external symbols may move between processes.
+ * @param external_symbols addresses of the symbols defined outside the module.
+ */
+JitModule jit_compile_cached(CodeCache& cache, const Module& module, const std::unordered_map<std::string, std::size_t>& external_symbols, bool verbose = false);
@@ -0,0 +1,193 @@
+#include "CodeHeap.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+#include "utility/ArithmeticUtils.h"
+#include "utility/Error.h"
+
+namespace details {
+    std::optional<std::size_t> FreeList::allocate(const std::size_t size) {
+        for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+            const auto [offset, block_size] = *it;
+            if (block_size < size) {
+                continue;
+            }
+
+            m_free.erase(it);
+            if (block_size != size) {
+                m_free.emplace(offset + size, block_size - size);
+            }
+
+            return offset;
+        }
+
+        return std::nullopt;
+    }
+
+    void FreeList::release(const std::size_t offset, const std::size_t size) {
+        auto [it, inserted] = m_free.emplace(offset, size);
+        assertion(inserted, "double release at offset {}", offset);
+
+        if (const auto next = std::next(it); next != m_free.end() && it->first + it->second == next->first) {
+            it->second += next->second;
+            m_free.erase(next);
+        }
+
+        if (it != m_free.begin()) {
+            if (const auto prev = std::prev(it); prev->first + prev->second == it->first) {
+                prev->second += it->second;
+                m_free.erase(it);
+            }
+        }
+    }
+
+    Arena::Arena(const std::size_t data_size, const std::size_t code_size):
+        m_data_size(data_size),
+        m_code_size(code_size),
+        m_data_free(data_size),
+        m_code_free(code_size) {
+        const auto total_size = data_size + code_size;
+        const auto base = mmap(nullptr, total_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) {
+            die("Failed to reserve code heap arena: {}", std::strerror(errno));
+        }
+        m_base = static_cast<std::uint8_t*>(base);
+
+        if (mprotect(m_base, data_size, PROT_READ | PROT_WRITE) != 0) {
+            die("Failed to map code heap data section: {}", std::strerror(errno));
+        }
+
+        const auto fd = memfd_create("polymorphine-jit", MFD_CLOEXEC);
+        if (fd < 0) {
+            die("Failed to create code heap memfd: {}", std::strerror(errno));
+        }
+        if (ftruncate(fd, static_cast<off_t>(code_size)) != 0) {
+            die("Failed to resize code heap memfd: {}", std::strerror(errno));
+        }
+
+        const auto code_rx = mmap(m_base + data_size, code_size, PROT_READ | PROT_EXEC, MAP_SHARED | MAP_FIXED, fd, 0);
+        if (code_rx == MAP_FAILED) {
+            die("Failed to map executable view of code heap: {}", std::strerror(errno));
+        }
+
+        const auto code_rw = mmap(nullptr, code_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (code_rw == MAP_FAILED) {
+            die("Failed to map writable view of code heap: {}", std::strerror(errno));
+        }
+        m_code_rw = static_cast<std::uint8_t*>(code_rw);
+
+        // The mappings keep the memory alive.
+        close(fd);
+    }
+
+    Arena::~Arena() noexcept {
+        auto err = munmap(m_code_rw, m_code_size);
+        assert_perror(err);
+        err = munmap(m_base, m_data_size + m_code_size);
+        assert_perror(err);
+    }
+}
+
+CodeHeapChunk::CodeHeapChunk(CodeHeapChunk &&other) noexcept:
+    m_heap(std::exchange(other.m_heap, nullptr)),
+    m_arena(std::exchange(other.m_arena, nullptr)),
+    m_data(std::exchange(other.m_data, {})),
+    m_code_rw(std::exchange(other.m_code_rw, {})),
+    m_code_rx(std::exchange(other.m_code_rx, nullptr)) {}
+
+CodeHeapChunk & CodeHeapChunk::operator=(CodeHeapChunk &&other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    if (m_heap != nullptr) {
+        m_heap->release(*this);
+    }
+
+    m_heap = std::exchange(other.m_heap, nullptr);
+    m_arena = std::exchange(other.m_arena, nullptr);
+    m_data = std::exchange(other.m_data, {});
+    m_code_rw = std::exchange(other.m_code_rw, {});
+    m_code_rx = std::exchange(other.m_code_rx, nullptr);
+    return *this;
+}
+
+CodeHeapChunk::~CodeHeapChunk() noexcept {
+    if (m_heap != nullptr) {
+        m_heap->release(*this);
+    }
+}
+
+CodeHeap & CodeHeap::shared() {
+    static CodeHeap heap;
+    return heap;
+}
+
+CodeHeapChunk CodeHeap::allocate(const std::size_t data_size, const std::size_t code_size) {
+    // Empty sections still get a unique offset, so every chunk can be released the same way.
+    const auto aligned_data_size = align_up(std::max(data_size, ALIGNMENT), ALIGNMENT);
+    const auto aligned_code_size = align_up(std::max(code_size, ALIGNMENT), ALIGNMENT);
+
+    std::lock_guard lock(m_mutex);
+    for (const auto& arena: m_arenas) {
+        if (auto chunk = try_allocate(*arena, aligned_data_size, aligned_code_size); chunk.has_value()) {
+            return std::move(chunk.value());
+        }
+    }
+
+    const auto arena_data_size = std::max(ARENA_SECTION_SIZE, align_up(aligned_data_size, PAGE_SIZE));
+    const auto arena_code_size = std::max(ARENA_SECTION_SIZE, align_up(aligned_code_size, PAGE_SIZE));
+    const auto& arena = m_arenas.emplace_back(std::make_unique<details::Arena>(arena_data_size, arena_code_size));
+    auto chunk = try_allocate(*arena, aligned_data_size, aligned_code_size);
+    assertion(chunk.has_value(), "new arena must fit the chunk");
+    return std::move(chunk.value());
+}
+
+std::optional<CodeHeapChunk> CodeHeap::allocate_near(const CodeHeapChunk &near, const std::size_t data_size, const std::size_t code_size) {
+    assertion(near.m_heap == this, "chunk is not allocated from this heap");
+    const auto aligned_data_size = align_up(std::max(data_size, ALIGNMENT), ALIGNMENT);
+    const auto aligned_code_size = align_up(std::max(code_size, ALIGNMENT), ALIGNMENT);
+
+    std::lock_guard lock(m_mutex);
+    return try_allocate(*near.m_arena, aligned_data_size, aligned_code_size);
+}
+
+std::optional<CodeHeapChunk> CodeHeap::try_allocate(details::Arena &arena, const std::size_t data_size, const std::size_t code_size) {
+    const auto data_offset = arena.data_free().allocate(data_size);
+    if (!data_offset.has_value()) {
+        return std::nullopt;
+    }
+
+    const auto code_offset = arena.code_free().allocate(code_size);
+    if (!code_offset.has_value()) {
+        arena.data_free().release(data_offset.value(), data_size);
+        return std::nullopt;
+    }
+
+    const std::span data(arena.data() + data_offset.value(), data_size);
+    const std::span code_rw(arena.code_rw() + code_offset.value(), code_size);
+    return CodeHeapChunk(this, &arena, data, code_rw, arena.code_rx() + code_offset.value());
+}
+
+void CodeHeap::release(const CodeHeapChunk &chunk) noexcept {
+    std::lock_guard lock(m_mutex);
+    const auto arena = chunk.m_arena;
+    const auto data_offset = static_cast<std::size_t>(chunk.m_data.data() - arena->data());
+    const auto code_offset = static_cast<std::size_t>(chunk.m_code_rw.data() - arena->code_rw());
+    arena->data_free().release(data_offset, chunk.m_data.size());
+    arena->code_free().release(code_offset, chunk.m_code_rw.size());
+
+    // Keep the last arena mapped for the next module.
+    if (!arena->empty() || m_arenas.size() == 1) {
+        return;
+    }
+
+    std::erase_if(m_arenas, [&](const std::unique_ptr<details::Arena>& a) {
+        return a.get() == arena;
+    });
+}
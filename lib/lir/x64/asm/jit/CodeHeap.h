@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+class CodeHeap;
+
+namespace details {
+    /**
+     * First-fit allocator over the offsets of one arena section.
+     * Adjacent free blocks are merged on release.
+     */
+    class FreeList final {
+    public:
+        explicit FreeList(const std::size_t size) noexcept:
+            m_size(size) {
+            m_free.emplace(0, size);
+        }
+
+        [[nodiscard]]
+        std::optional<std::size_t> allocate(std::size_t size);
+
+        void release(std::size_t offset, std::size_t size);
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return m_free.size() == 1 && m_free.begin()->second == m_size;
+        }
+
+    private:
+        const std::size_t m_size;
+        std::map<std::size_t, std::size_t> m_free; // offset -> size
+    };
+
+    /**
+     * One contiguous reservation of the code heap: a read-write data section followed by the code section.
+     * The code section is a memfd mapped twice: read-execute at its place in the reservation and read-write elsewhere.
+     * Keeping both sections in one reservation guarantees that rip-relative references between them fit in 32 bits.
+     */
+    class Arena final {
+    public:
+        Arena(std::size_t data_size, std::size_t code_size);
+        ~Arena() noexcept;
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        [[nodiscard]]
+        std::uint8_t* data() const noexcept { return m_base; }
+
+        [[nodiscard]]
+        std::uint8_t* code_rx() const noexcept { return m_base + m_data_size; }
+
+        [[nodiscard]]
+        std::uint8_t* code_rw() const noexcept { return m_code_rw; }
+
+        [[nodiscard]]
+        bool empty() const noexcept { return m_data_free.empty() && m_code_free.empty(); }
+
+        FreeList& data_free() noexcept { return m_data_free; }
+        FreeList& code_free() noexcept { return m_code_free; }
+
+    private:
+        std::size_t m_data_size;
+        std::size_t m_code_size;
+        std::uint8_t* m_base{};
+        std::uint8_t* m_code_rw{};
+        FreeList m_data_free;
+        FreeList m_code_free;
+    };
+}
+
+/**
+ * Memory of one JitModule allocated from the code heap.
+ * Code is written through 'code()' and executed at 'code_start()', so no page is writable and executable at once.
+ * The memory goes back to the heap when the chunk is destroyed.
+ */
+class CodeHeapChunk final {
+public:
+    CodeHeapChunk() noexcept = default;
+
+    explicit CodeHeapChunk(CodeHeap* heap, details::Arena* arena, const std::span<std::uint8_t> data, const std::span<std::uint8_t> code_rw, std::uint8_t* code_rx) noexcept:
+        m_heap(heap),
+        m_arena(arena),
+        m_data(data),
+        m_code_rw(code_rw),
+        m_code_rx(code_rx) {}
+
+    CodeHeapChunk(CodeHeapChunk&& other) noexcept;
+    CodeHeapChunk& operator=(CodeHeapChunk&& other) noexcept;
+
+    CodeHeapChunk(const CodeHeapChunk&) = delete;
+    CodeHeapChunk& operator=(const CodeHeapChunk&) = delete;
+
+    ~CodeHeapChunk() noexcept;
+
+    /** Writable memory for global data and the external symbol table. */
+    [[nodiscard]]
+    std::span<std::uint8_t> data() const noexcept { return m_data; }
+
+    /** Writable view of the code. */
+    [[nodiscard]]
+    std::span<std::uint8_t> code() const noexcept { return m_code_rw; }
+
+    /** Executable address of the code. */
+    [[nodiscard]]
+    std::uint8_t* code_start() const noexcept { return m_code_rx; }
+
+private:
+    friend class CodeHeap;
+
+    CodeHeap* m_heap{};
+    details::Arena* m_arena{};
+    std::span<std::uint8_t> m_data;
+    std::span<std::uint8_t> m_code_rw;
+    std::uint8_t* m_code_rx{};
+};
+
+/**
+ * Shared allocator of executable memory.
+ * Packs the code and data of many modules into large arenas instead of mapping pages per module.
+ */
+class CodeHeap final {
+public:
+    static constexpr std::size_t PAGE_SIZE = 4096;
+    static constexpr std::size_t ALIGNMENT = 16;
+    static constexpr std::size_t ARENA_SECTION_SIZE = 1024 * 1024;
+
+    CodeHeap() = default;
+
+    CodeHeap(const CodeHeap&) = delete;
+    CodeHeap& operator=(const CodeHeap&) = delete;
+
+    /** Returns the heap shared by all JitModules. */
+    static CodeHeap& shared();
+
+    [[nodiscard]]
+    CodeHeapChunk allocate(std::size_t data_size, std::size_t code_size);
+
+    /**
+     * Allocates memory in the arena of the given chunk, so rip-relative references between the two fit in 32 bits.
+     * @return nothing if the arena has no room left.
+     */
+    [[nodiscard]]
+    std::optional<CodeHeapChunk> allocate_near(const CodeHeapChunk& near, std::size_t data_size, std::size_t code_size);
+
+private:
+    friend class CodeHeapChunk;
+
+    void release(const CodeHeapChunk& chunk) noexcept;
+
+    std::optional<CodeHeapChunk> try_allocate(details::Arena& arena, std::size_t data_size, std::size_t code_size);
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<details::Arena>> m_arenas;
+};
@@ -7,7 +7,7 @@
 #include "mir/module/verify/Verifier.h"
 
 
-aasm::AsmModule jit_compile(const Module &module, const bool verbose) {
+aasm::AsmModule jit_compile(const Module &module, const bool verbose, const std::size_t jobs) {
 #ifndef NDEBUG
     if (const auto verifier_result = Verifier::apply(module); verifier_result.has_value()) {
         std::cerr << "Invalid instruction: " << verifier_result.value() << std::endl;
@@ -18,14 +18,14 @@ aasm::AsmModule jit_compile(const Module &module, const bool verbose) {
     if (verbose) {
         std::cout << module << std::endl;
     }
-    Lowering lower(module);
+    Lowering lower(module, jobs);
     lower.run();
     auto result = lower.result();
     if (verbose) {
         std::cout << result << std::endl;
     }
 
-    Codegen codegen(result);
+    Codegen codegen(result, jobs);
     codegen.run();
     auto obj = codegen.result();
     if (verbose) {
@@ -2,8 +2,12 @@
 
 #include "asm/x64/AsmModule.h"
 #include "mir/module/Module.h"
+#include "utility/ParallelFor.h"
 
 /**
  * Performs JIT compilation
+ * @param module The module to be compiled.
+ * @param verbose If true, prints the intermediate representations after each step.
+ * @param jobs The number of workers compiling functions in parallel. The output is the same for any value.
  */
-aasm::AsmModule jit_compile(const Module& module, bool verbose = false);
\ No newline at end of file
+aasm::AsmModule jit_compile(const Module& module, bool verbose = false, std::size_t jobs = default_concurrency());
\ No newline at end of file
@@ -44,6 +44,25 @@ public:
         return std::unexpected(Error::NotFoundError);
     }
 
+    /**
+     * Adds the absolute address of every symbol in the blob to the map.
+     */
+    void collect_addresses(std::unordered_map<std::string, std::int64_t>& addresses) const {
+        for (const auto& [symbol, chunk]: m_offset_table) {
+            addresses.emplace(symbol->name(), reinterpret_cast<std::int64_t>(m_code_buffer.data() + chunk.offset));
+        }
+    }
+
+    /**
+     * Calls 'fn' with the symbol, the absolute start and the size of every chunk in the blob.
+     */
+    template<typename Fn>
+    void for_each_chunk(Fn&& fn) const {
+        for (const auto& [symbol, chunk]: m_offset_table) {
+            fn(symbol, m_code_buffer.data() + chunk.offset, chunk.size);
+        }
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const JitDataBlob& blob);
 
 private:
@@ -1,50 +1,101 @@
 #include "JitModule.h"
 
 #include "OpCodeBuffer.h"
-#include "asm/x64/SizeEvaluator.h"
+#include "asm/x64/AssembledModule.h"
 #include "utility/ArithmeticUtils.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "PerfListener.h"
 #include "RelocResolver.h"
 
-static constexpr auto PAGE_SIZE = 4096;
+JitModule JitModule::assembly(const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols, aasm::AsmModule &&module) {
+    const auto assembled = aasm::AssembledModule::assemble(module);
+    return assembly(external_symbols, std::move(module.m_symbol_table), assembled);
+}
+
+JitModule JitModule::assembly(const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols, aasm::SymbolTable &&symbol_table, const aasm::AssembledModule &assembled) {
+    const auto data_size = plt_table_size(external_symbols) + assembled.data().size();
+    auto memory = CodeHeap::shared().allocate(data_size, assembled.text().size());
+    return link(external_symbols, nullptr, std::move(symbol_table), assembled, std::move(memory));
+}
 
-struct MmapAllocation final {
-    std::span<std::uint8_t> memory;
-    std::span<std::uint8_t> plt_table;
-    std::span<std::uint8_t> code_buffer;
-};
+std::optional<JitModule> JitModule::assembly_near(const JitModule &near,
+    const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols,
+    const std::unordered_map<std::string, std::int64_t> &imports,
+    aasm::SymbolTable &&symbol_table, const aasm::AssembledModule &assembled) {
+    const auto data_size = plt_table_size(external_symbols) + assembled.data().size();
+    auto memory = CodeHeap::shared().allocate_near(near.m_memory, data_size, assembled.text().size());
+    if (!memory.has_value()) {
+        return std::nullopt;
+    }
 
-static MmapAllocation map_memory(const std::size_t plt_size, const std::size_t code_buffer_size) {
-    const auto plt_table_size = align_up(plt_size, PAGE_SIZE);
-    const auto total_size = plt_table_size + code_buffer_size;
-    const auto memory = static_cast<std::uint8_t*>(mmap(nullptr, total_size,
-                                              PROT_READ | PROT_WRITE | PROT_EXEC,
-                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    return link(external_symbols, &imports, std::move(symbol_table), assembled, std::move(memory.value()));
+}
 
-    return {std::span(memory, total_size), std::span(memory, plt_table_size), std::span(memory + plt_table_size, code_buffer_size)};
+std::size_t JitModule::plt_table_size(const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols) noexcept {
+    return align_up(external_symbols.size() * sizeof(std::int64_t), CodeHeap::ALIGNMENT);
 }
 
-JitModule JitModule::assembly(const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols, aasm::AsmModule &&module) {
-    const auto code_buffer_size = aasm::ModuleSizeEvaluator::module_size_eval(module);
-    const auto plt_size = external_symbols.size() * sizeof(std::int64_t);
-    const auto [memory, plt_table, code_buffer] = map_memory(plt_size, code_buffer_size);
+JitModule JitModule::link(const std::unordered_map<const aasm::Symbol *, std::size_t> &external_symbols,
+    const std::unordered_map<std::string, std::int64_t> *imports,
+    aasm::SymbolTable &&symbol_table, const aasm::AssembledModule &assembled, CodeHeapChunk &&memory) {
+
+    // Data section layout: [external symbol table | global slots].
+    const auto plt_size = plt_table_size(external_symbols);
 
     std::unordered_map<const aasm::Symbol*, std::size_t> plt_table_map;
     plt_table_map.reserve(external_symbols.size());
 
-    std::span plt_table_span{reinterpret_cast<std::uint64_t*>(plt_table.data()), plt_table.size() / sizeof(std::uint64_t)};
-    std::size_t plt_table_offset{};
+    OpCodeBuffer plt_table(memory.data());
     for (const auto& [symbol, address] : external_symbols) {
-        plt_table_span[plt_table_offset] = address;
-        plt_table_offset += 1;
-        plt_table_map.emplace(symbol, sizeof(std::int64_t) * (plt_table_offset-1));
+        plt_table_map.emplace(symbol, plt_table.size());
+        plt_table.emit64(address);
     }
 
-    details::RelocResolver resolver(plt_table_map, module, code_buffer, plt_table.size());
+    std::ranges::copy(assembled.data().bytes(), memory.data().begin() + static_cast<std::ptrdiff_t>(plt_size));
+    std::ranges::copy(assembled.text().bytes(), memory.code().begin());
+
+    details::RelocResolver resolver(plt_table_map, assembled, memory, plt_size, imports);
     resolver.run();
 
-    JitDataBlob code_blob(resolver.result(), code_buffer);
-    return {std::move(module.m_symbol_table), memory, std::move(code_blob)};
+    JitDataBlob code_blob(resolver.result(), std::span(memory.code_start(), memory.code().size()));
+    PerfListener::shared().code_loaded(code_blob);
+    JitDataBlob data_blob(resolver.data_result(), memory.data().subspan(plt_size));
+    return {std::move(symbol_table), std::move(memory), std::move(code_blob), std::move(data_blob)};
+}
+
+std::unordered_map<std::string, std::int64_t> JitModule::exports() const {
+    std::unordered_map<std::string, std::int64_t> addresses;
+    m_code_blob.collect_addresses(addresses);
+    m_data_blob.collect_addresses(addresses);
+    return addresses;
+}
+
+std::expected<void, Error> JitModule::patch_entry(const std::string &name, const std::uint8_t *target) {
+    static constexpr std::uint8_t JMP_REL32 = 0xE9;
+    static constexpr std::size_t JMP_REL32_SIZE = 5;
+
+    const auto entry = code_start(name);
+    if (!entry.has_value()) {
+        return std::unexpected(entry.error());
+    }
+
+    const auto offset = static_cast<std::size_t>(entry.value() - m_memory.code_start());
+    assertion(offset % sizeof(std::uint64_t) == 0, "entry of '{}' is not aligned", name);
+
+    const auto rel = checked_cast<std::int32_t>(target - (entry.value() + JMP_REL32_SIZE));
+    auto& word = *reinterpret_cast<std::uint64_t*>(m_memory.code().data() + offset);
+    std::atomic_ref atomic_word(word);
+
+    // Keep the tail of the overwritten instruction, so the store is never torn across instructions.
+    auto patched = atomic_word.load(std::memory_order_relaxed);
+    patched &= ~0xFFFFFFFFFFULL;
+    patched |= JMP_REL32;
+    patched |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(rel)) << 8;
+    atomic_word.store(patched, std::memory_order_release);
+    return {};
 }
 
 std::ostream & operator<<(std::ostream &os, const JitModule &blob) {
@@ -1,14 +1,18 @@
 #pragma once
 
 #include <cassert>
-#include <sys/mman.h>
 #include <cstdint>
 #include <expected>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 #include "asm/symbol/SymbolTable.h"
+#include "lir/x64/asm/jit/CodeHeap.h"
 #include "lir/x64/asm/jit/JitDataBlob.h"
 #include "asm/x64/AsmModule.h"
+#include "asm/x64/AssembledModule.h"
 #include "utility/Error.h"
 #include "utility/Sanitizer.h"
 
@@ -32,17 +36,17 @@ private:
 };
 
 
+/**
+ * Code and data of a module placed into the code heap.
+ * The functions of every module are announced to perf when 'PerfListener::shared()' is enabled.
+ */
 class JitModule final {
 public:
-    JitModule(aasm::SymbolTable&& symbol_table, const std::span<std::uint8_t> total_mem, JitDataBlob&& code_blob) noexcept:
+    JitModule(aasm::SymbolTable&& symbol_table, CodeHeapChunk&& memory, JitDataBlob&& code_blob, JitDataBlob&& data_blob) noexcept:
         m_symbol_table(std::move(symbol_table)),
-        m_total_mem(total_mem),
-        m_code_blob(std::move(code_blob)) {}
-
-    ~JitModule() noexcept {
-        const auto err = munmap(m_total_mem.data(), m_total_mem.size());
-        assert_perror(err);
-    }
+        m_memory(std::move(memory)),
+        m_code_blob(std::move(code_blob)),
+        m_data_blob(std::move(data_blob)) {}
 
     /**
      * Finds the start of the code section for a given function name and casts it to a specific type.
@@ -60,11 +64,47 @@ public:
         return std::unexpected(Error::NotFoundError);
     }
 
+    /**
+     * Returns the absolute addresses of the functions and global slots defined in this module.
+     */
+    [[nodiscard]]
+    std::unordered_map<std::string, std::int64_t> exports() const;
+
+    /**
+     * Redirects the calls to the function to the given address by overwriting its first instruction with a jump.
+     * The entry must be 8-byte aligned and start with an instruction of at least 8 bytes, so the patch is one atomic
+     * store and a thread entering the function concurrently executes either the old or the new code.
+     * The target must lie within the same code heap arena.
+     */
+    std::expected<void, Error> patch_entry(const std::string& name, const std::uint8_t* target);
+
     friend std::ostream& operator<<(std::ostream& os, const JitModule& blob);
 
     static JitModule assembly(const std::unordered_map<const aasm::Symbol*, std::size_t>& external_symbols, aasm::AsmModule&& module);
 
+    /**
+     * Places the already encoded module into the code heap and resolves its relocations.
+     * @param symbol_table owns the symbols the chunks and relocations of the module refer to.
+     */
+    static JitModule assembly(const std::unordered_map<const aasm::Symbol*, std::size_t>& external_symbols, aasm::SymbolTable&& symbol_table, const aasm::AssembledModule& assembled);
+
+    /**
+     * Places the module into the code heap arena of another module.
+     * The symbols the module doesn't define are resolved against 'imports', usually the exports of 'near'.
+     * @return nothing if the arena has no room left for the module.
+     */
+    static std::optional<JitModule> assembly_near(const JitModule& near,
+        const std::unordered_map<const aasm::Symbol*, std::size_t>& external_symbols,
+        const std::unordered_map<std::string, std::int64_t>& imports,
+        aasm::SymbolTable&& symbol_table, const aasm::AssembledModule& assembled);
+
 private:
+    static std::size_t plt_table_size(const std::unordered_map<const aasm::Symbol*, std::size_t>& external_symbols) noexcept;
+
+    static JitModule link(const std::unordered_map<const aasm::Symbol*, std::size_t>& external_symbols,
+        const std::unordered_map<std::string, std::int64_t>* imports,
+        aasm::SymbolTable&& symbol_table, const aasm::AssembledModule& assembled, CodeHeapChunk&& memory);
+
     /**
      * Finds the start of the code section for a given function name.
      * @return start the address of the code section if found, otherwise an error.
@@ -80,6 +120,7 @@ private:
     }
 
     aasm::SymbolTable m_symbol_table;
-    std::span<std::uint8_t> m_total_mem;
+    CodeHeapChunk m_memory;
     JitDataBlob m_code_blob;
+    JitDataBlob m_data_blob;
 };
\ No newline at end of file
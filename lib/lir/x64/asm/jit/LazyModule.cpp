@@ -0,0 +1,254 @@
+#include "LazyModule.h"
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <unordered_set>
+
+#include "asm/global/Directive.h"
+#include "asm/x64/AsmEmitter.h"
+#include "lir/x64/codegen/Codegen.h"
+#include "lir/x64/lower/Lowering.h"
+#include "mir/types/VectorType.h"
+
+
+static constexpr std::string_view COMPILE_ON_FIRST_CALL = "__lazy_compile";
+
+static std::unordered_map<const aasm::Symbol*, std::size_t> resolve_externals(aasm::SymbolTable& symbol_table, const std::unordered_map<std::string, std::size_t>& external_symbols) {
+    std::unordered_map<const aasm::Symbol*, std::size_t> addresses;
+    addresses.reserve(external_symbols.size());
+    for (const auto& [name, address]: external_symbols) {
+        const auto [symbol, _] = symbol_table.add(name, aasm::BindAttribute::INTERNAL);
+        addresses.emplace(symbol, address);
+    }
+
+    return addresses;
+}
+
+static bool has_vector_arguments(const FunctionData& function) {
+    return std::ranges::any_of(function.prototype()->arg_types(), [](const NonTrivialType* type) {
+        return VectorType::cast(type) != nullptr;
+    });
+}
+
+static std::string slot_name(const std::string& name) {
+    return name + ".slot";
+}
+
+static std::string compile_path_name(const std::string& name) {
+    return name + ".lazy";
+}
+
+/**
+ * The entry of a lazy function. It jumps to the address in the slot of the function:
+ * the compile path of the stub at first and the compiled code afterwards.
+ */
+static aasm::AsmBuffer emit_entry(const aasm::Symbol* slot) {
+    aasm::AsmEmitter as;
+    as.jmp(aasm::Address(slot));
+    return as.to_buffer();
+}
+
+/**
+ * Emits the compile path of one function. 'function' is passed to the compiler in rdi, once the arguments are saved.
+ * The compiler stores the address of the code into the slot, so the path ends with the same jump as the entry.
+ */
+static aasm::AsmBuffer emit_compile_path(const std::uintptr_t function, const aasm::Symbol* compile, const aasm::Symbol* slot) {
+    // rax carries the number of vector arguments of a variadic call. 7 pushes realign the stack after the return address.
+    static constexpr std::array ARG_GP_REGS = {aasm::rdi, aasm::rsi, aasm::rdx, aasm::rcx, aasm::r8, aasm::r9, aasm::rax};
+    static constexpr std::array ARG_XMM_REGS = {aasm::xmm0, aasm::xmm1, aasm::xmm2, aasm::xmm3, aasm::xmm4, aasm::xmm5, aasm::xmm6, aasm::xmm7};
+    static constexpr auto XMM_AREA_SIZE = static_cast<std::int32_t>(ARG_XMM_REGS.size() * sizeof(double));
+
+    aasm::AsmEmitter as;
+    for (const auto reg: ARG_GP_REGS) {
+        as.push(8, reg);
+    }
+
+    as.sub(8, XMM_AREA_SIZE, aasm::rsp);
+    for (std::int32_t idx{}; const auto reg: ARG_XMM_REGS) {
+        as.movsd(reg, aasm::Address(aasm::rsp, idx++ * static_cast<std::int32_t>(sizeof(double))));
+    }
+
+    as.mov(8, static_cast<std::int64_t>(function), aasm::rdi);
+    as.call(compile);
+
+    for (std::int32_t idx{}; const auto reg: ARG_XMM_REGS) {
+        as.movsd(aasm::Address(aasm::rsp, idx++ * static_cast<std::int32_t>(sizeof(double))), reg);
+    }
+
+    as.add(8, XMM_AREA_SIZE, aasm::rsp);
+    for (const auto reg: ARG_GP_REGS | std::views::reverse) {
+        as.pop(8, reg);
+    }
+
+    as.jmp(aasm::Address(slot));
+    return as.to_buffer();
+}
+
+/**
+ * Generates the code of one function. The globals of the module are left out, they live next to the stubs.
+ * @param imported functions called through the external symbol table of the module.
+ * @param globals receives the symbols of the globals of the module.
+ */
+static aasm::AsmModule generate_function(const Module& module, const std::string& name, std::unordered_set<std::string>&& imported, std::unordered_set<const aasm::Symbol*>& globals) {
+    Lowering lower(module);
+    lower.select_functions({name});
+    lower.run();
+    auto lir_module = lower.result();
+
+    Codegen codegen(lir_module);
+    codegen.import_functions(std::move(imported));
+    codegen.run();
+    auto obj = codegen.result();
+
+    // The globals of the module live next to the stubs, the constants used by the function stay with its code.
+    for (const auto& global: lir_module.global_data() | std::views::keys) {
+        if (const auto symbol = obj.m_symbol_table.find(global); symbol.has_value()) {
+            obj.m_global_slots.erase(symbol.value());
+            globals.insert(symbol.value());
+        }
+    }
+
+    return obj;
+}
+
+std::unique_ptr<LazyModule> LazyModule::compile(const Module &module, const std::unordered_map<std::string, std::size_t> &external_symbols) {
+    std::unique_ptr<LazyModule> lazy(new LazyModule(module, external_symbols));
+
+    std::unordered_set<std::string> eager;
+    for (const auto& [name, function]: module.functions()) {
+        lazy->m_functions.try_emplace(name, lazy.get(), name);
+        if (has_vector_arguments(function)) {
+            eager.insert(name);
+        }
+    }
+
+    Lowering lower(module);
+    lower.select_functions(std::unordered_set(eager));
+    lower.run();
+    auto lir_module = lower.result();
+
+    Codegen codegen(lir_module);
+    codegen.run();
+    auto obj = codegen.result();
+
+    const auto compile = obj.m_symbol_table.add(COMPILE_ON_FIRST_CALL, aasm::BindAttribute::EXTERNAL).first;
+    for (auto& [name, function]: lazy->m_functions) {
+        if (eager.contains(name)) {
+            continue;
+        }
+
+        const auto slot = obj.m_symbol_table.add(slot_name(name), aasm::BindAttribute::INTERNAL).first;
+        obj.m_global_slots.emplace(slot, aasm::Directive(slot, aasm::Slot(ZeroInit(sizeof(std::uintptr_t)), sizeof(std::uintptr_t)), GValueKind::VARIABLE));
+
+        const auto entry = obj.m_symbol_table.add(name, aasm::BindAttribute::INTERNAL).first;
+        obj.m_asm_buffers.emplace(entry, emit_entry(slot));
+
+        const auto compile_path = obj.m_symbol_table.add(compile_path_name(name), aasm::BindAttribute::INTERNAL).first;
+        obj.m_asm_buffers.emplace(compile_path, emit_compile_path(reinterpret_cast<std::uintptr_t>(&function), compile, slot));
+    }
+
+    auto addresses = resolve_externals(obj.m_symbol_table, external_symbols);
+    addresses.emplace(compile, reinterpret_cast<std::size_t>(&compile_on_first_call));
+
+    lazy->m_stubs.emplace(JitModule::assembly(addresses, std::move(obj)));
+    lazy->m_imports = lazy->m_stubs->exports();
+    for (auto& [name, function]: lazy->m_functions) {
+        if (eager.contains(name)) {
+            function.entry.store(lazy->m_imports.at(name), std::memory_order_relaxed);
+            continue;
+        }
+
+        function.slot = reinterpret_cast<std::uintptr_t*>(lazy->m_imports.at(slot_name(name)));
+        assertion(reinterpret_cast<std::uintptr_t>(function.slot) % std::atomic_ref<std::uintptr_t>::required_alignment == 0, "slot of '{}' is not aligned", name);
+        *function.slot = static_cast<std::uintptr_t>(lazy->m_imports.at(compile_path_name(name)));
+    }
+
+    return lazy;
+}
+
+bool LazyModule::is_compiled(const std::string &name) const {
+    const auto it = m_functions.find(name);
+    if (it == m_functions.end()) {
+        return false;
+    }
+
+    return it->second.entry.load(std::memory_order_acquire) != 0;
+}
+
+std::size_t LazyModule::compiled_count() const {
+    std::lock_guard guard(m_mutex);
+    return m_compiled.size();
+}
+
+void LazyModule::compile_on_first_call(LazyFunction *function) {
+    if (function->entry.load(std::memory_order_acquire) != 0) {
+        // Another thread has compiled the function after this one entered the stub.
+        return;
+    }
+
+    auto& lazy = *function->owner;
+    std::lock_guard guard(lazy.m_mutex);
+    if (function->entry.load(std::memory_order_relaxed) != 0) {
+        return;
+    }
+
+    const auto entry = lazy.compile_function(function->name);
+    std::atomic_ref(*function->slot).store(entry, std::memory_order_release);
+    function->entry.store(entry, std::memory_order_release);
+}
+
+std::optional<JitModule> LazyModule::assemble_near(const std::string &name) const {
+    std::unordered_set<const aasm::Symbol*> globals;
+    auto obj = generate_function(m_module, name, {}, globals);
+
+    const auto addresses = resolve_externals(obj.m_symbol_table, m_external_symbols);
+    const auto assembled = aasm::AssembledModule::assemble(obj);
+    return JitModule::assembly_near(m_stubs.value(), addresses, m_imports, std::move(obj.m_symbol_table), assembled);
+}
+
+JitModule LazyModule::assemble_anywhere(const std::string &name) const {
+    std::unordered_set<std::string> imported;
+    for (const auto& callee: m_functions | std::views::keys) {
+        if (callee != name) {
+            imported.insert(callee);
+        }
+    }
+
+    std::unordered_set<const aasm::Symbol*> globals;
+    auto obj = generate_function(m_module, name, std::move(imported), globals);
+    auto addresses = resolve_externals(obj.m_symbol_table, m_external_symbols);
+    for (const auto& callee: m_functions | std::views::keys) {
+        if (const auto symbol = obj.m_symbol_table.find(callee); symbol.has_value() && callee != name) {
+            addresses.emplace(symbol.value(), static_cast<std::size_t>(m_imports.at(callee)));
+        }
+    }
+
+    const auto assembled = aasm::AssembledModule::assemble(obj);
+    const auto uses_globals = std::ranges::any_of(assembled.text().relocations(), [&](const aasm::Relocation& reloc) {
+        return globals.contains(reloc.symbol());
+    });
+    if (uses_globals) {
+        // The globals are addressed relative to the code, so the code must stay next to them.
+        die("no room left for '{}' next to the globals of the module", name);
+    }
+
+    return JitModule::assembly(addresses, std::move(obj.m_symbol_table), assembled);
+}
+
+std::uintptr_t LazyModule::compile_function(const std::string &name) {
+    if (auto compiled = assemble_near(name); compiled.has_value()) {
+        const auto entry = compiled->exports().at(name);
+        // The code placed later next to the stubs calls the function directly.
+        m_imports.insert_or_assign(name, entry);
+        m_compiled.push_back(std::move(compiled.value()));
+        return static_cast<std::uintptr_t>(entry);
+    }
+
+    // The arena of the stubs is full. The stub jumps through an absolute slot, so the code may live in any arena,
+    // the other code keeps calling the function through the stub.
+    auto compiled = assemble_anywhere(name);
+    const auto entry = compiled.exports().at(name);
+    m_compiled.push_back(std::move(compiled));
+    return static_cast<std::uintptr_t>(entry);
+}
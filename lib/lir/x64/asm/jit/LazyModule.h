@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lir/x64/asm/jit/JitModule.h"
+#include "mir/module/Module.h"
+
+/**
+ * JIT module which compiles a function on its first call.
+ * Every function starts as a stub which jumps through an 8 byte slot next to the globals. The slot points to the
+ * compile path of the stub at first: it saves the argument registers, compiles the function, stores the address of
+ * the code into the slot and jumps there, so the next calls reach the code with a single indirect jump.
+ * The code is placed next to the stubs while the arena has room. Functions compiled there call the already compiled
+ * ones directly and the other ones through their stubs, the globals of the module are addressed relative to the code.
+ * Once the arena is full the code goes to another arena and calls the other functions through absolute addresses.
+ * Concurrent first calls of one function compile it once, the other callers wait for the code.
+ * Functions taking vector arguments are compiled up front, because the stub only saves the scalar part of the registers.
+ */
+class LazyModule final {
+    struct LazyFunction final {
+        LazyFunction(LazyModule* owner, std::string name) noexcept:
+            owner(owner),
+            name(std::move(name)) {}
+
+        LazyModule* const owner;
+        const std::string name;
+        std::uintptr_t* slot{};
+        std::atomic<std::uintptr_t> entry{};
+    };
+
+public:
+    LazyModule(const LazyModule&) = delete;
+    LazyModule& operator=(const LazyModule&) = delete;
+
+    /**
+     * Emits the stubs of the functions and the globals of the module, no function is compiled yet.
+     * The stubs refer to the lazy module, so it is returned by pointer.
+     * @param module must outlive the lazy module, it is lowered again for every compiled function.
+     * @param external_symbols addresses of the symbols defined outside the module.
+     */
+    static std::unique_ptr<LazyModule> compile(const Module& module, const std::unordered_map<std::string, std::size_t>& external_symbols);
+
+    /**
+     * Returns the entry of the function. It stays valid after the function is compiled.
+     */
+    template<typename T>
+    requires std::is_function_v<T>
+    [[nodiscard]]
+    std::expected<JitFunctionFunctor<T>, Error> code_start_as(const std::string& name) const {
+        return m_stubs->code_start_as<T>(name);
+    }
+
+    [[nodiscard]]
+    bool is_compiled(const std::string& name) const;
+
+    /**
+     * Returns the number of functions compiled on their first call.
+     */
+    [[nodiscard]]
+    std::size_t compiled_count() const;
+
+private:
+    explicit LazyModule(const Module& module, const std::unordered_map<std::string, std::size_t>& external_symbols) noexcept:
+        m_module(module),
+        m_external_symbols(external_symbols) {}
+
+    /**
+     * Called by the stub of the function. Stores the address of the compiled code into the slot of the function.
+     */
+    static void compile_on_first_call(LazyFunction* function);
+
+    [[nodiscard]]
+    std::uintptr_t compile_function(const std::string& name);
+
+    /**
+     * Places the code of the function next to the stubs.
+     * @return nothing if the arena of the stubs has no room left.
+     */
+    [[nodiscard]]
+    std::optional<JitModule> assemble_near(const std::string& name) const;
+
+    /**
+     * Places the code of the function into any arena. The calls to the other functions of the module go through
+     * their absolute addresses. Dies if the function uses the globals of the module, they are out of its reach.
+     */
+    [[nodiscard]]
+    JitModule assemble_anywhere(const std::string& name) const;
+
+    const Module& m_module;
+    std::unordered_map<std::string, std::size_t> m_external_symbols;
+    std::unordered_map<std::string, LazyFunction> m_functions;
+    std::optional<JitModule> m_stubs;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::int64_t> m_imports;
+    std::vector<JitModule> m_compiled;
+};
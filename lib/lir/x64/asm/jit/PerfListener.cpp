@@ -0,0 +1,186 @@
+#include "PerfListener.h"
+
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <format>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "asm/x64/ByteBuffer.h"
+
+namespace {
+    /*
+     * Layout of the jitdump, see tools/perf/Documentation/jitdump-specification.txt in the Linux tree.
+     *  header:  magic u32, version u32, header size u32, elf machine u32, reserved u32, pid u32, timestamp u64, flags u64
+     *  records: id u32, record size u32, timestamp u64, then the body of the record
+     *  code load body: pid u32, tid u32, vma u64, code address u64, code size u64, code index u64, name, 0, code bytes
+     */
+    constexpr std::uint32_t JITDUMP_MAGIC = 0x4A695444; // "JiTD"
+    constexpr std::uint32_t JITDUMP_VERSION = 1;
+    constexpr std::uint32_t JITDUMP_HEADER_SIZE = 40;
+    constexpr std::uint32_t EM_X86_64 = 62;
+
+    constexpr std::uint32_t JIT_CODE_LOAD = 0;
+    constexpr std::uint32_t JIT_CODE_CLOSE = 3;
+    constexpr std::uint32_t RECORD_PREFIX_SIZE = 16;
+    constexpr std::uint32_t CODE_LOAD_SIZE = RECORD_PREFIX_SIZE + 40;
+
+    /** perf orders the records with the samples by this clock, it has to be started with '-k mono'. */
+    std::uint64_t timestamp() noexcept {
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    void emit_record_prefix(aasm::ByteBuffer& buffer, const std::uint32_t id, const std::size_t size) {
+        buffer.emit32(id);
+        buffer.emit32(static_cast<std::uint32_t>(size));
+        buffer.emit64(timestamp());
+    }
+}
+
+PerfListener::~PerfListener() {
+    disable();
+}
+
+PerfListener & PerfListener::shared() {
+    static PerfListener listener;
+    return listener;
+}
+
+bool PerfListener::enable(const PerfOptions &options) {
+    std::lock_guard guard(m_mutex);
+    if (m_enabled.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    const auto pid = getpid();
+    if (options.perf_map) {
+        // A map left by an earlier process with the same pid would name the samples after its functions.
+        m_perf_map.open(options.directory / std::format("perf-{}.map", pid), std::ios::trunc);
+        if (!m_perf_map.is_open()) {
+            return false;
+        }
+    }
+
+    if (options.jitdump && !open_jitdump(options.directory / std::format("jit-{}.dump", pid))) {
+        m_perf_map.close();
+        return false;
+    }
+
+    m_enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void PerfListener::disable() {
+    std::lock_guard guard(m_mutex);
+    m_enabled.store(false, std::memory_order_release);
+    m_perf_map.close();
+    close_jitdump();
+}
+
+bool PerfListener::open_jitdump(const std::filesystem::path &path) {
+    m_jitdump_fd = open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, 0666);
+    if (m_jitdump_fd < 0) {
+        return false;
+    }
+
+    // perf recognizes the dump by this mapping.
+    const auto marker = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, m_jitdump_fd, 0);
+    if (marker == MAP_FAILED) {
+        close(m_jitdump_fd);
+        m_jitdump_fd = -1;
+        return false;
+    }
+
+    m_jitdump_marker = marker;
+    aasm::ByteBuffer header;
+    header.emit32(JITDUMP_MAGIC);
+    header.emit32(JITDUMP_VERSION);
+    header.emit32(JITDUMP_HEADER_SIZE);
+    header.emit32(EM_X86_64);
+    header.emit32(0);
+    header.emit32(static_cast<std::uint32_t>(getpid()));
+    header.emit64(timestamp());
+    header.emit64(0);
+    write_jitdump(header.bytes());
+    return m_jitdump_fd >= 0;
+}
+
+void PerfListener::close_jitdump() {
+    if (m_jitdump_fd < 0) {
+        return;
+    }
+
+    aasm::ByteBuffer record;
+    emit_record_prefix(record, JIT_CODE_CLOSE, RECORD_PREFIX_SIZE);
+    write_jitdump(record.bytes());
+    release_jitdump();
+}
+
+void PerfListener::release_jitdump() noexcept {
+    if (m_jitdump_fd < 0) {
+        return;
+    }
+
+    munmap(m_jitdump_marker, sysconf(_SC_PAGESIZE));
+    m_jitdump_marker = nullptr;
+    close(m_jitdump_fd);
+    m_jitdump_fd = -1;
+}
+
+void PerfListener::write_jitdump(std::span<const std::uint8_t> bytes) {
+    while (!bytes.empty() && m_jitdump_fd >= 0) {
+        const auto written = write(m_jitdump_fd, bytes.data(), bytes.size());
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            // A broken dump isn't worth stopping the program, the perf map goes on.
+            release_jitdump();
+            return;
+        }
+
+        bytes = bytes.subspan(static_cast<std::size_t>(written));
+    }
+}
+
+void PerfListener::code_loaded(const JitDataBlob &code) {
+    if (!enabled()) {
+        return;
+    }
+
+    std::lock_guard guard(m_mutex);
+    if (!m_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    code.for_each_chunk([&](const aasm::Symbol* symbol, const std::uint8_t* start, const std::size_t size) {
+        const auto address = reinterpret_cast<std::uintptr_t>(start);
+        if (m_perf_map.is_open()) {
+            m_perf_map << std::format("{:x} {:x} {}\n", address, size, symbol->name());
+        }
+        if (m_jitdump_fd < 0) {
+            return;
+        }
+
+        const auto name = symbol->name();
+        aasm::ByteBuffer record;
+        emit_record_prefix(record, JIT_CODE_LOAD, CODE_LOAD_SIZE + name.size() + 1 + size);
+        record.emit32(static_cast<std::uint32_t>(getpid()));
+        record.emit32(static_cast<std::uint32_t>(gettid()));
+        record.emit64(address);
+        record.emit64(address);
+        record.emit64(size);
+        record.emit64(m_code_index++);
+        record.append(std::span(reinterpret_cast<const std::uint8_t*>(name.data()), name.size()));
+        record.emit8(0);
+        record.append(std::span(start, size));
+        write_jitdump(record.bytes());
+    });
+
+    // perf may read the map while the process runs.
+    m_perf_map.flush();
+}
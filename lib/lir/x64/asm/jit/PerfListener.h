@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+
+#include "lir/x64/asm/jit/JitDataBlob.h"
+
+/**
+ * Which files the perf listener writes.
+ */
+struct PerfOptions final {
+    /** Text map '<directory>/perf-<pid>.map', enough for 'perf report' to name the JIT functions. */
+    bool perf_map{true};
+    /** Binary '<directory>/jit-<pid>.dump' with the code bytes, for 'perf inject --jit' and 'perf annotate'. */
+    bool jitdump{false};
+    std::filesystem::path directory{"/tmp"};
+};
+
+/**
+ * Announces the functions of every JIT module to perf, so samples in the code heap resolve to their names.
+ * perf finds the jitdump by the executable mapping of the file, so the file stays mapped until the listener is disabled.
+ * Released code stays in the files: a function placed later at the same address supersedes it.
+ * The jitdump has no debug info records yet, so 'perf annotate' can't map the code back to MIR or LIR.
+ */
+class PerfListener final {
+public:
+    PerfListener() = default;
+    ~PerfListener();
+
+    PerfListener(const PerfListener&) = delete;
+    PerfListener& operator=(const PerfListener&) = delete;
+
+    /** Returns the listener the JIT modules report to. */
+    static PerfListener& shared();
+
+    /**
+     * Starts writing the files anew, the functions placed earlier are not announced.
+     * @return false if a file can't be created, the listener stays disabled then.
+     */
+    bool enable(const PerfOptions& options = {});
+
+    /**
+     * Closes the files. They are kept for perf to read.
+     */
+    void disable();
+
+    [[nodiscard]]
+    bool enabled() const noexcept {
+        return m_enabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Writes the functions of the code blob. Does nothing unless the listener is enabled.
+     */
+    void code_loaded(const JitDataBlob& code);
+
+private:
+    bool open_jitdump(const std::filesystem::path& path);
+    void close_jitdump();
+    void release_jitdump() noexcept;
+    void write_jitdump(std::span<const std::uint8_t> bytes);
+
+    std::mutex m_mutex;
+    std::atomic<bool> m_enabled{};
+    std::ofstream m_perf_map;
+    int m_jitdump_fd{-1};
+    void* m_jitdump_marker{};
+    std::uint64_t m_code_index{};
+};
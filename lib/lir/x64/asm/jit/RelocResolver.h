@@ -1,63 +1,103 @@
 #pragma once
 
 namespace details {
+    /**
+     * Resolves the relocations of an assembled module placed in a code heap chunk.
+     * Global slots live in the writable data section after the external symbol table, functions live in the code section.
+     * Addresses are resolved against the executable view of the code, not against the view it is written through.
+     * Symbols which the module doesn't define are looked up in 'imports': the absolute addresses of the code and data
+     * placed earlier in the same arena.
+     */
     class RelocResolver final {
     public:
         explicit RelocResolver(const std::unordered_map<const aasm::Symbol*, std::size_t>& plt_table,
-            const aasm::AsmModule& module,
-            const std::span<std::uint8_t> code_buffer, const std::size_t code_buffer_offset) noexcept:
+            const aasm::AssembledModule& module,
+            const CodeHeapChunk& memory, const std::size_t slots_offset,
+            const std::unordered_map<std::string, std::int64_t>* imports = nullptr) noexcept:
             m_plt_table(plt_table),
             m_module(module),
-            jit_assembler(code_buffer),
-            m_code_buffer_offset(code_buffer_offset) {}
+            m_memory(memory),
+            m_slots_offset(slots_offset),
+            m_imports(imports),
+            m_data_patcher(memory.data().subspan(slots_offset)),
+            m_code_patcher(memory.code()) {}
 
         void run() {
-            relocation_table.resize(m_module.m_asm_buffers.size() + m_module.m_global_slots.size());
-
-            for (const auto& [name, slot]: m_module.m_global_slots) {
-                assemble_slot(name, slot);
-            }
-
-            for (const auto& [name, emitter] : m_module.m_asm_buffers) {
-                assemble_slot(name, emitter);
-            }
-
+            fill_table(m_module.data(), m_data_table);
+            fill_table(m_module.text(), m_code_table);
             try_resolve_relocations();
         }
 
         std::unordered_map<const aasm::Symbol*, JitDataChunk> result() {
-            return std::move(offset_table);
+            return std::move(m_code_table);
+        }
+
+        std::unordered_map<const aasm::Symbol*, JitDataChunk> data_result() {
+            return std::move(m_data_table);
         }
 
     private:
-        template<typename T>
-        void assemble_slot(const aasm::Symbol* name, T& element) {
-            const auto start = jit_assembler.size();
-            auto reloc = element.emit(jit_assembler);
-
-            relocation_table.push_back(std::move(reloc));
-            [[maybe_unused]]
-            const auto [_unused2, has2] = offset_table.emplace(name, JitDataChunk(start, jit_assembler.size() - start));
-            assertion(has2, "Offset for symbol already exists: {}", name->name());
+        static void fill_table(const aasm::AssembledSection& section, std::unordered_map<const aasm::Symbol*, JitDataChunk>& table) {
+            table.reserve(section.chunks().size());
+            for (const auto& chunk: section.chunks()) {
+                [[maybe_unused]]
+                const auto [_unused, has] = table.emplace(chunk.symbol, JitDataChunk(chunk.offset, chunk.size));
+                assertion(has, "Offset for symbol already exists: {}", chunk.symbol->name());
+            }
         }
 
         void try_resolve_relocations() {
-            for (const auto& relocation : relocation_table) {
-                for (const auto& reloc : relocation) {
-                    switch (reloc.type()) {
-                        case RelType::X86_64_NONE:     break;
-                        case RelType::X86_64_PC32:     try_patch_relocation(reloc); break;
-                        case RelType::X86_64_PLT32:    try_plt_patch_relocation(reloc); break;
-                        case RelType::X86_64_GLOB_DAT: try_glob_patch_relocation(reloc); break;
-                        default: die("Unsupported relocation type: {}", static_cast<std::uint8_t>(reloc.type()));
-                    }
+            for (const auto& reloc : m_module.data().relocations()) {
+                switch (reloc.type()) {
+                    case RelType::X86_64_NONE:     break;
+                    case RelType::X86_64_GLOB_DAT: try_glob_patch_relocation(reloc); break;
+                    default: die("Unsupported relocation type in data: {}", static_cast<std::uint8_t>(reloc.type()));
+                }
+            }
+
+            for (const auto& reloc : m_module.text().relocations()) {
+                switch (reloc.type()) {
+                    case RelType::X86_64_NONE:     break;
+                    case RelType::X86_64_PC32:     try_patch_relocation(reloc); break;
+                    case RelType::X86_64_PLT32:    try_plt_patch_relocation(reloc); break;
+                    default: die("Unsupported relocation type: {}", static_cast<std::uint8_t>(reloc.type()));
                 }
             }
         }
 
+        /**
+         * Returns the executable address of the symbol defined in this module or imported into it.
+         */
+        [[nodiscard]]
+        std::int64_t symbol_address(const aasm::Symbol* symbol) const {
+            if (const auto chunk = m_code_table.find(symbol); chunk != m_code_table.end()) {
+                return reinterpret_cast<std::int64_t>(m_memory.code_start()) + static_cast<std::int64_t>(chunk->second.offset);
+            }
+
+            if (const auto chunk = m_data_table.find(symbol); chunk != m_data_table.end()) {
+                return reinterpret_cast<std::int64_t>(m_memory.data().data()) + static_cast<std::int64_t>(m_slots_offset + chunk->second.offset);
+            }
+
+            if (m_imports != nullptr) {
+                if (const auto imported = m_imports->find(std::string(symbol->name())); imported != m_imports->end()) {
+                    return imported->second;
+                }
+            }
+
+            die("Relocation for label '{}' not found in offset table", symbol->name());
+        }
+
+        /**
+         * Returns the rip-relative value for a relocation in the code section.
+         */
+        [[nodiscard]]
+        std::int32_t pc_relative(const std::int64_t target, const aasm::Relocation& reloc) const {
+            const auto pc = reinterpret_cast<std::int64_t>(m_memory.code_start()) + reloc.displacement();
+            return checked_cast<std::int32_t>(target - pc);
+        }
+
         void try_glob_patch_relocation(const aasm::Relocation& reloc) {
-            const auto address = reinterpret_cast<std::int64_t>(jit_assembler.data()) + reloc.displacement();
-            jit_assembler.patch64(reloc.offset(), address);
+            m_data_patcher.patch64(reloc.offset(), symbol_address(reloc.symbol()));
         }
 
         void try_plt_patch_relocation(const aasm::Relocation& reloc) {
@@ -66,27 +106,23 @@ namespace details {
                 die("PLT relocation for symbol '{}' not found in external symbols", reloc.symbol_name());
             }
 
-            const auto offset = static_cast<std::int64_t>(external->second) - static_cast<std::int64_t>(m_code_buffer_offset) - reloc.displacement();
-            jit_assembler.patch32(reloc.offset(), checked_cast<std::int32_t>(offset));
+            const auto entry = reinterpret_cast<std::int64_t>(m_memory.data().data()) + static_cast<std::int64_t>(external->second);
+            m_code_patcher.patch32(reloc.offset(), pc_relative(entry, reloc));
         }
 
         void try_patch_relocation(const aasm::Relocation& reloc) {
-            const auto chunk = offset_table.find(reloc.symbol());
-            if (chunk == offset_table.end()) {
-                die("Relocation for label '{}' not found in offset table", reloc.symbol_name());
-            }
-
-            const auto& [start, _] = chunk->second;
-            const auto offset = static_cast<std::int64_t>(start) - reloc.displacement();
-            jit_assembler.patch32(reloc.offset(), checked_cast<std::int32_t>(offset));
+            m_code_patcher.patch32(reloc.offset(), pc_relative(symbol_address(reloc.symbol()), reloc));
         }
 
         const std::unordered_map<const aasm::Symbol*, std::size_t>& m_plt_table;
-        const aasm::AsmModule& m_module;
-        OpCodeBuffer jit_assembler;
-        std::size_t m_code_buffer_offset;
-
-        std::vector<std::vector<aasm::Relocation>> relocation_table;
-        std::unordered_map<const aasm::Symbol*, JitDataChunk> offset_table;
+        const aasm::AssembledModule& m_module;
+        const CodeHeapChunk& m_memory;
+        const std::size_t m_slots_offset;
+        const std::unordered_map<std::string, std::int64_t>* m_imports;
+        OpCodeBuffer m_data_patcher;
+        OpCodeBuffer m_code_patcher;
+
+        std::unordered_map<const aasm::Symbol*, JitDataChunk> m_data_table;
+        std::unordered_map<const aasm::Symbol*, JitDataChunk> m_code_table;
     };
-}
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "TieredModule.h"
+
+#include <atomic>
+#include <ranges>
+
+#include "lir/x64/codegen/Codegen.h"
+#include "lir/x64/lower/Lowering.h"
+
+
+static std::unordered_map<const aasm::Symbol*, std::size_t> resolve_externals(aasm::SymbolTable& symbol_table, const std::unordered_map<std::string, std::size_t>& external_symbols) {
+    std::unordered_map<const aasm::Symbol*, std::size_t> addresses;
+    addresses.reserve(external_symbols.size());
+    for (const auto& [name, address]: external_symbols) {
+        const auto [symbol, _] = symbol_table.add(name, aasm::BindAttribute::INTERNAL);
+        addresses.emplace(symbol, address);
+    }
+
+    return addresses;
+}
+
+TieredModule TieredModule::compile(const Module &module, const std::unordered_map<std::string, std::size_t> &external_symbols, const std::uint64_t threshold) {
+    const auto& functions = module.functions();
+    auto counters = std::make_unique<std::uint64_t[]>(functions.size());
+    std::unordered_map<std::string, std::uint64_t*> entry_counters;
+    entry_counters.reserve(functions.size());
+    for (std::size_t idx{}; const auto& name: functions | std::views::keys) {
+        entry_counters.emplace(name, &counters[idx++]);
+    }
+
+    Lowering lower(module);
+    lower.run();
+    auto lir_module = lower.result();
+
+    Codegen codegen(lir_module, 1, CodegenTier::BASELINE);
+    codegen.count_entries(std::unordered_map(entry_counters));
+    codegen.run();
+    auto obj = codegen.result();
+
+    // The entries are patched with an atomic 8 byte store.
+    const auto addresses = resolve_externals(obj.m_symbol_table, external_symbols);
+    const auto assembled = aasm::AssembledModule::assemble(obj, sizeof(std::uint64_t));
+    auto baseline = JitModule::assembly(addresses, std::move(obj.m_symbol_table), assembled);
+    return TieredModule(module, external_symbols, threshold, std::move(counters), std::move(entry_counters), std::move(baseline));
+}
+
+std::uint64_t TieredModule::invocation_count(const std::string &name) const {
+    const auto it = m_entry_counters.find(name);
+    if (it == m_entry_counters.end()) {
+        return 0;
+    }
+
+    return std::atomic_ref(*it->second).load(std::memory_order_relaxed);
+}
+
+std::unordered_set<std::string> TieredModule::hot_functions() const {
+    std::unordered_set<std::string> hot;
+    for (const auto& name: m_entry_counters | std::views::keys) {
+        if (!m_optimized.contains(name) && invocation_count(name) >= m_threshold) {
+            hot.insert(name);
+        }
+    }
+
+    return hot;
+}
+
+std::size_t TieredModule::tier_up() {
+    auto hot = hot_functions();
+    if (hot.empty()) {
+        return 0;
+    }
+
+    Lowering lower(m_module);
+    lower.run();
+    auto lir_module = lower.result();
+
+    Codegen codegen(lir_module);
+    codegen.select_functions(std::unordered_set(hot));
+    codegen.run();
+    auto obj = codegen.result();
+
+    // Global data lives in the baseline module, the optimized code refers to it by the imported addresses.
+    obj.m_global_slots.clear();
+    const auto addresses = resolve_externals(obj.m_symbol_table, m_external_symbols);
+    const auto assembled = aasm::AssembledModule::assemble(obj);
+    auto optimized = JitModule::assembly_near(m_baseline, addresses, m_baseline.exports(), std::move(obj.m_symbol_table), assembled);
+    if (!optimized.has_value()) {
+        // The arena of the baseline module is full, the functions stay in the baseline tier.
+        return 0;
+    }
+
+    const auto entries = optimized->exports();
+    for (const auto& name: hot) {
+        const auto target = entries.find(name);
+        if (target == entries.end()) {
+            die("Optimized function '{}' not found", name);
+        }
+
+        if (const auto patched = m_baseline.patch_entry(name, reinterpret_cast<const std::uint8_t*>(target->second)); !patched.has_value()) {
+            die("Failed to patch the entry of '{}'", name);
+        }
+    }
+
+    const auto promoted = hot.size();
+    m_optimized_modules.push_back(std::move(optimized.value()));
+    m_optimized.merge(hot);
+    return promoted;
+}
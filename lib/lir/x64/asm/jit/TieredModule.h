@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "lir/x64/asm/jit/JitModule.h"
+#include "mir/module/Module.h"
+
+/**
+ * JIT module compiled in two tiers.
+ * All functions start in the baseline tier, which compiles quickly and counts the calls of every function.
+ * 'tier_up' recompiles the functions whose counter reached the threshold with the optimizing tier
+ * and redirects the baseline entries to the new code, so callers inside and outside the module switch over.
+ * The baseline code and global data stay in place: the optimized functions call the baseline ones and share the globals.
+ */
+class TieredModule final {
+public:
+    static constexpr std::uint64_t DEFAULT_THRESHOLD = 1000;
+
+    TieredModule(const TieredModule&) = delete;
+    TieredModule& operator=(const TieredModule&) = delete;
+    TieredModule(TieredModule&&) noexcept = default;
+
+    /**
+     * Compiles every function of the module with the baseline tier.
+     * @param module must outlive the tiered module, it is lowered again on every tier up.
+     * @param external_symbols addresses of the symbols defined outside the module.
+     * @param threshold the number of calls after which the function is optimized.
+     */
+    static TieredModule compile(const Module& module, const std::unordered_map<std::string, std::size_t>& external_symbols, std::uint64_t threshold = DEFAULT_THRESHOLD);
+
+    /**
+     * Returns the entry of the function. It stays valid after the function is optimized.
+     */
+    template<typename T>
+    requires std::is_function_v<T>
+    [[nodiscard]]
+    std::expected<JitFunctionFunctor<T>, Error> code_start_as(const std::string& name) const {
+        return m_baseline.code_start_as<T>(name);
+    }
+
+    /**
+     * Returns how many times the baseline code of the function was entered.
+     */
+    [[nodiscard]]
+    std::uint64_t invocation_count(const std::string& name) const;
+
+    [[nodiscard]]
+    bool is_optimized(const std::string& name) const {
+        return m_optimized.contains(name);
+    }
+
+    /**
+     * Optimizes the functions which reached the threshold since the last call.
+     * Must not run concurrently with itself, the compiled code may keep running meanwhile.
+     * @return the number of optimized functions.
+     */
+    std::size_t tier_up();
+
+private:
+    explicit TieredModule(const Module& module, const std::unordered_map<std::string, std::size_t>& external_symbols,
+        const std::uint64_t threshold, std::unique_ptr<std::uint64_t[]>&& counters,
+        std::unordered_map<std::string, std::uint64_t*>&& entry_counters, JitModule&& baseline) noexcept:
+        m_module(module),
+        m_external_symbols(external_symbols),
+        m_threshold(threshold),
+        m_counters(std::move(counters)),
+        m_entry_counters(std::move(entry_counters)),
+        m_baseline(std::move(baseline)) {}
+
+    [[nodiscard]]
+    std::unordered_set<std::string> hot_functions() const;
+
+    const Module& m_module;
+    std::unordered_map<std::string, std::size_t> m_external_symbols;
+    std::uint64_t m_threshold;
+    std::unique_ptr<std::uint64_t[]> m_counters;
+    std::unordered_map<std::string, std::uint64_t*> m_entry_counters;
+    JitModule m_baseline;
+    std::unordered_set<std::string> m_optimized;
+    std::vector<JitModule> m_optimized_modules;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "lir/x64/asm/map/LIROperandMapping.h"
 #include "lir/x64/instruction/LIRVisitor.h"
+#include "lir/x64/instruction/LIRVector.h"
 
 #include "lir/x64/asm/operand/GPOp.h"
 #include "lir/x64/asm/operand/XOp.h"
@@ -31,6 +32,11 @@
 #include "lir/x64/asm/emitters/AddFloatEmit.h"
 #include "lir/x64/asm/emitters/SubIntEmit.h"
 #include "lir/x64/asm/emitters/XorIntEmit.h"
+#include "lir/x64/asm/emitters/MulIntEmit.h"
+#include "lir/x64/asm/emitters/AndIntEmit.h"
+#include "lir/x64/asm/emitters/OrIntEmit.h"
+#include "lir/x64/asm/emitters/NegIntEmit.h"
+#include "lir/x64/asm/emitters/NotIntEmit.h"
 #include "lir/x64/asm/emitters/CMovGPEmit.h"
 #include "lir/x64/asm/emitters/CmpGPEmit.h"
 #include "lir/x64/asm/emitters/DivIntEmit.h"
@@ -61,6 +67,9 @@
 #include "lir/x64/asm/emitters/CvtUInt2FpEmit.h"
 #include "lir/x64/asm/emitters/ShiftIntEmit.h"
 #include "lir/x64/asm/emitters/DivFloatEmit.h"
+#include "lir/x64/asm/emitters/PackedBinaryEmit.h"
+#include "lir/x64/asm/emitters/BroadcastFloatEmit.h"
+#include "lir/x64/asm/emitters/BroadcastIntEmit.h"
 
 namespace details {
     template<typename TemporalRegStorage, typename AsmEmit>
@@ -79,6 +88,10 @@ namespace details {
             binary_gp_op<SubIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, in2);
         }
 
+        void mul_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            binary_gp_op<MulIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, in2);
+        }
+
         void div_i(const std::span<LIRVal const> outs, const LIROperand &in1, const LIROperand &in2) final {
             binary_gp_op<DivIntEmit<TemporalRegStorage, AsmEmit>>(outs[0], in1, in2);
         }
@@ -87,6 +100,14 @@ namespace details {
             binary_gp_op<DivUIntEmit<TemporalRegStorage, AsmEmit>>(outs[0], in1, in2);
         }
 
+        void and_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            binary_gp_op<AndIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, in2);
+        }
+
+        void or_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            binary_gp_op<OrIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, in2);
+        }
+
         void xor_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
             binary_gp_op<XorIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, in2);
         }
@@ -139,6 +160,21 @@ namespace details {
             emitter.apply(in1_reg, in2_reg);
         }
 
+        void cmp_by_idx_i(const LIROperand &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) final {
+            const auto in_op = convert_to_gp_op(in);
+            const auto address = indexed_address(pointer, index, in.size(), disp);
+            CmpGPEmit emitter(m_temp_regs, m_as, in.size());
+            emitter.apply(address, in_op);
+        }
+
+        void neg_i(const LIRVal &out, const LIROperand &in) final {
+            unary_gp_out<NegIntEmit<TemporalRegStorage, AsmEmit>>(out, in);
+        }
+
+        void not_i(const LIRVal &out, const LIROperand &in) final {
+            unary_gp_out<NotIntEmit<TemporalRegStorage, AsmEmit>>(out, in);
+        }
+
         void mov_i(const LIROperand &in1, const LIROperand &in2) final {
             const auto in1_reg = convert_to_gp_op(in1);
             const auto add_opt = in1_reg.as_address();
@@ -149,12 +185,12 @@ namespace details {
             emitter.apply(add_opt.value(), in2_op);
         }
 
-        void mov_by_idx_i(const LIRVal &pointer, const LIROperand &index, const LIROperand &in) final {
+        void mov_by_idx_i(const LIRVal &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) final {
             const auto out_reg = pointer.assigned_reg().to_gp_op().value();
             const auto index_op = convert_to_gp_op(index);
             const auto in2_op = convert_to_gp_op(in);
 
-            MovByIdxIntEmit emitter(m_temp_regs, m_as, in.size());
+            MovByIdxIntEmit emitter(m_temp_regs, m_as, in.size(), disp);
             emitter.apply(out_reg, index_op, in2_op);
         }
 
@@ -184,15 +220,35 @@ namespace details {
             emitter.apply(out_reg, pointer_reg);
         }
 
-        void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) final {
+        void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
             const auto out_reg = out.assigned_reg().to_gp_op().value();
             const auto index_op = convert_to_gp_op(index);
             const auto pointer_op = convert_to_gp_op(pointer);
 
-            LoadByIdxIntEmit emitter(m_temp_regs, m_as, out.size());
+            LoadByIdxIntEmit emitter(m_temp_regs, m_as, out.size(), disp);
             emitter.apply(out_reg, pointer_op, index_op);
         }
 
+        void add_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
+            binary_gp_by_idx<AddIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, pointer, index, disp);
+        }
+
+        void sub_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
+            binary_gp_by_idx<SubIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, pointer, index, disp);
+        }
+
+        void and_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
+            binary_gp_by_idx<AndIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, pointer, index, disp);
+        }
+
+        void or_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
+            binary_gp_by_idx<OrIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, pointer, index, disp);
+        }
+
+        void xor_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
+            binary_gp_by_idx<XorIntEmit<TemporalRegStorage, AsmEmit>>(out, in1, pointer, index, disp);
+        }
+
         void read_by_offset_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) final {
             const auto out_reg = out.assigned_reg().to_gp_op().value();
             const auto index_op = convert_to_gp_op(index);
@@ -244,21 +300,21 @@ namespace details {
             emitter.apply(add_opt.value(), in2_op);
         }
 
-        void mov_by_idx_f(const LIRVal &pointer, const LIROperand &index, const LIROperand &in) final {
+        void mov_by_idx_f(const LIRVal &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) final {
             const auto out_reg = pointer.assigned_reg().to_gp_op().value();
             const auto index_op = convert_to_gp_op(index);
             const auto in2_op = convert_to_x_op(in);
 
-            MovByIdxFloatEmit emitter(m_temp_regs, m_as, in.size());
+            MovByIdxFloatEmit emitter(m_temp_regs, m_as, in.size(), disp);
             emitter.apply(out_reg, index_op, in2_op);
         }
 
-        void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) final {
+        void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) final {
             const auto out_reg = out.assigned_reg().to_xmm_op().value();
             const auto index_op = convert_to_gp_op(index);
             const auto pointer_op = convert_to_gp_op(pointer);
 
-            LoadByIdxFloatEmit emitter(m_temp_regs, m_as, out.size());
+            LoadByIdxFloatEmit emitter(m_temp_regs, m_as, out.size(), disp);
             emitter.apply(out_reg, pointer_op, index_op);
         }
 
@@ -305,6 +361,54 @@ namespace details {
             emitter.apply(out_reg, in_reg);
         }
 
+        void vadd(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            packed_op(LIRVecKind::Add, lane, out, in1, in2);
+        }
+
+        void vsub(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            packed_op(LIRVecKind::Sub, lane, out, in1, in2);
+        }
+
+        void vmul(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            packed_op(LIRVecKind::Mul, lane, out, in1, in2);
+        }
+
+        void vdiv(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            packed_op(LIRVecKind::Div, lane, out, in1, in2);
+        }
+
+        void vcmp(const VecLane lane, const VecPredicate predicate, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            const auto out_reg = out.assigned_reg().to_xmm_op().value();
+            const auto in1_reg = convert_to_x_op(in1);
+            const auto in2_reg = convert_to_x_op(in2);
+            PackedBinaryEmit emitter(m_temp_regs, m_as, LIRVecKind::Cmp, lane, out.size(), predicate);
+            emitter.apply(out_reg, in1_reg, in2_reg);
+        }
+
+        void vxor(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            packed_op(LIRVecKind::Xor, lane, out, in1, in2);
+        }
+
+        void vshuffle(const VecLane lane, const std::uint8_t control, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) final {
+            const auto out_reg = out.assigned_reg().to_xmm_op().value();
+            const auto in1_reg = convert_to_x_op(in1);
+            const auto in2_reg = convert_to_x_op(in2);
+            PackedBinaryEmit emitter(m_temp_regs, m_as, LIRVecKind::Shuffle, lane, out.size(), VecPredicate::EQ, control);
+            emitter.apply(out_reg, in1_reg, in2_reg);
+        }
+
+        void vbroadcast(const VecLane lane, const LIRVal &out, const LIROperand &in) final {
+            const auto out_reg = out.assigned_reg().to_xmm_op().value();
+            if (is_float_lane(lane)) {
+                BroadcastFloatEmit emitter(m_temp_regs, m_as, lane, out.size());
+                emitter.apply(out_reg, convert_to_x_op(in));
+
+            } else {
+                BroadcastIntEmit emitter(m_temp_regs, m_as, lane, out.size());
+                emitter.apply(out_reg, convert_to_gp_op(in));
+            }
+        }
+
         void store_f(const LIRVal &pointer, const LIROperand &value) final {
             const auto pointer_reg = pointer.assigned_reg().to_gp_op().value();
             const auto value_op = convert_to_x_op(value);
@@ -338,6 +442,55 @@ namespace details {
             emitter.apply(out_reg, in1_reg, in2_reg);
         }
 
+        template<typename Emit>
+        void binary_gp_by_idx(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) {
+            const auto out_reg = out.assigned_reg().to_gp_op().value();
+            const auto in1_reg = convert_to_gp_op(in1);
+            const auto in2_addr = indexed_address(pointer, index, out.size(), disp);
+
+            Emit emitter(m_temp_regs, m_as, out.size());
+            emitter.apply(out_reg, in1_reg, in2_addr);
+        }
+
+        /**
+         * Makes the memory operand [pointer + index * size + disp].
+         * A spilled pointer is reloaded into the first temporal register, a spilled index into the second one.
+         */
+        aasm::Address indexed_address(const LIROperand &pointer, const LIROperand &index, const std::uint8_t size, const std::int32_t disp) {
+            const auto base = reload_gp(convert_to_gp_op(pointer), m_temp_regs.gp_temp1());
+            std::optional<aasm::Address> address;
+            convert_to_gp_op(index).visit([&]<typename T>(const T& op) {
+                if constexpr (std::is_same_v<T, std::int64_t>) {
+                    const auto offset = size * op + disp;
+                    assertion(std::in_range<std::int32_t>(offset), "Offset out of range");
+                    address.emplace(base, static_cast<std::int32_t>(offset));
+
+                } else {
+                    address.emplace(base, reload_gp(op, m_temp_regs.gp_temp2()), size, disp);
+                }
+            });
+
+            return address.value();
+        }
+
+        aasm::GPReg reload_gp(const GPOp& op, const aasm::GPReg temp) {
+            std::optional<aasm::GPReg> reg;
+            op.visit([&]<typename T>(const T& v) {
+                if constexpr (std::is_same_v<T, aasm::GPReg>) {
+                    reg = v;
+
+                } else if constexpr (std::is_same_v<T, aasm::Address>) {
+                    m_as.mov(cst::POINTER_SIZE, v, temp);
+                    reg = temp;
+
+                } else {
+                    die("Expected register or stack slot");
+                }
+            });
+
+            return reg.value();
+        }
+
         template<typename Emit>
         void binary_xmm_op(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) {
             const auto out_reg = out.assigned_reg().to_xmm_op().value();
@@ -347,6 +500,14 @@ namespace details {
             emitter.apply(out_reg, in1_reg, in2_reg);
         }
 
+        void packed_op(const LIRVecKind kind, const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) {
+            const auto out_reg = out.assigned_reg().to_xmm_op().value();
+            const auto in1_reg = convert_to_x_op(in1);
+            const auto in2_reg = convert_to_x_op(in2);
+            PackedBinaryEmit emitter(m_temp_regs, m_as, kind, lane, out.size());
+            emitter.apply(out_reg, in1_reg, in2_reg);
+        }
+
         void shift(const ShiftKind kind, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) {
             const auto out_reg = out.assigned_reg().to_gp_op().value();
             const auto in1_reg = convert_to_gp_op(in1);
@@ -0,0 +1,116 @@
+#include "BlockLayout.h"
+
+#include <algorithm>
+
+#include "lir/x64/instruction/LIRCall.h"
+
+void BlockLayout::run() {
+    m_placed.assign(m_data.id_bound(), false);
+    m_order.reserve(m_preorder.size());
+    find_cold_blocks();
+
+    const LIRBlock* start = m_data.first();
+    while (start != nullptr) {
+        place_chain(start);
+        start = next_chain_start(m_order.back());
+    }
+}
+
+void BlockLayout::find_cold_blocks() {
+    m_cold.assign(m_data.id_bound(), false);
+    const auto& profile = m_data.edge_profile();
+    if (profile.empty()) {
+        return;
+    }
+
+    std::vector<bool> executed(m_data.id_bound(), false);
+    executed[m_data.first()->id()] = true;
+    for (const auto bb: m_preorder) {
+        for (const auto succ: bb->successors()) {
+            if (profile.count(bb->id(), succ->id()) != 0) {
+                executed[succ->id()] = true;
+            }
+        }
+    }
+
+    for (const auto bb: m_preorder) {
+        m_cold[bb->id()] = !executed[bb->id()];
+    }
+}
+
+void BlockLayout::place_chain(const LIRBlock* start) {
+    for (auto bb = start; bb != nullptr; bb = best_successor(bb)) {
+        m_placed[bb->id()] = true;
+        m_order.push_back(bb);
+    }
+}
+
+std::pair<std::uint64_t, std::size_t> BlockLayout::edge_weight(const LIRBlock* from, const LIRBlock* to) const {
+    return {m_data.edge_profile().count(from->id(), to->id()), m_loops.depth(to)};
+}
+
+const LIRBlock* BlockLayout::best_successor(const LIRBlock* bb) const {
+    if (dynamic_cast<const LIRCall*>(bb->last()) != nullptr) {
+        // Codegen doesn't emit a jump after the call, so the continuation follows it whenever it can.
+        const auto cont = bb->succ(0);
+        return is_placed(cont) || cont == m_data.last() ? nullptr : cont;
+    }
+
+    const LIRBlock* best{};
+    for (const auto succ: bb->successors()) {
+        if (is_placed(succ) || succ == m_data.last() || (is_cold(succ) && !is_cold(bb))) {
+            continue;
+        }
+
+        if (best == nullptr || edge_weight(bb, succ) > edge_weight(bb, best)) {
+            best = succ;
+        }
+    }
+
+    if (best == nullptr) {
+        return nullptr;
+    }
+
+    const auto loop = m_loops.loop_of(bb);
+    if (loop != nullptr && !loop->contains(best) && has_unplaced_blocks(loop)) {
+        // The rest of the loop body goes first.
+        return nullptr;
+    }
+
+    return best;
+}
+
+bool BlockLayout::has_unplaced_blocks(const Loop<LIRBlock>* loop) const {
+    return std::ranges::any_of(loop->blocks(), [&](const LIRBlock* bb) {
+        return !is_placed(bb) && !is_cold(bb);
+    });
+}
+
+const LIRBlock* BlockLayout::next_chain_start(const LIRBlock* last) const {
+    for (auto loop = m_loops.loop_of(last); loop != nullptr; loop = loop->parent()) {
+        for (const auto bb: loop->blocks()) {
+            if (!is_placed(bb) && !is_cold(bb)) {
+                return bb;
+            }
+        }
+    }
+
+    const auto exit = m_data.last();
+    for (const auto bb: m_preorder) {
+        if (bb != exit && !is_placed(bb) && !is_cold(bb)) {
+            return bb;
+        }
+    }
+
+    if (!is_placed(exit)) {
+        return exit;
+    }
+
+    for (const auto bb: m_preorder) {
+        if (!is_placed(bb)) {
+            return bb;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "lir/x64/analysis/Analysis.h"
+#include "lir/x64/module/LIRFuncData.h"
+
+/**
+ * Decides the order in which the basic blocks are emitted.
+ * Blocks are placed in fall-through chains: every block is followed by its most likely successor which isn't placed yet.
+ * A chain doesn't leave a loop until the whole loop body is placed, so loop bodies stay contiguous.
+ * Edge likelihood comes from the measured edge counts of the function when it was profiled,
+ * otherwise an edge into a deeper loop is assumed to be more likely.
+ * The exit block follows the hot blocks, the blocks which were never executed according to the profile are sunk after it.
+ * The continuation of a call is always placed right after the call when possible.
+ */
+class BlockLayout final {
+    explicit BlockLayout(const LIRFuncData& data, const Ordering<LIRBlock>& preorder, const LoopInfo<LIRBlock>& loops) noexcept:
+        m_data(data),
+        m_preorder(preorder),
+        m_loops(loops) {}
+
+public:
+    void run();
+
+    Ordering<LIRBlock> result() noexcept {
+        return Ordering<LIRBlock>(std::move(m_order));
+    }
+
+    static BlockLayout create(LIRAnalysisPassManager* cache, const LIRFuncData* data) {
+        const auto preorder = cache->analyze<PreorderTraverseLIR>(data);
+        const auto loops = cache->analyze<LoopInfoEvalLIR>(data);
+        return BlockLayout(*data, *preorder, *loops);
+    }
+
+private:
+    void find_cold_blocks();
+    void place_chain(const LIRBlock* start);
+
+    [[nodiscard]]
+    std::pair<std::uint64_t, std::size_t> edge_weight(const LIRBlock* from, const LIRBlock* to) const;
+
+    [[nodiscard]]
+    const LIRBlock* best_successor(const LIRBlock* bb) const;
+
+    [[nodiscard]]
+    const LIRBlock* next_chain_start(const LIRBlock* last) const;
+
+    [[nodiscard]]
+    bool has_unplaced_blocks(const Loop<LIRBlock>* loop) const;
+
+    [[nodiscard]]
+    bool is_placed(const LIRBlock* bb) const noexcept {
+        return m_placed[bb->id()];
+    }
+
+    [[nodiscard]]
+    bool is_cold(const LIRBlock* bb) const noexcept {
+        return m_cold[bb->id()];
+    }
+
+    const LIRFuncData& m_data;
+    const Ordering<LIRBlock>& m_preorder;
+    const LoopInfo<LIRBlock>& m_loops;
+
+    std::vector<bool> m_placed;
+    std::vector<bool> m_cold;
+    std::vector<const LIRBlock*> m_order;
+};
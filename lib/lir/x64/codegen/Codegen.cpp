@@ -3,8 +3,14 @@
 #include "lir/x64/codegen/LIRFunctionCodegen.h"
 #include "lir/x64/analysis/Analysis.h"
 #include "lir/x64/transform/callinfo/CallInfoInitialize.h"
+#include "lir/x64/transform/regalloc/BaselineAllocation.h"
 #include "lir/x64/transform/regalloc/LinearScan.h"
+#include "lir/x64/transform/regalloc/Spilling.h"
 #include "asm/global/Directive.h"
+#include "utility/ParallelFor.h"
+
+#include <algorithm>
+#include <optional>
 
 aasm::Slot Codegen::convert_lir_slot(const LIRSlot& lir_slot) noexcept {
     const auto vis = [&]<typename T>(const T& data) -> aasm::Slot {
@@ -23,7 +29,7 @@ aasm::Slot Codegen::convert_lir_slot(const LIRSlot& lir_slot) noexcept {
         } else if constexpr (std::is_same_v<T, const LIRNamedSlot*>) {
             auto slot = convert_lir_slot(data->root());
             auto [symbol, _] = m_symbol_table.add(data->name(), aasm::BindAttribute::INTERNAL);
-            auto [directive, has] = m_slots.emplace(symbol, aasm::Directive(symbol, std::move(slot)));
+            auto [directive, has] = m_slots.emplace(symbol, aasm::Directive(symbol, std::move(slot), data->kind()));
             assertion(has, "Slot already exists in Codegen::convert_lir_slot");
             return aasm::Slot(&directive->second, lir_slot.size());
 
@@ -46,29 +52,91 @@ void Codegen::convert_lir_slots(const GlobalData& global_data) {
         }
 
         auto asm_slot = convert_lir_slot(slot.root());
-        m_slots.emplace_hint(element, symbol, aasm::Directive(symbol, std::move(asm_slot)));
+        m_slots.emplace_hint(element, symbol, aasm::Directive(symbol, std::move(asm_slot), slot.kind()));
     }
 }
 
+aasm::AsmBuffer Codegen::compile_function(LIRFuncData& func, aasm::SymbolTable& symbol_table) {
+    auto spilling = Spilling::create(&func, call_conv::CC_LinuxX64());
+    spilling.run();
+
+    LIRAnalysisPassManager manager;
+    auto linear_scan = LinearScan::create(&manager, &func, symbol_table, call_conv::CC_LinuxX64());
+    linear_scan.run();
+
+    auto call_info = CallInfoInitialize::create(&manager, &func, call_conv::CC_LinuxX64());
+    call_info.run();
+
+    auto fn_codegen = LIRFunctionCodegen::create(&manager, &func, symbol_table, call_conv::CC_LinuxX64());
+    fn_codegen.run();
+    return fn_codegen.result().to_buffer();
+}
+
+aasm::AsmBuffer Codegen::compile_function_baseline(LIRFuncData& func, aasm::SymbolTable& symbol_table, std::uint64_t* entry_counter) {
+    auto allocation = BaselineAllocation::create(&func, symbol_table, call_conv::CC_LinuxX64());
+    allocation.run();
+
+    auto call_info = CallInfoInitialize::create_without_liveness(&func, call_conv::CC_LinuxX64());
+    call_info.run();
+
+    auto fn_codegen = LIRFunctionCodegen::create_baseline(&func, symbol_table, entry_counter);
+    fn_codegen.run();
+    return fn_codegen.result().to_buffer();
+}
+
+std::uint64_t* Codegen::entry_counter(const LIRFuncData& func) const {
+    const auto it = m_entry_counters.find(std::string(func.name()));
+    return it == m_entry_counters.end() ? nullptr : it->second;
+}
+
 void Codegen::run() {
     convert_lir_slots(m_module.global_data());
 
+    std::vector<LIRFuncData*> functions;
     for (auto& func: m_module | std::views::values) {
-        convert_lir_slots(func.global_data());
+        functions.push_back(&func);
+    }
+    std::ranges::sort(functions, {}, [](const LIRFuncData* func) { return func->name(); });
+
+    // Register globals and function symbols up front, so the workers only look them up.
+    for (const auto& name: m_imported_functions) {
+        m_symbol_table.add(name, aasm::BindAttribute::EXTERNAL);
+    }
+
+    std::vector<const aasm::Symbol*> symbols;
+    symbols.reserve(functions.size());
+    for (const auto func: functions) {
+        convert_lir_slots(func->global_data());
+        const auto bind = func->bind() == FunctionBind::INTERNAL ? aasm::BindAttribute::INTERNAL : aasm::BindAttribute::DEFAULT;
+        const auto [symbol, _] = m_symbol_table.add(func->name(), bind);
+        symbols.push_back(symbol);
+    }
 
-        LIRAnalysisPassManager manager;
-        auto linear_scan = LinearScan::create(&manager, &func, m_symbol_table, call_conv::CC_LinuxX64());
-        linear_scan.run();
+    if (m_selected_functions.has_value()) {
+        const auto is_skipped = [&](const LIRFuncData* func) { return !m_selected_functions->contains(std::string(func->name())); };
+        std::erase_if(symbols, [&](const aasm::Symbol* symbol) { return !m_selected_functions->contains(std::string(symbol->name())); });
+        std::erase_if(functions, is_skipped);
+    }
 
-        auto call_info = CallInfoInitialize::create(&manager, &func, call_conv::CC_LinuxX64());
-        call_info.run();
+    std::vector<std::optional<aasm::AsmBuffer>> buffers(functions.size());
+    std::vector<aasm::PeepholeStats> stats(functions.size());
+    parallel_for_each(std::span(functions), m_jobs, [&](const std::size_t idx, LIRFuncData* func) {
+        if (m_tier == CodegenTier::BASELINE) {
+            buffers[idx].emplace(compile_function_baseline(*func, m_symbol_table, entry_counter(*func)));
+            return;
+        }
 
-        auto fn_codegen = LIRFunctionCodegen::create(&manager, &func, m_symbol_table);
-        fn_codegen.run();
+        auto& buffer = buffers[idx].emplace(compile_function(*func, m_symbol_table));
+        stats[idx] = buffer.optimize();
+    });
+
+    for (const auto& function_stats: stats) {
+        m_peephole_stats += function_stats;
+    }
 
-        const auto [symbol, _] = m_symbol_table.add(func.name(), aasm::BindAttribute::INTERNAL);
+    for (auto&& [symbol, buffer]: std::views::zip(symbols, buffers)) {
         [[maybe_unused]]
-        const auto [_unused, has] = m_assemblers.emplace(symbol, fn_codegen.result().to_buffer());
+        const auto [_unused, has] = m_assemblers.emplace(symbol, std::move(buffer.value()));
         assertion(has, "Function already exists");
     }
 }
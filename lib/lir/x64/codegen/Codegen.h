@@ -1,23 +1,84 @@
 #pragma once
 
+#include <optional>
+#include <unordered_set>
+
 #include "asm/x64/AsmModule.h"
 #include "lir/x64/module/LIRModule.h"
 
+/**
+ * How much work the code generator spends on a function.
+ */
+enum class CodegenTier: std::uint8_t {
+    /** Every value lives in its stack slot, the registers are picked in a single pass without any analysis. */
+    BASELINE,
+    /** Spilling, linear scan, block layout, shrink wrapping and the peephole optimizer. */
+    OPTIMIZING,
+};
+
+/**
+ * Generates machine code for the LIR module.
+ * Register allocation and encoding of the functions run on up to `jobs` workers.
+ * Every function is emitted into its own buffer, so the output doesn't depend on the number of workers.
+ * The instructions of the optimized function pass through the peephole optimizer before they are assembled.
+ */
 class Codegen final {
 public:
-    explicit Codegen(LIRModule &module) noexcept:
-        m_module(module) {}
+    explicit Codegen(LIRModule &module, const std::size_t jobs = 1, const CodegenTier tier = CodegenTier::OPTIMIZING) noexcept:
+        m_module(module),
+        m_jobs(jobs),
+        m_tier(tier) {}
+
+    /**
+     * Generates code only for the given functions. The symbols of the other functions are still defined,
+     * so the calls to them are resolved when the module is linked against the code placed earlier.
+     */
+    void select_functions(std::unordered_set<std::string>&& names) {
+        m_selected_functions = std::move(names);
+    }
+
+    /**
+     * Binds the functions defined outside the generated code as external symbols. The calls to them load the address
+     * from the external symbol table of the module, so the code doesn't have to be placed next to them.
+     */
+    void import_functions(std::unordered_set<std::string>&& names) {
+        m_imported_functions = std::move(names);
+    }
+
+    /**
+     * The baseline functions increment their counter on every entry. The counters must outlive the code.
+     */
+    void count_entries(std::unordered_map<std::string, std::uint64_t*>&& counters) {
+        m_entry_counters = std::move(counters);
+    }
 
     void run();
 
     aasm::AsmModule result();
 
+    /** @return how many times each peephole rule fired over all functions **/
+    [[nodiscard]]
+    const aasm::PeepholeStats& peephole_stats() const noexcept {
+        return m_peephole_stats;
+    }
+
 private:
     aasm::Slot convert_lir_slot(const LIRSlot &lir_slot) noexcept;
     void convert_lir_slots(const GlobalData& global_data);
+    static aasm::AsmBuffer compile_function(LIRFuncData& func, aasm::SymbolTable& symbol_table);
+    static aasm::AsmBuffer compile_function_baseline(LIRFuncData& func, aasm::SymbolTable& symbol_table, std::uint64_t* entry_counter);
+
+    [[nodiscard]]
+    std::uint64_t* entry_counter(const LIRFuncData& func) const;
 
     LIRModule& m_module;
+    const std::size_t m_jobs;
+    const CodegenTier m_tier;
+    std::optional<std::unordered_set<std::string>> m_selected_functions{};
+    std::unordered_set<std::string> m_imported_functions{};
+    std::unordered_map<std::string, std::uint64_t*> m_entry_counters{};
     aasm::SymbolTable m_symbol_table{}; // Symbol table for the module
     std::unordered_map<const aasm::Symbol*, aasm::AsmBuffer> m_assemblers;
     std::unordered_map<const aasm::Symbol*, aasm::Directive> m_slots;
+    aasm::PeepholeStats m_peephole_stats{};
 };
\ No newline at end of file
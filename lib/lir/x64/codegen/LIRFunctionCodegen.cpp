@@ -6,9 +6,11 @@
 
 #include "lir/x64/instruction/LIRCall.h"
 #include "lir/x64/instruction/LIRInstructionBase.h"
+#include "lir/x64/instruction/LIRProducerInstructionBase.h"
 #include "lir/x64/asm/map/LIRInstuctionMapping.h"
 #include "lir/x64/asm/map/LIROperandMapping.h"
 #include "lir/x64/operand/LIRVal.h"
+#include "utility/ArithmeticUtils.h"
 
 static aasm::BindAttribute cvt_bind_attribute(const FunctionBind bind) noexcept {
     switch (bind) {
@@ -22,19 +24,14 @@ static aasm::BindAttribute cvt_bind_attribute(const FunctionBind bind) noexcept
 namespace {
     class LIRInstructionCodegen final: public details::LIRInstructionMapping<TemporalRegs, MasmEmitter> {
     public:
-        explicit LIRInstructionCodegen(MasmEmitter& as, const TemporalRegs& regs, aasm::SymbolTable& symbol_table, const LIRBlock* next, std::unordered_map<const LIRBlock*, aasm::Label>& bb_labels) noexcept:
+        explicit LIRInstructionCodegen(MasmEmitter& as, const TemporalRegs& regs, aasm::SymbolTable& symbol_table, const LIRBlock* next, std::unordered_map<const LIRBlock*, aasm::Label>& bb_labels, const bool vzeroupper) noexcept:
             LIRInstructionMapping(regs, as, symbol_table),
             m_next(next),
-            m_bb_labels(bb_labels) {}
+            m_bb_labels(bb_labels),
+            m_vzeroupper(vzeroupper) {}
 
         void gen(const LIRVal &out) override {}
 
-        void mul_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {}
-
-        void and_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {}
-
-        void or_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {}
-
         void setcc_i(const LIRVal &out, aasm::CondType cond_type) override {
             const auto out_reg = out.assigned_reg().to_gp_op().value();
             const auto visitor = [&]<typename T>(const T &val) {
@@ -53,10 +50,6 @@ namespace {
 
         void parallel_copy(const LIRVal &out, std::span<LIRVal const> inputs) override {}
 
-        void neg_i(const LIRVal &out, const LIROperand &in) override {}
-
-        void not_i(const LIRVal &out, const LIROperand &in) override {}
-
         void up_stack(const aasm::RegSet &reg_set, const std::size_t caller_overflow_area_size, const std::size_t local_area_size) override {
             for (const auto &reg: reg_set.gp_regs()) {
                 m_as.pop(8, reg);
@@ -93,11 +86,9 @@ namespace {
             m_as.push(8, aasm::rbp);
             m_as.copy(8, aasm::rsp, aasm::rbp);
 
-            auto size_to_adjust = local_area_size;
-            if (const auto remains = local_area_size % call_conv::STACK_ALIGNMENT; remains != 0L) {
-                size_to_adjust += remains; // Stack must be aligned on 16.
-            }
-
+            // Stack must be aligned on 16 after the callee-saved registers are pushed.
+            const auto pushed_size = reg_set.size() * 8;
+            const auto size_to_adjust = align_up(local_area_size + pushed_size, call_conv::STACK_ALIGNMENT) - pushed_size;
             m_as.sub(8, checked_cast<std::int32_t>(size_to_adjust), aasm::rsp);
             for (const auto& reg: reg_set.gp_regs()) {
                 m_as.push(8, reg);
@@ -125,40 +116,72 @@ namespace {
         }
 
         void jcc(const aasm::CondType cond_type, const LIRBlock *on_true, const LIRBlock *on_false) override {
-            const auto target_false = m_bb_labels.at(on_false);
-            m_as.jcc(aasm::invert(cond_type), target_false);
+            if (m_next == on_true) {
+                m_as.jcc(aasm::invert(cond_type), m_bb_labels.at(on_false));
+                return;
+            }
+
+            m_as.jcc(cond_type, m_bb_labels.at(on_true));
+            jmp(on_false);
         }
 
         void call(const LIRVal &, const std::string_view name, std::span<LIRVal const> args, FunctionBind bind) override {
             const auto [symbol, _] = m_symbol_tab.add(name, cvt_bind_attribute(bind));
+            leave_avx();
             m_as.call(symbol);
         }
 
         void call(const LIRVal &, const LIRVal &, const std::string_view name, std::span<LIRVal const> args, const FunctionBind bind) override {
             const auto [symbol, _] = m_symbol_tab.add(name, cvt_bind_attribute(bind));
+            leave_avx();
             m_as.call(symbol);
         }
 
         void vcall(const std::string_view name, std::span<LIRVal const> args, const FunctionBind bind) override {
             const auto [symbol, _] = m_symbol_tab.add(name, cvt_bind_attribute(bind));
+            leave_avx();
             m_as.call(symbol);
         }
 
-        void icall(const LIRVal &out, const LIRVal &pointer, std::span<LIRVal const> args) override {}
+        void icall(const LIRVal &, const LIRVal &pointer, std::span<LIRVal const> args) override {
+            indirect_call(pointer);
+        }
 
-        void ivcall(const LIRVal &pointer, std::span<LIRVal const> args) override {}
+        void ivcall(const LIRVal &pointer, std::span<LIRVal const> args) override {
+            indirect_call(pointer);
+        }
 
         void ret(std::span<LIRVal const> ret_values) override {
+            leave_avx();
             m_as.ret();
         }
 
+    private:
+        void indirect_call(const LIRVal &pointer) {
+            const auto pointer_op = pointer.assigned_reg().to_gp_op().value();
+            const auto visitor = [&]<typename T>(const T &val) {
+                leave_avx();
+                m_as.call(val);
+            };
+
+            pointer_op.visit(visitor);
+        }
+
+        void leave_avx() {
+            // Dirty upper halves of the ymm registers slow down the SSE code of the callee or the caller.
+            if (m_vzeroupper) {
+                m_as.vzeroupper();
+            }
+        }
+
         const LIRBlock* m_next{};
         std::unordered_map<const LIRBlock*, aasm::Label>& m_bb_labels;
+        const bool m_vzeroupper;
     };
 }
 
 void LIRFunctionCodegen::setup_basic_block_labels() {
-    for (const auto &bb: m_preorder) {
+    for (const auto &bb: m_layout) {
         if (bb == m_data.first()) {
             // Skip the first basic block, it does not need a label.
             continue;
@@ -169,20 +192,81 @@ void LIRFunctionCodegen::setup_basic_block_labels() {
     }
 }
 
+bool LIRFunctionCodegen::uses_ymm_registers() const {
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            const auto producer = dynamic_cast<const LIRProducerInstructionBase*>(&inst);
+            if (producer == nullptr) {
+                continue;
+            }
+
+            const auto is_ymm = [](const LIRVal& def) { return def.type() == LIRValType::FP && def.size() == cst::YMMWORD_SIZE; };
+            if (std::ranges::any_of(producer->defs(), is_ymm)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void LIRFunctionCodegen::emit_entry_counter() {
+    if (m_entry_counter == nullptr) {
+        return;
+    }
+
+    // r11 is a caller-saved scratch register which never carries arguments, so it is free at the entry.
+    m_as.mov(8, static_cast<std::int64_t>(reinterpret_cast<std::uintptr_t>(m_entry_counter)), aasm::r11);
+    m_as.add(8, 1, aasm::Address(aasm::r11));
+}
+
 void LIRFunctionCodegen::traverse_instructions() {
-    const LIRBlock* m_next{};
-    for (const auto [idx, bb]: std::ranges::views::enumerate(m_preorder)) {
+    for (const auto [idx, bb]: std::ranges::views::enumerate(m_layout)) {
         if (bb != m_data.first()) {
             m_as.set_label(m_bb_labels.at(bb));
         }
-        
-        if (static_cast<std::uint64_t>(idx) + 1 < m_preorder.size()) {
-            m_next = m_preorder[idx + 1];
+
+        const auto next = static_cast<std::uint64_t>(idx) + 1 < m_layout.size() ? m_layout[idx + 1] : nullptr;
+        emit_block(bb, next);
+
+        if (const auto call = dynamic_cast<const LIRCall*>(bb->last()); call != nullptr && call->succ(0) != next) {
+            // The continuation of the call couldn't be placed right after it.
+            m_as.jmp(m_bb_labels.at(call->succ(0)));
+        }
+    }
+}
+
+void LIRFunctionCodegen::emit_block(const LIRBlock* bb, const LIRBlock* next) {
+    const auto prologue = m_data.prologue();
+    if (bb == m_frame.save_block() && bb != m_data.first()) {
+        LIRInstructionCodegen codegen(m_as, prologue->temporal_regs(), m_sym_tab, next, m_bb_labels, m_vzeroupper);
+        prologue->visit(codegen);
+    }
+
+    const auto bypass = m_frame.bypasses(bb);
+    for (auto& inst: bb->instructions()) {
+        if (&inst == prologue && bb != m_frame.save_block()) {
+            continue;
+        }
+        if (bypass && &inst == bb->last()) {
+            // The jump to the exit is replaced with its copy, which returns without the epilogue.
+            emit_return_without_frame();
+            break;
         }
-        
-        for (auto& inst: bb->instructions()) {
-            LIRInstructionCodegen codegen(m_as, inst.temporal_regs(), m_sym_tab, m_next, m_bb_labels);
-            inst.visit(codegen);
+
+        LIRInstructionCodegen codegen(m_as, inst.temporal_regs(), m_sym_tab, next, m_bb_labels, m_vzeroupper);
+        inst.visit(codegen);
+    }
+}
+
+void LIRFunctionCodegen::emit_return_without_frame() {
+    const auto epilogue = m_data.epilogue();
+    for (auto& inst: m_data.last()->instructions()) {
+        if (&inst == epilogue) {
+            continue;
         }
+
+        LIRInstructionCodegen codegen(m_as, inst.temporal_regs(), m_sym_tab, nullptr, m_bb_labels, m_vzeroupper);
+        inst.visit(codegen);
     }
-}
\ No newline at end of file
+}
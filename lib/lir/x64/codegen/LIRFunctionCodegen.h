@@ -2,18 +2,24 @@
 
 #include "lir/x64/analysis/Analysis.h"
 #include "lir/x64/asm/MasmEmitter.h"
+#include "lir/x64/codegen/BlockLayout.h"
+#include "lir/x64/codegen/ShrinkWrapping.h"
 #include "lir/x64/module/LIRFuncData.h"
 
 
 class LIRFunctionCodegen final {
-    explicit LIRFunctionCodegen(const LIRFuncData &data, const Ordering<LIRBlock>& preorder, aasm::SymbolTable& symbol_table) noexcept:
+    explicit LIRFunctionCodegen(const LIRFuncData &data, Ordering<LIRBlock>&& layout, FrameRegion&& frame, aasm::SymbolTable& symbol_table, std::uint64_t* entry_counter = nullptr) noexcept:
         m_data(data),
-        m_preorder(preorder),
+        m_layout(std::move(layout)),
+        m_frame(std::move(frame)),
+        m_entry_counter(entry_counter),
         m_sym_tab(symbol_table) {}
 
 public:
     void run() {
+        m_vzeroupper = uses_ymm_registers();
         setup_basic_block_labels();
+        emit_entry_counter();
         traverse_instructions();
     }
 
@@ -21,17 +27,46 @@ public:
         return std::move(m_as);
     }
 
-    static LIRFunctionCodegen create(LIRAnalysisPassManager* cache, const LIRFuncData* data, aasm::SymbolTable& symbol_tab) {
-        const auto preorder = cache->analyze<PreorderTraverseBase<LIRFuncData>>(data);
-        return LIRFunctionCodegen(*data, *preorder, symbol_tab);
+    static LIRFunctionCodegen create(LIRAnalysisPassManager* cache, const LIRFuncData* data, aasm::SymbolTable& symbol_tab, const call_conv::CallConvProvider* call_conv) {
+        auto layout = BlockLayout::create(cache, data);
+        layout.run();
+        auto shrink_wrapping = ShrinkWrapping::create(cache, data, call_conv);
+        shrink_wrapping.run();
+        return LIRFunctionCodegen(*data, layout.result(), shrink_wrapping.result(), symbol_tab);
+    }
+
+    /**
+     * Emits the blocks in the order they were created, the frame is set up in the first block. No analysis runs.
+     * If the counter is given, the function increments it on every entry.
+     */
+    static LIRFunctionCodegen create_baseline(const LIRFuncData* data, aasm::SymbolTable& symbol_tab, std::uint64_t* entry_counter) {
+        std::vector<const LIRBlock*> order;
+        order.reserve(data->size());
+        for (const auto& bb: data->basic_blocks()) {
+            order.push_back(&bb);
+        }
+
+        return LIRFunctionCodegen(*data, Ordering<LIRBlock>(std::move(order)), FrameRegion(data->first(), {}), symbol_tab, entry_counter);
     }
 
 private:
+    /**
+     * Returns true if some value of the function lives in a 256 bit register.
+     */
+    [[nodiscard]]
+    bool uses_ymm_registers() const;
     void setup_basic_block_labels();
+    void emit_entry_counter();
     void traverse_instructions();
+    void emit_block(const LIRBlock* bb, const LIRBlock* next);
+    void emit_return_without_frame();
 
     const LIRFuncData& m_data;
-    const Ordering<LIRBlock>& m_preorder;
+    Ordering<LIRBlock> m_layout;
+    FrameRegion m_frame;
+    std::uint64_t* m_entry_counter;
+    // The function leaves the AVX state clean before calls and returns.
+    bool m_vzeroupper{};
 
     std::unordered_map<const LIRBlock*, aasm::Label> m_bb_labels{};
     MasmEmitter m_as{};
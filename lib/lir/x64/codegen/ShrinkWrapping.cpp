@@ -0,0 +1,126 @@
+#include "ShrinkWrapping.h"
+
+#include <stack>
+
+#include "lir/x64/instruction/LIRAdjustStack.h"
+#include "lir/x64/instruction/LIRBranch.h"
+#include "lir/x64/instruction/LIRCall.h"
+
+void ShrinkWrapping::run() {
+    const LIRBlock* save{};
+    for (const auto& bb: m_data.basic_blocks()) {
+        if (!m_dom_tree.contains(&bb) || !needs_frame(&bb)) {
+            continue;
+        }
+
+        save = save == nullptr ? &bb : common_dominator(save, &bb);
+        if (save == m_data.first()) {
+            return;
+        }
+    }
+
+    if (save == nullptr || save == m_data.last()) {
+        return;
+    }
+    if (!is_single_entry_region(save) || !collect_bypass_blocks(save)) {
+        return;
+    }
+
+    m_save_block = save;
+}
+
+bool ShrinkWrapping::needs_frame(const LIRBlock* bb) const {
+    for (const auto& inst: bb->instructions()) {
+        if (const auto adjust = dynamic_cast<const LIRAdjustStack*>(&inst); adjust != nullptr) {
+            const auto kind = adjust->adjust_kind();
+            if (kind == LIRAdjustKind::UpStack || kind == LIRAdjustKind::DownStack) {
+                return true;
+            }
+
+            continue;
+        }
+
+        if (dynamic_cast<const LIRCall*>(&inst) != nullptr) {
+            return true;
+        }
+
+        for (const auto& def: LIRVal::defs(&inst)) {
+            if (needs_frame(def)) {
+                return true;
+            }
+        }
+
+        for (const auto& in: inst.inputs()) {
+            if (const auto vreg = in.as_vreg(); vreg.has_value() && needs_frame(vreg.value())) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool ShrinkWrapping::needs_frame(const LIRVal& lir_val) const {
+    const auto assigned = lir_val.assigned_reg();
+    const auto reg = assigned.to_reg();
+    if (!reg.has_value()) {
+        // Stack slot.
+        return !assigned.empty();
+    }
+
+    const auto gp_reg = reg.value().as_gp_reg();
+    return gp_reg.has_value() && m_call_conv->GP_CALLEE_SAVE_REGISTERS().contains(gp_reg.value());
+}
+
+const LIRBlock* ShrinkWrapping::common_dominator(const LIRBlock* lhs, const LIRBlock* rhs) const {
+    auto dom = lhs;
+    while (!dominates(dom, rhs)) {
+        dom = m_dom_tree.idom(dom);
+    }
+
+    return dom;
+}
+
+bool ShrinkWrapping::is_single_entry_region(const LIRBlock* save) const {
+    const auto exit = m_data.last();
+    std::vector visited(m_data.id_bound(), false);
+    std::stack<const LIRBlock*> stack;
+    for (const auto succ: save->successors()) {
+        stack.push(succ);
+    }
+
+    while (!stack.empty()) {
+        const auto bb = stack.top();
+        stack.pop();
+        if (visited[bb->id()] || bb == exit) {
+            continue;
+        }
+        if (bb == save || !dominates(save, bb)) {
+            return false;
+        }
+
+        visited[bb->id()] = true;
+        for (const auto succ: bb->successors()) {
+            stack.push(succ);
+        }
+    }
+
+    return true;
+}
+
+bool ShrinkWrapping::collect_bypass_blocks(const LIRBlock* save) {
+    std::unordered_set<const LIRBlock*> bypass;
+    for (const auto pred: m_data.last()->predecessors()) {
+        if (!m_dom_tree.contains(pred) || dominates(save, pred)) {
+            continue;
+        }
+        if (dynamic_cast<const LIRBranch*>(pred->last()) == nullptr) {
+            return false;
+        }
+
+        bypass.emplace(pred);
+    }
+
+    m_bypass = std::move(bypass);
+    return true;
+}
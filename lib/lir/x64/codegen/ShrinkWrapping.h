@@ -0,0 +1,88 @@
+#pragma once
+
+#include <unordered_set>
+
+#include "lir/x64/analysis/Analysis.h"
+#include "lir/x64/asm/cc/CallConv.h"
+#include "lir/x64/module/LIRFuncData.h"
+
+/**
+ * Part of the function which runs with the stack frame set up.
+ */
+class FrameRegion final {
+public:
+    explicit FrameRegion(const LIRBlock* save_block, std::unordered_set<const LIRBlock*>&& bypass) noexcept:
+        m_save_block(save_block),
+        m_bypass(std::move(bypass)) {}
+
+    /** @return the block which runs the prologue **/
+    [[nodiscard]]
+    const LIRBlock* save_block() const noexcept {
+        return m_save_block;
+    }
+
+    /** @return true if the block jumps to the exit without the frame, so it returns without the epilogue **/
+    [[nodiscard]]
+    bool bypasses(const LIRBlock* bb) const {
+        return m_bypass.contains(bb);
+    }
+
+private:
+    const LIRBlock* m_save_block;
+    std::unordered_set<const LIRBlock*> m_bypass;
+};
+
+/**
+ * Moves the prologue out of the first block when only a part of the function needs the stack frame.
+ * A block needs the frame when it calls or touches a stack slot or a callee-saved register.
+ * The prologue runs in the nearest common dominator of such blocks, the paths which don't pass through it
+ * return without the epilogue, so fast paths don't pay for the frame and the callee-saved registers.
+ * The save block must not be on a cycle and must dominate every block reachable from it,
+ * and the paths bypassing it must reach the exit by a plain jump, otherwise the prologue stays in the first block.
+ */
+class ShrinkWrapping final {
+    explicit ShrinkWrapping(const LIRFuncData& data, DominatorTree<LIRBlock>& dom_tree, const call_conv::CallConvProvider* call_conv) noexcept:
+        m_data(data),
+        m_dom_tree(dom_tree),
+        m_call_conv(call_conv),
+        m_save_block(data.first()) {}
+
+public:
+    void run();
+
+    FrameRegion result() noexcept {
+        return FrameRegion(m_save_block, std::move(m_bypass));
+    }
+
+    static ShrinkWrapping create(LIRAnalysisPassManager* cache, const LIRFuncData* data, const call_conv::CallConvProvider* call_conv) {
+        const auto dom_tree = cache->analyze<DominatorTreeEvalLIR>(data);
+        return ShrinkWrapping(*data, *dom_tree, call_conv);
+    }
+
+private:
+    [[nodiscard]]
+    bool needs_frame(const LIRBlock* bb) const;
+
+    [[nodiscard]]
+    bool needs_frame(const LIRVal& lir_val) const;
+
+    [[nodiscard]]
+    bool dominates(const LIRBlock* dominator, const LIRBlock* bb) const {
+        return dominator == bb || m_dom_tree.dominates(dominator, bb);
+    }
+
+    [[nodiscard]]
+    const LIRBlock* common_dominator(const LIRBlock* lhs, const LIRBlock* rhs) const;
+
+    [[nodiscard]]
+    bool is_single_entry_region(const LIRBlock* save) const;
+
+    bool collect_bypass_blocks(const LIRBlock* save);
+
+    const LIRFuncData& m_data;
+    DominatorTree<LIRBlock>& m_dom_tree;
+    const call_conv::CallConvProvider* m_call_conv;
+
+    const LIRBlock* m_save_block;
+    std::unordered_set<const LIRBlock*> m_bypass;
+};
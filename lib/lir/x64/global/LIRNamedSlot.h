@@ -1,12 +1,14 @@
 #pragma once
 
 #include "LIRSlot.h"
+#include "base/global/GValueKind.h"
 
 
 class LIRNamedSlot final {
 public:
-    explicit LIRNamedSlot(std::string&& name, LIRSlot&& value) noexcept:
+    explicit LIRNamedSlot(std::string&& name, LIRSlot&& value, const GValueKind kind) noexcept:
         m_name(std::move(name)),
+        m_kind(kind),
         m_value(std::move(value)) {}
 
     [[nodiscard]]
@@ -22,11 +24,15 @@ public:
     [[nodiscard]]
     std::string_view name() const noexcept { return m_name; }
 
+    [[nodiscard]]
+    GValueKind kind() const noexcept { return m_kind; }
+
     friend std::ostream &operator<<(std::ostream &os, const LIRNamedSlot &slot);
 
     void print_description(std::ostream &os) const;
 
 private:
     std::string m_name;
+    GValueKind m_kind;
     LIRSlot m_value;
 };
\ No newline at end of file
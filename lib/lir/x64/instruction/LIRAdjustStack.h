@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 
 #include "LIRInstructionBase.h"
 #include "asm/x64/reg/AnyRegSet.h"
@@ -41,23 +41,23 @@ public:
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRAdjustStack> up_stack() {
-        return std::make_unique<LIRAdjustStack>(LIRAdjustKind::UpStack);
+    static auto up_stack() {
+        return construct<LIRAdjustStack>(LIRAdjustKind::UpStack);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRAdjustStack> down_stack() {
-        return std::make_unique<LIRAdjustStack>(LIRAdjustKind::DownStack);
+    static auto down_stack() {
+        return construct<LIRAdjustStack>(LIRAdjustKind::DownStack);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRAdjustStack> prologue() {
-        return std::make_unique<LIRAdjustStack>(LIRAdjustKind::Prologue);
+    static auto prologue() {
+        return construct<LIRAdjustStack>(LIRAdjustKind::Prologue);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRAdjustStack> epilogue() {
-        return std::make_unique<LIRAdjustStack>(LIRAdjustKind::Epilogue);
+    static auto epilogue() {
+        return construct<LIRAdjustStack>(LIRAdjustKind::Epilogue);
     }
 
 private:
@@ -12,7 +12,7 @@ public:
         visitor.jmp(succ(0));
     }
 
-    static std::unique_ptr<LIRBranch> jmp(LIRBlock *target) {
-        return std::make_unique<LIRBranch>(std::vector<LIROperand>{}, std::vector{target});
+    static auto jmp(LIRBlock *target) {
+        return construct<LIRBranch>(std::vector<LIROperand>{}, std::vector{target});
     }
 };
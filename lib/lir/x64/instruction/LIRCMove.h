@@ -14,10 +14,10 @@ public:
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRCMove> cmov(aasm::CondType cond_type, const LIROperand &src, const LIROperand &dest) {
-        auto cmov = std::make_unique<LIRCMove>(cond_type, std::vector{src, dest});
-        cmov->add_def(LIRVal::reg(src.size(), src.align(), 0, cmov.get()));
-        return cmov;
+    static auto cmov(aasm::CondType cond_type, const LIROperand &src, const LIROperand &dest) {
+        return construct<LIRCMove>(cond_type, std::vector{src, dest}).then([size = src.size(), align = src.align()](LIRCMove* cmov) {
+            cmov->add_def(LIRVal::reg(size, align, 0, cmov));
+        });
     }
 
 private:
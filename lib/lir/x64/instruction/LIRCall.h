@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 
 #include "LIRDef.h"
 #include "LIRUse.h"
@@ -33,27 +33,55 @@ public:
         return m_name;
     }
 
+    /**
+     * Returns the call arguments. The callee address of an indirect call is not an argument.
+     */
     [[nodiscard]]
-    static std::unique_ptr<LIRCall> call(std::string&& name, const LIRValType ty, const std::uint8_t size, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
+    std::span<LIROperand const> arguments() const noexcept {
+        switch (m_kind) {
+            case LIRCallKind::ICall: [[fallthrough]];
+            case LIRCallKind::IVCall: return inputs().subspan(1);
+            default: return inputs();
+        }
+    }
+
+    [[nodiscard]]
+    static auto call(std::string&& name, const LIRValType ty, const std::uint8_t size, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
         InplaceVec<LIRValType, 2> types{ty};
-        auto call = std::make_unique<LIRCall>(std::move(name), types, LIRCallKind::Call, std::move(args), cont, bind);
-        call->add_def(LIRVal::reg(size, size, 0, call.get()));
-        return call;
+        return construct<LIRCall>(std::move(name), types, LIRCallKind::Call, std::move(args), cont, bind).then([=](LIRCall* call) {
+            call->add_def(LIRVal::reg(size, size, 0, call));
+        });
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRCall> tuple_call(std::string&& name, const LIRValType ty1, const LIRValType ty2, const std::size_t size1, const std::size_t size2, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
+    static auto tuple_call(std::string&& name, const LIRValType ty1, const LIRValType ty2, const std::size_t size1, const std::size_t size2, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
         InplaceVec<LIRValType, 2> types{ty1, ty2};
-        auto call = std::make_unique<LIRCall>(std::move(name), types, LIRCallKind::Call, std::move(args), cont, bind);
-        call->add_def(LIRVal::reg(size1, size2, 0, call.get()));
-        call->add_def(LIRVal::reg(size1, size2, 1, call.get()));
-        return call;
+        return construct<LIRCall>(std::move(name), types, LIRCallKind::Call, std::move(args), cont, bind).then([=](LIRCall* call) {
+            call->add_def(LIRVal::reg(size1, size2, 0, call));
+            call->add_def(LIRVal::reg(size1, size2, 1, call));
+        });
+    }
+
+    [[nodiscard]]
+    static auto vcall(std::string&& name, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
+        const InplaceVec<LIRValType, 2> types{LIRValType::GP};
+        return construct<LIRCall>(std::move(name), types, LIRCallKind::VCall, std::move(args), cont, bind);
+    }
+
+    [[nodiscard]]
+    static auto icall(const LIRValType ty, const std::uint8_t size, LIRBlock* cont, const LIROperand& pointer, std::vector<LIROperand>&& args) {
+        InplaceVec<LIRValType, 2> types{ty};
+        args.insert(args.begin(), pointer);
+        return construct<LIRCall>(std::string{}, types, LIRCallKind::ICall, std::move(args), cont, FunctionBind::DEFAULT).then([=](LIRCall* call) {
+            call->add_def(LIRVal::reg(size, size, 0, call));
+        });
     }
 
     [[nodiscard]]
-    static std::unique_ptr<LIRCall> vcall(std::string&& name, LIRBlock* cont, std::vector<LIROperand>&& args, FunctionBind bind) {
+    static auto ivcall(LIRBlock* cont, const LIROperand& pointer, std::vector<LIROperand>&& args) {
         const InplaceVec<LIRValType, 2> types{LIRValType::GP};
-        return std::make_unique<LIRCall>(std::move(name), types, LIRCallKind::VCall, std::move(args), cont, bind);
+        args.insert(args.begin(), pointer);
+        return construct<LIRCall>(std::string{}, types, LIRCallKind::IVCall, std::move(args), cont, FunctionBind::DEFAULT);
     }
 
 private:
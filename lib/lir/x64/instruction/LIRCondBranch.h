@@ -13,8 +13,8 @@ public:
         visitor.jcc(m_kind, succ(0), succ(1));
     }
 
-    static std::unique_ptr<LIRCondBranch> jcc(const aasm::CondType kind, LIRBlock *on_true, LIRBlock *on_false) {
-        return std::make_unique<LIRCondBranch>(kind, std::vector<LIROperand>{}, std::vector{on_true, on_false});
+    static auto jcc(const aasm::CondType kind, LIRBlock *on_true, LIRBlock *on_false) {
+        return construct<LIRCondBranch>(kind, std::vector<LIROperand>{}, std::vector{on_true, on_false});
     }
 
 private:
@@ -11,8 +11,8 @@ public:
 
     void visit(LIRVisitor &visitor) override;
 
-    static std::unique_ptr<LIRFCmp> cmp(const FcmpOrdering cmp_type, const LIROperand &lhs, const LIROperand &rhs) {
-        return std::make_unique<LIRFCmp>(cmp_type, std::vector{lhs, rhs});
+    static auto cmp(const FcmpOrdering cmp_type, const LIROperand &lhs, const LIROperand &rhs) {
+        return construct<LIRFCmp>(cmp_type, std::vector{lhs, rhs});
     }
 
 private:
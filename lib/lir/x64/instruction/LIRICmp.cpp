@@ -1,5 +1,11 @@
 #include "LIRICmp.h"
 
 void LIRICmp::visit(LIRVisitor &visitor) {
-    visitor.cmp_i(in(0), in(1));
-}
\ No newline at end of file
+    if (inputs().size() == 2) {
+        visitor.cmp_i(in(0), in(1));
+        return;
+    }
+
+    const auto disp = static_cast<std::int32_t>(in(2).as_cst().value().value());
+    visitor.cmp_by_idx_i(in(0), in(1), disp, in(3));
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 
 #include "LIRInstructionBase.h"
 
@@ -12,7 +12,15 @@ public:
     void visit(LIRVisitor &visitor) override;
 
     [[nodiscard]]
-    static std::unique_ptr<LIRICmp> cmp(const LIROperand &lhs, const LIROperand &rhs) {
-        return std::make_unique<LIRICmp>(std::vector{lhs, rhs});
+    static auto cmp(const LIROperand &lhs, const LIROperand &rhs) {
+        return construct<LIRICmp>(std::vector{lhs, rhs});
+    }
+
+    /**
+     * Compares [pointer + index * rhs.size() + disp] with rhs, the load of the left operand is folded into the memory operand.
+     */
+    [[nodiscard]]
+    static auto cmp_by_idx(const LIROperand &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &rhs) {
+        return construct<LIRICmp>(std::vector<LIROperand>{pointer, index, LirCst::imm32(disp), rhs});
     }
 };
@@ -13,9 +13,10 @@ void LIRInstruction::visit(LIRVisitor &visitor) {
         case LIRInstKind::MovByIdx: {
             const auto inout = LIRVal::try_from(in(0));
             assertion(inout.has_value(), "invariant");
+            const auto disp = static_cast<std::int32_t>(in(3).as_cst().value().value());
             switch (m_val_type) {
-                case LIRValType::GP: visitor.mov_by_idx_i(inout.value(), in(1), in(2)); break;
-                case LIRValType::FP: visitor.mov_by_idx_f(inout.value(), in(1), in(2)); break;
+                case LIRValType::GP: visitor.mov_by_idx_i(inout.value(), in(1), disp, in(2)); break;
+                case LIRValType::FP: visitor.mov_by_idx_f(inout.value(), in(1), disp, in(2)); break;
                 default: std::unreachable();
             }
             break;
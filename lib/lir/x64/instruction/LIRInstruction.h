@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 #include "LIRInstructionBase.h"
 
 
@@ -20,20 +20,23 @@ public:
 
     void visit(LIRVisitor &visitor) override;
 
-    static std::unique_ptr<LIRInstruction> mov(const LIRValType val_type, const LIROperand& dst, const LIROperand& src) {
-        return std::make_unique<LIRInstruction>(LIRInstKind::Mov, val_type, std::vector{dst, src});
+    static auto mov(const LIRValType val_type, const LIROperand& dst, const LIROperand& src) {
+        return construct<LIRInstruction>(LIRInstKind::Mov, val_type, std::vector{dst, src});
     }
 
-    static std::unique_ptr<LIRInstruction> mov_by_idx(const LIRValType val_type, const LIRVal& dst, const LIROperand& index, const LIROperand& src) {
-        return std::make_unique<LIRInstruction>(LIRInstKind::MovByIdx, val_type, std::vector<LIROperand>{dst, index, src});
+    /**
+     * Stores to [dst + index * src.size() + disp].
+     */
+    static auto mov_by_idx(const LIRValType val_type, const LIRVal& dst, const LIROperand& index, const LIROperand& src, const std::int32_t disp = 0) {
+        return construct<LIRInstruction>(LIRInstKind::MovByIdx, val_type, std::vector<LIROperand>{dst, index, src, LirCst::imm32(disp)});
     }
 
-    static std::unique_ptr<LIRInstruction> store(const LIRValType val_type, const LIRVal& dst, const LIROperand& src) {
-        return std::make_unique<LIRInstruction>(LIRInstKind::Store, val_type, std::vector<LIROperand>{dst, src});
+    static auto store(const LIRValType val_type, const LIRVal& dst, const LIROperand& src) {
+        return construct<LIRInstruction>(LIRInstKind::Store, val_type, std::vector<LIROperand>{dst, src});
     }
 
-    static std::unique_ptr<LIRInstruction> store_by_offset(const LIRValType val_type, const LIROperand& pointer, const LIROperand& index, const LIROperand& value) {
-        return std::make_unique<LIRInstruction>(LIRInstKind::StoreByOffset, val_type, std::vector{pointer, index, value});
+    static auto store_by_offset(const LIRValType val_type, const LIROperand& pointer, const LIROperand& index, const LIROperand& value) {
+        return construct<LIRInstruction>(LIRInstKind::StoreByOffset, val_type, std::vector{pointer, index, value});
     }
 
 private:
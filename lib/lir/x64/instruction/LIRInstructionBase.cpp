@@ -7,6 +7,7 @@
 #include "asm/x64/CondType.h"
 #include "asm/x64/reg/AnyRegSet.h"
 #include "lir/x64/asm/FcmpOrdering.h"
+#include "lir/x64/asm/VecLane.h"
 
 namespace {
     class LIRInstructionPrinter final: public LIRVisitor {
@@ -115,6 +116,10 @@ namespace {
             m_os << "cmp_i in1(" << in1 << ") in2(" << in2 << ')';
         }
 
+        void cmp_by_idx_i(const LIROperand &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) override {
+            m_os << "cmp_by_idx_i pointer(" << pointer << ") index(" << index << ") disp(" << disp << ") in(" << in << ')';
+        }
+
         void neg_i(const LIRVal &out, const LIROperand &in) override {
             unimplemented();
         }
@@ -127,8 +132,8 @@ namespace {
             m_os << "mov_i in(" << in0 << ") in(" << in << ')';
         }
 
-        void mov_by_idx_i(const LIRVal &pointer, const LIROperand &index, const LIROperand &in) override {
-            m_os << "mov_by_idx_i pointer(" << pointer << ") index(" << index << ") in(" << in << ')';
+        void mov_by_idx_i(const LIRVal &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) override {
+            m_os << "mov_by_idx_i pointer(" << pointer << ") index(" << index << ") disp(" << disp << ") in(" << in << ')';
         }
 
         void store_by_offset_i(const LIROperand &pointer, const LIROperand &index, const LIROperand &value) override {
@@ -172,8 +177,32 @@ namespace {
             m_os << "load_i out(" << out << ") pointer(" << pointer << ')';
         }
 
-        void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) override {
-            m_os << "load_by_idx_i out(" << out << ") index(" << index << ") pointer(" << pointer << ')';
+        void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            m_os << "load_by_idx_i out(" << out << ") index(" << index << ") pointer(" << pointer << ") disp(" << disp << ')';
+        }
+
+        void print_binary_by_idx(const std::string_view name, const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) const {
+            m_os << name << " out(" << out << ") in1(" << in1 << ") pointer(" << pointer << ") index(" << index << ") disp(" << disp << ')';
+        }
+
+        void add_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            print_binary_by_idx("add_by_idx_i", out, in1, pointer, index, disp);
+        }
+
+        void sub_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            print_binary_by_idx("sub_by_idx_i", out, in1, pointer, index, disp);
+        }
+
+        void and_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            print_binary_by_idx("and_by_idx_i", out, in1, pointer, index, disp);
+        }
+
+        void or_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            print_binary_by_idx("or_by_idx_i", out, in1, pointer, index, disp);
+        }
+
+        void xor_by_idx_i(const LIRVal &out, const LIROperand &in1, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            print_binary_by_idx("xor_by_idx_i", out, in1, pointer, index, disp);
         }
 
         void read_by_offset_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) override {
@@ -200,12 +229,12 @@ namespace {
             m_os << "cmp_f " << to_string(ord) << " in(" << in1 << ") in(" << in2 << ')';
         }
 
-        void mov_by_idx_f(const LIRVal &pointer, const LIROperand &index, const LIROperand &in) override {
-            m_os << "mov_by_idx_f pointer(" << pointer << ") index(" << index << ") in(" << in << ')';
+        void mov_by_idx_f(const LIRVal &pointer, const LIROperand &index, const std::int32_t disp, const LIROperand &in) override {
+            m_os << "mov_by_idx_f pointer(" << pointer << ") index(" << index << ") disp(" << disp << ") in(" << in << ')';
         }
 
-        void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) override {
-            m_os << "load_by_idx_f out(" << out << ") index(" << index << ") pointer(" << pointer << ')';
+        void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) override {
+            m_os << "load_by_idx_f out(" << out << ") index(" << index << ") pointer(" << pointer << ") disp(" << disp << ')';
         }
 
         void store_by_offset_f(const LIROperand &pointer, const LIROperand &index, const LIROperand &value) override {
@@ -240,6 +269,38 @@ namespace {
             m_os << "add_f out(" << out << ") in(" << in1 << ", " << in2 << ')';
         }
 
+        void vadd(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vadd " << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vsub(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vsub " << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vmul(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vmul " << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vdiv(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vdiv " << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vcmp(const VecLane lane, const VecPredicate predicate, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vcmp " << to_string(predicate) << ' ' << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vxor(const VecLane lane, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vxor " << to_string(lane) << " out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vshuffle(const VecLane lane, const std::uint8_t control, const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {
+            m_os << "vshuffle " << to_string(lane) << " control(" << static_cast<unsigned>(control) << ") out(" << out << ") in(" << in1 << ", " << in2 << ')';
+        }
+
+        void vbroadcast(const VecLane lane, const LIRVal &out, const LIROperand &in) override {
+            m_os << "vbroadcast " << to_string(lane) << " out(" << out << ") in(" << in << ')';
+        }
+
         void jmp(const LIRBlock *bb) override {
             m_os << "jmp ";
             bb->print_short_name(m_os);
@@ -3,6 +3,7 @@
 #include <iosfwd>
 
 #include "base/CommonInstruction.h"
+#include "utility/Arena.h"
 #include "lir/x64/asm/TemporalRegs.h"
 #include "lir/x64/operand/LIROperand.h"
 #include "lir/x64/instruction/LIRVisitor.h"
@@ -43,9 +43,26 @@ void LIRProducerInstruction::visit(LIRVisitor &visitor) {
             break;
         }
         case LIRProdInstKind::LoadByIdx: {
+            const auto disp = static_cast<std::int32_t>(in(2).as_cst().value().value());
             switch (type(0)) {
-                case LIRValType::GP: visitor.load_by_idx_i(def(0), in(0), in(1)); break;
-                case LIRValType::FP: visitor.load_by_idx_f(def(0), in(0), in(1)); break;
+                case LIRValType::GP: visitor.load_by_idx_i(def(0), in(0), in(1), disp); break;
+                case LIRValType::FP: visitor.load_by_idx_f(def(0), in(0), in(1), disp); break;
+                default: std::unreachable();
+            }
+            break;
+        }
+        case LIRProdInstKind::AddByIdx: [[fallthrough]];
+        case LIRProdInstKind::SubByIdx: [[fallthrough]];
+        case LIRProdInstKind::AndByIdx: [[fallthrough]];
+        case LIRProdInstKind::OrByIdx: [[fallthrough]];
+        case LIRProdInstKind::XorByIdx: {
+            const auto disp = static_cast<std::int32_t>(in(3).as_cst().value().value());
+            switch (m_kind) {
+                case LIRProdInstKind::AddByIdx: visitor.add_by_idx_i(def(0), in(0), in(1), in(2), disp); break;
+                case LIRProdInstKind::SubByIdx: visitor.sub_by_idx_i(def(0), in(0), in(1), in(2), disp); break;
+                case LIRProdInstKind::AndByIdx: visitor.and_by_idx_i(def(0), in(0), in(1), in(2), disp); break;
+                case LIRProdInstKind::OrByIdx:  visitor.or_by_idx_i(def(0), in(0), in(1), in(2), disp); break;
+                case LIRProdInstKind::XorByIdx: visitor.xor_by_idx_i(def(0), in(0), in(1), in(2), disp); break;
                 default: std::unreachable();
             }
             break;
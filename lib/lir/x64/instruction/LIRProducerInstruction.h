@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 
 #include "base/Constant.h"
 #include "lir/x64/instruction/LIRProducerInstructionBase.h"
@@ -24,6 +24,11 @@ enum class LIRProdInstKind: std::uint8_t {
     Copy,
     Load,
     LoadByIdx,
+    AddByIdx,
+    SubByIdx,
+    AndByIdx,
+    OrByIdx,
+    XorByIdx,
     ReadByOffset,
     Lea,
     Movz,
@@ -35,6 +40,14 @@ enum class LIRProdInstKind: std::uint8_t {
 };
 
 class LIRProducerInstruction final: public LIRProducerInstructionBase {
+    // Goes ahead of the factories: they deduce their return types from it.
+    template<typename... Args>
+    static auto create(LIRProdInstKind kind, const LIRValType type, const std::size_t size, const std::size_t align, Args&&... args) {
+        return construct<LIRProducerInstruction>(kind, type, std::vector{std::forward<Args>(args)...}).then([=](LIRProducerInstruction* prod) {
+            prod->add_def(LIRVal::reg(size, align, 0, prod));
+        });
+    }
+
 public:
     explicit LIRProducerInstruction(const LIRProdInstKind kind, const LIRValType type, std::vector<LIROperand>&& uses) noexcept:
         LIRProducerInstructionBase({type}, std::move(uses)),
@@ -42,113 +55,139 @@ public:
 
     void visit(LIRVisitor &visitor) override;
 
-    static std::unique_ptr<LIRProducerInstruction> copy(const std::uint8_t size, const LIRValType ty, const LIROperand &op)  {
+    static auto copy(const std::uint8_t size, const LIRValType ty, const LIROperand &op)  {
         return create(LIRProdInstKind::Copy, ty, size, size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> copy(const std::uint8_t size, const LIRValType ty, const LIROperand &op, const AssignedVReg& fixed_reg)  {
-        auto prod = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::Copy, ty, std::vector{op});
-        prod->add_def(LIRVal::reg(size, size, 0, prod.get()));
-        prod->assign_reg(0, fixed_reg);
-        return prod;
+    static auto copy(const std::uint8_t size, const LIRValType ty, const LIROperand &op, const AssignedVReg& fixed_reg)  {
+        return construct<LIRProducerInstruction>(LIRProdInstKind::Copy, ty, std::vector{op}).then([=](LIRProducerInstruction* prod) {
+            prod->add_def(LIRVal::reg(size, size, 0, prod));
+            prod->assign_reg(0, fixed_reg);
+        });
     }
 
-    static std::unique_ptr<LIRProducerInstruction> add(const LIRValType type, const LIROperand &lhs, const LIROperand &rhs) {
+    static auto add(const LIRValType type, const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Add, type, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> sub(const LIRValType type, const LIROperand &lhs, const LIROperand &rhs) {
+    static auto sub(const LIRValType type, const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Sub, type, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> sal(const LIROperand &lhs, const LIROperand &rhs) {
+    static auto mul(const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRProdInstKind::Mul, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
+    }
+
+    static auto sal(const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Sal, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> sar(const LIROperand &lhs, const LIROperand &rhs) {
+    static auto sar(const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Sar, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> shr(const LIROperand &lhs, const LIROperand &rhs) {
+    static auto shr(const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Shr, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> xxor(const LIROperand &lhs, const LIROperand &rhs) {
+    static auto aand(const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRProdInstKind::And, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
+    }
+
+    static auto oor(const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRProdInstKind::Or, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
+    }
+
+    static auto xxor(const LIROperand &lhs, const LIROperand &rhs) {
         return create(LIRProdInstKind::Xor, LIRValType::GP, lhs.size(), lhs.size(), lhs, rhs);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> idiv(const LIROperand &lhs, const LIROperand &rhs) {
-        auto idiv = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::DivI, LIRValType::GP, std::vector{lhs, rhs});
-        idiv->add_def(LIRVal::reg(lhs.size(), lhs.align(), 0, idiv.get()));
-        idiv->add_def(LIRVal::reg(lhs.size(), lhs.align(), 1, idiv.get()));
-        return idiv;
+    static auto neg(const LIROperand &op) {
+        return create(LIRProdInstKind::Neg, LIRValType::GP, op.size(), op.size(), op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> udiv(const LIROperand &lhs, const LIROperand &rhs) {
-        auto udiv = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::DivU, LIRValType::GP, std::vector{lhs, rhs});
-        udiv->add_def(LIRVal::reg(lhs.size(), lhs.align(), 0, udiv.get()));
-        udiv->add_def(LIRVal::reg(lhs.size(), lhs.align(), 1, udiv.get()));
-        return udiv;
+    static auto nnot(const LIROperand &op) {
+        return create(LIRProdInstKind::Not, LIRValType::GP, op.size(), op.size(), op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> fdiv(const LIROperand &lhs, const LIROperand &rhs) {
-        auto idiv = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::DivF, LIRValType::FP, std::vector{lhs, rhs});
-        idiv->add_def(LIRVal::reg(lhs.size(), lhs.align(), 0, idiv.get()));
-        return idiv;
+    static auto idiv(const LIROperand &lhs, const LIROperand &rhs) {
+        return construct<LIRProducerInstruction>(LIRProdInstKind::DivI, LIRValType::GP, std::vector{lhs, rhs}).then([size = lhs.size(), align = lhs.align()](LIRProducerInstruction* idiv) {
+            idiv->add_def(LIRVal::reg(size, align, 0, idiv));
+            idiv->add_def(LIRVal::reg(size, align, 1, idiv));
+        });
     }
 
-    static std::unique_ptr<LIRProducerInstruction> gen(const std::uint8_t size, const std::uint8_t align) {
-        auto gen = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::Gen, LIRValType::GP, std::vector<LIROperand>{});
-        gen->add_def(LIRVal::reg(size, align, 0, gen.get()));
-        return gen;
+    static auto udiv(const LIROperand &lhs, const LIROperand &rhs) {
+        return construct<LIRProducerInstruction>(LIRProdInstKind::DivU, LIRValType::GP, std::vector{lhs, rhs}).then([size = lhs.size(), align = lhs.align()](LIRProducerInstruction* udiv) {
+            udiv->add_def(LIRVal::reg(size, align, 0, udiv));
+            udiv->add_def(LIRVal::reg(size, align, 1, udiv));
+        });
     }
 
-    static std::unique_ptr<LIRProducerInstruction> load(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &op) {
+    static auto fdiv(const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRProdInstKind::DivF, LIRValType::FP, lhs.size(), lhs.align(), lhs, rhs);
+    }
+
+    static auto gen(const std::uint8_t size, const std::uint8_t align) {
+        return construct<LIRProducerInstruction>(LIRProdInstKind::Gen, LIRValType::GP, std::vector<LIROperand>{}).then([=](LIRProducerInstruction* gen) {
+            gen->add_def(LIRVal::reg(size, align, 0, gen));
+        });
+    }
+
+    static auto load(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &op) {
         return create(LIRProdInstKind::Load, type, loaded_ty_size, loaded_ty_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> load_by_idx(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &pointer, const LIROperand &index) {
-        return create(LIRProdInstKind::LoadByIdx, type, loaded_ty_size, loaded_ty_size, pointer, index);
+    /**
+     * Loads from [pointer + index * loaded_ty_size + disp].
+     */
+    static auto load_by_idx(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp = 0) {
+        return create(LIRProdInstKind::LoadByIdx, type, loaded_ty_size, loaded_ty_size, pointer, index, LIROperand(LirCst::imm32(disp)));
     }
 
-    static std::unique_ptr<LIRProducerInstruction> read_by_offset(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &pointer, const LIROperand &index) {
+    /**
+     * Computes 'lhs op [pointer + index * lhs.size() + disp]', the load is folded into the memory operand.
+     * The kind is one of AddByIdx, SubByIdx, AndByIdx, OrByIdx and XorByIdx.
+     */
+    static auto binary_by_idx(const LIRProdInstKind kind, const LIROperand &lhs, const LIROperand &pointer, const LIROperand &index, const std::int32_t disp) {
+        return create(kind, LIRValType::GP, lhs.size(), lhs.size(), lhs, pointer, index, LIROperand(LirCst::imm32(disp)));
+    }
+
+    static auto read_by_offset(const LIRValType type, const std::uint8_t loaded_ty_size, const LIROperand &pointer, const LIROperand &index) {
         return create(LIRProdInstKind::ReadByOffset, type, loaded_ty_size, loaded_ty_size, pointer, index);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> lea(const std::uint8_t size, const LIROperand &pointer, const LIROperand &index) {
-        auto lea = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::Lea, LIRValType::GP, std::vector{pointer, index});
-        lea->add_def(LIRVal::reg(size, cst::POINTER_SIZE, 0, lea.get()));
-        return lea;
+    static auto lea(const std::uint8_t size, const LIROperand &pointer, const LIROperand &index) {
+        return create(LIRProdInstKind::Lea, LIRValType::GP, size, cst::POINTER_SIZE, pointer, index);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> lea(const std::uint8_t size, const LIROperand &pointer, const LIROperand &index, const aasm::GPReg fixed_reg) {
-        auto lea = std::make_unique<LIRProducerInstruction>(LIRProdInstKind::Lea, LIRValType::GP, std::vector{pointer, index});
-        lea->add_def(LIRVal::reg(size, cst::POINTER_SIZE, 0, lea.get()));
-        lea->assign_reg(0, fixed_reg);
-        return lea;
+    static auto lea(const std::uint8_t size, const LIROperand &pointer, const LIROperand &index, const aasm::GPReg fixed_reg) {
+        return create(LIRProdInstKind::Lea, LIRValType::GP, size, cst::POINTER_SIZE, pointer, index).then([=](LIRProducerInstruction* lea) {
+            lea->assign_reg(0, fixed_reg);
+        });
     }
 
-    static std::unique_ptr<LIRProducerInstruction> movzx(const std::uint8_t to_size, const LIROperand &op) {
+    static auto movzx(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::Movz, LIRValType::GP, to_size, to_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> movsx(const std::uint8_t to_size, const LIROperand &op) {
+    static auto movsx(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::Movs, LIRValType::GP, to_size, to_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> trunc(const std::uint8_t to_size, const LIROperand &op) {
+    static auto trunc(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::Trunc, LIRValType::GP, to_size, to_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> cvtfp2int(const std::uint8_t to_size, const LIROperand &op) {
+    static auto cvtfp2int(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::CvtFp2Int, LIRValType::FP, to_size, to_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> cvtint2fp(const std::uint8_t to_size, const LIROperand &op) {
+    static auto cvtint2fp(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::CvtInt2Fp, LIRValType::FP, to_size, to_size, op);
     }
 
-    static std::unique_ptr<LIRProducerInstruction> cvtuint2fp(const std::uint8_t to_size, const LIROperand &op) {
+    static auto cvtuint2fp(const std::uint8_t to_size, const LIROperand &op) {
         return create(LIRProdInstKind::CvtUInt2Fp, LIRValType::FP, to_size, to_size, op);
     }
 
@@ -158,12 +197,5 @@ public:
     }
 
 private:
-    template<typename... Args>
-    static std::unique_ptr<LIRProducerInstruction> create(LIRProdInstKind kind, const LIRValType type, const std::size_t size, const std::size_t align, Args&&... args) {
-        auto prod = std::make_unique<LIRProducerInstruction>(kind, type, std::vector{std::forward<Args>(args)...});
-        prod->add_def(LIRVal::reg(size, align, 0, prod.get()));
-        return prod;
-    }
-
     const LIRProdInstKind m_kind;
 };
\ No newline at end of file
@@ -13,15 +13,15 @@ public:
         visitor.ret(ret_values);
     }
 
-    static std::unique_ptr<LIRReturn> ret(const LIROperand& value) {
-        return std::make_unique<LIRReturn>(std::vector{value});
+    static auto ret(const LIROperand& value) {
+        return construct<LIRReturn>(std::vector{value});
     }
 
-    static std::unique_ptr<LIRReturn> ret(const LIROperand& first, const LIROperand& second) {
-        return std::make_unique<LIRReturn>(std::vector{first, second});
+    static auto ret(const LIROperand& first, const LIROperand& second) {
+        return construct<LIRReturn>(std::vector{first, second});
     }
 
-    static std::unique_ptr<LIRReturn> ret() {
-        return std::make_unique<LIRReturn>(std::vector<LIROperand>{});
+    static auto ret() {
+        return construct<LIRReturn>(std::vector<LIROperand>{});
     }
 };
@@ -13,10 +13,10 @@ public:
         visitor.setcc_i(def(0), m_cond_type);
     }
 
-    static std::unique_ptr<LIRSetCC> setcc(aasm::CondType cond_type) {
-        auto setcc = std::make_unique<LIRSetCC>(cond_type);
-        setcc->add_def(LIRVal::reg(cst::BYTE_SIZE, cst::BYTE_SIZE, 0, setcc.get()));
-        return setcc;
+    static auto setcc(aasm::CondType cond_type) {
+        return construct<LIRSetCC>(cond_type).then([](LIRSetCC* setcc) {
+            setcc->add_def(LIRVal::reg(cst::BYTE_SIZE, cst::BYTE_SIZE, 0, setcc));
+        });
     }
 
 private:
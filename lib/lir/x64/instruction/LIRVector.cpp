@@ -0,0 +1,15 @@
+#include "LIRVector.h"
+
+void LIRVector::visit(LIRVisitor &visitor) {
+    switch (m_kind) {
+        case LIRVecKind::Add: visitor.vadd(m_lane, def(0), in(0), in(1)); break;
+        case LIRVecKind::Sub: visitor.vsub(m_lane, def(0), in(0), in(1)); break;
+        case LIRVecKind::Mul: visitor.vmul(m_lane, def(0), in(0), in(1)); break;
+        case LIRVecKind::Div: visitor.vdiv(m_lane, def(0), in(0), in(1)); break;
+        case LIRVecKind::Cmp: visitor.vcmp(m_lane, m_predicate, def(0), in(0), in(1)); break;
+        case LIRVecKind::Xor: visitor.vxor(m_lane, def(0), in(0), in(1)); break;
+        case LIRVecKind::Shuffle: visitor.vshuffle(m_lane, m_control, def(0), in(0), in(1)); break;
+        case LIRVecKind::Broadcast: visitor.vbroadcast(m_lane, def(0), in(0)); break;
+        default: std::unreachable();
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "utility/Arena.h"
+
+#include "lir/x64/instruction/LIRProducerInstructionBase.h"
+#include "lir/x64/asm/VecLane.h"
+
+enum class LIRVecKind: std::uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Cmp,
+    Xor,
+    Shuffle,
+    Broadcast,
+};
+
+/**
+ * Lane-wise operation over packed vectors held in xmm/ymm registers.
+ * The size of the result selects 128 or 256 bit registers.
+ */
+class LIRVector final: public LIRProducerInstructionBase {
+    // Goes ahead of the factories: they deduce their return types from it.
+    template<typename... Args>
+    static auto create(const LIRVecKind kind, const VecLane lane, const std::size_t size, Args&&... args) {
+        return construct<LIRVector>(kind, lane, std::vector{std::forward<Args>(args)...}).then([=](LIRVector* vec) {
+            vec->add_def(LIRVal::reg(size, size, 0, vec));
+        });
+    }
+
+public:
+    explicit LIRVector(const LIRVecKind kind, const VecLane lane, std::vector<LIROperand>&& uses) noexcept:
+        LIRProducerInstructionBase({LIRValType::FP}, std::move(uses)),
+        m_kind(kind),
+        m_lane(lane) {}
+
+    void visit(LIRVisitor &visitor) override;
+
+    static auto add(const VecLane lane, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Add, lane, lhs.size(), lhs, rhs);
+    }
+
+    static auto sub(const VecLane lane, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Sub, lane, lhs.size(), lhs, rhs);
+    }
+
+    static auto mul(const VecLane lane, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Mul, lane, lhs.size(), lhs, rhs);
+    }
+
+    static auto div(const VecLane lane, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Div, lane, lhs.size(), lhs, rhs);
+    }
+
+    /**
+     * Sets every bit of the lane where the predicate holds, clears it otherwise.
+     */
+    static auto cmp(const VecLane lane, const VecPredicate predicate, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Cmp, lane, lhs.size(), lhs, rhs).then([=](LIRVector* cmp) {
+            cmp->m_predicate = predicate;
+        });
+    }
+
+    static auto xxor(const VecLane lane, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Xor, lane, lhs.size(), lhs, rhs);
+    }
+
+    /**
+     * Selects the two low lanes of each 128 bit half from lhs and the two high lanes from rhs by the control byte.
+     */
+    static auto shuffle(const VecLane lane, const std::uint8_t control, const LIROperand &lhs, const LIROperand &rhs) {
+        return create(LIRVecKind::Shuffle, lane, lhs.size(), lhs, rhs).then([=](LIRVector* shuffle) {
+            shuffle->m_control = control;
+        });
+    }
+
+    static auto broadcast(const VecLane lane, const std::uint8_t size, const LIROperand &scalar) {
+        return create(LIRVecKind::Broadcast, lane, size, scalar);
+    }
+
+    [[nodiscard]]
+    LIRVecKind kind() const noexcept {
+        return m_kind;
+    }
+
+    [[nodiscard]]
+    VecLane lane() const noexcept {
+        return m_lane;
+    }
+
+private:
+    const LIRVecKind m_kind;
+    const VecLane m_lane;
+    VecPredicate m_predicate{VecPredicate::EQ};
+    std::uint8_t m_control{};
+};
@@ -28,11 +28,12 @@ public:
     virtual void trunc_i(const LIRVal& out, const LIROperand& in) = 0;
 
     virtual void cmp_i(const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void cmp_by_idx_i(const LIROperand& pointer, const LIROperand& index, std::int32_t disp, const LIROperand& in) = 0;
     virtual void neg_i(const LIRVal& out, const LIROperand& in) = 0;
     virtual void not_i(const LIRVal& out, const LIROperand& in) = 0;
 
     virtual void mov_i(const LIROperand& in1, const LIROperand& in2) = 0;
-    virtual void mov_by_idx_i(const LIRVal& pointer, const LIROperand& index, const LIROperand& in) = 0;
+    virtual void mov_by_idx_i(const LIRVal& pointer, const LIROperand& index, std::int32_t disp, const LIROperand& in) = 0;
     virtual void store_by_offset_i(const LIROperand& pointer, const LIROperand& index, const LIROperand& value) = 0;
     virtual void store_i(const LIRVal& pointer, const LIROperand& value) = 0;
     virtual void up_stack(const aasm::RegSet& reg_set, std::size_t caller_overflow_area_size, std::size_t local_area_size) = 0;
@@ -42,7 +43,12 @@ public:
 
     virtual void copy_i(const LIRVal& out, const LIROperand& in) = 0;
     virtual void load_i(const LIRVal& out, const LIRVal& pointer) = 0;
-    virtual void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) = 0;
+    virtual void load_by_idx_i(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, std::int32_t disp) = 0;
+    virtual void add_by_idx_i(const LIRVal& out, const LIROperand& in1, const LIROperand& pointer, const LIROperand& index, std::int32_t disp) = 0;
+    virtual void sub_by_idx_i(const LIRVal& out, const LIROperand& in1, const LIROperand& pointer, const LIROperand& index, std::int32_t disp) = 0;
+    virtual void and_by_idx_i(const LIRVal& out, const LIROperand& in1, const LIROperand& pointer, const LIROperand& index, std::int32_t disp) = 0;
+    virtual void or_by_idx_i(const LIRVal& out, const LIROperand& in1, const LIROperand& pointer, const LIROperand& index, std::int32_t disp) = 0;
+    virtual void xor_by_idx_i(const LIRVal& out, const LIROperand& in1, const LIROperand& pointer, const LIROperand& index, std::int32_t disp) = 0;
     virtual void read_by_offset_i(const LIRVal& out, const LIROperand& pointer, const LIROperand& index) = 0;
     virtual void lea_i(const LIRVal& out, const LIROperand& pointer, const LIROperand& index) = 0;
 
@@ -51,8 +57,8 @@ public:
     virtual void load_f(const LIRVal& out, const LIRVal& pointer) = 0;
     virtual void mov_f(const LIROperand& in1, const LIROperand& in2) = 0;
     virtual void cmp_f(FcmpOrdering ord, const LIROperand& in1, const LIROperand& in2) = 0;
-    virtual void mov_by_idx_f(const LIRVal& pointer, const LIROperand& index, const LIROperand& in) = 0;
-    virtual void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index) = 0;
+    virtual void mov_by_idx_f(const LIRVal& pointer, const LIROperand& index, std::int32_t disp, const LIROperand& in) = 0;
+    virtual void load_by_idx_f(const LIRVal &out, const LIROperand &pointer, const LIROperand &index, std::int32_t disp) = 0;
     virtual void store_by_offset_f(const LIROperand& pointer, const LIROperand& index, const LIROperand& value) = 0;
     virtual void store_f(const LIRVal& pointer, const LIROperand& value) = 0;
     virtual void add_f(const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
@@ -62,6 +68,16 @@ public:
     virtual void cvtint2fp(const LIRVal& out, const LIROperand& in) = 0;
     virtual void cvtuint2fp(const LIRVal& out, const LIROperand& in) = 0;
 
+    // Packed vector instructions
+    virtual void vadd(VecLane lane, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vsub(VecLane lane, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vmul(VecLane lane, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vdiv(VecLane lane, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vcmp(VecLane lane, VecPredicate predicate, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vxor(VecLane lane, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vshuffle(VecLane lane, std::uint8_t control, const LIRVal& out, const LIROperand& in1, const LIROperand& in2) = 0;
+    virtual void vbroadcast(VecLane lane, const LIRVal& out, const LIROperand& in) = 0;
+
     virtual void jmp(const LIRBlock* bb) = 0;
     virtual void jcc(aasm::CondType cond_type, const LIRBlock* on_true, const LIRBlock* on_false) = 0;
 
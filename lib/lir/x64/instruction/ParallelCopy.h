@@ -20,11 +20,28 @@ public:
         return m_blocks;
     }
 
-    static std::unique_ptr<ParallelCopy> copy(const LIRValType ty, std::vector<LIROperand> &&uses, std::vector<LIRBlock*>&& blocks) {
+    /**
+     * Appends the input for the next target block. Used when inputs are resolved after the copy is inserted.
+     */
+    void add_input(const LIROperand& op) {
+        assertion(m_inputs.size() < m_blocks.size(), "too many inputs");
+        m_inputs.push_back(op);
+        if (const auto lir_val = LIRVal::try_from(op); lir_val.has_value()) {
+            lir_val->add_user(this);
+        }
+    }
+
+    static auto copy(const LIRValType ty, const std::uint8_t size, std::vector<LIRBlock*>&& blocks) {
+        return construct<ParallelCopy>(ty, std::vector<LIROperand>{}, std::move(blocks)).then([=](ParallelCopy* copy) {
+            copy->add_def(LIRVal::reg(size, size, 0, copy));
+        });
+    }
+
+    static auto copy(const LIRValType ty, std::vector<LIROperand> &&uses, std::vector<LIRBlock*>&& blocks) {
         const auto size = uses.front().size();
-        auto copy = std::make_unique<ParallelCopy>(ty, std::move(uses), std::move(blocks));
-        copy->add_def(LIRVal::reg(size, size, 0, copy.get()));
-        return copy;
+        return construct<ParallelCopy>(ty, std::move(uses), std::move(blocks)).then([=](ParallelCopy* copy) {
+            copy->add_def(LIRVal::reg(size, size, 0, copy));
+        });
     }
 
 private:
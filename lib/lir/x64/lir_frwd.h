@@ -10,9 +10,13 @@ class LIRControlInstruction;
 class LIRProducerInstructionBase;
 class LIRCall;
 class LIRAdjustStack;
+class ParallelCopy;
+class LIRVector;
 
 enum class FunctionBind: std::uint8_t;
 enum class FcmpOrdering : std::uint8_t;
+enum class VecLane: std::uint8_t;
+enum class VecPredicate: std::uint8_t;
 
 class LIROperand;
 class LIRVal;
@@ -1,5 +1,7 @@
 #include "lir/x64/lower/FunctionLower.h"
 
+#include <limits>
+
 #include "ArgumentRegistersAllocator.h"
 #include "GlobalsLowering.h"
 #include "lir/x64/instruction/LIRAdjustStack.h"
@@ -12,6 +14,7 @@
 #include "lir/x64/instruction/LIRProducerInstruction.h"
 #include "lir/x64/instruction/LIRReturn.h"
 #include "lir/x64/instruction/LIRSetCC.h"
+#include "lir/x64/instruction/LIRVector.h"
 #include "lir/x64/instruction/Matcher.h"
 #include "lir/x64/instruction/ParallelCopy.h"
 #include "lir/x64/operand/OperandMatcher.h"
@@ -132,10 +135,34 @@ static LIRValType convert_type_to_lir_val_type(const Type* type) {
     if (type->isa(float_type())) {
         return LIRValType::FP;
     }
+    if (type->isa(vector_type())) {
+        return LIRValType::FP;
+    }
 
     die("Unsupported type for LIRValType");
 }
 
+static VecLane vec_lane(const VectorType* type) {
+    const auto element = type->element_type();
+    if (element->isa(float_type())) {
+        return element->size_of() == cst::DWORD_SIZE ? VecLane::F32 : VecLane::F64;
+    }
+
+    return element->size_of() == cst::DWORD_SIZE ? VecLane::I32 : VecLane::I64;
+}
+
+static VecPredicate vec_predicate(const IcmpPredicate predicate) noexcept {
+    switch (predicate) {
+        case IcmpPredicate::Eq: return VecPredicate::EQ;
+        case IcmpPredicate::Ne: return VecPredicate::NE;
+        case IcmpPredicate::Lt: return VecPredicate::LT;
+        case IcmpPredicate::Le: return VecPredicate::LE;
+        case IcmpPredicate::Gt: return VecPredicate::GT;
+        case IcmpPredicate::Ge: return VecPredicate::GE;
+        default: std::unreachable();
+    }
+}
+
 /**
  * Determines the condition type from a given Value.
  */
@@ -226,6 +253,88 @@ static std::pair<Value, Value> try_fold_field_access(const FieldAccess* field_ac
     std::unreachable();
 }
 
+/**
+ * Address [pointer + index * size + disp] of the field access, where size is the size of the accessed type.
+ */
+struct FoldedAddress final {
+    Value pointer;
+    Value index;
+    std::int32_t disp;
+};
+
+/**
+ * Splits 'index + c' and 'index - c' of 64-bit integers into the index and the constant.
+ */
+static std::pair<Value, std::int64_t> split_constant_addend(const Value& index) noexcept {
+    if (!index.is<ValueInstruction*>() || PrimitiveType::cast(index.type())->size_of() != 8) {
+        return {index, 0};
+    }
+
+    const auto binary = dynamic_cast<const Binary*>(index.get<ValueInstruction*>());
+    if (binary == nullptr) {
+        return {index, 0};
+    }
+
+    const auto& lhs = binary->lhs();
+    const auto& rhs = binary->rhs();
+    switch (binary->op()) {
+        case BinaryOp::Add: {
+            if (rhs.is<std::int64_t>()) {
+                return {lhs, rhs.get<std::int64_t>()};
+            }
+            if (lhs.is<std::int64_t>()) {
+                return {rhs, lhs.get<std::int64_t>()};
+            }
+            break;
+        }
+        case BinaryOp::Subtract: {
+            if (rhs.is<std::int64_t>() && rhs.get<std::int64_t>() != std::numeric_limits<std::int64_t>::min()) {
+                return {lhs, -rhs.get<std::int64_t>()};
+            }
+            break;
+        }
+        default: break;
+    }
+
+    return {index, 0};
+}
+
+/**
+ * Folds the field access into a single memory operand.
+ * Constant offsets of the pointer chain under a variable index and the constant addend of the index
+ * go into the displacement, so 'a[i + 1]' or '&s->arr[i]' don't need an add or a lea.
+ */
+static FoldedAddress try_fold_address(const FieldAccess* field_access) noexcept {
+    const auto gep_inst = dynamic_cast<const GetElementPtr*>(field_access);
+    if (gep_inst == nullptr || gep_inst->index().isa(constant())) {
+        const auto [pointer, index] = try_fold_field_access(field_access);
+        return {pointer, index, 0};
+    }
+
+    const FoldedAddress unfolded{gep_inst->pointer(), gep_inst->index(), 0};
+    const auto size = static_cast<std::int64_t>(gep_inst->access_type()->size_of());
+    const auto [index, addend] = split_constant_addend(gep_inst->index());
+    constexpr auto max_disp = std::numeric_limits<std::int32_t>::max();
+    if (addend > max_disp / size || addend < -max_disp / size) {
+        return unfolded;
+    }
+
+    auto disp = addend * size;
+    auto pointer = gep_inst->pointer();
+    if (pointer.isa(gfp()) || pointer.isa(gep(any_value(), constant()))) {
+        const auto [base, offset] = try_fold_field_access_iter(dynamic_cast<const FieldAccess*>(pointer.get<ValueInstruction*>()));
+        pointer = base;
+        disp += offset;
+    }
+
+    // Stack slots and globals are addressed by their own instructions without the displacement.
+    if (pointer.isa(value_semantic()) || pointer.isa(g_value()) || !std::in_range<std::int32_t>(disp)) {
+        return unfolded;
+    }
+
+    return {pointer, index, static_cast<std::int32_t>(disp)};
+}
+
 static bool is_pinned(const Instruction& inst) noexcept {
     const auto value_inst = dynamic_cast<const ValueInstruction*>(&inst);
     if (value_inst == nullptr) {
@@ -244,6 +353,66 @@ static bool is_pinned(const Instruction& inst) noexcept {
         return true;
     }
 
+    // Phi operands are resolved after all blocks are lowered, so they must not be scheduled late.
+    const auto is_phi = [](const Instruction* user) { return dynamic_cast<const Phi*>(user) != nullptr; };
+    return std::ranges::any_of(value_inst->users(), is_phi);
+}
+
+/**
+ * Returns true if the integer load can be folded into the memory operand of the next instruction.
+ * It must be the only user of the load: 'add', 'sub', 'and', 'or', 'xor' or 'icmp' right before its conditional branch.
+ * Nothing is executed between the load and its user, so a store can't change the memory in between.
+ */
+static bool is_foldable_load(const Instruction& inst, const Instruction& next, const Instruction* after_next) noexcept {
+    if (!inst.isa(load())) {
+        return false;
+    }
+
+    const auto load_inst = dynamic_cast<const Unary*>(&inst);
+    const auto users = load_inst->users();
+    if (!load_inst->type()->isa(gp_type()) || users.size() != 1 || users.front() != &next) {
+        return false;
+    }
+
+    if (const auto& pointer = load_inst->operand(); pointer.isa(field_access())) {
+        const auto [src, idx, disp] = try_fold_address(dynamic_cast<const FieldAccess*>(pointer.get<ValueInstruction*>()));
+        if (src.isa(value_semantic())) {
+            return false;
+        }
+
+    } else if (!pointer.isa(argument())) {
+        return false;
+    }
+
+    const auto is_load = [&](const Value& val) {
+        return val.is<ValueInstruction*>() && val.get<ValueInstruction*>() == load_inst;
+    };
+
+    if (const auto binary = dynamic_cast<const Binary*>(&next)) {
+        if (is_load(binary->lhs()) && is_load(binary->rhs())) {
+            return false;
+        }
+
+        switch (binary->op()) {
+            case BinaryOp::Add: [[fallthrough]];
+            case BinaryOp::BitwiseAnd: [[fallthrough]];
+            case BinaryOp::BitwiseOr: [[fallthrough]];
+            case BinaryOp::BitwiseXor: return true;
+            case BinaryOp::Subtract: return is_load(binary->rhs());
+            default: return false;
+        }
+    }
+
+    if (const auto icmp = dynamic_cast<const IcmpInstruction*>(&next)) {
+        // The memory operand can only be the left one, so the predicate stays as it is.
+        if (!is_load(icmp->lhs()) || is_load(icmp->rhs())) {
+            return false;
+        }
+
+        const auto icmp_users = icmp->users();
+        return icmp_users.size() == 1 && icmp_users.front() == after_next && dynamic_cast<const CondBranch*>(after_next) != nullptr;
+    }
+
     return false;
 }
 
@@ -288,7 +457,7 @@ LIRFuncData FunctionLower::create_lir_function(const FunctionData &function) {
         lir_args.push_back(LIRVal::from(&inserted, non_trivial_type->size_of(), non_trivial_type->align_of()));
     }
 
-    return {function.uid(), function.name(), std::move(args), std::move(lir_args)};
+    return {function.uid(), function.name(), function.prototype()->bind(), std::move(args), std::move(lir_args)};
 }
 
 void FunctionLower::allocate_fixed_regs_for_arguments() const {
@@ -345,8 +514,18 @@ void FunctionLower::setup_arguments() {
 void FunctionLower::traverse_instructions() {
     for (const auto &bb: m_dom_ordering) {
         m_bb = m_bb_mapping.at(bb);
-        for (auto &inst: bb->instructions()) {
-            if (is_pinned(inst)) {
+        const auto& instructions = bb->instructions();
+        for (auto it = instructions.begin(); it != instructions.end(); ++it) {
+            auto& inst = *it;
+            if (const auto next = std::next(it); next != instructions.end()) {
+                const auto after_next = std::next(next);
+                if (is_foldable_load(inst, *next, after_next == instructions.end() ? nullptr : &*after_next)) {
+                    m_load_folding_users.emplace(&*next);
+                }
+            }
+
+            // The user of a folded load reads the memory, so it stays in place.
+            if (is_pinned(inst) || m_load_folding_users.contains(&inst)) {
                 inst.visit(*this);
                 continue;
             }
@@ -368,24 +547,42 @@ void FunctionLower::setup_bb_mapping() {
         auto lir_bb = m_obj_function.create_mach_block();
         m_bb_mapping.emplace(&bb, lir_bb);
     }
+
+    transfer_edge_profile();
 }
 
-static void insert_copies(ParallelCopy& p_copy) noexcept {
-    for (auto [idx, input, target]: std::views::zip(std::views::iota(0UL), p_copy.inputs(), p_copy.targets())) {
-        const auto lir_val = LIRVal::try_from(input);
-        assertion(lir_val.has_value(), "Expected LIRVal for ParallelCopy input");
+void FunctionLower::transfer_edge_profile() {
+    const auto& profile = m_function.edge_profile();
+    if (profile.empty()) {
+        return;
+    }
 
-        const auto copy = target->ins_before(target->last(), LIRProducerInstruction::copy(lir_val->size(), lir_val.value().type(), input));
-        p_copy.in(idx, copy->def(0));
+    // Blocks are mapped one to one, only their ids are different.
+    std::vector<const LIRBlock*> lir_blocks(m_function.id_bound(), nullptr);
+    for (const auto& [bb, lir_bb]: m_bb_mapping) {
+        lir_blocks[bb->id()] = lir_bb;
     }
-}
 
-void FunctionLower::finalize_parallel_copies() const noexcept {
-    for (auto& bb: m_parallel_copy_owners) {
-        for (auto& inst: bb->instructions()) {
-            if (!inst.isa(parallel_copy())) break;
+    auto& lir_profile = m_obj_function.edge_profile();
+    profile.for_each([&](const std::size_t from, const std::size_t to, const std::uint64_t count) {
+        if (from >= lir_blocks.size() || to >= lir_blocks.size() || lir_blocks[from] == nullptr || lir_blocks[to] == nullptr) {
+            return;
+        }
+
+        lir_profile.add(lir_blocks[from]->id(), lir_blocks[to]->id(), count);
+    });
+}
 
-            insert_copies(dynamic_cast<ParallelCopy&>(inst));
+void FunctionLower::finalize_parallel_copies() {
+    // Incoming values might be defined in blocks lowered after the phi, so they are resolved at the end.
+    for (const auto& [phi, p_copy]: m_phis) {
+        const auto size = p_copy->def(0).size();
+        const auto lir_val_type = p_copy->def(0).type();
+        for (const auto [target, incoming]: std::views::zip(phi->incoming(), phi->operands())) {
+            const auto lir_target = m_bb_mapping.at(target);
+            const auto input = get_lir_operand(incoming);
+            const auto copy = lir_target->ins_before(lir_target->last(), LIRProducerInstruction::copy(size, lir_val_type, input));
+            p_copy->add_input(copy->def(0));
         }
     }
 }
@@ -418,7 +615,7 @@ LIROperand FunctionLower::make_fp_constant(const Type& type, const double val) {
     auto& global = m_obj_function.global_data();
     auto label = create_anon_constant_label(m_obj_function.uid(), m_cst_index++);
     const auto name = label;
-    const auto slot = global.add_slot(name, LIRNamedSlot(std::move(label), LIRSlot(Constant(slot_type, bitmask))));
+    const auto slot = global.add_slot(name, LIRNamedSlot(std::move(label), LIRSlot(Constant(slot_type, bitmask)), GValueKind::CONSTANT));
     return slot.value();
 }
 
@@ -465,6 +662,16 @@ LIRVal FunctionLower::get_lir_val(const Value &val) {
 }
 
 void FunctionLower::accept(Binary *inst) {
+    if (const auto vec_type = VectorType::cast(inst->type()); vec_type != nullptr) {
+        lower_vector_binary(inst, vec_type);
+        return;
+    }
+
+    if (m_load_folding_users.contains(inst)) {
+        lower_binary_by_idx(inst);
+        return;
+    }
+
     const auto lhs = get_lir_operand(inst->lhs());
     const auto& rhs_v = inst->rhs();
     const auto rhs = get_lir_operand(rhs_v);
@@ -511,6 +718,25 @@ void FunctionLower::accept(Binary *inst) {
             memorize(inst, shift->def(0));
             break;
         }
+        case BinaryOp::Multiply: {
+            if (inst->type()->isa(float_type())) {
+                unimplemented();
+            }
+
+            const auto mul = m_bb->ins(LIRProducerInstruction::mul(lhs, rhs));
+            memorize(inst, mul->def(0));
+            break;
+        }
+        case BinaryOp::BitwiseAnd: {
+            const auto aand = m_bb->ins(LIRProducerInstruction::aand(lhs, rhs));
+            memorize(inst, aand->def(0));
+            break;
+        }
+        case BinaryOp::BitwiseOr: {
+            const auto oor = m_bb->ins(LIRProducerInstruction::oor(lhs, rhs));
+            memorize(inst, oor->def(0));
+            break;
+        }
         case BinaryOp::BitwiseXor: {
             const auto xxor = m_bb->ins(LIRProducerInstruction::xxor(lhs, rhs));
             memorize(inst, xxor->def(0));
@@ -520,6 +746,36 @@ void FunctionLower::accept(Binary *inst) {
     }
 }
 
+void FunctionLower::lower_binary_by_idx(const Binary *inst) {
+    // The folded load becomes the right operand. It comes from the left one only for the commutative operations.
+    const auto rhs_load = folded_load(inst->rhs());
+    const auto folded = rhs_load != nullptr ? rhs_load : folded_load(inst->lhs());
+    assertion(folded != nullptr, "expected folded load");
+
+    const auto lhs = get_lir_operand(rhs_load != nullptr ? inst->lhs() : inst->rhs());
+    LIRProdInstKind kind;
+    switch (inst->op()) {
+        case BinaryOp::Add: kind = LIRProdInstKind::AddByIdx; break;
+        case BinaryOp::Subtract: kind = LIRProdInstKind::SubByIdx; break;
+        case BinaryOp::BitwiseAnd: kind = LIRProdInstKind::AndByIdx; break;
+        case BinaryOp::BitwiseOr: kind = LIRProdInstKind::OrByIdx; break;
+        case BinaryOp::BitwiseXor: kind = LIRProdInstKind::XorByIdx; break;
+        default: die("Unsupported binary operation with folded load: {}", static_cast<int>(inst->op()));
+    }
+
+    const auto binary = m_bb->ins(LIRProducerInstruction::binary_by_idx(kind, lhs, folded->pointer, folded->index, folded->disp));
+    memorize(inst, binary->def(0));
+}
+
+const FunctionLower::FoldedLoad* FunctionLower::folded_load(const Value &val) const {
+    if (!val.is<ValueInstruction*>()) {
+        return nullptr;
+    }
+
+    const auto it = m_folded_loads.find(val.get<ValueInstruction*>());
+    return it != m_folded_loads.end() ? &it->second : nullptr;
+}
+
 void FunctionLower::accept(Branch *branch) {
     const auto target = m_bb_mapping.at(branch->target());
     m_bb->ins(LIRBranch::jmp(target));
@@ -723,21 +979,32 @@ void FunctionLower::accept(VCall *call) {
     allocate_arguments_for_call(lir_call->inputs());
 }
 
-void FunctionLower::accept(Phi *inst) {
-    m_parallel_copy_owners.emplace(m_bb);
+void FunctionLower::accept(IVCall *call) {
+    m_bb->ins(LIRAdjustStack::down_stack());
+
+    const auto proto = call->prototype();
+    auto args = lower_function_prototypes(call->arguments(), *proto);
+    // r11 is a caller-saved scratch register which never carries arguments.
+    const auto pointer = lower_primitive_type_argument(call->pointer());
+    pointer.assign_reg(aasm::r11);
+    const auto cont = m_bb_mapping.at(call->cont());
 
-    std::vector<LIROperand> incoming_values;
-    incoming_values.reserve(inst->incoming().size());
+    const auto lir_call = m_bb->ins(LIRCall::ivcall(cont, pointer, std::move(args)));
+    cont->ins(LIRAdjustStack::up_stack());
+    allocate_arguments_for_call(lir_call->arguments());
+}
 
+void FunctionLower::accept(Phi *inst) {
     std::vector<LIRBlock*> incoming_targets;
     incoming_targets.reserve(inst->incoming().size());
-
-    for (const auto [target, incoming]: std::views::zip(inst->incoming(), inst->operands())) {
-        incoming_values.emplace_back(get_lir_val(incoming));
+    for (const auto target: inst->incoming()) {
         incoming_targets.push_back(m_bb_mapping.at(target));
     }
+
     const auto lir_val_type = convert_type_to_lir_val_type(inst->type());
-    const auto parallel_copy = m_bb->ins(ParallelCopy::copy(lir_val_type, std::move(incoming_values), std::move(incoming_targets)));
+    const auto size = checked_cast<std::uint8_t>(PrimitiveType::cast(inst->type())->size_of());
+    const auto parallel_copy = m_bb->ins(ParallelCopy::copy(lir_val_type, size, std::move(incoming_targets)));
+    m_phis.emplace_back(inst, parallel_copy);
     memorize(inst, parallel_copy->def(0));
 }
 
@@ -753,16 +1020,23 @@ void FunctionLower::accept(Store *store) {
         return;
     }
 
+    if (value.type()->isa(vector_type())) {
+        // Indexed addressing scales by at most 8 bytes, so the vector is stored through the materialized pointer.
+        const auto pointer_vreg = get_lir_val(pointer);
+        m_bb->ins(LIRInstruction::store(lir_val_type, pointer_vreg, value_vreg));
+        return;
+    }
+
     if (pointer.isa(field_access())) {
         const auto gep = dynamic_cast<FieldAccess*>(pointer.get<ValueInstruction*>());
-        const auto [src, idx] = try_fold_field_access(gep);
+        const auto [src, idx, disp] = try_fold_address(gep);
         const auto src_vreg = get_lir_operand(src);
         const auto idx_lir_op = get_lir_operand(idx);
         if (src.isa(value_semantic())) {
             m_bb->ins(LIRInstruction::store_by_offset(lir_val_type, src_vreg, idx_lir_op, value_vreg));
             return;
         }
-        m_bb->ins(LIRInstruction::mov_by_idx(lir_val_type, src_vreg.as_vreg().value(), idx_lir_op, value_vreg));
+        m_bb->ins(LIRInstruction::mov_by_idx(lir_val_type, src_vreg.as_vreg().value(), idx_lir_op, value_vreg, disp));
         return;
     }
 
@@ -782,6 +1056,12 @@ void FunctionLower::accept(Alloc *alloc) {
 }
 
 void FunctionLower::accept(IcmpInstruction *icmp) {
+    if (const auto folded = folded_load(icmp->lhs())) {
+        const auto rhs = get_lir_operand(icmp->rhs());
+        m_bb->ins(LIRICmp::cmp_by_idx(folded->pointer, folded->index, folded->disp, rhs));
+        return;
+    }
+
     const auto lhs = get_lir_operand(icmp->lhs());
     const auto rhs = get_lir_operand(icmp->rhs());
     m_bb->ins(LIRICmp::cmp(lhs, rhs));
@@ -870,6 +1150,22 @@ void FunctionLower::accept(Unary *inst) {
             break;
         }
         case UnaryOp::Load: lower_load(inst); break;
+        case UnaryOp::Negate: {
+            if (inst->type()->isa(float_type())) {
+                unimplemented();
+            }
+
+            const auto operand = get_lir_operand(inst->operand());
+            const auto neg = m_bb->ins(LIRProducerInstruction::neg(operand));
+            memorize(inst, neg->def(0));
+            break;
+        }
+        case UnaryOp::LogicalNot: {
+            const auto operand = get_lir_operand(inst->operand());
+            const auto nnot = m_bb->ins(LIRProducerInstruction::nnot(operand));
+            memorize(inst, nnot->def(0));
+            break;
+        }
         case UnaryOp::SignExtend: {
             const auto operand = get_lir_operand(inst->operand());
             const auto type = PrimitiveType::cast(inst->type());
@@ -939,6 +1235,73 @@ void FunctionLower::accept(Unary *inst) {
     }
 }
 
+void FunctionLower::lower_vector_binary(const Binary *inst, const VectorType *type) {
+    const auto lhs = get_lir_operand(inst->lhs());
+    const auto rhs = get_lir_operand(inst->rhs());
+    const auto lane = vec_lane(type);
+    LIRVector* vec;
+    switch (inst->op()) {
+        case BinaryOp::Add:      vec = m_bb->ins(LIRVector::add(lane, lhs, rhs)); break;
+        case BinaryOp::Subtract: vec = m_bb->ins(LIRVector::sub(lane, lhs, rhs)); break;
+        case BinaryOp::Multiply: vec = m_bb->ins(LIRVector::mul(lane, lhs, rhs)); break;
+        case BinaryOp::Divide:   vec = m_bb->ins(LIRVector::div(lane, lhs, rhs)); break;
+        default: die("Unsupported vector operation");
+    }
+
+    memorize(inst, vec->def(0));
+}
+
+LIRVector* FunctionLower::lower_vector_cmp(const VecLane lane, const VecPredicate predicate, const LIROperand& lhs, const LIROperand& rhs) {
+    if (is_float_lane(lane)) {
+        return m_bb->ins(LIRVector::cmp(lane, predicate, lhs, rhs));
+    }
+
+    // Packed integers compare only for 'equal' and 'greater than', the rest is the negation of the opposite predicate.
+    VecPredicate opposite;
+    switch (predicate) {
+        case VecPredicate::EQ: [[fallthrough]];
+        case VecPredicate::LT: [[fallthrough]];
+        case VecPredicate::GT: return m_bb->ins(LIRVector::cmp(lane, predicate, lhs, rhs));
+        case VecPredicate::NE: opposite = VecPredicate::EQ; break;
+        case VecPredicate::LE: opposite = VecPredicate::GT; break;
+        case VecPredicate::GE: opposite = VecPredicate::LT; break;
+        default: std::unreachable();
+    }
+
+    const auto cmp = m_bb->ins(LIRVector::cmp(lane, opposite, lhs, rhs));
+    // Any vector is equal to itself, so this sets every bit.
+    const auto ones = m_bb->ins(LIRVector::cmp(lane, VecPredicate::EQ, cmp->def(0), cmp->def(0)));
+    return m_bb->ins(LIRVector::xxor(lane, cmp->def(0), ones->def(0)));
+}
+
+void FunctionLower::accept(VectorInstruction *vec) {
+    const auto type = vec->vector_type();
+    const auto lane = vec_lane(type);
+    LIRVector* lir_vec;
+    switch (vec->op()) {
+        case VectorOp::Broadcast: {
+            const auto scalar = get_lir_operand(vec->lhs());
+            lir_vec = m_bb->ins(LIRVector::broadcast(lane, type->size_of(), scalar));
+            break;
+        }
+        case VectorOp::Shuffle: {
+            const auto lhs = get_lir_operand(vec->lhs());
+            const auto rhs = get_lir_operand(vec->rhs());
+            lir_vec = m_bb->ins(LIRVector::shuffle(lane, vec->control(), lhs, rhs));
+            break;
+        }
+        case VectorOp::Compare: {
+            const auto lhs = get_lir_operand(vec->lhs());
+            const auto rhs = get_lir_operand(vec->rhs());
+            lir_vec = lower_vector_cmp(lane, vec_predicate(vec->predicate()), lhs, rhs);
+            break;
+        }
+        default: std::unreachable();
+    }
+
+    memorize(vec, lir_vec->def(0));
+}
+
 void FunctionLower::lower_load(const Unary *inst) {
     const auto& pointer = inst->operand();
     const auto type = PrimitiveType::cast(inst->type());
@@ -951,9 +1314,29 @@ void FunctionLower::lower_load(const Unary *inst) {
     }
 
     const auto lir_val_type = convert_type_to_lir_val_type(inst->type());
+    if (type->isa(vector_type())) {
+        // Indexed addressing scales by at most 8 bytes, so the vector is loaded through the materialized pointer.
+        const auto pointer_vreg = get_lir_val(pointer);
+        const auto load_inst = m_bb->ins(LIRProducerInstruction::load(lir_val_type, type->size_of(), pointer_vreg));
+        memorize(inst, load_inst->def(0));
+        return;
+    }
+
+    if (const auto users = inst->users(); users.size() == 1 && m_load_folding_users.contains(users.front())) {
+        // The user reads the memory itself, only the address is lowered here.
+        if (pointer.isa(field_access())) {
+            const auto [src, idx, disp] = try_fold_address(dynamic_cast<FieldAccess*>(pointer.get<ValueInstruction*>()));
+            m_folded_loads.emplace(inst, FoldedLoad{get_lir_operand(src), get_lir_operand(idx), disp});
+
+        } else {
+            m_folded_loads.emplace(inst, FoldedLoad{get_lir_val(pointer), LirCst::imm64(0L), 0});
+        }
+        return;
+    }
+
     if (pointer.isa(field_access())) {
         const auto gep = dynamic_cast<FieldAccess*>(pointer.get<ValueInstruction*>());
-        const auto [src, idx] = try_fold_field_access(gep);
+        const auto [src, idx, disp] = try_fold_address(gep);
         const auto src_vreg = get_lir_operand(src);
         const auto idx_lir_op = get_lir_operand(idx);
 
@@ -963,7 +1346,7 @@ void FunctionLower::lower_load(const Unary *inst) {
             return;
         }
 
-        const auto load_inst = m_bb->ins(LIRProducerInstruction::load_by_idx(lir_val_type, gep->access_type()->size_of(), src_vreg, idx_lir_op));
+        const auto load_inst = m_bb->ins(LIRProducerInstruction::load_by_idx(lir_val_type, gep->access_type()->size_of(), src_vreg, idx_lir_op, disp));
         memorize(inst, load_inst->def(0));
         return;
     }
@@ -54,7 +54,9 @@ private:
 
     void setup_bb_mapping();
 
-    void finalize_parallel_copies() const noexcept;
+    void transfer_edge_profile();
+
+    void finalize_parallel_copies();
 
     void accept(Binary *inst) override;
 
@@ -78,9 +80,7 @@ private:
 
     void accept(VCall *call) override;
 
-    void accept(IVCall *call) override {
-        unimplemented();
-    }
+    void accept(IVCall *call) override;
 
     void accept(Phi *inst) override;
 
@@ -102,7 +102,12 @@ private:
 
     void accept(Projection *proj) override {}
 
+    void accept(VectorInstruction *vec) override;
+
+    void lower_vector_binary(const Binary *inst, const VectorType *type);
+    LIRVector* lower_vector_cmp(VecLane lane, VecPredicate predicate, const LIROperand& lhs, const LIROperand& rhs);
     void lower_load(const Unary *inst);
+    void lower_binary_by_idx(const Binary *inst);
     LIRVal lower_primitive_type_argument(const Value& arg);
     std::vector<LIROperand> lower_function_prototypes(std::span<const Value> operands, const FunctionPrototype& proto);
 
@@ -118,6 +123,17 @@ private:
     LIROperand get_lir_operand(const Value& val);
     LIRVal get_lir_val(const Value& val);
 
+    /**
+     * Memory operand [pointer + index * size + disp] of a load folded into its user.
+     */
+    struct FoldedLoad final {
+        LIROperand pointer;
+        LIROperand index;
+        std::int32_t disp;
+    };
+
+    const FoldedLoad* folded_load(const Value& val) const;
+
     template <IsLocalValueType T>
     void memorize(const T* val, const LIROperand& lir_val) {
         m_value_mapping.emplace(UsedValue::from(val), lir_val);
@@ -133,9 +149,12 @@ private:
     LIRBlock* m_bb;
     std::unordered_map<const BasicBlock*, LIRBlock*> m_bb_mapping;
     UsedValueMap<LIROperand> m_value_mapping;
-    // Inserted parallel copies in the current function for late handling.
-    std::unordered_set<LIRBlock*> m_parallel_copy_owners;
+    // Lowered phis with their parallel copies. Inputs of the copies are resolved at the end.
+    std::vector<std::pair<const Phi*, ParallelCopy*>> m_phis;
     // Temporal storage for late scheduled instructions.
     std::unordered_set<ValueInstruction*> m_late_schedule_instructions;
+    // Instructions which read the memory of a folded load, they are lowered in place.
+    std::unordered_set<const Instruction*> m_load_folding_users;
+    std::unordered_map<const ValueInstruction*, FoldedLoad> m_folded_loads;
 };
 
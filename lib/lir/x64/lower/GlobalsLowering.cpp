@@ -13,7 +13,7 @@
 
 const LIRNamedSlot* GlobalsLowering::lower() {
     auto slot = create_slot(m_global_value.content_type(), m_global_value.initializer());
-    return m_global_data.add_slot(m_global_value.name(), LIRNamedSlot(std::string(m_global_value.name()), std::move(slot))).value();
+    return m_global_data.add_slot(m_global_value.name(), LIRNamedSlot(std::string(m_global_value.name()), std::move(slot), m_global_value.kind())).value();
 }
 
 LIRSlot GlobalsLowering::create_slot(const NonTrivialType *ty, const Initializer &global) {
@@ -84,7 +84,7 @@ LIRSlot GlobalsLowering::create_slot_iter(const NonTrivialType* ty, const Initia
 
         } else if constexpr (std::is_same_v<U, const GlobalValue*>) {
             auto slot = create_slot(glob->content_type(), glob->initializer());
-            const auto named_slot = m_global_data.add_slot(glob->name(), LIRNamedSlot(std::string(glob->name()), std::move(slot))).value();
+            const auto named_slot = m_global_data.add_slot(glob->name(), LIRNamedSlot(std::string(glob->name()), std::move(slot), glob->kind())).value();
             return LIRSlot(named_slot);
 
         } else {
@@ -2,7 +2,10 @@
 #include "lir/x64/lower/FunctionLower.h"
 #include "lir/x64/asm/cc/LinuxX64.h"
 #include "lir/x64/lower/GlobalsLowering.h"
+#include "utility/ParallelFor.h"
 
+#include <algorithm>
+#include <optional>
 #include <ranges>
 
 
@@ -18,12 +21,29 @@ void Lowering::lower_globals_pool() {
 }
 
 void Lowering::lower_functions() {
+    // Sort functions by name, so the result doesn't depend on the hash map order.
+    std::vector<const FunctionData*> functions;
+    functions.reserve(m_module.functions().size());
     for (const auto &func: m_module.functions() | std::views::values) {
+        if (m_selected_functions.has_value() && !m_selected_functions->contains(std::string(func.name()))) {
+            continue;
+        }
+
+        functions.push_back(&func);
+    }
+    std::ranges::sort(functions, {}, [](const FunctionData* func) { return func->name(); });
+
+    // Globals pool is already lowered and is only read from here on.
+    std::vector<std::optional<LIRFuncData>> lowered(functions.size());
+    parallel_for_each(std::span(functions), m_jobs, [&](const std::size_t idx, const FunctionData* func) {
         AnalysisPassManager cache;
-        auto lower = FunctionLower::create(&cache, &func, m_global_data, call_conv::CC_LinuxX64());
+        auto lower = FunctionLower::create(&cache, func, m_global_data, call_conv::CC_LinuxX64());
         lower.run();
+        lowered[idx].emplace(lower.result());
+    });
 
-        m_obj_functions.emplace(func.name(), lower.result());
+    for (auto&& [func, obj_func]: std::views::zip(functions, lowered)) {
+        m_obj_functions.emplace(func->name(), std::move(obj_func.value()));
     }
 }
 
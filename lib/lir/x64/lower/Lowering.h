@@ -1,15 +1,30 @@
 #pragma once
 
+#include <optional>
+#include <unordered_set>
+
 #include "mir/module/Module.h"
 #include "mir/analysis/Analysis.h"
 
 #include "lir/x64/module/LIRModule.h"
 
 
+/**
+ * Lowers the MIR module to LIR.
+ * Functions are lowered independently of each other, so up to `jobs` of them are processed in parallel.
+ */
 class Lowering final {
 public:
-    explicit Lowering(const Module &module) noexcept:
-        m_module(module) {}
+    explicit Lowering(const Module &module, const std::size_t jobs = 1) noexcept:
+        m_module(module),
+        m_jobs(jobs) {}
+
+    /**
+     * Lowers only the given functions. The globals pool is lowered as a whole.
+     */
+    void select_functions(std::unordered_set<std::string>&& names) {
+        m_selected_functions = std::move(names);
+    }
 
     void run();
 
@@ -26,6 +41,8 @@ private:
     void lower_functions();
 
     const Module& m_module;
+    const std::size_t m_jobs;
+    std::optional<std::unordered_set<std::string>> m_selected_functions{};
     std::unordered_map<std::string, LIRFuncData> m_obj_functions;
     GlobalData m_global_data{};
 };
\ No newline at end of file
@@ -12,10 +12,13 @@
 
 class LIRBlock final: public BasicBlockBase<LIRBlock, LIRInstructionBase> {
 public:
-    template<std::derived_from<LIRInstructionBase> U>
-    U* ins(std::unique_ptr<U>&& inst) {
-        auto inst_ptr = inst.get();
-        const auto id = m_instructions.push_back(std::move(inst));
+    explicit LIRBlock(Arena& arena) noexcept:
+        BasicBlockBase(arena) {}
+
+    template<std::derived_from<LIRInstructionBase> U, typename Fn>
+    U* ins(Deferred<U, Fn>&& inst) {
+        const auto inst_ptr = std::move(inst)(*m_arena);
+        const auto id = m_instructions.push_back(inst_ptr);
         inst_ptr->connect(id, this);
 
         make_def_use_chain(inst_ptr);
@@ -25,10 +28,10 @@ public:
         return inst_ptr;
     }
 
-    template<std::derived_from<LIRInstructionBase> U>
-    U* ins_before(const LIRInstructionBase* base, std::unique_ptr<U>&& inst) {
-        const auto inst_ptr = inst.get();
-        const auto id = m_instructions.insert_before(base->id(), std::move(inst));
+    template<std::derived_from<LIRInstructionBase> U, typename Fn>
+    U* ins_before(const LIRInstructionBase* base, Deferred<U, Fn>&& inst) {
+        const auto inst_ptr = std::move(inst)(*m_arena);
+        const auto id = m_instructions.insert_before(base->id(), inst_ptr);
         inst_ptr->connect(id, this);
 
         make_def_use_chain(inst_ptr);
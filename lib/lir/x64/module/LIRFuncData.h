@@ -1,6 +1,7 @@
 #pragma once
 
 #include "lir/x64/lir_frwd.h"
+#include "base/FunctionBind.h"
 #include "base/FunctionDataBase.h"
 #include "lir/x64/global/GlobalData.h"
 #include "lir/x64/module/LIRBlock.h"
@@ -9,15 +10,16 @@
 
 class LIRFuncData final: public FunctionDataBase<LIRBlock, LIRArg> {
 public:
-    LIRFuncData(const std::size_t uid, const std::string_view name, std::vector<LIRArg> &&args, std::vector<LIRVal>&& lir_args) noexcept:
+    LIRFuncData(const std::size_t uid, const std::string_view name, const FunctionBind bind, std::vector<LIRArg> &&args, std::vector<LIRVal>&& lir_args) noexcept:
         FunctionDataBase(uid, std::move(args)),
         m_name(name),
+        m_bind(bind),
         m_lir_args(std::move(lir_args)) {
         create_mach_block();
     }
 
     LIRBlock* create_mach_block() {
-        const auto id = m_basic_blocks.push_back(std::make_unique<LIRBlock>());
+        const auto id = m_basic_blocks.push_back(m_arena->make<LIRBlock>(*m_arena));
         m_basic_blocks[id].set_id(id);
         return &m_basic_blocks[id];
     }
@@ -27,6 +29,11 @@ public:
         return m_name;
     }
 
+    [[nodiscard]]
+    FunctionBind bind() const noexcept {
+        return m_bind;
+    }
+
     [[nodiscard]]
     LIRVal arg(const std::size_t index) const noexcept {
         assertion(index < m_lir_args.size(), "invariant");
@@ -66,6 +73,7 @@ public:
 
 private:
     std::string m_name;
+    FunctionBind m_bind;
     std::vector<LIRVal> m_lir_args;
     GlobalData m_global_data;
 };
\ No newline at end of file
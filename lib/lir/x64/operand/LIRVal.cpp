@@ -106,10 +106,12 @@ std::ostream & operator<<(std::ostream &os, const LIRVal &op) noexcept {
     const auto idx = static_cast<std::size_t>(op.m_index);
     switch (op.m_type) {
         case LIRVal::Op::Arg: return os << LIRArg::try_from(op).value();
-        case LIRVal::Op::Inst: [[fallthrough]];
-        case LIRVal::Op::Call: {
+        case LIRVal::Op::Inst: {
             return os << op.m_variant.m_inst->owner()->id() << 'x' << op.id() << '-' << idx << '\'' << size_prefix(op.size());
         }
+        case LIRVal::Op::Call: {
+            return os << op.m_variant.m_call->owner()->id() << 'x' << op.id() << '-' << idx << '\'' << size_prefix(op.size());
+        }
         default: std::unreachable();
     }
 }
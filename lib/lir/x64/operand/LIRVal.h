@@ -1,6 +1,7 @@
 #pragma once
 
 #include <expected>
+#include <functional>
 #include <utility>
 
 #include "LIRArg.h"
@@ -8,6 +9,10 @@
 #include "lir/x64/lir_frwd.h"
 #include "utility/Error.h"
 
+namespace details {
+    struct LIRValHash;
+}
+
 /**
  * Represents a value in the Low-Level Intermediate Representation (LIR).
  * This class can represent either an argument or a produced values from instructions.
@@ -106,7 +111,7 @@ public:
                m_align == rhs.m_align &&
                m_index == rhs.m_index &&
                m_type == rhs.m_type &&
-               m_variant.m_arg == rhs.m_variant.m_arg;
+               definition() == rhs.definition();
     }
 
     void add_user(LIRInstructionBase *inst) const noexcept;
@@ -141,9 +146,22 @@ public:
     static std::span<LIRVal const> defs(const LIRInstructionBase* inst) noexcept;
 
 private:
+    friend struct details::LIRValHash;
+
     [[nodiscard]]
     std::size_t id() const noexcept;
 
+    /** Address of the defining entity, read through the active member of the variant. */
+    [[nodiscard]]
+    const void* definition() const noexcept {
+        switch (m_type) {
+            case Op::Arg:  return m_variant.m_arg;
+            case Op::Inst: return m_variant.m_inst;
+            case Op::Call: return m_variant.m_call;
+            default: std::unreachable();
+        }
+    }
+
     std::size_t m_size;
     std::size_t m_align;
     std::uint8_t m_index;
@@ -161,7 +179,9 @@ namespace details {
     struct LIRValHash final {
         [[nodiscard]]
         std::size_t operator()(const LIRVal& val) const noexcept {
-            return val.size() << 8 | static_cast<std::uint64_t>(val.index());
+            // Values are distinguished by the defining entity, size and index only refine it.
+            const auto def = reinterpret_cast<std::uintptr_t>(val.definition());
+            return std::hash<std::uintptr_t>{}(def ^ (val.size() << 2 | static_cast<std::uint64_t>(val.index())));
         }
     };
 
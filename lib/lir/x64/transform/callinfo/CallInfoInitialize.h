@@ -7,8 +7,12 @@
 #include "lir/x64/operand/OperandMatcher.h"
 
 
+/**
+ * Fills the adjust stack instructions around calls: the caller-saved registers which are live across the call
+ * and the size of the area for the arguments passed on the stack.
+ */
 class CallInfoInitialize final {
-    CallInfoInitialize(const LivenessAnalysisInfo& liveness_info, LIRFuncData& func_data, const call_conv::CallConvProvider* call_conv) noexcept:
+    CallInfoInitialize(const LivenessAnalysisInfo* liveness_info, LIRFuncData& func_data, const call_conv::CallConvProvider* call_conv) noexcept:
         m_liveness_info(liveness_info),
         m_call_conv(call_conv),
         m_func_data(func_data) {}
@@ -16,7 +20,14 @@ class CallInfoInitialize final {
 public:
     static CallInfoInitialize create(AnalysisPassManagerBase<LIRFuncData>* manager, LIRFuncData* data, const call_conv::CallConvProvider* call_conv) {
         const auto liveness_info = manager->analyze<LivenessAnalysis>(data);
-        return {*liveness_info, *data, call_conv};
+        return {liveness_info, *data, call_conv};
+    }
+
+    /**
+     * For the functions where no value is kept in a register across a call, so nothing is saved around it.
+     */
+    static CallInfoInitialize create_without_liveness(LIRFuncData* data, const call_conv::CallConvProvider* call_conv) {
+        return {nullptr, *data, call_conv};
     }
 
     void run() {
@@ -36,12 +47,22 @@ private:
     void initialize_adjust_stack(LIRAdjustStack* adjust_stack) {
         switch (adjust_stack->adjust_kind()) {
             case LIRAdjustKind::UpStack: {
-                const auto& live_in = m_liveness_info.live_in(adjust_stack->owner());
+                if (m_liveness_info == nullptr) {
+                    initialize_data(adjust_stack, adjust_stack->owner()->pred(0), std::span<LIRVal const>{});
+                    break;
+                }
+
+                const auto live_in = m_liveness_info->live_in(adjust_stack->owner());
                 initialize_data(adjust_stack, adjust_stack->owner()->pred(0), live_in);
                 break;
             }
             case LIRAdjustKind::DownStack: {
-                const auto& live_out = m_liveness_info.live_out(adjust_stack->owner());
+                if (m_liveness_info == nullptr) {
+                    initialize_data(adjust_stack, adjust_stack->owner(), std::span<LIRVal const>{});
+                    break;
+                }
+
+                const auto live_out = m_liveness_info->live_out(adjust_stack->owner());
                 initialize_data(adjust_stack, adjust_stack->owner(), live_out);
                 break;
             }
@@ -51,7 +72,8 @@ private:
         }
     }
 
-    void initialize_data(LIRAdjustStack* adjust_inst, const LIRBlock* call_holder_bb, const LIRValSet& live_set) {
+    template<typename LiveValues>
+    void initialize_data(LIRAdjustStack* adjust_inst, const LIRBlock* call_holder_bb, const LiveValues& live_set) {
         const auto call = find_call_instruction(call_holder_bb);
         const auto no_return_val = call->defs().empty();
 
@@ -77,8 +99,8 @@ private:
 
                     const auto& gp_reg_set = m_call_conv->GP_CALLER_SAVE_REGISTERS();
                     if (!gp_reg_set.contains(gp_reg)) {
-                        // If the register is a caller-saved register, we need to add it to the adjust stack.
-                        return;
+                        // The callee preserves it, only caller-saved registers go to the adjust stack.
+                        continue;
                     }
                     break;
                 }
@@ -94,8 +116,8 @@ private:
 
                     const auto& xmm_reg_set = m_call_conv->XMM_CALLER_SAVE_REGISTERS();
                     if (!xmm_reg_set.contains(xmm_reg)) {
-                        // If the register is a caller-saved register, we need to add it to the adjust stack.
-                        return;
+                        // The callee preserves it, only caller-saved registers go to the adjust stack.
+                        continue;
                     }
                     break;
                 }
@@ -115,7 +137,7 @@ private:
 
     std::size_t evaluate_overflow_area_size(const LIRCall* call) noexcept {
         std::size_t overflow_args{};
-        for (const auto &[idx, arg]: std::ranges::zip_view(std::ranges::iota_view{0UL}, call->inputs())) {
+        for (const auto &[idx, arg]: std::ranges::zip_view(std::ranges::iota_view{0UL}, call->arguments())) {
             if (const auto vreg = arg.as_vreg().value(); vreg.isa(gen_v())) {
                 overflow_args+=vreg.size();
 
@@ -133,7 +155,7 @@ private:
         return call;
     }
 
-    const LivenessAnalysisInfo& m_liveness_info;
+    const LivenessAnalysisInfo* m_liveness_info;
     std::size_t m_max_caller_overflow_area_size{};
     const call_conv::CallConvProvider* m_call_conv;
     LIRFuncData& m_func_data;
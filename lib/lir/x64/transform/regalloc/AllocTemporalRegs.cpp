@@ -74,17 +74,7 @@ namespace details {
 
         void ret(std::span<LIRVal const> ret_values) override{}
 
-        void mul_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override{}
-
-        void and_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {}
-
-        void or_i(const LIRVal &out, const LIROperand &in1, const LIROperand &in2) override {}
-
         void setcc_i(const LIRVal &out, aasm::CondType cond_type) override {}
-
-        void neg_i(const LIRVal &out, const LIROperand &in) override {}
-
-        void not_i(const LIRVal &out, const LIROperand &in) override {}
     };
 
     std::pair<std::uint8_t, std::uint8_t> AllocTemporalRegs::allocate(aasm::SymbolTable &symbol_tab, const LIRInstructionBase *inst) {
@@ -0,0 +1,358 @@
+#include "BaselineAllocation.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "AllocTemporalRegs.h"
+
+#include "lir/x64/instruction/LIRAdjustStack.h"
+#include "lir/x64/instruction/LIRInstruction.h"
+#include "lir/x64/instruction/LIRProducerInstruction.h"
+#include "lir/x64/instruction/LIRReturn.h"
+#include "lir/x64/instruction/Matcher.h"
+#include "lir/x64/operand/LIRCst.h"
+#include "lir/x64/operand/OperandMatcher.h"
+
+static const LIRInstructionBase* next_instruction(const LIRInstructionBase* inst) {
+    bool found = false;
+    for (const auto& current: inst->owner()->instructions()) {
+        if (found) {
+            return &current;
+        }
+
+        found = &current == inst;
+    }
+
+    die("instruction has no successor in its block");
+}
+
+static LIRBlock* def_block(const LIRFuncData& data, const LIRVal& lir_val) {
+    if (lir_val.arg().has_value()) {
+        return data.first();
+    }
+
+    return lir_val.inst().value()->owner();
+}
+
+static std::vector<LIRInstructionBase*> unique_users(const LIRVal& lir_val) {
+    std::vector<LIRInstructionBase*> users;
+    for (const auto user: lir_val.users()) {
+        if (!std::ranges::contains(users, user)) {
+            users.push_back(user);
+        }
+    }
+
+    return users;
+}
+
+static void replace_uses(LIRInstructionBase* user, const LIRVal& from, const LIRVal& to) {
+    for (const auto& [idx, op]: std::views::enumerate(user->inputs())) {
+        if (const auto vreg = LIRVal::try_from(op); vreg.has_value() && vreg.value() == from) {
+            user->in(idx, to);
+        }
+    }
+}
+
+/**
+ * @return the register where the return instruction expects the value. Same order as the lowering assigns them.
+ */
+static AssignedVReg return_reg(const LIRInstructionBase* ret, const LIRVal& lir_val) {
+    constexpr aasm::GPReg gp_regs[] = {aasm::rax, aasm::rdx};
+    constexpr aasm::XmmReg fp_regs[] = {aasm::xmm0, aasm::xmm1};
+
+    std::size_t gp_idx{};
+    std::size_t fp_idx{};
+    for (const auto& op: ret->inputs()) {
+        const auto vreg = LIRVal::try_from(op);
+        assertion(vreg.has_value(), "Expected LIRVal for return value");
+
+        const auto is_returned = vreg.value() == lir_val;
+        switch (vreg.value().type()) {
+            case LIRValType::GP: {
+                if (is_returned) {
+                    return gp_regs[gp_idx];
+                }
+                gp_idx += 1;
+                break;
+            }
+            case LIRValType::FP: {
+                if (is_returned) {
+                    return fp_regs[fp_idx];
+                }
+                fp_idx += 1;
+                break;
+            }
+            default: std::unreachable();
+        }
+    }
+
+    die("value is not returned");
+}
+
+static void collect_regs(const std::span<LIROperand const> operands, aasm::RegSet& regs) {
+    for (const auto& op: operands) {
+        const auto vreg = LIRVal::try_from(op);
+        if (!vreg.has_value()) {
+            continue;
+        }
+
+        if (const auto reg = vreg->assigned_reg().to_reg(); reg.has_value()) {
+            regs.emplace(reg.value());
+        }
+    }
+}
+
+static void collect_regs(const std::span<LIRVal const> defs, aasm::RegSet& regs) {
+    for (const auto& def: defs) {
+        if (const auto reg = def.assigned_reg().to_reg(); reg.has_value()) {
+            regs.emplace(reg.value());
+        }
+    }
+}
+
+void BaselineAllocation::run() {
+    lower_parallel_copies();
+    insert_stores_and_reloads();
+    allocate_stack_slots();
+    for (const auto& bb: m_data.basic_blocks()) {
+        allocate_block(&bb);
+    }
+
+    finalize_prologue_epilogue();
+}
+
+void BaselineAllocation::lower_parallel_copies() {
+    for (auto& bb: m_data.basic_blocks()) {
+        const LIRInstructionBase* last_copy{};
+        for (const auto& inst: bb.instructions()) {
+            if (!inst.isa(parallel_copy())) {
+                break;
+            }
+
+            last_copy = &inst;
+        }
+        if (last_copy == nullptr) {
+            continue;
+        }
+
+        const auto after_copies = next_instruction(last_copy);
+        for (auto& inst: bb.instructions()) {
+            if (!inst.isa(parallel_copy())) {
+                break;
+            }
+
+            const auto phi = LIRVal::defs(&inst)[0];
+            const auto slot = stack_slot(phi);
+            for (const auto& input: inst.inputs()) {
+                // Incoming value is the copy right before the jump in the predecessor.
+                const auto incoming = LIRVal::try_from(input).value();
+                const auto incoming_inst = incoming.inst().value();
+                incoming_inst->owner()->ins_before(next_instruction(incoming_inst), LIRInstruction::store_by_offset(phi.type(), slot, LirCst::imm64(0L), incoming));
+            }
+
+            const auto read = bb.ins_before(after_copies, LIRProducerInstruction::read_by_offset(phi.type(), static_cast<std::uint8_t>(phi.size()), slot, LirCst::imm64(0L)));
+            for (const auto user: unique_users(phi)) {
+                replace_uses(user, phi, read->def(0));
+            }
+        }
+    }
+}
+
+void BaselineAllocation::insert_stores_and_reloads() {
+    std::vector<LIRVal> values(m_data.args().begin(), m_data.args().end());
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            std::ranges::copy(LIRVal::defs(&inst), std::back_inserter(values));
+        }
+    }
+
+    for (const auto& lir_val: values) {
+        if (lir_val.users().empty() || lir_val.isa(gen_v()) || lir_val.isa(parallel_copy_v())) {
+            continue;
+        }
+        if (!lir_val.arg().has_value() && !lir_val.inst().has_value()) {
+            // Call results are defined by the block terminator, they are copied right in the continuation.
+            continue;
+        }
+        if (const auto& reg = lir_val.assigned_reg(); !reg.empty() && !reg.to_reg().has_value()) {
+            // Already in memory.
+            continue;
+        }
+
+        const auto is_parallel_copy = [](const LIRInstructionBase* user) { return user->isa(parallel_copy()); };
+        if (std::ranges::any_of(lir_val.users(), is_parallel_copy)) {
+            // Incoming value of the phi, it is stored to the phi slot right after the definition.
+            continue;
+        }
+        if (is_pinned(lir_val)) {
+            continue;
+        }
+
+        store_and_reload(lir_val);
+    }
+}
+
+bool BaselineAllocation::is_pinned(const LIRVal& lir_val) const {
+    if (lir_val.arg().has_value() || !lir_val.assigned_reg().to_reg().has_value()) {
+        return false;
+    }
+
+    // The lowering puts the value into the register right before the instruction which needs it there.
+    const auto def = def_block(m_data, lir_val);
+    const auto is_local = [&](const LIRInstructionBase* user) { return user->owner() == def; };
+    return std::ranges::all_of(lir_val.users(), is_local);
+}
+
+LIRVal BaselineAllocation::stack_slot(const LIRVal& lir_val) const {
+    const auto after_prologue = next_instruction(m_data.prologue());
+    const auto slot = m_data.first()->ins_before(after_prologue, LIRProducerInstruction::gen(static_cast<std::uint8_t>(lir_val.size()), static_cast<std::uint8_t>(lir_val.alignment())));
+    return slot->def(0);
+}
+
+void BaselineAllocation::store_and_reload(const LIRVal& lir_val) {
+    const auto slot = stack_slot(lir_val);
+    const auto def = def_block(m_data, lir_val);
+    const auto store_point = lir_val.arg().has_value() ? next_instruction(slot.inst().value()) : next_instruction(lir_val.inst().value());
+    const auto store = def->ins_before(store_point, LIRInstruction::store_by_offset(lir_val.type(), slot, LirCst::imm64(0L), lir_val));
+
+    const auto fixed_reg = lir_val.arg().has_value() ? std::nullopt : lir_val.assigned_reg().to_reg();
+    for (const auto user: unique_users(lir_val)) {
+        if (user == store) {
+            continue;
+        }
+
+        // The epilogue restores the frame pointer, so the returned value is read before it.
+        const auto is_return = dynamic_cast<const LIRReturn*>(user) != nullptr;
+        const auto reload_point = is_return ? static_cast<const LIRInstructionBase*>(m_data.epilogue()) : user;
+        const auto reload = user->owner()->ins_before(reload_point, LIRProducerInstruction::read_by_offset(lir_val.type(), static_cast<std::uint8_t>(lir_val.size()), slot, LirCst::imm64(0L)));
+        if (is_return) {
+            reload->assign_reg(0, return_reg(user, lir_val));
+
+        } else if (fixed_reg.has_value() && !user->isa(unary_copy())) {
+            fixed_reg->visit([&]<typename T>(const T& reg) { reload->assign_reg(0, reg); });
+        }
+
+        replace_uses(user, lir_val, reload->def(0));
+    }
+}
+
+void BaselineAllocation::allocate_stack_slots() {
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            for (const auto& def: LIRVal::defs(&inst)) {
+                if (!def.isa(gen_v()) || !def.assigned_reg().empty()) {
+                    continue;
+                }
+
+                def.assign_reg(m_reg_set.stack_alloc(def.size(), def.alignment()));
+            }
+        }
+    }
+}
+
+void BaselineAllocation::allocate_block(const LIRBlock* bb) {
+    std::vector<LIRInstructionBase*> instructions;
+    instructions.reserve(bb->size());
+    for (auto& inst: bb->instructions()) {
+        instructions.push_back(&inst);
+    }
+
+    // Parallel copies emit nothing, so they don't keep their inputs in registers.
+    LIRValMap<std::size_t> last_use;
+    LIRValSet block_defs;
+    for (std::size_t idx{}; idx < instructions.size(); ++idx) {
+        const auto inst = instructions[idx];
+        block_defs.insert(LIRVal::defs(inst).begin(), LIRVal::defs(inst).end());
+        if (inst->isa(parallel_copy())) {
+            continue;
+        }
+
+        for (const auto& op: inst->inputs()) {
+            if (const auto vreg = LIRVal::try_from(op); vreg.has_value()) {
+                last_use.insert_or_assign(vreg.value(), idx);
+            }
+        }
+    }
+
+    // Values defined in other blocks are arguments and call results, they come in the registers.
+    std::vector<std::pair<LIRVal, std::size_t>> live;
+    for (const auto& [lir_val, last]: last_use) {
+        if (!block_defs.contains(lir_val) && lir_val.assigned_reg().to_reg().has_value()) {
+            live.emplace_back(lir_val, last);
+        }
+    }
+
+    const auto live_regs = [&] {
+        aasm::RegSet regs;
+        for (const auto& lir_val: live | std::views::keys) {
+            regs.emplace(lir_val.assigned_reg().to_reg().value());
+        }
+        return regs;
+    };
+
+    for (std::size_t idx{}; idx < instructions.size(); ++idx) {
+        const auto inst = instructions[idx];
+        std::erase_if(live, [&](const std::pair<LIRVal, std::size_t>& entry) { return entry.second < idx; });
+
+        const auto end_of = [&](const LIRVal& def) {
+            const auto it = last_use.find(def);
+            return it == last_use.end() ? idx : it->second;
+        };
+
+        const auto defs = LIRVal::defs(inst);
+        for (const auto& def: defs) {
+            if (def.assigned_reg().to_reg().has_value()) {
+                live.emplace_back(def, end_of(def));
+            }
+        }
+
+        for (const auto& def: defs) {
+            if (!def.assigned_reg().empty()) {
+                continue;
+            }
+
+            // Registers taken by the lowering until the last use must stay free.
+            auto exclude = live_regs();
+            const auto end = end_of(def);
+            for (auto next = idx + 1; next <= end; ++next) {
+                collect_regs(instructions[next]->inputs(), exclude);
+                collect_regs(LIRVal::defs(instructions[next]), exclude);
+            }
+
+            select_reg(def, exclude).visit([&]<typename T>(const T& reg) { def.assign_reg(reg); });
+            live.emplace_back(def, end);
+        }
+
+        allocate_temporal_regs(inst, live_regs());
+    }
+}
+
+aasm::Reg BaselineAllocation::select_reg(const LIRVal& lir_val, const aasm::RegSet& exclude) {
+    auto reg_set = details::VRegSelection::create(m_call_conv, exclude);
+    const auto reg = reg_set.top(IntervalHint::NOTHING, lir_val.type());
+    if (const auto gp_reg = reg.as_gp_reg(); gp_reg.has_value() && m_call_conv->GP_CALLEE_SAVE_REGISTERS().contains(gp_reg.value())) {
+        m_used_callee_saved_regs.emplace(gp_reg.value());
+    }
+
+    return reg;
+}
+
+void BaselineAllocation::allocate_temporal_regs(LIRInstructionBase* inst, const aasm::RegSet& exclude) const {
+    if (!inst->temporal_regs().empty()) {
+        return;
+    }
+
+    const auto [gp_num, xmm_num] = details::AllocTemporalRegs::allocate(m_symbol_tab, inst);
+    const auto xmm_regs = m_reg_set.alloc_xmm_temp(exclude, xmm_num);
+    const auto gp_regs = m_reg_set.alloc_gp_temp(exclude, gp_num);
+    inst->init_temporal_regs(TemporalRegs(gp_regs, xmm_regs));
+}
+
+void BaselineAllocation::finalize_prologue_epilogue() const {
+    const auto prologue = m_data.prologue();
+    const auto epilogue = m_data.epilogue();
+    epilogue->add_regs(m_used_callee_saved_regs);
+    prologue->add_regs(m_used_callee_saved_regs);
+    epilogue->increase_local_area_size(m_reg_set.local_area_size());
+    prologue->increase_local_area_size(m_reg_set.local_area_size());
+}
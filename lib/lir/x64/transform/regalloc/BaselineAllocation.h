@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include "VRegSelection.h"
+
+#include "lir/x64/asm/cc/CallConv.h"
+#include "lir/x64/module/LIRFuncData.h"
+#include "lir/x64/operand/LIRValMap.h"
+
+/**
+ * Register allocation of the baseline tier. It runs without liveness or interval analysis.
+ * Every value gets its own stack slot: it is stored right after the definition and reloaded right before every use,
+ * so a value occupies a register only between neighbouring instructions of one block, and the registers are picked
+ * by a single scan of each block. Values pinned to a register by the lowering keep it when all their uses are in the
+ * defining block, the other ones are reloaded into the register the return or the user needs.
+ * Phi values go through their own slot: the incoming values are stored to it before the jump and it is read once
+ * after the parallel copies, so the copies on the edges never overwrite a value which is still read.
+ */
+class BaselineAllocation final {
+    explicit BaselineAllocation(LIRFuncData& data, aasm::SymbolTable& symbol_tab, const call_conv::CallConvProvider* call_conv) noexcept:
+        m_data(data),
+        m_symbol_tab(symbol_tab),
+        m_call_conv(call_conv),
+        m_reg_set(details::VRegSelection::create(call_conv, {})) {}
+
+public:
+    void run();
+
+    static BaselineAllocation create(LIRFuncData* data, aasm::SymbolTable& symbol_tab, const call_conv::CallConvProvider* call_conv) {
+        return BaselineAllocation(*data, symbol_tab, call_conv);
+    }
+
+private:
+    void lower_parallel_copies();
+    void insert_stores_and_reloads();
+    void allocate_stack_slots();
+    void allocate_block(const LIRBlock* bb);
+    void finalize_prologue_epilogue() const;
+
+    [[nodiscard]]
+    LIRVal stack_slot(const LIRVal& lir_val) const;
+    void store_and_reload(const LIRVal& lir_val);
+
+    [[nodiscard]]
+    bool is_pinned(const LIRVal& lir_val) const;
+
+    [[nodiscard]]
+    aasm::Reg select_reg(const LIRVal& lir_val, const aasm::RegSet& exclude);
+    void allocate_temporal_regs(LIRInstructionBase* inst, const aasm::RegSet& exclude) const;
+
+    LIRFuncData& m_data;
+    aasm::SymbolTable& m_symbol_tab;
+    const call_conv::CallConvProvider* m_call_conv;
+
+    details::VRegSelection m_reg_set;
+    aasm::RegSet m_used_callee_saved_regs{};
+};
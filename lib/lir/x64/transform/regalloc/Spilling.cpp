@@ -0,0 +1,262 @@
+#include "Spilling.h"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include <tuple>
+
+#include "lir/x64/analysis/Analysis.h"
+#include "lir/x64/instruction/LIRAdjustStack.h"
+#include "lir/x64/instruction/LIRInstruction.h"
+#include "lir/x64/instruction/LIRProducerInstruction.h"
+#include "lir/x64/instruction/Matcher.h"
+#include "lir/x64/operand/LIRCst.h"
+#include "lir/x64/operand/OperandMatcher.h"
+
+static constexpr auto NO_NEXT_USE = std::numeric_limits<std::uint32_t>::max();
+
+static LIRBlock* def_block(const LIRFuncData& data, const LIRVal& lir_val) {
+    if (lir_val.arg().has_value()) {
+        return data.first();
+    }
+
+    return lir_val.inst().value()->owner();
+}
+
+static const LIRInstructionBase* next_instruction(const LIRInstructionBase* inst) {
+    bool found = false;
+    for (const auto& current: inst->owner()->instructions()) {
+        if (found) {
+            return &current;
+        }
+
+        found = &current == inst;
+    }
+
+    die("instruction has no successor in its block");
+}
+
+static bool uses(const LIRInstructionBase* inst, const LIRVal& lir_val) {
+    const auto pred = [&](const LIROperand& op) {
+        const auto vreg = LIRVal::try_from(op);
+        return vreg.has_value() && vreg.value() == lir_val;
+    };
+
+    return std::ranges::any_of(inst->inputs(), pred);
+}
+
+void Spilling::run() {
+    while (spill_round()) {}
+}
+
+bool Spilling::spill_round() {
+    LIRAnalysisPassManager cache;
+    const auto intervals = cache.analyze<LiveIntervalsEval>(&m_data);
+    const auto groups = cache.analyze<LiveIntervalsJoinEval>(&m_data);
+    const auto preorder = cache.analyze<PreorderTraverseLIR>(&m_data);
+    const auto loops = cache.analyze<LoopInfoEvalLIR>(&m_data);
+    number_instructions(*preorder);
+
+    const auto victims = select_victims(*intervals, *groups, *loops);
+    for (const auto& victim: victims) {
+        spill(victim);
+    }
+
+    return !victims.empty();
+}
+
+void Spilling::number_instructions(const Ordering<LIRBlock>& preorder) {
+    // Same numbering as in LiveIntervalsEval. Arguments are defined at the point 0.
+    m_positions.clear();
+    std::uint32_t inst_number{};
+    for (const auto bb: preorder) {
+        for (const auto& inst: bb->instructions()) {
+            inst_number += 1;
+            m_positions.emplace(&inst, inst_number);
+        }
+    }
+}
+
+std::vector<LIRVal> Spilling::select_victims(const LiveIntervals& intervals, const LiveIntervalsGroups& groups, const LoopInfo<LIRBlock>& loops) const {
+    std::vector<std::pair<LIRVal, LiveRange>> ranges;
+    for (const auto& [lir_val, interval]: intervals.intervals()) {
+        if (lir_val.isa(gen_v())) {
+            // Lives on the stack.
+            continue;
+        }
+
+        for (const auto& range: interval) {
+            ranges.emplace_back(lir_val, range);
+        }
+    }
+
+    // The intervals come from a hash map, ties are broken by the definition so the victims don't depend on its order.
+    const auto by_start = [&](const std::pair<LIRVal, LiveRange>& entry) {
+        return std::make_tuple(entry.second.start(), vreg_order(entry.first), entry.first.index());
+    };
+    std::ranges::stable_sort(ranges, {}, by_start);
+
+    std::vector<LIRVal> victims;
+    LIRValSet selected;
+    std::vector<std::pair<LIRVal, LiveRange>> active;
+    for (std::size_t idx = 0; idx < ranges.size();) {
+        const auto point = ranges[idx].second.start();
+        // The value whose last use is at the point leaves its register to the value defined at the point.
+        const auto is_expired = [&](const std::pair<LIRVal, LiveRange>& entry) {
+            const auto& range = entry.second;
+            return range.end() < point || (range.end() == point && range.start() < point);
+        };
+        std::erase_if(active, is_expired);
+
+        for (; idx < ranges.size() && ranges[idx].second.start() == point; ++idx) {
+            if (!selected.contains(ranges[idx].first)) {
+                active.push_back(ranges[idx]);
+            }
+        }
+
+        for (const auto type: {LIRValType::GP, LIRValType::FP}) {
+            const auto is_same_type = [&](const std::pair<LIRVal, LiveRange>& entry) {
+                return entry.first.type() == type;
+            };
+
+            while (static_cast<std::size_t>(std::ranges::count_if(active, is_same_type)) > max_live_values(type)) {
+                std::optional<LIRVal> victim{};
+                auto victim_depth = std::numeric_limits<std::size_t>::max();
+                auto victim_next_use = point;
+                for (const auto& lir_val: active | std::views::filter(is_same_type) | std::views::keys) {
+                    if (!is_spillable(lir_val, groups) || is_live_after_split(lir_val, point)) {
+                        continue;
+                    }
+
+                    const auto depth = use_depth(lir_val, loops);
+                    const auto use = next_use(lir_val, point);
+                    if (use <= point) {
+                        continue;
+                    }
+                    if (depth < victim_depth || (depth == victim_depth && use > victim_next_use)) {
+                        victim = lir_val;
+                        victim_depth = depth;
+                        victim_next_use = use;
+                    }
+                }
+
+                if (!victim.has_value()) {
+                    // Nothing helps at this point, leave it to the allocator.
+                    break;
+                }
+
+                selected.emplace(victim.value());
+                victims.push_back(victim.value());
+                std::erase_if(active, [&](const std::pair<LIRVal, LiveRange>& entry) { return entry.first == victim.value(); });
+            }
+        }
+    }
+
+    return victims;
+}
+
+bool Spilling::is_spillable(const LIRVal& lir_val, const LiveIntervalsGroups& groups) const {
+    if (m_spilled.contains(lir_val) || m_reloads.contains(lir_val)) {
+        return false;
+    }
+    if (groups.try_get_group(lir_val).has_value()) {
+        // Joined values share the register, they are allocated as a whole.
+        return false;
+    }
+    if (lir_val.arg().has_value()) {
+        // Arguments passed on the stack are already in memory.
+        return lir_val.assigned_reg().to_reg().has_value();
+    }
+
+    // Call results are defined by the block terminator, there is no place for the spill store.
+    if (!lir_val.inst().has_value() || lir_val.isa(parallel_copy_v()) || !lir_val.assigned_reg().empty()) {
+        return false;
+    }
+
+    const auto is_parallel_copy = [](const LIRInstructionBase* user) { return user->isa(parallel_copy()); };
+    return std::ranges::none_of(lir_val.users(), is_parallel_copy);
+}
+
+bool Spilling::is_live_after_split(const LIRVal& lir_val, const std::uint32_t point) const {
+    // After the split the value lives only up to the store, and each reload only up to its use.
+    // So the split helps anywhere but at the definition itself.
+    const auto def_pos = lir_val.arg().has_value() ? std::optional<std::uint32_t>(0) : position(lir_val.inst().value());
+    return def_pos == point;
+}
+
+std::uint32_t Spilling::vreg_order(const LIRVal& lir_val) const {
+    if (lir_val.arg().has_value()) {
+        return 0;
+    }
+
+    return position(lir_val.inst().value()).value_or(NO_NEXT_USE);
+}
+
+std::uint32_t Spilling::next_use(const LIRVal& lir_val, const std::uint32_t point) const {
+    auto next = NO_NEXT_USE;
+    for (const auto user: lir_val.users()) {
+        const auto pos = position(user);
+        if (pos.has_value() && pos.value() > point) {
+            next = std::min(next, pos.value());
+        }
+    }
+
+    return next;
+}
+
+std::size_t Spilling::use_depth(const LIRVal& lir_val, const LoopInfo<LIRBlock>& loops) {
+    std::size_t depth{};
+    for (const auto user: lir_val.users()) {
+        depth = std::max(depth, loops.depth(user->owner()));
+    }
+
+    return depth;
+}
+
+std::size_t Spilling::max_live_values(const LIRValType type) const noexcept {
+    // Keep room for the temporal registers of the instructions.
+    switch (type) {
+        case LIRValType::GP: return m_call_conv->ALL_GP_REGISTERS().size() - TemporalRegs::MAX_NOF_GP_TEMPORAL_REGS;
+        case LIRValType::FP: return m_call_conv->ALL_XMM_REGISTERS().size() - TemporalRegs::MAX_NOF_XMM_TEMPORAL_REGS;
+        default: std::unreachable();
+    }
+}
+
+void Spilling::spill(const LIRVal& lir_val) {
+    const auto entry = m_data.first();
+    const auto after_prologue = next_instruction(m_data.prologue());
+    const auto slot = entry->ins_before(after_prologue, LIRProducerInstruction::gen(static_cast<std::uint8_t>(lir_val.size()), static_cast<std::uint8_t>(lir_val.alignment())));
+    const auto slot_val = slot->def(0);
+
+    const auto def = def_block(m_data, lir_val);
+    const auto store_point = lir_val.arg().has_value() ? after_prologue : next_instruction(lir_val.inst().value());
+    const auto store = def->ins_before(store_point, LIRInstruction::store_by_offset(lir_val.type(), slot_val, LirCst::imm64(0L), lir_val));
+    m_spilled.emplace(lir_val);
+
+    // Every use reads the value from the slot right before it, so neither the value
+    // nor its reloads live across the other instructions of the block.
+    const std::vector<LIRInstructionBase*> users(lir_val.users().begin(), lir_val.users().end());
+    for (const auto user: users) {
+        if (user == store || !uses(user, lir_val)) {
+            continue;
+        }
+
+        const auto load = user->owner()->ins_before(user, LIRProducerInstruction::read_by_offset(lir_val.type(), static_cast<std::uint8_t>(lir_val.size()), slot_val, LirCst::imm64(0L)));
+        const auto reload = load->def(0);
+        m_reloads.emplace(reload);
+        for (const auto& [idx, op]: std::views::enumerate(user->inputs())) {
+            if (const auto vreg = LIRVal::try_from(op); vreg.has_value() && vreg.value() == lir_val) {
+                user->in(idx, reload);
+            }
+        }
+    }
+}
+
+std::optional<std::uint32_t> Spilling::position(const LIRInstructionBase* inst) const {
+    const auto it = m_positions.find(inst);
+    if (it == m_positions.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
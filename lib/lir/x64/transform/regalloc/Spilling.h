@@ -0,0 +1,78 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/analysis/loop/LoopInfo.h"
+#include "base/analysis/traverse/Ordering.h"
+#include "lir/x64/analysis/intervals/LiveIntervals.h"
+#include "lir/x64/analysis/join_intervals/LiveIntervalsGroups.h"
+#include "lir/x64/asm/cc/CallConv.h"
+#include "lir/x64/module/LIRFuncData.h"
+#include "lir/x64/operand/LIRValMap.h"
+
+/**
+ * Lowers register pressure of the function below the number of allocatable registers before LinearScan runs.
+ * When too many values are live at some point, the value with the furthest next use is spilled:
+ * it is stored into its own stack slot right after the definition and reloaded right before every use.
+ * So the interval is split inside the blocks too, it keeps a register only from the definition to the store
+ * and from each reload to its use.
+ * Values used in deeper loops are spilled last, since their reloads would run on every iteration.
+ */
+class Spilling final {
+    explicit Spilling(LIRFuncData& data, const call_conv::CallConvProvider* call_conv) noexcept:
+        m_data(data),
+        m_call_conv(call_conv) {}
+
+public:
+    void run();
+
+    static Spilling create(LIRFuncData* data, const call_conv::CallConvProvider* call_conv) {
+        return Spilling(*data, call_conv);
+    }
+
+private:
+    /**
+     * Spills values at every point where the register pressure is too high.
+     * Returns false if nothing was spilled.
+     */
+    bool spill_round();
+    void number_instructions(const Ordering<LIRBlock>& preorder);
+
+    [[nodiscard]]
+    std::vector<LIRVal> select_victims(const LiveIntervals& intervals, const LiveIntervalsGroups& groups, const LoopInfo<LIRBlock>& loops) const;
+
+    [[nodiscard]]
+    bool is_spillable(const LIRVal& lir_val, const LiveIntervalsGroups& groups) const;
+
+    [[nodiscard]]
+    bool is_live_after_split(const LIRVal& lir_val, std::uint32_t point) const;
+
+    /**
+     * Orders the values by their definitions: arguments first, then the instructions by their positions.
+     */
+    [[nodiscard]]
+    std::uint32_t vreg_order(const LIRVal& lir_val) const;
+
+    [[nodiscard]]
+    std::uint32_t next_use(const LIRVal& lir_val, std::uint32_t point) const;
+
+    [[nodiscard]]
+    static std::size_t use_depth(const LIRVal& lir_val, const LoopInfo<LIRBlock>& loops);
+
+    [[nodiscard]]
+    std::size_t max_live_values(LIRValType type) const noexcept;
+
+    void spill(const LIRVal& lir_val);
+
+    [[nodiscard]]
+    std::optional<std::uint32_t> position(const LIRInstructionBase* inst) const;
+
+    LIRFuncData& m_data;
+    const call_conv::CallConvProvider* m_call_conv;
+
+    std::unordered_map<const LIRInstructionBase*, std::uint32_t> m_positions;
+    // Already spilled values and reloads. They are never spilled again.
+    LIRValSet m_spilled;
+    LIRValSet m_reloads;
+};
@@ -5,27 +5,22 @@
 
 namespace details {
     aasm::GPReg VRegSelection::top_gp(const IntervalHint hint) noexcept {
-        switch (hint) {
-            case IntervalHint::NOTHING: {
-                for (const auto reg: std::ranges::reverse_view(m_free_gp_regs)) {
-                    if (!m_call_conv->GP_CALLER_SAVE_REGISTERS().contains(reg)) {
-                        continue;
-                    }
-
-                    remove(reg);
-                    return reg;
-                }
-
-                [[fallthrough]];
-            }
-            case IntervalHint::CALL_LIVE_OUT: {
-                assertion(!m_free_gp_regs.empty(), "Attempted to access top of an empty register set");
-                const auto reg = m_free_gp_regs.back();
-                m_free_gp_regs.pop_back();
-                return reg;
+        // Values which live across a call go to callee-saved registers: they are saved once in the prologue
+        // instead of around every call. Other values take caller-saved registers, which cost nothing to clobber.
+        const auto& preferred = hint == IntervalHint::CALL_LIVE_OUT ? m_call_conv->GP_CALLEE_SAVE_REGISTERS() : m_call_conv->GP_CALLER_SAVE_REGISTERS();
+        for (const auto reg: std::ranges::reverse_view(m_free_gp_regs)) {
+            if (!preferred.contains(reg)) {
+                continue;
             }
-            default: std::unreachable();
+
+            remove(reg);
+            return reg;
         }
+
+        assertion(!m_free_gp_regs.empty(), "Attempted to access top of an empty register set");
+        const auto reg = m_free_gp_regs.back();
+        m_free_gp_regs.pop_back();
+        return reg;
     }
 
     aasm::XmmReg VRegSelection::top_xmm(const IntervalHint hint) noexcept {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "base/analysis/dom/DominanceFrontierEvalBase.h"
 #include "base/analysis/dom/DominatorTreeEvalBase.h"
+#include "base/analysis/loop/LoopInfoEvalBase.h"
 #include "base/analysis/traverse/BFSOrderTraverseBase.h"
 #include "base/analysis/traverse/PostOrderTraverseBase.h"
 #include "base/analysis/traverse/PreorderTraverseBase.h"
@@ -11,10 +13,14 @@ using BFSOrderTraverse = BFSOrderTraverseBase<FunctionData>;
 using PostOrderTraverse = PostOrderTraverseBase<FunctionData>;
 using PreorderTraverse = PreorderTraverseBase<FunctionData>;
 using DominatorTreeEval = DominatorTreeEvalBase<FunctionData>;
+using DominanceFrontierEval = DominanceFrontierEvalBase<FunctionData>;
+using LoopInfoEval = LoopInfoEvalBase<FunctionData>;
 
 static_assert(Analysis<BFSOrderTraverse>);
 static_assert(Analysis<PostOrderTraverse>);
 static_assert(Analysis<PreorderTraverse>);
 static_assert(Analysis<DominatorTreeEval>);
+static_assert(Analysis<DominanceFrontierEval>);
+static_assert(Analysis<LoopInfoEval>);
 
 using AnalysisPassManager = AnalysisPassManagerBase<FunctionData>;
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "mir/instruction/Icmp.h"
 #include "mir/instruction/Phi.h"
 #include "mir/instruction/Select.h"
+#include "mir/instruction/VectorInstruction.h"
 #include "mir/instruction/Store.h"
 #include "mir/instruction/TerminateInstruction.h"
 #include "mir/instruction/TerminateValueInstruction.h"
@@ -51,6 +52,11 @@ public:
         return m_bb->ins(Binary::sub(lhs, rhs));
     }
 
+    [[nodiscard]]
+    Value mul(const Value& lhs, const Value& rhs) const {
+        return m_bb->ins(Binary::mul(lhs, rhs));
+    }
+
     [[nodiscard]]
     Value shl(const Value& lhs, const Value& count) const {
         return m_bb->ins(Binary::shl(lhs, count));
@@ -61,6 +67,16 @@ public:
         return m_bb->ins(Binary::shr(lhs, count));
     }
 
+    [[nodiscard]]
+    Value aand(const Value& lhs, const Value& rhs) const {
+        return m_bb->ins(Binary::aand(lhs, rhs));
+    }
+
+    [[nodiscard]]
+    Value oor(const Value& lhs, const Value& rhs) const {
+        return m_bb->ins(Binary::oor(lhs, rhs));
+    }
+
     [[nodiscard]]
     Value xxor(const Value& lhs, const Value& rhs) const {
         return m_bb->ins(Binary::xxor(lhs, rhs));
@@ -99,6 +115,21 @@ public:
         return m_bb->ins(Select::select(cond, lhs, rhs));
     }
 
+    [[nodiscard]]
+    Value broadcast(const VectorType* type, const Value& scalar) const {
+        return m_bb->ins(VectorInstruction::broadcast(type, scalar));
+    }
+
+    [[nodiscard]]
+    Value shuffle(const Value& lhs, const Value& rhs, const std::uint8_t control) const {
+        return m_bb->ins(VectorInstruction::shuffle(lhs, rhs, control));
+    }
+
+    [[nodiscard]]
+    Value vcmp(const IcmpPredicate predicate, const Value& lhs, const Value& rhs) const {
+        return m_bb->ins(VectorInstruction::cmp(predicate, lhs, rhs));
+    }
+
     [[nodiscard]]
     Value phi(const PrimitiveType* type, std::vector<Value>&& values, std::vector<BasicBlock*>&& targets) const {
         return m_bb->ins(Phi::phi(type, std::move(values), std::move(targets)));
@@ -129,6 +160,12 @@ public:
         switch_block(cont);
     }
 
+    void ivcall(const FunctionPrototype* prototype, const Value& pointer, std::vector<Value>&& args) {
+        const auto cont = create_basic_block();
+        m_bb->ins(IVCall::call(prototype, pointer, std::move(args), cont));
+        switch_block(cont);
+    }
+
     [[nodiscard]]
     Value gep(const NonTrivialType* ty, const Value& pointer, const Value& index) const {
         return m_bb->ins(GetElementPtr::gep(ty, pointer, index));
@@ -149,6 +186,16 @@ public:
         return m_bb->ins(Unary::zext(to_type, value));
     }
 
+    [[nodiscard]]
+    Value neg(const Value& value) const {
+        return m_bb->ins(Unary::neg(value));
+    }
+
+    [[nodiscard]]
+    Value nnot(const Value& value) const {
+        return m_bb->ins(Unary::nnot(value));
+    }
+
     [[nodiscard]]
     Value trunc(const IntegerType* to_type, const Value& value) const {
         return m_bb->ins(Unary::trunc(to_type, value));
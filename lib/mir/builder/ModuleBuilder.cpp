@@ -43,8 +43,7 @@ static void finalize_function(FunctionData* fd) noexcept {
             continue;
         }
 
-        auto current = fd->remove(&bb);
-        fd->add_basic_block(std::move(current));
+        fd->add_basic_block(fd->remove(&bb));
         break;
     }
 }
@@ -2,19 +2,7 @@
 
 #include "mir/global/Initializer.h"
 #include "mir/global/GlobalSymbol.h"
-
-enum class GValueKind : uint8_t {
-    CONSTANT,
-    VARIABLE,
-};
-
-inline std::string_view to_string(const GValueKind kind) {
-    switch (kind) {
-        case GValueKind::CONSTANT: return "constant";
-        case GValueKind::VARIABLE: return "variable";
-        default: std::unreachable();
-    }
-}
+#include "base/global/GValueKind.h"
 
 class GlobalValue final: public GlobalSymbol {
 public:
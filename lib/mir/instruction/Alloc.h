@@ -12,8 +12,8 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<Alloc> alloc(const NonTrivialType* ty) {
-        return std::make_unique<Alloc>(ty);
+    static auto alloc(const NonTrivialType* ty) {
+        return construct<Alloc>(ty);
     }
 
     [[nodiscard]]
@@ -36,33 +36,48 @@ public:
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> add(const Value &lhs, const Value &rhs) {
-        return std::make_unique<Binary>(BinaryOp::Add, lhs, rhs);
+    static auto add(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::Add, lhs, rhs);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> sub(const Value &lhs, const Value &rhs) {
-        return std::make_unique<Binary>(BinaryOp::Subtract, lhs, rhs);
+    static auto sub(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::Subtract, lhs, rhs);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> shl(const Value &lhs, const Value &count) {
-        return std::make_unique<Binary>(BinaryOp::ShiftLeft, lhs, count);
+    static auto mul(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::Multiply, lhs, rhs);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> shr(const Value &lhs, const Value &count) {
-        return std::make_unique<Binary>(BinaryOp::ShiftRight, lhs, count);
+    static auto shl(const Value &lhs, const Value &count) {
+        return construct<Binary>(BinaryOp::ShiftLeft, lhs, count);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> xxor(const Value &lhs, const Value &rhs) {
-        return std::make_unique<Binary>(BinaryOp::BitwiseXor, lhs, rhs);
+    static auto shr(const Value &lhs, const Value &count) {
+        return construct<Binary>(BinaryOp::ShiftRight, lhs, count);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Binary> div(const Value &lhs, const Value &rhs) {
-        return std::make_unique<Binary>(BinaryOp::Divide, lhs, rhs);
+    static auto aand(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::BitwiseAnd, lhs, rhs);
+    }
+
+    [[nodiscard]]
+    static auto oor(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::BitwiseOr, lhs, rhs);
+    }
+
+    [[nodiscard]]
+    static auto xxor(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::BitwiseXor, lhs, rhs);
+    }
+
+    [[nodiscard]]
+    static auto div(const Value &lhs, const Value &rhs) {
+        return construct<Binary>(BinaryOp::Divide, lhs, rhs);
     }
 
 private:
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 #include "Compare.h"
 
 enum class FcmpPredicate: std::uint8_t {
@@ -56,8 +56,8 @@ public:
     }
 
     [[nodiscard]]
-    static std::unique_ptr<FcmpInstruction> fcmp(const FcmpPredicate pred, const Value& lhs, const Value& rhs) {
-        return std::make_unique<FcmpInstruction>(pred, lhs, rhs);
+    static auto fcmp(const FcmpPredicate pred, const Value& lhs, const Value& rhs) {
+        return construct<FcmpInstruction>(pred, lhs, rhs);
     }
 
 private:
@@ -20,8 +20,8 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<GetElementPtr> gep(const NonTrivialType* basic_type, const Value &pointer, const Value &index) {
-        return std::make_unique<GetElementPtr>(basic_type, pointer, index);
+    static auto gep(const NonTrivialType* basic_type, const Value &pointer, const Value &index) {
+        return construct<GetElementPtr>(basic_type, pointer, index);
     }
 
 private:
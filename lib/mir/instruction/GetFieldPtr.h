@@ -27,8 +27,8 @@ public:
         return m_basic_type->field_type_of(m_index);
     }
 
-    static std::unique_ptr<GetFieldPtr> gfp(const StructType* basic_type, const Value &pointer, const std::size_t index) {
-        return std::make_unique<GetFieldPtr>(basic_type, pointer, index);
+    static auto gfp(const StructType* basic_type, const Value &pointer, const std::size_t index) {
+        return construct<GetFieldPtr>(basic_type, pointer, index);
     }
 
 private:
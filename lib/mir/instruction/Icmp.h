@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 #include "Compare.h"
 
 enum class IcmpPredicate {
@@ -37,8 +37,8 @@ public:
         return m_pred;
     }
 
-    static std::unique_ptr<IcmpInstruction> icmp(const IcmpPredicate pred, const Value& lhs, const Value& rhs) {
-        return std::make_unique<IcmpInstruction>(pred, lhs, rhs);
+    static auto icmp(const IcmpPredicate pred, const Value& lhs, const Value& rhs) {
+        return construct<IcmpInstruction>(pred, lhs, rhs);
     }
 
 private:
@@ -23,6 +23,8 @@
 #include "mir/instruction/Select.h"
 #include "mir/instruction/Alloc.h"
 #include "mir/instruction/Store.h"
+#include "mir/instruction/VectorInstruction.h"
+#include "mir/value/UsedValue.h"
 
 #include "utility/Error.h"
 
@@ -216,6 +218,23 @@ namespace {
             os << ' ' << proj->operand() << ": " << proj->idx();
         }
 
+        void accept(VectorInstruction *vec) override {
+            print_val(vec);
+            os << "vector " << to_string(vec->op()) << ' ' << *vec->type();
+            switch (vec->op()) {
+                case VectorOp::Broadcast: os << ' ' << vec->lhs(); break;
+                case VectorOp::Shuffle: {
+                    os << ' ' << vec->lhs() << ", " << vec->rhs() << ": " << static_cast<unsigned>(vec->control());
+                    break;
+                }
+                case VectorOp::Compare: {
+                    os << ' ' << to_string(vec->predicate()) << ' ' << vec->lhs() << ", " << vec->rhs();
+                    break;
+                }
+                default: std::unreachable();
+            }
+        }
+
         std::ostream& os;
     };
 }
@@ -224,4 +243,15 @@ namespace {
 void Instruction::print(std::ostream& os) const {
     Printer p(os);
     p.do_print(const_cast<Instruction *>(this));
-}
\ No newline at end of file
+}
+void Instruction::replace_operand(const std::size_t idx, const Value &new_value) {
+    assertion(idx < m_values.size(), "index out of bounds");
+    if (const auto old = UsedValue::try_from(m_values[idx]); old.has_value()) {
+        old->kill_user(this);
+    }
+
+    m_values[idx] = new_value;
+    if (auto local = UsedValue::try_from(new_value); local.has_value()) {
+        local->add_user(this);
+    }
+}
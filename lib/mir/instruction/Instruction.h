@@ -7,14 +7,13 @@
 
 #include "InstructionVisitor.h"
 #include "base/CommonInstruction.h"
+#include "utility/Arena.h"
 #include "mir/value/Value.h"
 
 template<typename F>
 concept InstructionMatcher = std::is_invocable_r_v<bool, F, const Instruction*>;
 
 class Instruction : public CommonInstruction<BasicBlock> {
-    static constexpr auto NO_ID = std::numeric_limits<std::size_t>::max();
-
 public:
     explicit Instruction(std::vector<Value>&& values) noexcept:
         m_values(std::move(values)) {}
@@ -31,6 +30,11 @@ public:
         return m_values;
     }
 
+    /**
+     * Replaces the operand at the given index and keeps def-use chains consistent.
+     */
+    void replace_operand(std::size_t idx, const Value& new_value);
+
     virtual void visit(Visitor& visitor) = 0;
 
     void print(std::ostream& os) const;
@@ -38,7 +42,5 @@ public:
 protected:
     friend class BasicBlock;
 
-    BasicBlock* m_owner{};
-    std::size_t m_id{NO_ID};
     std::vector<Value> m_values;
 };
\ No newline at end of file
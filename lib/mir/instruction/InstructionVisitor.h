@@ -26,4 +26,5 @@ public:
     virtual void accept(Select* select) = 0;
     virtual void accept(IntDiv* div) = 0;
     virtual void accept(Projection* proj) = 0;
+    virtual void accept(VectorInstruction* vec) = 0;
 };
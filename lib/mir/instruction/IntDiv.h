@@ -31,8 +31,8 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<IntDiv> div(const Value &lhs, const Value &rhs) {
-        return std::make_unique<IntDiv>(lhs, rhs);
+    static auto div(const Value &lhs, const Value &rhs) {
+        return construct<IntDiv>(lhs, rhs);
     }
 
 private:
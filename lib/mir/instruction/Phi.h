@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+
 #include "ValueInstruction.h"
+#include "mir/value/UsedValue.h"
 
 class Phi final: public ValueInstruction {
 public:
@@ -14,8 +17,51 @@ public:
         return m_entries;
     }
 
-    static std::unique_ptr<Phi> phi(const PrimitiveType* type, std::vector<Value>&& values, std::vector<BasicBlock*>&& targets) {
-        return std::make_unique<Phi>(type, std::move(values), std::move(targets));
+    /**
+     * Appends the incoming value for the given predecessor.
+     */
+    void add_incoming(const Value& value, BasicBlock* target) {
+        m_values.push_back(value);
+        m_entries.push_back(target);
+        if (m_owner == nullptr) {
+            // Def-use chain is built when the phi is inserted into a block.
+            return;
+        }
+
+        if (auto local = UsedValue::try_from(value); local.has_value()) {
+            local->add_user(this);
+        }
+    }
+
+    /**
+     * Removes the incoming values of the given predecessor.
+     */
+    void remove_incoming(const BasicBlock* target) {
+        for (auto idx = m_entries.size(); idx-- > 0;) {
+            if (m_entries[idx] != target) {
+                continue;
+            }
+
+            if (m_owner != nullptr) {
+                if (const auto local = UsedValue::try_from(m_values[idx]); local.has_value()) {
+                    local->kill_user(this);
+                }
+            }
+
+            m_values.erase(m_values.begin() + static_cast<std::ptrdiff_t>(idx));
+            m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(idx));
+        }
+    }
+
+    /**
+     * Makes the values incoming from one block come from another one. Used when the predecessor is merged into a block.
+     */
+    void replace_incoming_block(const BasicBlock* from, BasicBlock* to) {
+        std::ranges::replace(m_entries, from, to);
+    }
+
+    static auto phi(const PrimitiveType* type, std::vector<Value>&& values, std::vector<BasicBlock*>&& targets) {
+        return construct<Phi>(type, std::move(values), std::move(targets));
     }
 
 private:
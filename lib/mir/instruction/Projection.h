@@ -1,5 +1,5 @@
 #pragma once
-#include <memory>
+#include "utility/Arena.h"
 
 #include "ValueInstruction.h"
 #include "mir/types/TupleType.h"
@@ -22,10 +22,10 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<Projection> proj(const Value& operand, const std::uint8_t idx) {
+    static auto proj(const Value& operand, const std::uint8_t idx) {
         const auto type = dynamic_cast<const TupleType*>(operand.type());
         assertion(type != nullptr, "expected");
-        return std::make_unique<Projection>(type->inner_type(idx), operand, idx);
+        return construct<Projection>(type->inner_type(idx), operand, idx);
     }
 
 private:
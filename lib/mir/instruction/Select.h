@@ -27,7 +27,7 @@ public:
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Select> select(const Value& cond, const Value& true_val, const Value& false_val) {
-        return std::make_unique<Select>(true_val.type(), std::vector{cond, true_val, false_val});
+    static auto select(const Value& cond, const Value& true_val, const Value& false_val) {
+        return construct<Select>(true_val.type(), std::vector{cond, true_val, false_val});
     }
 };
\ No newline at end of file
@@ -19,7 +19,7 @@ public:
         return m_values[1];
     }
 
-    static std::unique_ptr<Store> store(const Value& ptr, const Value& value) {
-        return std::make_unique<Store>(ptr, value);
+    static auto store(const Value& ptr, const Value& value) {
+        return construct<Store>(ptr, value);
     }
 };
\ No newline at end of file
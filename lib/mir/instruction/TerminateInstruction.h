@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 
 #include "Callable.h"
 #include "mir/module/FunctionPrototype.h"
@@ -30,8 +30,8 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<Return> ret() {
-        return std::make_unique<Return>();
+    static auto ret() {
+        return construct<Return>();
     }
 private:
     std::vector<BasicBlock* > m_successors;
@@ -59,8 +59,8 @@ public:
         return m_values[0];
     }
 
-    static std::unique_ptr<CondBranch> br_cond(const Value& condition, BasicBlock *true_target, BasicBlock *false_target) {
-        return std::make_unique<CondBranch>(condition, true_target, false_target);
+    static auto br_cond(const Value& condition, BasicBlock *true_target, BasicBlock *false_target) {
+        return construct<CondBranch>(condition, true_target, false_target);
     }
 };
 
@@ -76,8 +76,8 @@ public:
         return m_successors.front();
     }
 
-    static std::unique_ptr<Branch> br(BasicBlock *target) {
-        return std::make_unique<Branch>(target);
+    static auto br(BasicBlock *target) {
+        return construct<Branch>(target);
     }
 };
 
@@ -89,9 +89,27 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<Switch> sw(const Value &condition, std::vector<Value> &&cases, BasicBlock* default_target, std::vector<BasicBlock*>&& targets) {
+    [[nodiscard]]
+    const Value& condition() const {
+        return m_values[0];
+    }
+
+    /**
+     * Case values, the i-th one leads to the i-th successor.
+     */
+    [[nodiscard]]
+    std::span<const Value> cases() const noexcept {
+        return m_cases;
+    }
+
+    [[nodiscard]]
+    BasicBlock* default_target() const {
+        return m_successors.back();
+    }
+
+    static auto sw(const Value &condition, std::vector<Value> &&cases, BasicBlock* default_target, std::vector<BasicBlock*>&& targets) {
         targets.emplace_back(default_target);
-        return std::make_unique<Switch>(condition, std::move(cases), std::move(targets));
+        return construct<Switch>(condition, std::move(cases), std::move(targets));
     }
 
 private:
@@ -132,12 +150,12 @@ public:
         }
     }
 
-    static std::unique_ptr<ReturnValue> ret(const Value& ret_value) {
-        return std::make_unique<ReturnValue>(std::vector{ret_value});
+    static auto ret(const Value& ret_value) {
+        return construct<ReturnValue>(std::vector{ret_value});
     }
 
-    static std::unique_ptr<ReturnValue> ret(const Value& first, const Value& second) {
-        return std::make_unique<ReturnValue>(std::vector{first, second});
+    static auto ret(const Value& first, const Value& second) {
+        return construct<ReturnValue>(std::vector{first, second});
     }
 
 private:
@@ -158,9 +176,9 @@ public:
         return m_successors.front();
     }
 
-    static std::unique_ptr<VCall> call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
+    static auto call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
         assertion(proto->ret_type()->isa(void_type()), "Call instruction must have a non-void return type");
-        return std::make_unique<VCall>(proto, std::move(args), cont);
+        return construct<VCall>(proto, std::move(args), cont);
     }
 };
 
@@ -172,8 +190,27 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<IVCall> call(const FunctionPrototype* prototype, const Value& pointer, std::vector<Value> &&args, BasicBlock *successor) {
+    [[nodiscard]]
+    const BasicBlock * cont() const noexcept {
+        assertion(m_successors.size() == 1, "IVCall must have exactly one successor");
+        return m_successors.front();
+    }
+
+    /**
+     * The callee address is kept as the last operand.
+     */
+    [[nodiscard]]
+    const Value& pointer() const noexcept {
+        return m_values.back();
+    }
+
+    [[nodiscard]]
+    std::span<const Value> arguments() const noexcept {
+        return std::span{m_values}.first(m_values.size() - 1);
+    }
+
+    static auto call(const FunctionPrototype* prototype, const Value& pointer, std::vector<Value> &&args, BasicBlock *successor) {
         args.push_back(pointer);
-        return std::make_unique<IVCall>(prototype, std::move(args), successor);
+        return construct<IVCall>(prototype, std::move(args), successor);
     }
 };
\ No newline at end of file
@@ -35,9 +35,9 @@ public:
 
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
-    static std::unique_ptr<Call> call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
+    static auto call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
         assertion(!proto->ret_type()->isa(void_type()), "Call instruction must have a non-void return type");
-        return std::make_unique<Call>(proto, cont, std::move(args));
+        return construct<Call>(proto, cont, std::move(args));
     }
 };
 
@@ -59,7 +59,7 @@ public:
         return dynamic_cast<const Projection*>(m_users[1]);
     }
 
-    static std::unique_ptr<TupleCall> call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
-        return std::make_unique<TupleCall>(proto, cont, std::move(args));
+    static auto call(const FunctionPrototype* proto, BasicBlock* cont, std::vector<Value>&& args) {
+        return construct<TupleCall>(proto, cont, std::move(args));
     }
 };
\ No newline at end of file
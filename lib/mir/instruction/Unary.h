@@ -1,6 +1,6 @@
 #pragma once
 
-#include <memory>
+#include "utility/Arena.h"
 #include "ValueInstruction.h"
 #include "mir/types/PointerType.h"
 
@@ -36,53 +36,63 @@ public:
     void visit(Visitor &visitor) override { visitor.accept(this); }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> load(const PrimitiveType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Load, value);
+    static auto neg(const Value &value) {
+        return construct<Unary>(PrimitiveType::cast(value.type()), UnaryOp::Negate, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> flag2int(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Flag2Int, value);
+    static auto nnot(const Value &value) {
+        return construct<Unary>(PrimitiveType::cast(value.type()), UnaryOp::LogicalNot, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> int2fp(const FloatingPointType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Int2Float, value);
+    static auto load(const PrimitiveType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Load, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> fp2int(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Float2Int, value);
+    static auto flag2int(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Flag2Int, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> sext(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::SignExtend, value);
+    static auto int2fp(const FloatingPointType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Int2Float, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> zext(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::ZeroExtend, value);
+    static auto fp2int(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Float2Int, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> trunc(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Trunk, value);
+    static auto sext(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::SignExtend, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> bitcast(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Bitcast, value);
+    static auto zext(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::ZeroExtend, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> ptr2int(const IntegerType* ty, const Value &value) {
-        return std::make_unique<Unary>(ty, UnaryOp::Ptr2Int, value);
+    static auto trunc(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Trunk, value);
     }
 
     [[nodiscard]]
-    static std::unique_ptr<Unary> int2ptr(const Value &value) {
-        return std::make_unique<Unary>(PointerType::ptr(), UnaryOp::Int2Ptr, value);
+    static auto bitcast(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Bitcast, value);
+    }
+
+    [[nodiscard]]
+    static auto ptr2int(const IntegerType* ty, const Value &value) {
+        return construct<Unary>(ty, UnaryOp::Ptr2Int, value);
+    }
+
+    [[nodiscard]]
+    static auto int2ptr(const Value &value) {
+        return construct<Unary>(PointerType::ptr(), UnaryOp::Int2Ptr, value);
     }
 
 private:
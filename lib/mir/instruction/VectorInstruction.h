@@ -0,0 +1,106 @@
+#pragma once
+
+#include "utility/Arena.h"
+
+#include "ValueInstruction.h"
+#include "Icmp.h"
+#include "mir/types/VectorType.h"
+
+enum class VectorOp: std::uint8_t {
+    Broadcast,
+    Shuffle,
+    Compare,
+};
+
+inline std::string_view to_string(const VectorOp op) noexcept {
+    switch (op) {
+        case VectorOp::Broadcast: return "broadcast";
+        case VectorOp::Shuffle:   return "shuffle";
+        case VectorOp::Compare:   return "cmp";
+        default: std::unreachable();
+    }
+}
+
+/**
+ * Lane-wise operations over packed vectors that have no scalar counterpart.
+ * Lane-wise arithmetic is expressed with the ordinary binary instructions over vector types.
+ */
+class VectorInstruction final: public ValueInstruction {
+public:
+    VectorInstruction(const VectorOp op, const VectorType* type, std::vector<Value>&& values, const IcmpPredicate predicate, const std::uint8_t control) noexcept:
+        ValueInstruction(type, std::move(values)),
+        m_op(op),
+        m_predicate(predicate),
+        m_control(control) {}
+
+    [[nodiscard]]
+    VectorOp op() const noexcept {
+        return m_op;
+    }
+
+    [[nodiscard]]
+    const VectorType* vector_type() const noexcept {
+        return static_cast<const VectorType*>(type());
+    }
+
+    [[nodiscard]]
+    const Value& lhs() const {
+        return m_values[0];
+    }
+
+    [[nodiscard]]
+    const Value& rhs() const {
+        return m_values[1];
+    }
+
+    /**
+     * Comparison predicate, meaningful only for VectorOp::Compare.
+     */
+    [[nodiscard]]
+    IcmpPredicate predicate() const noexcept {
+        return m_predicate;
+    }
+
+    /**
+     * Lane selector of the shuffle, meaningful only for VectorOp::Shuffle.
+     */
+    [[nodiscard]]
+    std::uint8_t control() const noexcept {
+        return m_control;
+    }
+
+    void visit(Visitor &visitor) override { visitor.accept(this); }
+
+    /**
+     * Copies the scalar into every lane of the vector.
+     */
+    [[nodiscard]]
+    static auto broadcast(const VectorType* type, const Value& scalar) {
+        return construct<VectorInstruction>(VectorOp::Broadcast, type, std::vector{scalar}, IcmpPredicate::Eq, 0);
+    }
+
+    /**
+     * Picks two 32-bit lanes of each 128-bit half from lhs and two from rhs, two bits of control per lane.
+     */
+    [[nodiscard]]
+    static auto shuffle(const Value& lhs, const Value& rhs, const std::uint8_t control) {
+        const auto type = VectorType::cast(lhs.type());
+        assertion(type != nullptr, "expected vector type");
+        return construct<VectorInstruction>(VectorOp::Shuffle, type, std::vector{lhs, rhs}, IcmpPredicate::Eq, control);
+    }
+
+    /**
+     * Sets every bit of the lane where the predicate holds and clears it otherwise.
+     */
+    [[nodiscard]]
+    static auto cmp(const IcmpPredicate predicate, const Value& lhs, const Value& rhs) {
+        const auto type = VectorType::cast(lhs.type());
+        assertion(type != nullptr, "expected vector type");
+        return construct<VectorInstruction>(VectorOp::Compare, type, std::vector{lhs, rhs}, predicate, 0);
+    }
+
+private:
+    const VectorOp m_op;
+    const IcmpPredicate m_predicate;
+    const std::uint8_t m_control;
+};
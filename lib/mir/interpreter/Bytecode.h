@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mir/mir_frwd.h"
+#include "mir/module/FunctionPrototype.h"
+
+namespace interp {
+    /**
+     * Representation of a value in a register of the interpreter.
+     * Integers are kept sign or zero extended to 64 bits according to their type, flags are 0 or 1,
+     * pointers are addresses, floating point values keep their bit pattern: f32 in the low 32 bits.
+     */
+    enum class ValueKind: std::uint8_t {
+        NONE,
+        I8,
+        I16,
+        I32,
+        I64,
+        U8,
+        U16,
+        U32,
+        U64,
+        F32,
+        F64,
+    };
+
+    /**
+     * Brings the bits to the canonical form of the kind.
+     */
+    constexpr std::uint64_t normalize(const ValueKind kind, const std::uint64_t bits) noexcept {
+        switch (kind) {
+            case ValueKind::I8:  return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int8_t>(bits)));
+            case ValueKind::I16: return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int16_t>(bits)));
+            case ValueKind::I32: return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(bits)));
+            case ValueKind::U8:  return bits & 0xFF;
+            case ValueKind::U16: return bits & 0xFFFF;
+            case ValueKind::U32: [[fallthrough]];
+            case ValueKind::F32: return bits & 0xFFFFFFFF;
+            default:             return bits;
+        }
+    }
+
+    constexpr bool is_signed(const ValueKind kind) noexcept {
+        return kind == ValueKind::I8 || kind == ValueKind::I16 || kind == ValueKind::I32 || kind == ValueKind::I64;
+    }
+
+    constexpr bool is_float(const ValueKind kind) noexcept {
+        return kind == ValueKind::F32 || kind == ValueKind::F64;
+    }
+
+    constexpr std::uint8_t size_of(const ValueKind kind) noexcept {
+        switch (kind) {
+            case ValueKind::I8:  [[fallthrough]];
+            case ValueKind::U8:  return 1;
+            case ValueKind::I16: [[fallthrough]];
+            case ValueKind::U16: return 2;
+            case ValueKind::I32: [[fallthrough]];
+            case ValueKind::U32: [[fallthrough]];
+            case ValueKind::F32: return 4;
+            case ValueKind::NONE: return 0;
+            default:             return 8;
+        }
+    }
+
+    enum class Opcode: std::uint8_t {
+        MOV,      // dst := a
+        ADD,      // dst := a + b
+        SUB,
+        MUL,
+        AND,
+        OR,
+        XOR,
+        SHL,
+        SHR,      // arithmetic for signed kinds
+        FADD,
+        FSUB,
+        FMUL,
+        FDIV,
+        NEG,
+        NOT,
+        FNEG,
+        CONVERT,  // dst := a, re-normalized to the kind of dst
+        SEXT,     // aux: width of the operand in bytes
+        ZEXT,     // aux: width of the operand in bytes
+        I2F,      // aux: 1 if the operand is signed
+        F2I,      // aux: 1 if the operand is f32
+        LOAD,     // dst := *a
+        STORE,    // *a := b
+        ALLOC,    // dst := new stack memory of c bytes
+        GEP,      // dst := a + b * c
+        ADDI,     // dst := a + c
+        ICMP,     // aux: IcmpPredicate, kind: kind of the operands
+        FCMP,     // aux: FcmpPredicate, kind: kind of the operands
+        SELECT,   // dst := a ? b : c
+        DIV,      // dst := a / b, c := a % b
+        JMP,      // pc := c
+        BR,       // pc := a ? b : c
+        SWITCH,   // pc := switch table c
+        CALL,     // call site c
+        RET,
+        RET_VALUE // return a and b
+    };
+
+    /**
+     * Pre-decoded instruction. Operands are register indices, the meaning of the fields depends on the opcode.
+     */
+    struct Bytecode final {
+        Opcode op;
+        ValueKind kind;
+        std::uint8_t aux;
+        std::uint32_t dst;
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t c;
+    };
+
+    static_assert(sizeof(Bytecode) == 20, "keep the instruction compact");
+
+    /**
+     * Where the callee of a call site lives. Filled when the function is linked by the interpreter.
+     */
+    struct CallTarget final {
+        const FunctionData* interpreted{};
+        std::uintptr_t native{};
+    };
+
+    struct CallSite final {
+        const FunctionPrototype* prototype;
+        std::vector<std::uint32_t> args;
+        std::vector<ValueKind> arg_kinds;
+        /** Register with the callee address of an indirect call, 0 for a direct call. */
+        std::uint32_t pointer;
+        std::array<std::uint32_t, 2> results;
+        std::array<ValueKind, 2> result_kinds;
+        CallTarget target{};
+    };
+
+    struct SwitchTable final {
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> cases; // value -> pc
+        std::uint32_t default_pc;
+    };
+
+    /**
+     * Function decoded for the interpreter.
+     * Register 0 is a scratch register for the discarded results, registers 1..n hold the arguments.
+     * 'registers' is the initial register file: constants and global addresses are in place before the first instruction.
+     */
+    struct BytecodeFunction final {
+        std::vector<Bytecode> code;
+        std::vector<std::uint64_t> registers;
+        std::vector<CallSite> calls;
+        std::vector<SwitchTable> switches;
+        std::vector<std::pair<std::uint32_t, const GlobalValue*>> global_refs;
+    };
+}
@@ -0,0 +1,420 @@
+#include "BytecodeCompiler.h"
+
+#include <bit>
+
+#include "mir/mir.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/instruction/Fcmp.h"
+#include "mir/instruction/GetElementPtr.h"
+#include "mir/instruction/GetFieldPtr.h"
+#include "mir/instruction/Icmp.h"
+#include "mir/instruction/IntDiv.h"
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/Projection.h"
+#include "mir/instruction/Select.h"
+#include "mir/instruction/Store.h"
+#include "mir/instruction/TerminateValueInstruction.h"
+#include "mir/instruction/VectorInstruction.h"
+#include "mir/types/FlagType.h"
+
+namespace interp {
+    static constexpr std::uint32_t SCRATCH = 0;
+
+    static ValueKind kind_of(const Type* type) {
+        if (const auto int_type = SignedIntegerType::cast(type)) {
+            switch (int_type->size_of()) {
+                case 1: return ValueKind::I8;
+                case 2: return ValueKind::I16;
+                case 4: return ValueKind::I32;
+                default: return ValueKind::I64;
+            }
+        }
+        if (const auto int_type = UnsignedIntegerType::cast(type)) {
+            switch (int_type->size_of()) {
+                case 1: return ValueKind::U8;
+                case 2: return ValueKind::U16;
+                case 4: return ValueKind::U32;
+                default: return ValueKind::U64;
+            }
+        }
+        if (PointerType::cast(type) != nullptr) {
+            return ValueKind::U64;
+        }
+        if (FlagType::cast(type) != nullptr) {
+            return ValueKind::U8;
+        }
+        if (const auto fp_type = FloatingPointType::cast(type)) {
+            return fp_type == FloatingPointType::f32() ? ValueKind::F32 : ValueKind::F64;
+        }
+        if (VoidType::cast(type) != nullptr) {
+            return ValueKind::NONE;
+        }
+
+        die("Unsupported type in the interpreter");
+    }
+
+    static std::uint64_t constant_bits(const Value& value) {
+        if (value.is<double>()) {
+            if (value.type() == FloatingPointType::f32()) {
+                return std::bit_cast<std::uint32_t>(static_cast<float>(value.get<double>()));
+            }
+
+            return std::bit_cast<std::uint64_t>(value.get<double>());
+        }
+
+        return normalize(kind_of(value.type()), static_cast<std::uint64_t>(value.get<std::int64_t>()));
+    }
+
+    static std::span<const Phi* const> phis(const BasicBlock* bb, std::vector<const Phi*>& out) {
+        out.clear();
+        for (const auto& inst: bb->instructions()) {
+            const auto phi = dynamic_cast<const Phi*>(&inst);
+            if (phi == nullptr) {
+                break;
+            }
+
+            out.push_back(phi);
+        }
+
+        return out;
+    }
+
+    static const Value& incoming_value(const Phi* phi, const BasicBlock* pred) {
+        const auto incoming = phi->incoming();
+        for (std::size_t idx{}; idx < incoming.size(); ++idx) {
+            if (incoming[idx] == pred) {
+                return phi->operands()[idx];
+            }
+        }
+
+        die("Phi has no incoming value for the predecessor");
+    }
+
+    void BytecodeCompiler::run() {
+        // Scratch register and arguments.
+        m_function.registers.resize(m_data.args().size() + 1);
+        for (const auto& arg: m_data.args()) {
+            if (arg.attributes().has(Attribute::ByValue)) {
+                die("Arguments passed by value are not supported by the interpreter: '{}'", m_data.name());
+            }
+        }
+
+        const auto& blocks = m_data.basic_blocks();
+        for (auto it = blocks.begin(); it != blocks.end(); ++it) {
+            m_bb = it.get();
+            const auto next = std::next(it);
+            m_next_bb = next == blocks.end() ? nullptr : next.get();
+
+            m_block_pc.emplace(m_bb, static_cast<std::uint32_t>(m_function.code.size()));
+            for (auto& inst: m_bb->instructions()) {
+                inst.visit(*this);
+            }
+        }
+
+        resolve_fixups();
+    }
+
+    std::uint32_t BytecodeCompiler::new_reg(const std::uint64_t initial) {
+        m_function.registers.push_back(initial);
+        return static_cast<std::uint32_t>(m_function.registers.size() - 1);
+    }
+
+    std::uint32_t BytecodeCompiler::reg(const ValueInstruction *inst) {
+        if (const auto it = m_regs.find(inst); it != m_regs.end()) {
+            return it->second;
+        }
+
+        const auto r = new_reg();
+        m_regs.emplace(inst, r);
+        return r;
+    }
+
+    std::uint32_t BytecodeCompiler::shadow_reg(const Phi *phi) {
+        if (const auto it = m_shadow_regs.find(phi); it != m_shadow_regs.end()) {
+            return it->second;
+        }
+
+        const auto r = new_reg();
+        m_shadow_regs.emplace(phi, r);
+        return r;
+    }
+
+    std::uint32_t BytecodeCompiler::reg(const Value &value) {
+        if (value.is<ArgumentValue*>()) {
+            return static_cast<std::uint32_t>(value.get<ArgumentValue*>()->index() + 1);
+        }
+        if (value.is<ValueInstruction*>()) {
+            return reg(value.get<ValueInstruction*>());
+        }
+        if (value.is<GlobalValue*>()) {
+            const auto global = value.get<GlobalValue*>();
+            if (const auto it = m_globals.find(global); it != m_globals.end()) {
+                return it->second;
+            }
+
+            // The address is known only when the function is linked.
+            const auto r = new_reg();
+            m_globals.emplace(global, r);
+            m_function.global_refs.emplace_back(r, global);
+            return r;
+        }
+
+        const auto bits = constant_bits(value);
+        const auto [it, inserted] = m_constants.try_emplace({bits, value.type()}, 0);
+        if (inserted) {
+            it->second = new_reg(bits);
+        }
+
+        return it->second;
+    }
+
+    std::uint32_t BytecodeCompiler::projection_reg(const ValueInstruction *tuple, const std::uint8_t idx) {
+        for (const auto user: tuple->users()) {
+            if (const auto proj = dynamic_cast<const Projection*>(user); proj != nullptr && proj->idx() == idx) {
+                return reg(proj);
+            }
+        }
+
+        return SCRATCH;
+    }
+
+    void BytecodeCompiler::emit(const Opcode op, const ValueKind kind, const std::uint8_t aux, const std::uint32_t dst, const std::uint32_t a, const std::uint32_t b, const std::uint32_t c) {
+        m_function.code.push_back(Bytecode{op, kind, aux, dst, a, b, c});
+    }
+
+    void BytecodeCompiler::emit_edge_copies(const BasicBlock *pred, const BasicBlock *succ) {
+        std::vector<const Phi*> succ_phis;
+        for (const auto phi: phis(succ, succ_phis)) {
+            emit(Opcode::MOV, ValueKind::NONE, 0, shadow_reg(phi), reg(incoming_value(phi, pred)), 0, 0);
+        }
+    }
+
+    void BytecodeCompiler::emit_jump(const BasicBlock *succ) {
+        emit_edge_copies(m_bb, succ);
+        if (succ == m_next_bb) {
+            return;
+        }
+
+        emit(Opcode::JMP, ValueKind::NONE, 0, 0, 0, 0, 0);
+        m_fixups.push_back(Fixup{m_function.code.size() - 1, &Bytecode::c, nullptr, succ});
+    }
+
+    std::uint32_t BytecodeCompiler::edge_pc(const BasicBlock *pred, const BasicBlock *succ) {
+        std::vector<const Phi*> succ_phis;
+        if (pred == nullptr || phis(succ, succ_phis).empty()) {
+            return m_block_pc.at(succ);
+        }
+
+        const auto [it, inserted] = m_stub_pc.try_emplace({pred, succ}, 0);
+        if (!inserted) {
+            return it->second;
+        }
+
+        it->second = static_cast<std::uint32_t>(m_function.code.size());
+        for (const auto phi: succ_phis) {
+            emit(Opcode::MOV, ValueKind::NONE, 0, shadow_reg(phi), reg(incoming_value(phi, pred)), 0, 0);
+        }
+
+        emit(Opcode::JMP, ValueKind::NONE, 0, 0, 0, 0, m_block_pc.at(succ));
+        return it->second;
+    }
+
+    void BytecodeCompiler::resolve_fixups() {
+        // Stubs are appended while the fixups are resolved, so iterate by index.
+        for (std::size_t idx{}; idx < m_fixups.size(); ++idx) {
+            const auto fixup = m_fixups[idx];
+            const auto pc = edge_pc(fixup.pred, fixup.succ);
+            m_function.code[fixup.pc].*fixup.field = pc;
+        }
+
+        for (std::size_t idx{}; idx < m_switch_edges.size(); ++idx) {
+            auto& table = m_function.switches[idx];
+            const auto& edges = m_switch_edges[idx];
+            for (std::size_t case_idx{}; case_idx < table.cases.size(); ++case_idx) {
+                const auto [pred, succ] = edges[case_idx];
+                table.cases[case_idx].second = edge_pc(pred, succ);
+            }
+
+            const auto [pred, succ] = edges.back();
+            table.default_pc = edge_pc(pred, succ);
+        }
+    }
+
+    void BytecodeCompiler::accept(Binary *inst) {
+        const auto kind = kind_of(inst->type());
+        if (is_float(kind)) {
+            Opcode op;
+            switch (inst->op()) {
+                case BinaryOp::Add:      op = Opcode::FADD; break;
+                case BinaryOp::Subtract: op = Opcode::FSUB; break;
+                case BinaryOp::Multiply: op = Opcode::FMUL; break;
+                case BinaryOp::Divide:   op = Opcode::FDIV; break;
+                default: die("Unsupported floating point operation in '{}'", m_data.name());
+            }
+
+            emit(op, kind, 0, reg(inst), reg(inst->lhs()), reg(inst->rhs()), 0);
+            return;
+        }
+
+        Opcode op;
+        switch (inst->op()) {
+            case BinaryOp::Add:        op = Opcode::ADD; break;
+            case BinaryOp::Subtract:   op = Opcode::SUB; break;
+            case BinaryOp::Multiply:   op = Opcode::MUL; break;
+            case BinaryOp::BitwiseAnd: op = Opcode::AND; break;
+            case BinaryOp::BitwiseOr:  op = Opcode::OR; break;
+            case BinaryOp::BitwiseXor: op = Opcode::XOR; break;
+            case BinaryOp::ShiftLeft:  op = Opcode::SHL; break;
+            case BinaryOp::ShiftRight: op = Opcode::SHR; break;
+            default: die("Integer division is expected to be IntDiv in '{}'", m_data.name());
+        }
+
+        emit(op, kind, 0, reg(inst), reg(inst->lhs()), reg(inst->rhs()), 0);
+    }
+
+    void BytecodeCompiler::accept(Unary *inst) {
+        const auto kind = kind_of(inst->type());
+        const auto operand_kind = kind_of(inst->operand().type());
+        const auto dst = reg(inst);
+        const auto src = reg(inst->operand());
+        switch (inst->op()) {
+            case UnaryOp::Negate:     emit(is_float(kind) ? Opcode::FNEG : Opcode::NEG, kind, 0, dst, src, 0, 0); break;
+            case UnaryOp::LogicalNot: emit(Opcode::NOT, kind, 0, dst, src, 0, 0); break;
+            case UnaryOp::Trunk:      [[fallthrough]];
+            case UnaryOp::Bitcast:    [[fallthrough]];
+            case UnaryOp::Ptr2Int:    [[fallthrough]];
+            case UnaryOp::Int2Ptr:    [[fallthrough]];
+            case UnaryOp::Flag2Int:   emit(Opcode::CONVERT, kind, 0, dst, src, 0, 0); break;
+            case UnaryOp::SignExtend: emit(Opcode::SEXT, kind, size_of(operand_kind), dst, src, 0, 0); break;
+            case UnaryOp::ZeroExtend: emit(Opcode::ZEXT, kind, size_of(operand_kind), dst, src, 0, 0); break;
+            case UnaryOp::Int2Float:  emit(Opcode::I2F, kind, is_signed(operand_kind), dst, src, 0, 0); break;
+            case UnaryOp::Float2Int:  emit(Opcode::F2I, kind, operand_kind == ValueKind::F32, dst, src, 0, 0); break;
+            case UnaryOp::Load:       emit(Opcode::LOAD, kind, 0, dst, src, 0, 0); break;
+            default: std::unreachable();
+        }
+    }
+
+    void BytecodeCompiler::accept(Branch *branch) {
+        emit_jump(branch->target());
+    }
+
+    void BytecodeCompiler::accept(CondBranch *cond_branch) {
+        emit(Opcode::BR, ValueKind::NONE, 0, 0, reg(cond_branch->condition()), 0, 0);
+        const auto pc = m_function.code.size() - 1;
+        m_fixups.push_back(Fixup{pc, &Bytecode::b, m_bb, cond_branch->on_true()});
+        m_fixups.push_back(Fixup{pc, &Bytecode::c, m_bb, cond_branch->on_false()});
+    }
+
+    void BytecodeCompiler::emit_call(const FunctionPrototype *prototype, const std::span<const Value> args, const std::uint32_t pointer, const std::array<std::uint32_t, 2> results, const BasicBlock *cont) {
+        CallSite site{prototype, {}, {}, pointer, results, {ValueKind::NONE, ValueKind::NONE}};
+        site.args.reserve(args.size());
+        site.arg_kinds.reserve(args.size());
+        for (std::size_t idx{}; idx < args.size(); ++idx) {
+            if (prototype->attribute(idx).has(Attribute::ByValue)) {
+                die("Arguments passed by value are not supported by the interpreter: call of '{}' in '{}'", prototype->name(), m_data.name());
+            }
+
+            site.args.push_back(reg(args[idx]));
+            site.arg_kinds.push_back(kind_of(args[idx].type()));
+        }
+
+        if (const auto tuple = dynamic_cast<const TupleType*>(prototype->ret_type()); tuple != nullptr) {
+            site.result_kinds = {kind_of(tuple->first()), kind_of(tuple->second())};
+        } else {
+            site.result_kinds[0] = kind_of(prototype->ret_type());
+        }
+
+        m_function.calls.push_back(std::move(site));
+        emit(Opcode::CALL, ValueKind::NONE, 0, 0, 0, 0, static_cast<std::uint32_t>(m_function.calls.size() - 1));
+        emit_jump(cont);
+    }
+
+    void BytecodeCompiler::accept(Call *inst) {
+        emit_call(inst->prototype(), inst->operands(), 0, {reg(inst), SCRATCH}, inst->cont());
+    }
+
+    void BytecodeCompiler::accept(TupleCall *inst) {
+        emit_call(inst->prototype(), inst->operands(), 0, {projection_reg(inst, 0), projection_reg(inst, 1)}, inst->cont());
+    }
+
+    void BytecodeCompiler::accept(VCall *call) {
+        emit_call(call->prototype(), call->operands(), 0, {SCRATCH, SCRATCH}, call->cont());
+    }
+
+    void BytecodeCompiler::accept(IVCall *call) {
+        emit_call(call->prototype(), call->arguments(), reg(call->pointer()), {SCRATCH, SCRATCH}, call->cont());
+    }
+
+    void BytecodeCompiler::accept(Return *inst) {
+        emit(Opcode::RET, ValueKind::NONE, 0, 0, 0, 0, 0);
+    }
+
+    void BytecodeCompiler::accept(ReturnValue *inst) {
+        const auto second = inst->second();
+        emit(Opcode::RET_VALUE, ValueKind::NONE, 0, 0, reg(inst->first()), second.has_value() ? reg(second.value()) : SCRATCH, 0);
+    }
+
+    void BytecodeCompiler::accept(Switch *inst) {
+        SwitchTable table{{}, 0};
+        std::vector<std::pair<const BasicBlock*, const BasicBlock*>> edges;
+        const auto targets = inst->successors();
+        for (std::size_t idx{}; idx < inst->cases().size(); ++idx) {
+            table.cases.emplace_back(constant_bits(inst->cases()[idx]), 0);
+            edges.emplace_back(m_bb, targets[idx]);
+        }
+
+        edges.emplace_back(m_bb, inst->default_target());
+        m_function.switches.push_back(std::move(table));
+        m_switch_edges.push_back(std::move(edges));
+        emit(Opcode::SWITCH, ValueKind::NONE, 0, 0, reg(inst->condition()), 0, static_cast<std::uint32_t>(m_function.switches.size() - 1));
+    }
+
+    void BytecodeCompiler::accept(Phi *inst) {
+        emit(Opcode::MOV, ValueKind::NONE, 0, reg(inst), shadow_reg(inst), 0, 0);
+    }
+
+    void BytecodeCompiler::accept(Store *store) {
+        emit(Opcode::STORE, kind_of(store->value().type()), 0, 0, reg(store->pointer()), reg(store->value()), 0);
+    }
+
+    void BytecodeCompiler::accept(Alloc *alloc) {
+        emit(Opcode::ALLOC, ValueKind::U64, 0, reg(alloc), 0, 0, static_cast<std::uint32_t>(alloc->allocated_type()->size_of()));
+    }
+
+    void BytecodeCompiler::accept(IcmpInstruction *icmp) {
+        const auto kind = kind_of(icmp->lhs().type());
+        emit(Opcode::ICMP, kind, static_cast<std::uint8_t>(icmp->predicate()), reg(icmp), reg(icmp->lhs()), reg(icmp->rhs()), 0);
+    }
+
+    void BytecodeCompiler::accept(FcmpInstruction *fcmp) {
+        const auto kind = kind_of(fcmp->lhs().type());
+        emit(Opcode::FCMP, kind, static_cast<std::uint8_t>(fcmp->predicate()), reg(fcmp), reg(fcmp->lhs()), reg(fcmp->rhs()), 0);
+    }
+
+    void BytecodeCompiler::accept(GetElementPtr *gep) {
+        const auto size = static_cast<std::uint32_t>(gep->access_type()->size_of());
+        emit(Opcode::GEP, ValueKind::U64, 0, reg(gep), reg(gep->pointer()), reg(gep->index()), size);
+    }
+
+    void BytecodeCompiler::accept(GetFieldPtr *gfp) {
+        const auto offset = static_cast<std::uint32_t>(gfp->basic_type()->offset_of(gfp->index()));
+        emit(Opcode::ADDI, ValueKind::U64, 0, reg(gfp), reg(gfp->pointer()), 0, offset);
+    }
+
+    void BytecodeCompiler::accept(Select *select) {
+        emit(Opcode::SELECT, ValueKind::NONE, 0, reg(select), reg(select->condition()), reg(select->on_true()), reg(select->on_false()));
+    }
+
+    void BytecodeCompiler::accept(IntDiv *div) {
+        const auto kind = kind_of(div->lhs().type());
+        emit(Opcode::DIV, kind, 0, projection_reg(div, 0), reg(div->lhs()), reg(div->rhs()), projection_reg(div, 1));
+    }
+
+    void BytecodeCompiler::accept(Projection *proj) {
+        // The register of the projection is written by the tuple instruction itself.
+    }
+
+    void BytecodeCompiler::accept(VectorInstruction *vec) {
+        die("Vector instructions are not supported by the interpreter: '{}'", m_data.name());
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "Bytecode.h"
+
+#include "mir/instruction/InstructionVisitor.h"
+#include "mir/module/FunctionData.h"
+
+namespace interp {
+    /**
+     * Decodes the function into the bytecode of the interpreter.
+     * Every argument, constant and value instruction gets its own register, types are resolved into opcodes and kinds,
+     * so the interpreter never looks at the IR again.
+     * A phi reads its own shadow register at the start of the block, the incoming values are copied to the shadow register
+     * on the edge: inline before a jump, or in a stub after the code when the edge starts at a conditional branch or a switch.
+     * Writing the shadows first keeps the copies on an edge independent of each other.
+     */
+    class BytecodeCompiler final: public Visitor {
+        explicit BytecodeCompiler(const FunctionData& data) noexcept:
+            m_data(data) {}
+
+    public:
+        void run();
+
+        [[nodiscard]]
+        BytecodeFunction result() {
+            return std::move(m_function);
+        }
+
+        static BytecodeCompiler create(const FunctionData* data) {
+            return BytecodeCompiler(*data);
+        }
+
+    private:
+        void accept(Binary *inst) override;
+        void accept(Unary *inst) override;
+        void accept(Branch* branch) override;
+        void accept(CondBranch* cond_branch) override;
+        void accept(Call* inst) override;
+        void accept(TupleCall* inst) override;
+        void accept(Return* inst) override;
+        void accept(ReturnValue* inst) override;
+        void accept(Switch* inst) override;
+        void accept(VCall* call) override;
+        void accept(IVCall* call) override;
+        void accept(Phi *inst) override;
+        void accept(Store* store) override;
+        void accept(Alloc* alloc) override;
+        void accept(IcmpInstruction *icmp) override;
+        void accept(FcmpInstruction* fcmp) override;
+        void accept(GetElementPtr* gep) override;
+        void accept(GetFieldPtr* gfp) override;
+        void accept(Select* select) override;
+        void accept(IntDiv* div) override;
+        void accept(Projection* proj) override;
+        void accept(VectorInstruction* vec) override;
+
+        [[nodiscard]]
+        std::uint32_t reg(const Value& value);
+        [[nodiscard]]
+        std::uint32_t reg(const ValueInstruction* inst);
+        [[nodiscard]]
+        std::uint32_t shadow_reg(const Phi* phi);
+        [[nodiscard]]
+        std::uint32_t projection_reg(const ValueInstruction* tuple, std::uint8_t idx);
+        [[nodiscard]]
+        std::uint32_t new_reg(std::uint64_t initial = 0);
+
+        void emit(Opcode op, ValueKind kind, std::uint8_t aux, std::uint32_t dst, std::uint32_t a, std::uint32_t b, std::uint32_t c);
+        void emit_jump(const BasicBlock* succ);
+        void emit_edge_copies(const BasicBlock* pred, const BasicBlock* succ);
+        void emit_call(const FunctionPrototype* prototype, std::span<const Value> args, std::uint32_t pointer, std::array<std::uint32_t, 2> results, const BasicBlock* cont);
+
+        /**
+         * Returns the pc to jump to from the end of 'pred' to 'succ'. Must be called after all blocks are emitted.
+         */
+        [[nodiscard]]
+        std::uint32_t edge_pc(const BasicBlock* pred, const BasicBlock* succ);
+        void resolve_fixups();
+
+        /**
+         * Operand of the instruction at 'pc' which receives the pc of the edge.
+         */
+        struct Fixup final {
+            std::size_t pc;
+            std::uint32_t Bytecode::* field;
+            const BasicBlock* pred;
+            const BasicBlock* succ;
+        };
+
+        const FunctionData& m_data;
+        BytecodeFunction m_function{};
+        const BasicBlock* m_bb{};
+        const BasicBlock* m_next_bb{};
+
+        std::unordered_map<const ValueInstruction*, std::uint32_t> m_regs;
+        std::unordered_map<const Phi*, std::uint32_t> m_shadow_regs;
+        std::map<std::pair<std::uint64_t, const Type*>, std::uint32_t> m_constants;
+        std::unordered_map<const GlobalValue*, std::uint32_t> m_globals;
+
+        std::unordered_map<const BasicBlock*, std::uint32_t> m_block_pc;
+        std::map<std::pair<const BasicBlock*, const BasicBlock*>, std::uint32_t> m_stub_pc;
+        std::vector<Fixup> m_fixups;
+        std::vector<std::vector<std::pair<const BasicBlock*, const BasicBlock*>>> m_switch_edges;
+    };
+}
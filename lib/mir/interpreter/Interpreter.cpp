@@ -0,0 +1,396 @@
+#include "Interpreter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "BytecodeCompiler.h"
+
+#include "mir/global/GlobalValue.h"
+#include "mir/instruction/Fcmp.h"
+#include "mir/instruction/Icmp.h"
+#include "mir/types/ArrayType.h"
+#include "mir/types/StructType.h"
+#include "utility/Sanitizer.h"
+
+using namespace interp;
+
+namespace {
+    constexpr std::size_t MAX_GP_ARGS = 6;
+    constexpr std::size_t MAX_FP_ARGS = 8;
+
+    using GPArgs = std::array<std::int64_t, MAX_GP_ARGS>;
+    using FPArgs = std::array<double, MAX_FP_ARGS>;
+
+    template<typename First, typename Second>
+    struct Pair final {
+        First first;
+        Second second;
+    };
+
+    /**
+     * Calls the native function with every argument in a register. The integer and floating point registers
+     * are assigned independently by the System V ABI, so the callee sees its arguments in the registers it expects
+     * and ignores the rest. Two word results are returned as a pair in rax:rdx, xmm0:xmm1 or one of each.
+     */
+    template<typename R>
+    no_usan R call_native(const std::uintptr_t address, const GPArgs& gp, const FPArgs& fp) {
+        using Fn = R(std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t,
+            double, double, double, double, double, double, double, double);
+        const auto fn = reinterpret_cast<Fn*>(address);
+        return fn(gp[0], gp[1], gp[2], gp[3], gp[4], gp[5], fp[0], fp[1], fp[2], fp[3], fp[4], fp[5], fp[6], fp[7]);
+    }
+
+    template<typename First, typename Second>
+    std::array<std::uint64_t, 2> call_native_pair(const std::uintptr_t address, const GPArgs& gp, const FPArgs& fp) {
+        const auto [first, second] = call_native<Pair<First, Second>>(address, gp, fp);
+        return {std::bit_cast<std::uint64_t>(first), std::bit_cast<std::uint64_t>(second)};
+    }
+
+    template<std::floating_point T, typename Op>
+    std::uint64_t fp_binary(const std::uint64_t lhs, const std::uint64_t rhs, Op&& op) {
+        return to_bits<T>(op(from_bits<T>(lhs), from_bits<T>(rhs)));
+    }
+
+    template<typename Op>
+    std::uint64_t fp_binary(const ValueKind kind, const std::uint64_t lhs, const std::uint64_t rhs, Op&& op) {
+        if (kind == ValueKind::F32) {
+            return fp_binary<float>(lhs, rhs, op);
+        }
+
+        return fp_binary<double>(lhs, rhs, op);
+    }
+
+    double to_double(const ValueKind kind, const std::uint64_t bits) noexcept {
+        return kind == ValueKind::F32 ? from_bits<float>(bits) : from_bits<double>(bits);
+    }
+
+    bool icmp(const IcmpPredicate predicate, const ValueKind kind, const std::uint64_t lhs, const std::uint64_t rhs) noexcept {
+        const auto compare = [&]<std::integral T>(const T a, const T b) {
+            switch (predicate) {
+                case IcmpPredicate::Eq: return a == b;
+                case IcmpPredicate::Ne: return a != b;
+                case IcmpPredicate::Lt: return a < b;
+                case IcmpPredicate::Le: return a <= b;
+                case IcmpPredicate::Gt: return a > b;
+                case IcmpPredicate::Ge: return a >= b;
+                default: std::unreachable();
+            }
+        };
+
+        if (is_signed(kind)) {
+            return compare(static_cast<std::int64_t>(lhs), static_cast<std::int64_t>(rhs));
+        }
+
+        return compare(lhs, rhs);
+    }
+
+    bool fcmp(const FcmpPredicate predicate, const double a, const double b) noexcept {
+        const auto unordered = std::isnan(a) || std::isnan(b);
+        switch (predicate) {
+            case FcmpPredicate::Oeq: return !unordered && a == b;
+            case FcmpPredicate::One: return !unordered && a != b;
+            case FcmpPredicate::Olt: return !unordered && a < b;
+            case FcmpPredicate::Ole: return !unordered && a <= b;
+            case FcmpPredicate::Ogt: return !unordered && a > b;
+            case FcmpPredicate::Oge: return !unordered && a >= b;
+            case FcmpPredicate::Ord: return !unordered;
+            case FcmpPredicate::Ueq: return unordered || a == b;
+            case FcmpPredicate::Une: return unordered || a != b;
+            case FcmpPredicate::Ult: return unordered || a < b;
+            case FcmpPredicate::Ule: return unordered || a <= b;
+            case FcmpPredicate::Ugt: return unordered || a > b;
+            case FcmpPredicate::Uge: return unordered || a >= b;
+            case FcmpPredicate::Uno: return unordered;
+            default: std::unreachable();
+        }
+    }
+
+    /**
+     * Truncates toward zero like cvttsd2si: values out of range give the 'integer indefinite'.
+     */
+    std::uint64_t fp2int(const double value) noexcept {
+        const auto truncated = std::trunc(value);
+        if (!(truncated >= -9223372036854775808.0 && truncated < 9223372036854775808.0)) {
+            return static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::min());
+        }
+
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(truncated));
+    }
+
+    std::uint64_t shift_count(const ValueKind kind, const std::uint64_t count) noexcept {
+        return count & (size_of(kind) == 8 ? 63 : 31);
+    }
+
+    std::uint64_t load(const ValueKind kind, const std::uint64_t address) noexcept {
+        std::uint64_t bits{};
+        std::memcpy(&bits, reinterpret_cast<const void*>(address), size_of(kind));
+        return normalize(kind, bits);
+    }
+
+    void store(const ValueKind kind, const std::uint64_t address, const std::uint64_t bits) noexcept {
+        std::memcpy(reinterpret_cast<void*>(address), &bits, size_of(kind));
+    }
+}
+
+const BytecodeFunction & Interpreter::bytecode(const FunctionData *function) {
+    if (const auto it = m_bytecode.find(function); it != m_bytecode.end()) {
+        return *it->second;
+    }
+
+    auto compiler = BytecodeCompiler::create(function);
+    compiler.run();
+    auto decoded = std::make_unique<BytecodeFunction>(compiler.result());
+    link(*decoded);
+    return *m_bytecode.emplace(function, std::move(decoded)).first->second;
+}
+
+void Interpreter::link(BytecodeFunction &function) {
+    for (const auto& [reg, global]: function.global_refs) {
+        function.registers[reg] = reinterpret_cast<std::uintptr_t>(global_address(global));
+    }
+
+    for (auto& site: function.calls) {
+        if (site.pointer != 0) {
+            continue;
+        }
+
+        const auto name = std::string(site.prototype->name());
+        if (const auto it = m_symbols.find(name); it != m_symbols.end()) {
+            site.target.native = it->second;
+            continue;
+        }
+
+        const auto& functions = m_module.functions();
+        const auto callee = functions.find(name);
+        if (callee == functions.end()) {
+            die("Unresolved symbol '{}'", name);
+        }
+
+        site.target.interpreted = &callee->second;
+    }
+}
+
+std::uint8_t * Interpreter::global_address(const GlobalValue *global) {
+    const auto name = std::string(global->name());
+    if (const auto it = m_symbols.find(name); it != m_symbols.end()) {
+        return reinterpret_cast<std::uint8_t*>(it->second);
+    }
+
+    if (const auto it = m_globals.find(global); it != m_globals.end()) {
+        return it->second.get();
+    }
+
+    // Registered before the initializer is written, so globals may refer to each other.
+    const auto type = global->content_type();
+    const auto memory = m_globals.emplace(global, std::make_unique<std::uint8_t[]>(type->size_of())).first->second.get();
+    write_initializer(type, global->initializer(), memory);
+    return memory;
+}
+
+void Interpreter::write_initializer(const NonTrivialType *type, const Initializer &initializer, std::uint8_t *dst) {
+    const auto vis = [&]<typename U>(const U& value) {
+        if constexpr (std::is_same_v<U, std::int64_t> || std::is_same_v<U, double>) {
+            if (const auto fp_type = FloatingPointType::cast(type)) {
+                const auto bits = fp_type == FloatingPointType::f32() ? to_bits(static_cast<float>(value)) : to_bits(static_cast<double>(value));
+                std::memcpy(dst, &bits, fp_type->size_of());
+                return;
+            }
+
+            const auto bits = static_cast<std::uint64_t>(value);
+            std::memcpy(dst, &bits, type->size_of());
+
+        } else if constexpr (std::is_same_v<U, const GlobalValue*>) {
+            const auto address = reinterpret_cast<std::uintptr_t>(global_address(value));
+            std::memcpy(dst, &address, sizeof(address));
+
+        } else if constexpr (std::is_same_v<U, std::string>) {
+            std::memcpy(dst, value.data(), std::min(value.size(), type->size_of()));
+
+        } else if constexpr (std::is_same_v<U, std::vector<Initializer>>) {
+            const auto aggregate = dynamic_cast<const AggregateType*>(type);
+            assertion(aggregate != nullptr, "expected aggregate type for aggregate initializer");
+            const auto struct_type = dynamic_cast<const StructType*>(type);
+            for (std::size_t idx{}; idx < value.size(); ++idx) {
+                const auto field_type = aggregate->field_type_of(idx);
+                const auto offset = struct_type != nullptr ? struct_type->offset_of(idx) : idx * field_type->size_of();
+                write_initializer(field_type, value[idx], dst + offset);
+            }
+
+        } else {
+            static_assert(false);
+        }
+    };
+
+    initializer.visit(vis);
+}
+
+std::array<std::uint64_t, 2> Interpreter::invoke(const FunctionData *function, const std::span<const std::uint64_t> args) {
+    if (args.size() != function->args().size()) {
+        die("Wrong number of arguments for '{}': expected {}, got {}", function->name(), function->args().size(), args.size());
+    }
+
+    return execute(bytecode(function), args);
+}
+
+std::array<std::uint64_t, 2> Interpreter::call(const CallSite &site, const std::span<const std::uint64_t> registers) {
+    std::vector<std::uint64_t> args;
+    args.reserve(site.args.size());
+    for (const auto reg: site.args) {
+        args.push_back(registers[reg]);
+    }
+
+    if (site.target.interpreted != nullptr) {
+        return execute(bytecode(site.target.interpreted), args);
+    }
+
+    const auto address = site.pointer != 0 ? static_cast<std::uintptr_t>(registers[site.pointer]) : site.target.native;
+    GPArgs gp{};
+    FPArgs fp{};
+    std::size_t gp_count{};
+    std::size_t fp_count{};
+    for (std::size_t idx{}; idx < args.size(); ++idx) {
+        if (is_float(site.arg_kinds[idx])) {
+            if (fp_count == MAX_FP_ARGS) {
+                die("Too many floating point arguments for a native call of '{}'", site.prototype->name());
+            }
+
+            fp[fp_count++] = std::bit_cast<double>(args[idx]);
+        } else {
+            if (gp_count == MAX_GP_ARGS) {
+                die("Too many integer arguments for a native call of '{}'", site.prototype->name());
+            }
+
+            gp[gp_count++] = static_cast<std::int64_t>(args[idx]);
+        }
+    }
+
+    const auto [first, second] = site.result_kinds;
+    if (second == ValueKind::NONE) {
+        if (is_float(first)) {
+            return {std::bit_cast<std::uint64_t>(call_native<double>(address, gp, fp)), 0};
+        }
+
+        return {static_cast<std::uint64_t>(call_native<std::int64_t>(address, gp, fp)), 0};
+    }
+
+    if (is_float(first)) {
+        return is_float(second) ? call_native_pair<double, double>(address, gp, fp) : call_native_pair<double, std::int64_t>(address, gp, fp);
+    }
+
+    return is_float(second) ? call_native_pair<std::int64_t, double>(address, gp, fp) : call_native_pair<std::int64_t, std::int64_t>(address, gp, fp);
+}
+
+std::array<std::uint64_t, 2> Interpreter::execute(const BytecodeFunction &function, const std::span<const std::uint64_t> args) {
+    std::vector<std::uint64_t> regs(function.registers);
+    std::ranges::copy(args, regs.begin() + 1);
+
+    // Memory of the alloc instructions, released on return like a stack frame.
+    std::vector<std::unique_ptr<std::uint8_t[]>> frame;
+    for (std::size_t pc{};;) {
+        const auto& inst = function.code[pc++];
+        m_executed += 1;
+
+        const auto a = regs[inst.a];
+        const auto b = regs[inst.b];
+        const auto kind = inst.kind;
+        switch (inst.op) {
+            case Opcode::MOV: regs[inst.dst] = a; break;
+            case Opcode::ADD: regs[inst.dst] = normalize(kind, a + b); break;
+            case Opcode::SUB: regs[inst.dst] = normalize(kind, a - b); break;
+            case Opcode::MUL: regs[inst.dst] = normalize(kind, a * b); break;
+            case Opcode::AND: regs[inst.dst] = a & b; break;
+            case Opcode::OR:  regs[inst.dst] = a | b; break;
+            case Opcode::XOR: regs[inst.dst] = a ^ b; break;
+            case Opcode::SHL: regs[inst.dst] = normalize(kind, a << shift_count(kind, b)); break;
+            case Opcode::SHR: {
+                const auto count = shift_count(kind, b);
+                regs[inst.dst] = is_signed(kind) ? static_cast<std::uint64_t>(static_cast<std::int64_t>(a) >> count) : a >> count;
+                break;
+            }
+            case Opcode::FADD: regs[inst.dst] = fp_binary(kind, a, b, std::plus{}); break;
+            case Opcode::FSUB: regs[inst.dst] = fp_binary(kind, a, b, std::minus{}); break;
+            case Opcode::FMUL: regs[inst.dst] = fp_binary(kind, a, b, std::multiplies{}); break;
+            case Opcode::FDIV: regs[inst.dst] = fp_binary(kind, a, b, std::divides{}); break;
+            case Opcode::NEG:  regs[inst.dst] = normalize(kind, 0 - a); break;
+            case Opcode::NOT:  regs[inst.dst] = normalize(kind, ~a); break;
+            case Opcode::FNEG: regs[inst.dst] = a ^ (kind == ValueKind::F32 ? 1ULL << 31 : 1ULL << 63); break;
+            case Opcode::CONVERT: regs[inst.dst] = normalize(kind, a); break;
+            case Opcode::SEXT: {
+                const auto shift = 64 - inst.aux * 8;
+                regs[inst.dst] = normalize(kind, static_cast<std::uint64_t>(static_cast<std::int64_t>(a << shift) >> shift));
+                break;
+            }
+            case Opcode::ZEXT: {
+                const auto shift = 64 - inst.aux * 8;
+                regs[inst.dst] = normalize(kind, a << shift >> shift);
+                break;
+            }
+            case Opcode::I2F: {
+                if (kind == ValueKind::F32) {
+                    regs[inst.dst] = to_bits(inst.aux != 0 ? static_cast<float>(static_cast<std::int64_t>(a)) : static_cast<float>(a));
+                } else {
+                    regs[inst.dst] = to_bits(inst.aux != 0 ? static_cast<double>(static_cast<std::int64_t>(a)) : static_cast<double>(a));
+                }
+                break;
+            }
+            case Opcode::F2I: {
+                const auto value = inst.aux != 0 ? from_bits<float>(a) : from_bits<double>(a);
+                regs[inst.dst] = normalize(kind, fp2int(value));
+                break;
+            }
+            case Opcode::LOAD:  regs[inst.dst] = load(kind, a); break;
+            case Opcode::STORE: store(kind, a, b); break;
+            case Opcode::ALLOC: {
+                const auto& memory = frame.emplace_back(std::make_unique<std::uint8_t[]>(std::max<std::size_t>(inst.c, 1)));
+                regs[inst.dst] = reinterpret_cast<std::uintptr_t>(memory.get());
+                break;
+            }
+            case Opcode::GEP:  regs[inst.dst] = a + b * inst.c; break;
+            case Opcode::ADDI: regs[inst.dst] = a + inst.c; break;
+            case Opcode::ICMP: regs[inst.dst] = icmp(static_cast<IcmpPredicate>(inst.aux), kind, a, b); break;
+            case Opcode::FCMP: regs[inst.dst] = fcmp(static_cast<FcmpPredicate>(inst.aux), to_double(kind, a), to_double(kind, b)); break;
+            case Opcode::SELECT: regs[inst.dst] = a != 0 ? b : regs[inst.c]; break;
+            case Opcode::DIV: {
+                if (b == 0) {
+                    die("Division by zero");
+                }
+
+                if (is_signed(kind)) {
+                    const auto lhs = static_cast<std::int64_t>(a);
+                    const auto rhs = static_cast<std::int64_t>(b);
+                    if (lhs == std::numeric_limits<std::int64_t>::min() && rhs == -1) {
+                        die("Division overflow");
+                    }
+
+                    regs[inst.dst] = normalize(kind, static_cast<std::uint64_t>(lhs / rhs));
+                    regs[inst.c] = normalize(kind, static_cast<std::uint64_t>(lhs % rhs));
+                } else {
+                    regs[inst.dst] = a / b;
+                    regs[inst.c] = a % b;
+                }
+                break;
+            }
+            case Opcode::JMP: pc = inst.c; break;
+            case Opcode::BR:  pc = a != 0 ? inst.b : inst.c; break;
+            case Opcode::SWITCH: {
+                const auto& table = function.switches[inst.c];
+                const auto it = std::ranges::find(table.cases, a, [](const auto& entry) { return entry.first; });
+                pc = it != table.cases.end() ? it->second : table.default_pc;
+                break;
+            }
+            case Opcode::CALL: {
+                const auto& site = function.calls[inst.c];
+                const auto [first, second] = call(site, regs);
+                regs[site.results[0]] = normalize(site.result_kinds[0], first);
+                regs[site.results[1]] = normalize(site.result_kinds[1], second);
+                break;
+            }
+            case Opcode::RET: return {0, 0};
+            case Opcode::RET_VALUE: return {a, b};
+            default: std::unreachable();
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "Bytecode.h"
+
+#include "mir/module/Module.h"
+#include "utility/Error.h"
+
+class Interpreter;
+
+namespace interp {
+    template<typename T>
+    std::uint64_t to_bits(const T value) noexcept {
+        if constexpr (std::is_same_v<T, float>) {
+            return std::bit_cast<std::uint32_t>(value);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::bit_cast<std::uint64_t>(value);
+        } else if constexpr (std::is_pointer_v<T>) {
+            return reinterpret_cast<std::uintptr_t>(value);
+        } else {
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        }
+    }
+
+    template<typename T>
+    T from_bits(const std::uint64_t bits) noexcept {
+        if constexpr (std::is_same_v<T, float>) {
+            return std::bit_cast<float>(static_cast<std::uint32_t>(bits));
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::bit_cast<double>(bits);
+        } else if constexpr (std::is_pointer_v<T>) {
+            return reinterpret_cast<T>(static_cast<std::uintptr_t>(bits));
+        } else {
+            return static_cast<T>(bits);
+        }
+    }
+}
+
+template<typename T>
+class InterpretedFunction;
+
+/**
+ * Typed entry into a function run by the interpreter, the counterpart of JitFunctionFunctor.
+ */
+template<typename R, typename... Args>
+class InterpretedFunction<R(Args...)> final {
+public:
+    explicit InterpretedFunction(Interpreter& interpreter, const FunctionData* function) noexcept:
+        m_interpreter(interpreter),
+        m_function(function) {}
+
+    R operator()(Args... args) const;
+
+private:
+    Interpreter& m_interpreter;
+    const FunctionData* m_function;
+};
+
+/**
+ * Runs the functions of the module without compiling them to machine code.
+ * A function is decoded into bytecode on its first call. Calls go to the address in 'symbols' when the callee is there,
+ * otherwise to the interpreted function of the module, so interpreted code can call external functions and functions
+ * compiled by the JIT. Globals listed in 'symbols' are shared with that code, the other ones are created by the interpreter.
+ * Native calls follow the System V ABI with all arguments in registers: up to 6 integer and 8 floating point ones.
+ * The interpreter is not thread safe.
+ */
+class Interpreter final {
+public:
+    explicit Interpreter(const Module& module, std::unordered_map<std::string, std::size_t> symbols = {}) noexcept:
+        m_module(module),
+        m_symbols(std::move(symbols)) {}
+
+    Interpreter(const Interpreter&) = delete;
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    template<typename T>
+    requires std::is_function_v<T>
+    [[nodiscard]]
+    std::expected<InterpretedFunction<T>, Error> function_as(const std::string& name) {
+        const auto& functions = m_module.functions();
+        if (const auto it = functions.find(name); it != functions.end()) {
+            return InterpretedFunction<T>(*this, &it->second);
+        }
+
+        return std::unexpected(Error::NotFoundError);
+    }
+
+    /**
+     * Runs the function with the arguments in the register representation of the interpreter.
+     * @return the returned values, the second one is used by functions returning a tuple.
+     */
+    std::array<std::uint64_t, 2> invoke(const FunctionData* function, std::span<const std::uint64_t> args);
+
+    /**
+     * Returns the address of the global, creating it on the first use.
+     */
+    [[nodiscard]]
+    std::uint8_t* global_address(const GlobalValue* global);
+
+    /**
+     * Returns the number of executed instructions.
+     */
+    [[nodiscard]]
+    std::size_t executed() const noexcept {
+        return m_executed;
+    }
+
+private:
+    const interp::BytecodeFunction& bytecode(const FunctionData* function);
+    void link(interp::BytecodeFunction& function);
+
+    std::array<std::uint64_t, 2> execute(const interp::BytecodeFunction& function, std::span<const std::uint64_t> args);
+    std::array<std::uint64_t, 2> call(const interp::CallSite& site, std::span<const std::uint64_t> registers);
+
+    void write_initializer(const NonTrivialType* type, const Initializer& initializer, std::uint8_t* dst);
+
+    const Module& m_module;
+    std::unordered_map<std::string, std::size_t> m_symbols;
+    std::unordered_map<const FunctionData*, std::unique_ptr<interp::BytecodeFunction>> m_bytecode;
+    std::unordered_map<const GlobalValue*, std::unique_ptr<std::uint8_t[]>> m_globals;
+    std::size_t m_executed{};
+};
+
+template<typename R, typename... Args>
+R InterpretedFunction<R(Args...)>::operator()(Args... args) const {
+    const std::array<std::uint64_t, sizeof...(Args)> bits{interp::to_bits(args)...};
+    const auto result = m_interpreter.invoke(m_function, bits);
+    if constexpr (!std::is_void_v<R>) {
+        return interp::from_bits<R>(result[0]);
+    }
+}
@@ -25,6 +25,7 @@ class TupleCall;
 class Select;
 class IntDiv;
 class Projection;
+class VectorInstruction;
 
 class BasicBlock;
 
@@ -41,6 +42,7 @@ class VoidType;
 class StructType;
 class ArrayType;
 class TupleType;
+class VectorType;
 
 class Value;
 class ArgumentValue;
@@ -2,6 +2,9 @@
 #include "mir/instruction/Terminator.h"
 #include "utility/Error.h"
 #include "mir/value/UsedValue.h"
+#include "mir/instruction/InstructionMatcher.h"
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/ValueInstruction.h"
 
 Terminator BasicBlock::last() const noexcept {
     const auto back = m_instructions.back();
@@ -17,6 +20,16 @@ Terminator BasicBlock::last() const noexcept {
     return term.value();
 }
 
+void BasicBlock::kill_operand_uses() {
+    for (const auto& inst: m_instructions) {
+        for (const auto& operand: inst.operands()) {
+            if (const auto local = UsedValue::try_from(operand); local.has_value()) {
+                local->kill_user(&inst);
+            }
+        }
+    }
+}
+
 void BasicBlock::make_def_use_chain(Instruction *inst) {
     for (const auto& operand: inst->operands()) {
         auto local = UsedValue::try_from(operand);
@@ -26,4 +39,94 @@ void BasicBlock::make_def_use_chain(Instruction *inst) {
 
         local->add_user(inst);
     }
+}
+void BasicBlock::remove(const Instruction *inst) {
+    assertion(inst->owner() == this, "instruction belongs to another block");
+    assertion(!inst->isa(any_terminate()), "terminator cannot be removed");
+    if (const auto value = dynamic_cast<const ValueInstruction*>(inst); value != nullptr) {
+        assertion(value->users().empty(), "instruction still has users");
+    }
+
+    for (const auto& operand: inst->operands()) {
+        if (const auto local = UsedValue::try_from(operand); local.has_value()) {
+            local->kill_user(inst);
+        }
+    }
+
+    m_instructions.remove(inst->id());
+}
+
+std::vector<BasicBlock*> BasicBlock::remove_terminator() {
+    const auto back = m_instructions.back();
+    assertion(back != m_instructions.end(), "block has no instructions");
+    const auto term = dynamic_cast<const TerminateInstruction*>(back.get());
+    assertion(term != nullptr, "only branches and returns can be replaced");
+
+    std::vector old_successors(term->successors().begin(), term->successors().end());
+    for (const auto succ: old_successors) {
+        std::erase(succ->m_predecessors, this);
+    }
+
+    for (const auto& operand: term->operands()) {
+        if (const auto local = UsedValue::try_from(operand); local.has_value()) {
+            local->kill_user(term);
+        }
+    }
+
+    m_instructions.remove(term->id());
+    return old_successors;
+}
+
+void BasicBlock::remove_phi_incoming(const BasicBlock *pred) {
+    for (auto& inst: m_instructions) {
+        if (const auto phi = dynamic_cast<Phi*>(&inst); phi != nullptr) {
+            phi->remove_incoming(pred);
+        }
+    }
+}
+
+void BasicBlock::remove_predecessor(const BasicBlock *pred) {
+    std::erase(m_predecessors, pred);
+    remove_phi_incoming(pred);
+}
+
+
+Instruction* BasicBlock::detach(const Instruction *inst) {
+    assertion(inst->owner() == this, "instruction belongs to another block");
+    const auto detached = m_instructions.remove(inst->id());
+    detached->disconnect();
+    return detached;
+}
+
+void BasicBlock::move_before(const Instruction *before, const Instruction *inst) {
+    assertion(before->owner() == this, "instruction belongs to another block");
+    assertion(!inst->isa(any_terminate()), "terminator cannot be moved");
+    assertion(dynamic_cast<const Phi*>(inst) == nullptr, "phi node cannot be moved");
+
+    const auto id = m_instructions.insert_before(before->id(), inst->owner()->detach(inst));
+    m_instructions[id].connect(id, this);
+}
+
+void BasicBlock::merge(BasicBlock *succ) {
+    assertion(succ != this, "block cannot be merged into itself");
+    assertion(last().targets().size() == 1 && last().targets().front() == succ, "block must branch only to the successor");
+    assertion(succ->m_predecessors.size() == 1, "successor must have a single predecessor");
+    remove_terminator();
+
+    while (succ->m_instructions.begin() != succ->m_instructions.end()) {
+        const auto& front = *succ->m_instructions.begin();
+        assertion(dynamic_cast<const Phi*>(&front) == nullptr, "successor must not have phi nodes");
+
+        const auto id = m_instructions.push_back(succ->detach(&front));
+        m_instructions[id].connect(id, this);
+    }
+
+    for (const auto target: successors()) {
+        std::ranges::replace(target->m_predecessors, succ, this);
+        for (auto& inst: target->m_instructions) {
+            if (const auto phi = dynamic_cast<Phi*>(&inst); phi != nullptr) {
+                phi->replace_incoming_block(succ, this);
+            }
+        }
+    }
 }
\ No newline at end of file
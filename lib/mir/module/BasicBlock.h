@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "base/BasicBlockBase.h"
 #include "base/Constrains.h"
 #include "mir/instruction/Instruction.h"
@@ -8,10 +10,16 @@
 
 class BasicBlock final: public BasicBlockBase<BasicBlock, Instruction> {
 public:
-    template<std::derived_from<Instruction> U>
-    U* ins(std::unique_ptr<U>&& inst) {
-        auto inst_ptr = inst.get();
-        const auto id = m_instructions.push_back(std::move(inst));
+    explicit BasicBlock(Arena& arena) noexcept:
+        BasicBlockBase(arena) {}
+
+    /**
+     * Constructs the instruction in the arena of the function and appends it to the block.
+     */
+    template<std::derived_from<Instruction> U, typename Fn>
+    U* ins(Deferred<U, Fn>&& inst) {
+        const auto inst_ptr = std::move(inst)(*m_arena);
+        const auto id = m_instructions.push_back(inst_ptr);
         inst_ptr->connect(id, this);
         make_def_use_chain(inst_ptr);
         if constexpr (IsTerminator<U>) {
@@ -21,6 +29,69 @@ public:
         return inst_ptr;
     }
 
+    /**
+     * Inserts the instruction before the given one. Terminators can be added only by @ref ins.
+     */
+    template<std::derived_from<Instruction> U, typename Fn>
+    U* ins_before(const Instruction* before, Deferred<U, Fn>&& inst) {
+        return ins_before(before, std::move(inst)(*m_arena));
+    }
+
+    /**
+     * Inserts the instruction made by @ref FunctionData::make before the given one.
+     */
+    template<std::derived_from<Instruction> U>
+    U* ins_before(const Instruction* before, U* inst) {
+        static_assert(!IsTerminator<U>, "terminator must be the last instruction");
+        assertion(before->owner() == this, "instruction belongs to another block");
+        const auto id = m_instructions.insert_before(before->id(), inst);
+        inst->connect(id, this);
+        make_def_use_chain(inst);
+        return inst;
+    }
+
+    /**
+     * Removes the instruction from the block and unregisters it from the users of its operands.
+     * The instruction must not have users and must not be a terminator. Its memory is released with the function.
+     */
+    void remove(const Instruction* inst);
+
+    /**
+     * Replaces the terminator of the block. Successors which are no longer targets of the block
+     * lose it as a predecessor together with their phi incoming values. Calls cannot be replaced.
+     */
+    template<std::derived_from<TerminateInstruction> U, typename Fn>
+    U* replace_terminator(Deferred<U, Fn>&& inst) {
+        const auto old_successors = remove_terminator();
+        const auto inst_ptr = ins(std::move(inst));
+        for (const auto succ: old_successors) {
+            if (!std::ranges::contains(successors(), succ)) {
+                succ->remove_phi_incoming(this);
+            }
+        }
+
+        return inst_ptr;
+    }
+
+    /**
+     * Drops the edge from the predecessor together with the phi incoming values of it.
+     */
+    void remove_predecessor(const BasicBlock* pred);
+
+    /**
+     * Moves the instruction from its block to this one, before the given instruction.
+     * Def-use chains refer to instructions, so users and operands stay as they are.
+     * Phi nodes and terminators cannot be moved.
+     */
+    void move_before(const Instruction* before, const Instruction* inst);
+
+    /**
+     * Moves the instructions of the successor to the end of this block in place of the branch to it.
+     * The successor must be the only target of the branch, have this block as the only predecessor and no phi nodes.
+     * It is left empty and should be removed from the function.
+     */
+    void merge(BasicBlock* succ);
+
     [[nodiscard]]
     Terminator last() const noexcept;
 
@@ -33,6 +104,20 @@ private:
     friend class FunctionData;
 
     static void make_def_use_chain(Instruction* inst);
+
+    std::vector<BasicBlock*> remove_terminator();
+
+    /**
+     * Takes the instruction out of the block without touching def-use chains.
+     */
+    Instruction* detach(const Instruction* inst);
+
+    void remove_phi_incoming(const BasicBlock* pred);
+
+    /**
+     * Unregisters every instruction of the block from the users of its operands.
+     */
+    void kill_operand_uses();
 };
 
 
@@ -1,11 +1,58 @@
 #include "FunctionData.h"
 
+#include <vector>
+
 FunctionData::FunctionData(const std::size_t uid, const FunctionPrototype* prototype, std::vector<ArgumentValue> &&args) noexcept:
     FunctionDataBase(uid, std::move(args)),
     m_prototype(prototype) {
     create_basic_block();
 }
 
+std::size_t FunctionData::remove_unreachable_blocks() {
+    std::vector reachable(id_bound(), false);
+    std::vector<BasicBlock*> stack{first()};
+    reachable[first()->id()] = true;
+    while (!stack.empty()) {
+        const auto bb = stack.back();
+        stack.pop_back();
+        for (const auto succ: bb->successors()) {
+            if (!reachable[succ->id()]) {
+                reachable[succ->id()] = true;
+                stack.push_back(succ);
+            }
+        }
+    }
+
+    if (!reachable[last()->id()]) {
+        return 0;
+    }
+
+    std::vector<BasicBlock*> dead;
+    for (auto& bb: m_basic_blocks) {
+        if (!reachable[bb.id()]) {
+            dead.push_back(&bb);
+        }
+    }
+
+    for (const auto bb: dead) {
+        for (const auto succ: bb->successors()) {
+            if (reachable[succ->id()]) {
+                succ->remove_predecessor(bb);
+            }
+        }
+    }
+
+    // Dead values can be used only by other dead instructions, so the chains are cut before anything is destroyed.
+    for (const auto bb: dead) {
+        bb->kill_operand_uses();
+    }
+    for (const auto bb: dead) {
+        remove(bb);
+    }
+
+    return dead.size();
+}
+
 static std::ostream& print_blocks(std::ostream &os, const OrderedSet<BasicBlock> &blocks) {
     os << '{' << std::endl;
     for (const auto &bb : blocks) {
@@ -30,7 +30,7 @@ public:
     }
 
     BasicBlock* create_basic_block() {
-        const auto id = add_basic_block(std::make_unique<BasicBlock>());
+        const auto id = add_basic_block(m_arena->make<BasicBlock>(*m_arena));
         m_basic_blocks[id].set_id(id);
         return &m_basic_blocks[id];
     }
@@ -55,8 +55,15 @@ public:
         return m_prototype->name();
     }
 
-    std::size_t add_basic_block(std::unique_ptr<BasicBlock>&& bb) {
-        return m_basic_blocks.push_back(std::move(bb));
+    /**
+     * Removes the blocks which cannot be reached from the entry, along with their edges into the reachable ones.
+     * Nothing is removed if the return block itself is unreachable.
+     * @return The number of removed blocks.
+     */
+    std::size_t remove_unreachable_blocks();
+
+    std::size_t add_basic_block(BasicBlock* bb) {
+        return m_basic_blocks.push_back(bb);
     }
 
     [[nodiscard]]
@@ -1,6 +1,44 @@
 #include "mir/module/Module.h"
 
+#include <algorithm>
 #include <ranges>
+#include <sstream>
+
+#include "utility/Hash.h"
+
+std::uint64_t Module::hash() const {
+    std::vector<std::string> entries;
+    const auto print = [&](const auto& printer) {
+        std::ostringstream os;
+        // The default precision would map near-equal floating point constants to the same text.
+        os << std::hexfloat;
+        printer(os);
+        entries.push_back(std::move(os).str());
+    };
+
+    for (const auto& proto: std::ranges::views::values(m_prototypes)) {
+        print([&](std::ostream& os) { os << "declare " << proto; });
+    }
+    for (const auto &s: std::ranges::views::values(m_known_structs)) {
+        print([&](std::ostream& os) { s.print_declaration(os); });
+    }
+    for (const auto &c: std::ranges::views::values(m_gvalue_pool)) {
+        print([&](std::ostream& os) { c.print_description(os); });
+    }
+    for (const auto &f: std::ranges::views::values(m_functions)) {
+        print([&](std::ostream& os) { os << f; });
+    }
+
+    // Hash maps iterate in an unspecified order.
+    std::ranges::sort(entries);
+    Fnv1a hasher;
+    for (const auto& entry: entries) {
+        hasher.update(entry.size());
+        hasher.update(entry);
+    }
+
+    return hasher.digest();
+}
 
 std::ostream & operator<<(std::ostream &os, const Module &module) {
     for (const auto& proto: std::ranges::views::values(module.m_prototypes)) {
@@ -36,11 +36,22 @@ public:
         return m_functions;
     }
 
+    std::unordered_map<std::string, FunctionData>& functions() {
+        return m_functions;
+    }
+
     [[nodiscard]]
     const GValuePool& gvalue_pool() const noexcept {
         return m_gvalue_pool;
     }
 
+    /**
+     * Hash of the printed prototypes, structs, globals and functions.
+     * It doesn't depend on the order the module was built in.
+     */
+    [[nodiscard]]
+    std::uint64_t hash() const;
+
     friend std::ostream &operator<<(std::ostream &os, const Module &module);
 
 private:
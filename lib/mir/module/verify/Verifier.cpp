@@ -11,6 +11,7 @@
 #include "mir/instruction/Phi.h"
 #include "mir/instruction/Store.h"
 #include "mir/instruction/IntDiv.h"
+#include "mir/instruction/VectorInstruction.h"
 #include "mir/value/UsedValue.h"
 
 class InstructionVerifier final: public Visitor {
@@ -98,7 +99,40 @@ private:
         }
     }
 
+    void validate_vector_binary(const Binary* inst) {
+        const auto vec_type = VectorType::cast(inst->type());
+        switch (inst->op()) {
+            case BinaryOp::Add:      [[fallthrough]];
+            case BinaryOp::Subtract: validate_binary<VectorType>(inst); break;
+            case BinaryOp::Multiply: {
+                // AVX2 has no packed 64-bit integer multiply.
+                if (const auto element = vec_type->element_type(); IntegerType::cast(element) != nullptr && element->size_of() == 8) {
+                    raise_type_error(vec_type);
+                    return;
+                }
+
+                validate_binary<VectorType>(inst);
+                break;
+            }
+            case BinaryOp::Divide: {
+                if (FloatingPointType::cast(vec_type->element_type()) == nullptr) {
+                    raise_type_error(vec_type);
+                    return;
+                }
+
+                validate_binary<VectorType>(inst);
+                break;
+            }
+            default: raise_type_error(vec_type); break;
+        }
+    }
+
     void accept(Binary *inst) override {
+        if (VectorType::cast(inst->type()) != nullptr) {
+            validate_vector_binary(inst);
+            return;
+        }
+
         switch (inst->op()) {
             case BinaryOp::Add:        [[fallthrough]];
             case BinaryOp::Subtract:   [[fallthrough]];
@@ -328,6 +362,29 @@ private:
     void accept(Projection *proj) override {
     }
 
+    void accept(VectorInstruction *vec) override {
+        const auto vec_type = vec->vector_type();
+        switch (vec->op()) {
+            case VectorOp::Broadcast: {
+                if (const auto scalar_type = vec->lhs().type(); scalar_type != vec_type->element_type()) {
+                    raise_type_error(vec_type, scalar_type);
+                }
+                break;
+            }
+            case VectorOp::Shuffle: {
+                if (vec_type->element_type()->size_of() != 4) {
+                    raise_type_error(vec_type);
+                    return;
+                }
+
+                validate_binary<VectorType>(vec);
+                break;
+            }
+            case VectorOp::Compare: validate_binary<VectorType>(vec); break;
+            default: std::unreachable();
+        }
+    }
+
     std::optional<VerifierResult> m_correct{};
     const Instruction* m_inst;
     const FunctionPrototype* m_prototype;
@@ -0,0 +1,244 @@
+#include "ConstantFolding.h"
+
+#include <cmath>
+#include <concepts>
+
+#include "mir/value/ValueMatcher.h"
+
+
+static constexpr std::size_t BITS_IN_BYTE = 8;
+
+static std::uint64_t width_mask(const std::size_t width) noexcept {
+    return width >= 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+static std::uint64_t sign_extend(const std::uint64_t bits, const std::size_t width) noexcept {
+    if (width >= 64) {
+        return bits;
+    }
+
+    const auto mask = width_mask(width);
+    const auto value = bits & mask;
+    return (value >> (width - 1) & 1) != 0 ? value | ~mask : value;
+}
+
+/**
+ * Wraps the bits to the width of the type. Signed constants are kept sign extended, unsigned ones zero extended.
+ */
+static Value make_int(const IntegerType* type, const std::uint64_t bits) {
+    const auto width = type->size_of() * BITS_IN_BYTE;
+    const auto value = type->isa(signed_type()) ? sign_extend(bits, width) : bits & width_mask(width);
+    return {static_cast<std::int64_t>(value), type};
+}
+
+static Value make_fp(const FloatingPointType* type, const double value) {
+    if (type == FloatingPointType::f32()) {
+        return {static_cast<double>(static_cast<float>(value)), type};
+    }
+
+    return {value, type};
+}
+
+/**
+ * Returns the bits of the integer constant in the canonical form of its type.
+ */
+static std::uint64_t int_bits(const Value& value) {
+    const auto type = IntegerType::cast(value.type());
+    return static_cast<std::uint64_t>(make_int(type, static_cast<std::uint64_t>(value.get<std::int64_t>())).get<std::int64_t>());
+}
+
+template<std::floating_point T>
+static std::optional<T> fp_binary(const BinaryOp op, const T lhs, const T rhs) noexcept {
+    switch (op) {
+        case BinaryOp::Add:      return lhs + rhs;
+        case BinaryOp::Subtract: return lhs - rhs;
+        case BinaryOp::Multiply: return lhs * rhs;
+        case BinaryOp::Divide:   return lhs / rhs;
+        default:                 return std::nullopt;
+    }
+}
+
+static std::optional<Value> fold_fp_binary(const BinaryOp op, const Value& lhs, const Value& rhs) {
+    const auto type = FloatingPointType::cast(lhs.type());
+    if (type == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto lhs_val = lhs.get<double>();
+    const auto rhs_val = rhs.get<double>();
+    if (type == FloatingPointType::f32()) {
+        const auto result = fp_binary(op, static_cast<float>(lhs_val), static_cast<float>(rhs_val));
+        return result.transform([&](const float val) { return make_fp(type, val); });
+    }
+
+    const auto result = fp_binary(op, lhs_val, rhs_val);
+    return result.transform([&](const double val) { return make_fp(type, val); });
+}
+
+std::optional<Value> fold_binary(const BinaryOp op, const Value& lhs, const Value& rhs) {
+    if (lhs.is<double>() && rhs.is<double>()) {
+        return fold_fp_binary(op, lhs, rhs);
+    }
+
+    const auto type = IntegerType::cast(lhs.type());
+    if (type == nullptr || !lhs.is<std::int64_t>() || !rhs.is<std::int64_t>() || IntegerType::cast(rhs.type()) == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto a = int_bits(lhs);
+    const auto b = int_bits(rhs);
+    const auto width = type->size_of() * BITS_IN_BYTE;
+    switch (op) {
+        case BinaryOp::Add:        return make_int(type, a + b);
+        case BinaryOp::Subtract:   return make_int(type, a - b);
+        case BinaryOp::Multiply:   return make_int(type, a * b);
+        case BinaryOp::BitwiseAnd: return make_int(type, a & b);
+        case BinaryOp::BitwiseOr:  return make_int(type, a | b);
+        case BinaryOp::BitwiseXor: return make_int(type, a ^ b);
+        case BinaryOp::ShiftLeft: {
+            if (b >= width) {
+                return std::nullopt;
+            }
+
+            return make_int(type, a << b);
+        }
+        case BinaryOp::ShiftRight: {
+            if (b >= width) {
+                return std::nullopt;
+            }
+            if (lhs.isa(signed_v())) {
+                return make_int(type, static_cast<std::uint64_t>(static_cast<std::int64_t>(a) >> b));
+            }
+
+            return make_int(type, a >> b);
+        }
+        // Integer division is IntDiv, Divide is defined only for floats.
+        case BinaryOp::Divide: return std::nullopt;
+        default: std::unreachable();
+    }
+}
+
+/**
+ * Converts with truncation toward zero. Values which don't fit the type produce the 'integer indefinite' on x86, they are not folded.
+ */
+static std::optional<Value> fold_fp2int(const IntegerType* type, const double value) {
+    const auto truncated = std::trunc(value);
+    // [-2^63, 2^63)
+    if (!(truncated >= -9223372036854775808.0 && truncated < 9223372036854775808.0)) {
+        return std::nullopt;
+    }
+
+    const auto integer = static_cast<std::int64_t>(truncated);
+    const auto result = make_int(type, static_cast<std::uint64_t>(integer));
+    if (result.get<std::int64_t>() != integer) {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+static std::optional<Value> fold_int2fp(const FloatingPointType* type, const Value& operand) {
+    const auto bits = int_bits(operand);
+    if (operand.isa(signed_v())) {
+        const auto value = static_cast<std::int64_t>(bits);
+        return type == FloatingPointType::f32() ? make_fp(type, static_cast<float>(value)) : make_fp(type, static_cast<double>(value));
+    }
+
+    return type == FloatingPointType::f32() ? make_fp(type, static_cast<float>(bits)) : make_fp(type, static_cast<double>(bits));
+}
+
+std::optional<Value> fold_unary(const UnaryOp op, const Type* type, const Value& operand) {
+    if (operand.is<double>()) {
+        switch (op) {
+            case UnaryOp::Negate: {
+                const auto fp_type = FloatingPointType::cast(type);
+                return fp_type == nullptr ? std::nullopt : std::optional(make_fp(fp_type, -operand.get<double>()));
+            }
+            case UnaryOp::Float2Int: {
+                const auto int_type = IntegerType::cast(type);
+                return int_type == nullptr ? std::nullopt : fold_fp2int(int_type, operand.get<double>());
+            }
+            default: return std::nullopt;
+        }
+    }
+
+    const auto operand_type = IntegerType::cast(operand.type());
+    if (!operand.is<std::int64_t>() || operand_type == nullptr) {
+        return std::nullopt;
+    }
+
+    if (op == UnaryOp::Int2Float) {
+        const auto fp_type = FloatingPointType::cast(type);
+        return fp_type == nullptr ? std::nullopt : fold_int2fp(fp_type, operand);
+    }
+
+    const auto int_type = IntegerType::cast(type);
+    if (int_type == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto bits = int_bits(operand);
+    const auto operand_width = operand_type->size_of() * BITS_IN_BYTE;
+    switch (op) {
+        case UnaryOp::Negate:     return make_int(int_type, 0 - bits);
+        case UnaryOp::LogicalNot: return make_int(int_type, ~bits);
+        case UnaryOp::Trunk:      [[fallthrough]];
+        case UnaryOp::Bitcast:    return make_int(int_type, bits);
+        case UnaryOp::SignExtend: return make_int(int_type, sign_extend(bits, operand_width));
+        case UnaryOp::ZeroExtend: return make_int(int_type, bits & width_mask(operand_width));
+        default:                  return std::nullopt;
+    }
+}
+
+std::optional<bool> fold_icmp(const IcmpPredicate predicate, const Value& lhs, const Value& rhs) {
+    if (!lhs.is<std::int64_t>() || !rhs.is<std::int64_t>() || IntegerType::cast(lhs.type()) == nullptr || IntegerType::cast(rhs.type()) == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto compare = [&]<std::integral T>(const T a, const T b) {
+        switch (predicate) {
+            case IcmpPredicate::Eq: return a == b;
+            case IcmpPredicate::Ne: return a != b;
+            case IcmpPredicate::Lt: return a < b;
+            case IcmpPredicate::Le: return a <= b;
+            case IcmpPredicate::Gt: return a > b;
+            case IcmpPredicate::Ge: return a >= b;
+            default: std::unreachable();
+        }
+    };
+
+    const auto a = int_bits(lhs);
+    const auto b = int_bits(rhs);
+    if (lhs.isa(signed_v())) {
+        return compare(static_cast<std::int64_t>(a), static_cast<std::int64_t>(b));
+    }
+
+    return compare(a, b);
+}
+
+std::optional<bool> fold_fcmp(const FcmpPredicate predicate, const Value& lhs, const Value& rhs) {
+    if (!lhs.is<double>() || !rhs.is<double>()) {
+        return std::nullopt;
+    }
+
+    const auto a = lhs.get<double>();
+    const auto b = rhs.get<double>();
+    const auto unordered = std::isnan(a) || std::isnan(b);
+    switch (predicate) {
+        case FcmpPredicate::Oeq: return !unordered && a == b;
+        case FcmpPredicate::One: return !unordered && a != b;
+        case FcmpPredicate::Olt: return !unordered && a < b;
+        case FcmpPredicate::Ole: return !unordered && a <= b;
+        case FcmpPredicate::Ogt: return !unordered && a > b;
+        case FcmpPredicate::Oge: return !unordered && a >= b;
+        case FcmpPredicate::Ord: return !unordered;
+        case FcmpPredicate::Ueq: return unordered || a == b;
+        case FcmpPredicate::Une: return unordered || a != b;
+        case FcmpPredicate::Ult: return unordered || a < b;
+        case FcmpPredicate::Ule: return unordered || a <= b;
+        case FcmpPredicate::Ugt: return unordered || a > b;
+        case FcmpPredicate::Uge: return unordered || a >= b;
+        case FcmpPredicate::Uno: return unordered;
+        default: std::unreachable();
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <optional>
+
+#include "mir/instruction/Binary.h"
+#include "mir/instruction/Fcmp.h"
+#include "mir/instruction/Icmp.h"
+#include "mir/instruction/Unary.h"
+
+/**
+ * Evaluates operations on constants with the semantics of the generated code.
+ * Integers wrap around to the width of their type. Nothing is returned if an operand is not a constant
+ * or the machine result is not defined, e.g. shifts by the width of the type or out of range float to integer conversions.
+ */
+std::optional<Value> fold_binary(BinaryOp op, const Value& lhs, const Value& rhs);
+
+std::optional<Value> fold_unary(UnaryOp op, const Type* type, const Value& operand);
+
+std::optional<bool> fold_icmp(IcmpPredicate predicate, const Value& lhs, const Value& rhs);
+
+std::optional<bool> fold_fcmp(FcmpPredicate predicate, const Value& lhs, const Value& rhs);
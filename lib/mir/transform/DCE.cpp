@@ -0,0 +1,102 @@
+#include "DCE.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/Store.h"
+#include "mir/instruction/TerminateInstruction.h"
+#include "mir/instruction/TerminateValueInstruction.h"
+#include "mir/types/TupleType.h"
+
+static bool is_root(const Instruction* inst) noexcept {
+    return dynamic_cast<const TerminateInstruction*>(inst) != nullptr ||
+        dynamic_cast<const TerminateValueInstruction*>(inst) != nullptr ||
+        dynamic_cast<const Store*>(inst) != nullptr;
+}
+
+bool DCE::is_live(const Instruction *inst) const {
+    return m_live[inst->owner()->id()][inst->id()];
+}
+
+void DCE::mark_live(const Instruction *inst) {
+    auto&& live = m_live[inst->owner()->id()][inst->id()];
+    if (live) {
+        return;
+    }
+
+    live = true;
+    m_worklist.push_back(inst);
+}
+
+void DCE::mark() {
+    m_live.resize(m_data.id_bound());
+    for (const auto& bb: m_data.basic_blocks()) {
+        m_live[bb.id()].assign(bb.instructions().id_bound(), false);
+        for (const auto& inst: bb.instructions()) {
+            if (is_root(&inst)) {
+                mark_live(&inst);
+            }
+        }
+    }
+
+    while (!m_worklist.empty()) {
+        const auto inst = m_worklist.back();
+        m_worklist.pop_back();
+        for (const auto& operand: inst->operands()) {
+            if (operand.is<ValueInstruction*>()) {
+                mark_live(operand.get<ValueInstruction*>());
+            }
+        }
+
+        const auto value = dynamic_cast<const ValueInstruction*>(inst);
+        if (value != nullptr && dynamic_cast<const TupleType*>(value->type()) != nullptr) {
+            for (const auto user: value->users()) {
+                mark_live(user);
+            }
+        }
+    }
+}
+
+bool DCE::sweep() {
+    std::vector<Instruction*> dead;
+    for (auto& bb: m_data.basic_blocks()) {
+        for (auto& inst: bb.instructions()) {
+            if (!is_live(&inst)) {
+                dead.push_back(const_cast<Instruction*>(&inst));
+            }
+        }
+    }
+
+    // Dead phi nodes may use each other, so they drop their operands first.
+    // The rest of the dead instructions cannot form a cycle and go away once their users are gone.
+    for (const auto inst: dead) {
+        const auto phi = dynamic_cast<Phi*>(inst);
+        if (phi == nullptr) {
+            continue;
+        }
+
+        const std::vector incoming(phi->incoming().begin(), phi->incoming().end());
+        for (const auto bb: incoming) {
+            phi->remove_incoming(bb);
+        }
+    }
+
+    const auto removed = !dead.empty();
+    while (!dead.empty()) {
+        std::vector<Instruction*> pending;
+        for (const auto inst: std::views::reverse(dead)) {
+            if (const auto value = dynamic_cast<const ValueInstruction*>(inst); value != nullptr && !value->users().empty()) {
+                pending.push_back(inst);
+                continue;
+            }
+
+            inst->owner()->remove(inst);
+        }
+
+        std::ranges::reverse(pending);
+        dead = std::move(pending);
+    }
+
+    return removed;
+}
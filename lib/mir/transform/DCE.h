@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+#include "mir/analysis/Analysis.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Aggressive dead code elimination.
+ * Terminators and stores are live, everything they use is live transitively, the rest is removed.
+ * Unlike removing unused instructions one by one, this also removes cycles of phi nodes which feed only each other.
+ * Projections live and die together with the tuple they belong to, since the lowering finds them by position in its users.
+ */
+class DCE final {
+    explicit DCE(FunctionData& data) noexcept:
+        m_data(data) {}
+
+public:
+    PreservedAnalyses run() {
+        mark();
+        if (!sweep()) {
+            return PreservedAnalyses::all();
+        }
+
+        // Only instructions are removed, the control flow graph stays intact.
+        return PreservedAnalyses::cfg();
+    }
+
+    static DCE create(AnalysisPassManager*, FunctionData* data) {
+        return DCE(*data);
+    }
+
+private:
+    void mark();
+    void mark_live(const Instruction* inst);
+    bool sweep();
+
+    [[nodiscard]]
+    bool is_live(const Instruction* inst) const;
+
+    FunctionData& m_data;
+    // Liveness of instructions, indexed by block id and instruction id.
+    std::vector<std::vector<bool>> m_live;
+    std::vector<const Instruction*> m_worklist;
+};
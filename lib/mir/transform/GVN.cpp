@@ -0,0 +1,151 @@
+#include "GVN.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+#include "mir/instruction/Binary.h"
+#include "mir/instruction/GetElementPtr.h"
+#include "mir/instruction/GetFieldPtr.h"
+#include "mir/instruction/Unary.h"
+#include "mir/value/UsedValue.h"
+
+static std::tuple<std::size_t, std::uint64_t, std::uintptr_t> operand_of(const Value& value) noexcept {
+    const auto visitor = []<typename T>(const T& val) noexcept -> std::uint64_t {
+        if constexpr (std::is_same_v<T, double>) {
+            return std::bit_cast<std::uint64_t>(val);
+        } else if constexpr (std::is_same_v<T, std::int64_t>) {
+            return static_cast<std::uint64_t>(val);
+        } else {
+            return reinterpret_cast<std::uintptr_t>(val);
+        }
+    };
+
+    const auto kind = value.visit([]<typename T>(const T&) noexcept {
+        return std::is_same_v<T, double> ? 0UZ : std::is_same_v<T, std::int64_t> ? 1UZ : 2UZ;
+    });
+
+    return {kind, value.visit(visitor), reinterpret_cast<std::uintptr_t>(value.type())};
+}
+
+static bool is_commutative(const BinaryOp op) noexcept {
+    switch (op) {
+        case BinaryOp::Add:        [[fallthrough]];
+        case BinaryOp::Multiply:   [[fallthrough]];
+        case BinaryOp::BitwiseAnd: [[fallthrough]];
+        case BinaryOp::BitwiseOr:  [[fallthrough]];
+        case BinaryOp::BitwiseXor: return true;
+        default:                   return false;
+    }
+}
+
+std::size_t GVN::ExpressionHash::operator()(const Expression &expr) const noexcept {
+    std::size_t hash = std::hash<std::uint8_t>{}(static_cast<std::uint8_t>(expr.m_kind));
+    const auto combine = [&](const std::size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(expr.m_op);
+    combine(std::hash<const Type*>{}(expr.m_type));
+    combine(expr.m_index);
+    for (const auto& [kind, bits, type]: expr.m_operands) {
+        combine(kind);
+        combine(std::hash<std::uint64_t>{}(bits));
+        combine(std::hash<std::uintptr_t>{}(type));
+    }
+
+    return hash;
+}
+
+std::optional<GVN::Expression> GVN::expression_of(const Instruction *inst) {
+    std::vector<Operand> operands;
+    operands.reserve(inst->operands().size());
+    for (const auto& operand: inst->operands()) {
+        operands.push_back(operand_of(operand));
+    }
+
+    if (const auto binary = dynamic_cast<const Binary*>(inst); binary != nullptr) {
+        if (is_commutative(binary->op())) {
+            std::ranges::sort(operands);
+        }
+
+        return Expression{ExpressionKind::Binary, static_cast<std::uint8_t>(binary->op()), binary->type(), 0, std::move(operands)};
+    }
+
+    if (const auto unary = dynamic_cast<const Unary*>(inst); unary != nullptr) {
+        if (unary->op() == UnaryOp::Load || unary->op() == UnaryOp::Flag2Int) {
+            return std::nullopt;
+        }
+
+        return Expression{ExpressionKind::Unary, static_cast<std::uint8_t>(unary->op()), unary->type(), 0, std::move(operands)};
+    }
+
+    if (const auto gep = dynamic_cast<const GetElementPtr*>(inst); gep != nullptr) {
+        return Expression{ExpressionKind::GetElementPtr, 0, gep->access_type(), 0, std::move(operands)};
+    }
+
+    if (const auto gfp = dynamic_cast<const GetFieldPtr*>(inst); gfp != nullptr) {
+        return Expression{ExpressionKind::GetFieldPtr, 0, gfp->basic_type(), gfp->index(), std::move(operands)};
+    }
+
+    return std::nullopt;
+}
+
+void GVN::number_block(const BasicBlock *bb, std::vector<Expression>& scope) {
+    for (const auto& inst: bb->instructions()) {
+        auto expr = expression_of(&inst);
+        if (!expr.has_value()) {
+            continue;
+        }
+
+        const auto value = dynamic_cast<const ValueInstruction*>(&inst);
+        if (const auto leader = m_available.find(expr.value()); leader != m_available.end()) {
+            // Users are rewritten at once, so expressions using this value are numbered by the leader.
+            UsedValue::from(value).replace_all_uses_with(leader->second);
+            m_redundant.push_back(&inst);
+            continue;
+        }
+
+        m_available.emplace(expr.value(), value);
+        scope.push_back(std::move(expr.value()));
+    }
+}
+
+void GVN::remove_redundant() const {
+    for (const auto inst: m_redundant) {
+        inst->owner()->remove(inst);
+    }
+}
+
+PreservedAnalyses GVN::run() {
+    std::vector<std::vector<Expression>> scopes;
+
+    // Walks the dominator tree in preorder. The second element marks the exit from the subtree.
+    std::vector<std::pair<const BasicBlock*, bool>> worklist{{m_data.first(), false}};
+    while (!worklist.empty()) {
+        const auto [bb, exit] = worklist.back();
+        worklist.pop_back();
+        if (exit) {
+            for (const auto& expr: scopes.back()) {
+                m_available.erase(expr);
+            }
+
+            scopes.pop_back();
+            continue;
+        }
+
+        worklist.emplace_back(bb, true);
+        number_block(bb, scopes.emplace_back());
+        for (const auto child: m_dom_tree.children(bb)) {
+            worklist.emplace_back(child, false);
+        }
+    }
+
+    if (m_redundant.empty()) {
+        return PreservedAnalyses::all();
+    }
+
+    remove_redundant();
+    // Only instructions are removed, the control flow graph stays intact.
+    return PreservedAnalyses::cfg();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "mir/analysis/Analysis.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Dominator based global value numbering.
+ * Pure instructions are numbered by their opcode, type and operands while the dominator tree is walked in preorder,
+ * so an instruction is replaced only by an equal one from a dominating block.
+ * Loads and calls are kept since memory may change between them. Compares, selects and flag conversions are kept too,
+ * because the flags are consumed where they are produced.
+ */
+class GVN final {
+    // Variant index, raw bits and type of an operand. Floating point constants are compared bitwise.
+    using Operand = std::tuple<std::size_t, std::uint64_t, std::uintptr_t>;
+
+    enum class ExpressionKind: std::uint8_t {
+        Binary,
+        Unary,
+        GetElementPtr,
+        GetFieldPtr,
+    };
+
+    struct Expression final {
+        ExpressionKind m_kind;
+        std::uint8_t m_op;
+        const Type* m_type;
+        std::size_t m_index;
+        std::vector<Operand> m_operands;
+
+        bool operator==(const Expression& other) const noexcept = default;
+    };
+
+    struct ExpressionHash final {
+        std::size_t operator()(const Expression& expr) const noexcept;
+    };
+
+    explicit GVN(FunctionData& data, const DominatorTree<BasicBlock>& dom_tree) noexcept:
+        m_data(data),
+        m_dom_tree(dom_tree) {}
+
+public:
+    PreservedAnalyses run();
+
+    static GVN create(AnalysisPassManager* cache, FunctionData* data) {
+        const auto dom_tree = cache->analyze<DominatorTreeEval>(data);
+        return GVN(*data, *dom_tree);
+    }
+
+private:
+    void number_block(const BasicBlock* bb, std::vector<Expression>& scope);
+    void remove_redundant() const;
+
+    [[nodiscard]]
+    static std::optional<Expression> expression_of(const Instruction* inst);
+
+    FunctionData& m_data;
+    const DominatorTree<BasicBlock>& m_dom_tree;
+
+    // Leaders of the expressions available in the current block.
+    std::unordered_map<Expression, const ValueInstruction*, ExpressionHash> m_available;
+    // Instructions whose uses were moved to their leaders.
+    std::vector<const Instruction*> m_redundant;
+};
@@ -0,0 +1,110 @@
+#include "LICM.h"
+
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
+#include "mir/global/GlobalValue.h"
+#include "mir/instruction/Binary.h"
+#include "mir/instruction/GetElementPtr.h"
+#include "mir/instruction/GetFieldPtr.h"
+#include "mir/instruction/Unary.h"
+
+/**
+ * Checks that the pointer refers to a read-only global, possibly through a field of it.
+ * Indexed accesses are not accepted: the index may be valid only under a condition inside the loop.
+ */
+static bool points_to_constant(const Value& pointer) {
+    if (pointer.is<GlobalValue*>()) {
+        return pointer.get<GlobalValue*>()->kind() == GValueKind::CONSTANT;
+    }
+
+    if (!pointer.is<ValueInstruction*>()) {
+        return false;
+    }
+
+    const auto gfp = dynamic_cast<const GetFieldPtr*>(pointer.get<ValueInstruction*>());
+    return gfp != nullptr && points_to_constant(gfp->pointer());
+}
+
+static bool can_move(const Instruction* inst) {
+    if (dynamic_cast<const Binary*>(inst) != nullptr) {
+        return true;
+    }
+
+    if (dynamic_cast<const GetElementPtr*>(inst) != nullptr || dynamic_cast<const GetFieldPtr*>(inst) != nullptr) {
+        return true;
+    }
+
+    const auto unary = dynamic_cast<const Unary*>(inst);
+    if (unary == nullptr) {
+        return false;
+    }
+
+    switch (unary->op()) {
+        // Flags are consumed where they are produced.
+        case UnaryOp::Flag2Int: return false;
+        case UnaryOp::Load:     return points_to_constant(unary->operand());
+        default:                return true;
+    }
+}
+
+bool LICM::is_invariant(const Loop<BasicBlock>& loop, const Instruction* inst) {
+    if (!can_move(inst)) {
+        return false;
+    }
+
+    // A preheader may end in a call. Its result is defined only after the hoisted instructions.
+    const auto terminator = &*loop.preheader()->instructions().back();
+    const auto is_outside = [&](const Value& operand) {
+        if (!operand.is<ValueInstruction*>()) {
+            return true;
+        }
+
+        const auto def = operand.get<ValueInstruction*>();
+        return def != terminator && !loop.contains(def->owner());
+    };
+
+    return std::ranges::all_of(inst->operands(), is_outside);
+}
+
+bool LICM::hoist(const Loop<BasicBlock>& loop) {
+    const auto preheader = const_cast<BasicBlock*>(loop.preheader());
+    if (preheader == nullptr) {
+        return false;
+    }
+
+    const auto terminator = &*preheader->instructions().back();
+    auto changed = false;
+    // Blocks are in preorder, so the operands defined in the loop are visited before their users.
+    // An instruction leaves the loop before its users are checked.
+    for (const auto bb: loop.blocks()) {
+        std::vector<const Instruction*> instructions;
+        for (const auto& inst: bb->instructions()) {
+            instructions.push_back(&inst);
+        }
+
+        for (const auto inst: instructions) {
+            if (is_invariant(loop, inst)) {
+                preheader->move_before(terminator, inst);
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+PreservedAnalyses LICM::run() {
+    auto changed = false;
+    for (const auto& loop: m_loops.loops() | std::views::reverse) {
+        changed |= hoist(*loop);
+    }
+
+    if (!changed) {
+        return PreservedAnalyses::all();
+    }
+
+    // Instructions change their blocks, the control flow graph stays intact.
+    return PreservedAnalyses::cfg();
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "mir/analysis/Analysis.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Loop invariant code motion.
+ * Pure computations whose operands are defined outside of the loop, and loads from read-only globals,
+ * are moved to the end of the loop preheader. Inner loops are processed first, so a value invariant
+ * in several nested loops climbs up to the outermost preheader. Loops without a preheader are skipped.
+ * Users of a call that ends the preheader stay in the loop, because the call defines its result last.
+ * The moved instructions cannot trap, so it is safe to execute them even when the loop body would not run.
+ */
+class LICM final {
+    explicit LICM(const LoopInfo<BasicBlock>& loops) noexcept:
+        m_loops(loops) {}
+
+public:
+    PreservedAnalyses run();
+
+    static LICM create(AnalysisPassManager* cache, FunctionData* data) {
+        const auto loops = cache->analyze<LoopInfoEval>(data);
+        return LICM(*loops);
+    }
+
+private:
+    static bool hoist(const Loop<BasicBlock>& loop);
+
+    [[nodiscard]]
+    static bool is_invariant(const Loop<BasicBlock>& loop, const Instruction* inst);
+
+    const LoopInfo<BasicBlock>& m_loops;
+};
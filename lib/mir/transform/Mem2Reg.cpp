@@ -0,0 +1,296 @@
+#include "Mem2Reg.h"
+
+#include <ranges>
+#include <unordered_set>
+
+#include "mir/instruction/Store.h"
+#include "mir/instruction/Unary.h"
+#include "mir/types/FloatingPointType.h"
+#include "mir/types/IntegerType.h"
+#include "mir/value/UsedValue.h"
+#include "mir/value/ValueMatcher.h"
+
+
+/**
+ * Returns the value of uninitialized local of the given type.
+ * Only arithmetic types have one. Pointer allocations are promoted only if they are initialized before any load.
+ */
+static std::optional<Value> undef_value(const Type* type) noexcept {
+    if (const auto int_type = IntegerType::cast(type); int_type != nullptr) {
+        return Value(static_cast<std::int64_t>(0), int_type);
+    }
+    if (const auto fp_type = FloatingPointType::cast(type); fp_type != nullptr) {
+        return Value(0.0, fp_type);
+    }
+
+    return std::nullopt;
+}
+
+static const Unary* as_load(const Instruction* inst) noexcept {
+    if (!inst->isa(load())) {
+        return nullptr;
+    }
+
+    return dynamic_cast<const Unary*>(inst);
+}
+
+/**
+ * Checks that the first access to the allocation in its own block is a store.
+ * Every load dominated by the allocation then has a reaching definition.
+ */
+static bool is_initialized_before_use(const Alloc* alloc) {
+    const Value pointer(alloc);
+    for (const auto& inst: alloc->owner()->instructions()) {
+        if (const auto unary = as_load(&inst); unary != nullptr && unary->operand() == pointer) {
+            return false;
+        }
+        if (const auto store = dynamic_cast<const Store*>(&inst); store != nullptr && store->pointer() == pointer) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Mem2Reg::collect_promotable_allocs() {
+    const auto is_promotable = [&](const Alloc* alloc) {
+        const auto type = PrimitiveType::cast(alloc->allocated_type());
+        if (type == nullptr) {
+            return false;
+        }
+
+        const Value pointer(alloc);
+        for (const auto user: alloc->users()) {
+            if (!m_dom_tree.contains(user->owner())) {
+                return false;
+            }
+            if (const auto unary = as_load(user); unary != nullptr) {
+                if (unary->type() != type) {
+                    return false;
+                }
+
+                continue;
+            }
+            if (const auto store = dynamic_cast<const Store*>(user); store != nullptr) {
+                const auto& value = store->value();
+                if (store->pointer() != pointer || value.type() != type || value.isa(value_semantic())) {
+                    return false;
+                }
+
+                continue;
+            }
+
+            // Any other user might let the pointer escape.
+            return false;
+        }
+
+        return undef_value(type).has_value() || is_initialized_before_use(alloc);
+    };
+
+    for (const auto& bb: m_data.basic_blocks()) {
+        if (!m_dom_tree.contains(&bb)) {
+            continue;
+        }
+
+        for (auto& inst: bb.instructions()) {
+            const auto alloc = dynamic_cast<Alloc*>(&inst);
+            if (alloc == nullptr || !is_promotable(alloc)) {
+                continue;
+            }
+
+            m_alloc_index.emplace(alloc, m_allocs.size());
+            m_allocs.push_back(alloc);
+        }
+    }
+}
+
+void Mem2Reg::insert_phis() {
+    for (const auto& [idx, alloc]: std::views::enumerate(m_allocs)) {
+        const auto type = PrimitiveType::cast(alloc->allocated_type());
+
+        std::vector<const BasicBlock*> worklist;
+        std::unordered_set<const BasicBlock*> enqueued;
+        for (const auto user: alloc->users()) {
+            if (dynamic_cast<const Store*>(user) == nullptr) {
+                continue;
+            }
+            if (enqueued.emplace(user->owner()).second) {
+                worklist.push_back(user->owner());
+            }
+        }
+
+        std::unordered_set<const BasicBlock*> has_phi;
+        while (!worklist.empty()) {
+            const auto bb = worklist.back();
+            worklist.pop_back();
+
+            for (const auto df: m_frontier.frontier(bb)) {
+                if (!has_phi.emplace(df).second) {
+                    continue;
+                }
+
+                m_phis[df].push_back(PhiNode{static_cast<std::size_t>(idx), m_data.make(Phi::phi(type, {}, {}))});
+                if (enqueued.emplace(df).second) {
+                    worklist.push_back(df);
+                }
+            }
+        }
+    }
+}
+
+void Mem2Reg::rename() {
+    std::vector<std::vector<Value>> stacks(m_allocs.size());
+    std::vector<std::vector<std::size_t>> snapshots;
+
+    // Walks the dominator tree in preorder. The second element marks the exit from the subtree.
+    std::vector<std::pair<const BasicBlock*, bool>> worklist{{m_data.first(), false}};
+    while (!worklist.empty()) {
+        const auto [bb, exit] = worklist.back();
+        worklist.pop_back();
+        if (exit) {
+            for (auto&& [stack, size]: std::views::zip(stacks, snapshots.back())) {
+                stack.erase(stack.begin() + static_cast<std::ptrdiff_t>(size), stack.end());
+            }
+
+            snapshots.pop_back();
+            continue;
+        }
+
+        auto& sizes = snapshots.emplace_back();
+        sizes.reserve(stacks.size());
+        for (const auto& stack: stacks) {
+            sizes.push_back(stack.size());
+        }
+
+        worklist.emplace_back(bb, true);
+        rename_block(const_cast<BasicBlock*>(bb), stacks);
+        for (const auto child: m_dom_tree.children(bb)) {
+            worklist.emplace_back(child, false);
+        }
+    }
+}
+
+void Mem2Reg::rename_block(BasicBlock* bb, std::vector<std::vector<Value>>& stacks) {
+    if (const auto phis = m_phis.find(bb); phis != m_phis.end()) {
+        for (const auto& node: phis->second) {
+            stacks[node.m_alloc_idx].emplace_back(node.m_phi);
+        }
+    }
+
+    for (auto& inst: bb->instructions()) {
+        if (const auto unary = as_load(&inst); unary != nullptr) {
+            const auto idx = promoted_index(unary->operand());
+            if (!idx.has_value()) {
+                continue;
+            }
+
+            const auto& stack = stacks[idx.value()];
+            const auto reaching = stack.empty() ? undef_value(unary->type()) : stack.back();
+            assertion(reaching.has_value(), "load of uninitialized pointer");
+            UsedValue::from(unary).replace_all_uses_with(reaching.value());
+            m_promoted_accesses.push_back(&inst);
+
+        } else if (const auto store = dynamic_cast<const Store*>(&inst); store != nullptr) {
+            const auto idx = promoted_index(store->pointer());
+            if (!idx.has_value()) {
+                continue;
+            }
+
+            stacks[idx.value()].push_back(store->value());
+            m_promoted_accesses.push_back(&inst);
+        }
+    }
+
+    for (const auto succ: bb->successors()) {
+        const auto phis = m_phis.find(succ);
+        if (phis == m_phis.end()) {
+            continue;
+        }
+
+        for (auto& node: phis->second) {
+            const auto& stack = stacks[node.m_alloc_idx];
+            node.m_incoming.emplace_back(stack.empty() ? std::nullopt : std::optional(stack.back()), bb);
+        }
+    }
+}
+
+void Mem2Reg::finalize() {
+    insert_live_phis();
+    remove_promoted_instructions();
+}
+
+void Mem2Reg::insert_live_phis() {
+    std::unordered_map<const Phi*, PhiNode*> nodes;
+    std::unordered_set<const PhiNode*> live;
+    std::vector<PhiNode*> worklist;
+    for (auto& block_phis: m_phis | std::views::values) {
+        for (auto& node: block_phis) {
+            nodes.emplace(node.m_phi, &node);
+            if (!node.m_phi->users().empty()) {
+                live.emplace(&node);
+                worklist.push_back(&node);
+            }
+        }
+    }
+
+    // Phi is live if it is used by a live instruction or by another live phi.
+    while (!worklist.empty()) {
+        const auto node = worklist.back();
+        worklist.pop_back();
+        for (const auto& value: node->m_incoming | std::views::keys) {
+            if (!value.has_value() || !value->is<ValueInstruction*>()) {
+                continue;
+            }
+
+            const auto it = nodes.find(dynamic_cast<const Phi*>(value->get<ValueInstruction*>()));
+            if (it != nodes.end() && live.emplace(it->second).second) {
+                worklist.push_back(it->second);
+            }
+        }
+    }
+
+    for (auto& [bb, block_phis]: m_phis) {
+        const auto block = const_cast<BasicBlock*>(bb);
+        const auto first = &*block->instructions().begin();
+        for (auto& node: block_phis) {
+            if (!live.contains(&node)) {
+                continue;
+            }
+
+            for (const auto& [value, pred]: node.m_incoming) {
+                const auto incoming = value.has_value() ? value : undef_value(node.m_phi->type());
+                assertion(incoming.has_value(), "phi of uninitialized pointer is live");
+                node.m_phi->add_incoming(incoming.value(), pred);
+            }
+
+            block->ins_before(first, node.m_phi);
+        }
+    }
+}
+
+void Mem2Reg::remove_promoted_instructions() const {
+    for (const auto inst: m_promoted_accesses) {
+        inst->owner()->remove(inst);
+    }
+    for (const auto alloc: m_allocs) {
+        alloc->owner()->remove(alloc);
+    }
+}
+
+std::optional<std::size_t> Mem2Reg::promoted_index(const Value &pointer) const {
+    if (!pointer.is<ValueInstruction*>()) {
+        return std::nullopt;
+    }
+
+    const auto alloc = dynamic_cast<const Alloc*>(pointer.get<ValueInstruction*>());
+    if (alloc == nullptr) {
+        return std::nullopt;
+    }
+
+    const auto it = m_alloc_index.find(alloc);
+    if (it == m_alloc_index.end()) {
+        return std::nullopt;
+    }
+
+    return it->second;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "mir/analysis/Analysis.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/instruction/Phi.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Promotes non-escaping scalar stack allocations to SSA values.
+ * Phi nodes are placed on the iterated dominance frontier of the stores,
+ * then loads are renamed along the dominator tree. Phi nodes which end up unused are not inserted.
+ */
+class Mem2Reg final {
+    struct PhiNode final {
+        std::size_t m_alloc_idx;
+        Phi* m_phi;
+        std::vector<std::pair<std::optional<Value>, BasicBlock*>> m_incoming{};
+    };
+
+    explicit Mem2Reg(FunctionData& data, const DominatorTree<BasicBlock>& dom_tree, const DominanceFrontier<BasicBlock>& frontier) noexcept:
+        m_data(data),
+        m_dom_tree(dom_tree),
+        m_frontier(frontier) {}
+
+public:
+    PreservedAnalyses run() {
+        collect_promotable_allocs();
+        if (m_allocs.empty()) {
+            return PreservedAnalyses::all();
+        }
+
+        insert_phis();
+        rename();
+        finalize();
+        // Only instructions are rewritten, the control flow graph stays intact.
+        return PreservedAnalyses::cfg();
+    }
+
+    static Mem2Reg create(AnalysisPassManager* cache, FunctionData* data) {
+        const auto dom_tree = cache->analyze<DominatorTreeEval>(data);
+        const auto frontier = cache->analyze<DominanceFrontierEval>(data);
+        return Mem2Reg(*data, *dom_tree, *frontier);
+    }
+
+private:
+    void collect_promotable_allocs();
+    void insert_phis();
+    void rename();
+    void rename_block(BasicBlock* bb, std::vector<std::vector<Value>>& stacks);
+    void finalize();
+    void insert_live_phis();
+    void remove_promoted_instructions() const;
+
+    [[nodiscard]]
+    std::optional<std::size_t> promoted_index(const Value& pointer) const;
+
+    FunctionData& m_data;
+    const DominatorTree<BasicBlock>& m_dom_tree;
+    const DominanceFrontier<BasicBlock>& m_frontier;
+
+    std::vector<Alloc*> m_allocs;
+    std::unordered_map<const Alloc*, std::size_t> m_alloc_index;
+    std::unordered_map<const BasicBlock*, std::vector<PhiNode>> m_phis;
+    // Loads and stores of promoted allocations. They are removed at the end of the pass.
+    std::vector<Instruction*> m_promoted_accesses;
+};
@@ -0,0 +1,70 @@
+#include "PassManager.h"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_map>
+
+#include "DCE.h"
+#include "GVN.h"
+#include "LICM.h"
+#include "Mem2Reg.h"
+#include "SCCP.h"
+#include "SimplifyCFG.h"
+
+
+/**
+ * Collects the functions of the module sorted by name, so the schedule doesn't depend on the hash map order.
+ */
+static std::vector<FunctionData*> sorted_functions(Module& module) {
+    std::vector<FunctionData*> functions;
+    functions.reserve(module.functions().size());
+    for (auto& func: module.functions() | std::views::values) {
+        functions.push_back(&func);
+    }
+
+    std::ranges::sort(functions, {}, [](const FunctionData* func) { return func->name(); });
+    return functions;
+}
+
+void ModulePassManager::run(Module& module) const {
+    auto functions = sorted_functions(module);
+    std::unordered_map<const FunctionData*, AnalysisPassManager> caches;
+    for (const auto func: functions) {
+        caches.try_emplace(func);
+    }
+
+    for (const auto& stage: m_stages) {
+        if (const auto pipeline = std::get_if<FunctionPassPipeline>(&stage); pipeline != nullptr) {
+            // The cache map is not modified here, so each worker touches only its own entry.
+            parallel_for_each(std::span(functions), m_jobs, [&](std::size_t, FunctionData* func) {
+                pipeline->run(caches.at(func), func);
+            });
+            continue;
+        }
+
+        const auto preserved = std::get<module_pass_fn>(stage)(module);
+        for (auto& cache: caches | std::views::values) {
+            cache.invalidate(preserved);
+        }
+
+        // Module passes may add or remove functions. New functions start with an empty cache.
+        functions = sorted_functions(module);
+        std::erase_if(caches, [&](const auto& entry) {
+            return !std::ranges::contains(functions, entry.first);
+        });
+        for (const auto func: functions) {
+            caches.try_emplace(func);
+        }
+    }
+}
+
+ModulePassManager ModulePassManager::standard(const std::size_t jobs) {
+    ModulePassManager manager(jobs);
+    manager.add<Mem2Reg>()
+        .add<SCCP>()
+        .add<GVN>()
+        .add<LICM>()
+        .add<DCE>()
+        .add<SimplifyCFG>();
+    return manager;
+}
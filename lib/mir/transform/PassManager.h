@@ -0,0 +1,71 @@
+#pragma once
+
+#include <concepts>
+#include <variant>
+#include <vector>
+
+#include "base/transform/FunctionPassPipelineBase.h"
+#include "mir/analysis/Analysis.h"
+#include "mir/module/Module.h"
+#include "utility/ParallelFor.h"
+
+using FunctionPassPipeline = FunctionPassPipelineBase<FunctionData>;
+
+/**
+ * Pass which sees the whole module, e.g. to add or remove functions.
+ * The returned set is applied to the analysis cache of every function.
+ */
+template<typename P>
+concept ModulePass = requires(P p, Module& module)
+{
+    { P::create(module) } -> std::same_as<P>;
+    { p.run() } -> std::same_as<PreservedAnalyses>;
+};
+
+/**
+ * Schedules transformation passes over a module.
+ * Consecutive function passes are grouped into a pipeline which runs over every function in parallel,
+ * a module pass is a barrier between such pipelines. Each function keeps its analysis cache for the whole run.
+ */
+class ModulePassManager final {
+    using module_pass_fn = PreservedAnalyses(*)(Module&);
+    using Stage = std::variant<FunctionPassPipeline, module_pass_fn>;
+
+public:
+    explicit ModulePassManager(const std::size_t jobs = default_concurrency()) noexcept:
+        m_jobs(jobs) {}
+
+    template<typename P>
+    requires TransformPass<P, FunctionData>
+    ModulePassManager& add() {
+        if (m_stages.empty() || !std::holds_alternative<FunctionPassPipeline>(m_stages.back())) {
+            m_stages.emplace_back(FunctionPassPipeline{});
+        }
+
+        std::get<FunctionPassPipeline>(m_stages.back()).add<P>();
+        return *this;
+    }
+
+    template<ModulePass P>
+    ModulePassManager& add_module_pass() {
+        m_stages.emplace_back(&run_module_pass<P>);
+        return *this;
+    }
+
+    void run(Module& module) const;
+
+    /**
+     * Pipeline applied to a module before code generation.
+     */
+    static ModulePassManager standard(std::size_t jobs = default_concurrency());
+
+private:
+    template<ModulePass P>
+    static PreservedAnalyses run_module_pass(Module& module) {
+        auto pass = P::create(module);
+        return pass.run();
+    }
+
+    const std::size_t m_jobs;
+    std::vector<Stage> m_stages;
+};
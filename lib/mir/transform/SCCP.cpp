@@ -0,0 +1,429 @@
+#include "SCCP.h"
+
+#include <bit>
+#include <ranges>
+
+#include "ConstantFolding.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/instruction/GetElementPtr.h"
+#include "mir/instruction/GetFieldPtr.h"
+#include "mir/instruction/IntDiv.h"
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/Projection.h"
+#include "mir/instruction/Select.h"
+#include "mir/instruction/Store.h"
+#include "mir/instruction/VectorInstruction.h"
+#include "mir/value/UsedValue.h"
+#include "mir/value/ValueMatcher.h"
+
+
+static bool same_constant(const Value& lhs, const Value& rhs) noexcept {
+    if (lhs.type() != rhs.type()) {
+        return false;
+    }
+    // Distinguishes 0.0 from -0.0.
+    if (lhs.is<double>() && rhs.is<double>()) {
+        return std::bit_cast<std::uint64_t>(lhs.get<double>()) == std::bit_cast<std::uint64_t>(rhs.get<double>());
+    }
+
+    return lhs == rhs;
+}
+
+bool SCCP::Cell::operator==(const Cell &other) const noexcept {
+    if (m_state != other.m_state) {
+        return false;
+    }
+
+    switch (m_state) {
+        case State::Constant: return same_constant(m_value.value(), other.m_value.value());
+        case State::Flag:     return m_flag == other.m_flag;
+        default:              return true;
+    }
+}
+
+SCCP::Cell SCCP::Cell::meet(const Cell &other) const noexcept {
+    if (m_state == State::Undefined) {
+        return other;
+    }
+    if (other.m_state == State::Undefined || *this == other) {
+        return *this;
+    }
+
+    return overdefined();
+}
+
+void SCCP::solve() {
+    add_edge(nullptr, m_data.first());
+    while (!m_flow_worklist.empty() || !m_ssa_worklist.empty()) {
+        while (!m_flow_worklist.empty()) {
+            const auto bb = m_flow_worklist.back();
+            m_flow_worklist.pop_back();
+            visit_block(bb);
+        }
+
+        while (!m_ssa_worklist.empty()) {
+            const auto inst = m_ssa_worklist.back();
+            m_ssa_worklist.pop_back();
+            if (m_executable_blocks.contains(inst->owner())) {
+                inst->visit(*this);
+            }
+        }
+    }
+}
+
+void SCCP::visit_block(BasicBlock *bb) {
+    // The block is evaluated once, new incoming edges change only its phi nodes.
+    const auto first_visit = m_executable_blocks.insert(bb).second;
+    for (auto& inst: bb->instructions()) {
+        if (first_visit || dynamic_cast<const Phi*>(&inst) != nullptr) {
+            inst.visit(*this);
+        }
+    }
+}
+
+void SCCP::add_edge(const BasicBlock *from, BasicBlock *to) {
+    if (!m_executable_edges.emplace(from, to).second) {
+        return;
+    }
+
+    m_flow_worklist.push_back(to);
+}
+
+void SCCP::add_successors(const Instruction *inst) {
+    const auto bb = inst->owner();
+    for (const auto succ: bb->successors()) {
+        add_edge(bb, succ);
+    }
+}
+
+SCCP::Cell SCCP::cell(const Value &value) const {
+    if (value.isa(constant())) {
+        return Cell::constant(value);
+    }
+    if (!value.is<ValueInstruction*>()) {
+        return Cell::overdefined();
+    }
+
+    const auto it = m_cells.find(value.get<ValueInstruction*>());
+    return it == m_cells.end() ? Cell::undefined() : it->second;
+}
+
+void SCCP::update(const ValueInstruction *inst, const Cell &cell) {
+    const auto [it, inserted] = m_cells.try_emplace(inst, Cell::undefined());
+    const auto merged = it->second.meet(cell);
+    if (merged == it->second) {
+        return;
+    }
+
+    it->second = merged;
+    for (const auto user: inst->users()) {
+        m_ssa_worklist.push_back(const_cast<Instruction*>(user));
+    }
+}
+
+void SCCP::accept(Binary *inst) {
+    const auto lhs = cell(inst->lhs());
+    const auto rhs = cell(inst->rhs());
+    if (lhs.state() == Cell::State::Overdefined || rhs.state() == Cell::State::Overdefined) {
+        update(inst, Cell::overdefined());
+        return;
+    }
+    if (lhs.state() != Cell::State::Constant || rhs.state() != Cell::State::Constant) {
+        return;
+    }
+
+    const auto folded = fold_binary(inst->op(), lhs.value(), rhs.value());
+    update(inst, folded.has_value() ? Cell::constant(folded.value()) : Cell::overdefined());
+}
+
+void SCCP::accept(Unary *inst) {
+    const auto operand = cell(inst->operand());
+    switch (operand.state()) {
+        case Cell::State::Undefined: break;
+        case Cell::State::Overdefined: update(inst, Cell::overdefined()); break;
+        case Cell::State::Flag: {
+            const auto type = IntegerType::cast(inst->type());
+            if (inst->op() != UnaryOp::Flag2Int || type == nullptr) {
+                update(inst, Cell::overdefined());
+                break;
+            }
+
+            update(inst, Cell::constant(Value(static_cast<std::int64_t>(operand.flag()), type)));
+            break;
+        }
+        case Cell::State::Constant: {
+            const auto folded = fold_unary(inst->op(), inst->type(), operand.value());
+            update(inst, folded.has_value() ? Cell::constant(folded.value()) : Cell::overdefined());
+            break;
+        }
+        default: std::unreachable();
+    }
+}
+
+void SCCP::accept(IcmpInstruction *icmp) {
+    const auto lhs = cell(icmp->lhs());
+    const auto rhs = cell(icmp->rhs());
+    if (lhs.state() == Cell::State::Overdefined || rhs.state() == Cell::State::Overdefined) {
+        update(icmp, Cell::overdefined());
+        return;
+    }
+    if (lhs.state() != Cell::State::Constant || rhs.state() != Cell::State::Constant) {
+        return;
+    }
+
+    const auto folded = fold_icmp(icmp->predicate(), lhs.value(), rhs.value());
+    update(icmp, folded.has_value() ? Cell::flag(folded.value()) : Cell::overdefined());
+}
+
+void SCCP::accept(FcmpInstruction *fcmp) {
+    const auto lhs = cell(fcmp->lhs());
+    const auto rhs = cell(fcmp->rhs());
+    if (lhs.state() == Cell::State::Overdefined || rhs.state() == Cell::State::Overdefined) {
+        update(fcmp, Cell::overdefined());
+        return;
+    }
+    if (lhs.state() != Cell::State::Constant || rhs.state() != Cell::State::Constant) {
+        return;
+    }
+
+    const auto folded = fold_fcmp(fcmp->predicate(), lhs.value(), rhs.value());
+    update(fcmp, folded.has_value() ? Cell::flag(folded.value()) : Cell::overdefined());
+}
+
+void SCCP::accept(Select *select) {
+    const auto condition = cell(select->condition());
+    switch (condition.state()) {
+        case Cell::State::Undefined: break;
+        case Cell::State::Flag: {
+            update(select, cell(condition.flag() ? select->on_true() : select->on_false()));
+            break;
+        }
+        default: {
+            update(select, cell(select->on_true()).meet(cell(select->on_false())));
+            break;
+        }
+    }
+}
+
+void SCCP::accept(Phi *inst) {
+    auto result = Cell::undefined();
+    for (const auto& [value, pred]: std::views::zip(inst->operands(), inst->incoming())) {
+        if (!m_executable_edges.contains({pred, inst->owner()})) {
+            continue;
+        }
+
+        result = result.meet(cell(value));
+    }
+
+    update(inst, result);
+}
+
+void SCCP::accept(Branch *branch) {
+    add_edge(branch->owner(), branch->target());
+}
+
+void SCCP::accept(CondBranch *cond_branch) {
+    const auto condition = cell(cond_branch->condition());
+    switch (condition.state()) {
+        case Cell::State::Undefined: break;
+        case Cell::State::Flag: {
+            add_edge(cond_branch->owner(), condition.flag() ? cond_branch->on_true() : cond_branch->on_false());
+            break;
+        }
+        default: add_successors(cond_branch); break;
+    }
+}
+
+void SCCP::accept(Call *inst) {
+    update(inst, Cell::overdefined());
+    add_successors(inst);
+}
+
+void SCCP::accept(TupleCall *inst) {
+    update(inst, Cell::overdefined());
+    add_successors(inst);
+}
+
+void SCCP::accept(Return *inst) {}
+
+void SCCP::accept(ReturnValue *inst) {}
+
+void SCCP::accept(Switch *inst) {
+    add_successors(inst);
+}
+
+void SCCP::accept(VCall *call) {
+    add_successors(call);
+}
+
+void SCCP::accept(IVCall *call) {
+    add_successors(call);
+}
+
+void SCCP::accept(Store *store) {}
+
+void SCCP::accept(Alloc *alloc) {
+    update(alloc, Cell::overdefined());
+}
+
+void SCCP::accept(GetElementPtr *gep) {
+    update(gep, Cell::overdefined());
+}
+
+void SCCP::accept(GetFieldPtr *gfp) {
+    update(gfp, Cell::overdefined());
+}
+
+void SCCP::accept(IntDiv *div) {
+    update(div, Cell::overdefined());
+}
+
+void SCCP::accept(Projection *proj) {
+    update(proj, Cell::overdefined());
+}
+
+void SCCP::accept(VectorInstruction *vec) {
+    update(vec, Cell::overdefined());
+}
+
+bool SCCP::fold_branches() {
+    std::vector<CondBranch*> branches;
+    for (const auto& bb: m_data.basic_blocks()) {
+        if (!m_executable_blocks.contains(&bb)) {
+            continue;
+        }
+
+        const auto cond_branch = dynamic_cast<CondBranch*>(bb.instructions().back().get());
+        if (cond_branch != nullptr && cell(cond_branch->condition()).state() == Cell::State::Flag) {
+            branches.push_back(cond_branch);
+        }
+    }
+
+    for (const auto cond_branch: branches) {
+        const auto target = cell(cond_branch->condition()).flag() ? cond_branch->on_true() : cond_branch->on_false();
+        cond_branch->owner()->replace_terminator(Branch::br(target));
+    }
+
+    return !branches.empty();
+}
+
+/**
+ * Checks that instruction selection takes a constant at the operand position.
+ * Binary operations and compares accept only a 32-bit immediate on the right-hand side.
+ */
+static bool accepts_constant(const Instruction* user, const std::size_t idx, const Value& constant) {
+    if (dynamic_cast<const Phi*>(user) != nullptr || dynamic_cast<const ReturnValue*>(user) != nullptr) {
+        return true;
+    }
+
+    const auto imm32 = constant.is<std::int64_t>() && std::in_range<std::int32_t>(constant.get<std::int64_t>());
+    if (dynamic_cast<const Store*>(user) != nullptr || dynamic_cast<const IcmpInstruction*>(user) != nullptr) {
+        return idx == 1 && imm32;
+    }
+
+    if (const auto binary = dynamic_cast<const Binary*>(user); binary != nullptr) {
+        switch (binary->op()) {
+            case BinaryOp::Add:        [[fallthrough]];
+            case BinaryOp::Multiply:   [[fallthrough]];
+            case BinaryOp::BitwiseAnd: [[fallthrough]];
+            case BinaryOp::BitwiseOr:  return idx == 1 && imm32;
+            default:                   return false;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Replaces the uses of the instruction by the value. Constants are placed only where the instruction selection accepts them.
+ */
+static bool replace_uses(const ValueInstruction* inst, const Value& value) {
+    const auto filter = value.isa(constant()) ? accepts_constant : nullptr;
+    return UsedValue::from(inst).replace_all_uses_with(value, filter) != 0;
+}
+
+std::optional<Value> SCCP::selected_operand(const Select *select) const {
+    const auto condition = cell(select->condition());
+    if (condition.state() != Cell::State::Flag) {
+        return std::nullopt;
+    }
+
+    return condition.flag() ? select->on_true() : select->on_false();
+}
+
+bool SCCP::replace_constants() {
+    auto changed = false;
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            if (const auto select = dynamic_cast<const Select*>(&inst); select != nullptr) {
+                if (const auto operand = selected_operand(select); operand.has_value()) {
+                    changed |= replace_uses(select, operand.value());
+                }
+            }
+        }
+    }
+
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            const auto value = dynamic_cast<const ValueInstruction*>(&inst);
+            if (value == nullptr) {
+                continue;
+            }
+
+            if (const auto it = m_cells.find(value); it != m_cells.end() && it->second.state() == Cell::State::Constant) {
+                changed |= replace_uses(value, it->second.value());
+            }
+        }
+    }
+
+    return remove_folded_instructions() || changed;
+}
+
+bool SCCP::is_folded(const Instruction *inst) const {
+    if (inst->isa(any_terminate())) {
+        return false;
+    }
+    if (const auto select = dynamic_cast<const Select*>(inst); select != nullptr && selected_operand(select).has_value()) {
+        return true;
+    }
+
+    const auto value = dynamic_cast<const ValueInstruction*>(inst);
+    if (value == nullptr) {
+        return false;
+    }
+
+    const auto it = m_cells.find(value);
+    return it != m_cells.end() && (it->second.state() == Cell::State::Constant || it->second.state() == Cell::State::Flag);
+}
+
+/**
+ * Removes the folded instructions which have no users left.
+ * Users are visited before their operands, so a chain of folded instructions usually goes in one sweep.
+ */
+bool SCCP::remove_folded_instructions() {
+    std::vector<Instruction*> candidates;
+    for (const auto& bb: m_data.basic_blocks()) {
+        for (auto& inst: bb.instructions()) {
+            if (is_folded(&inst)) {
+                candidates.push_back(&inst);
+            }
+        }
+    }
+
+    auto changed = false;
+    for (auto progress = true; progress;) {
+        progress = false;
+        for (auto& inst: std::views::reverse(candidates)) {
+            if (inst == nullptr || !dynamic_cast<const ValueInstruction*>(inst)->users().empty()) {
+                continue;
+            }
+
+            inst->owner()->remove(inst);
+            inst = nullptr;
+            progress = true;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "mir/analysis/Analysis.h"
+#include "mir/instruction/InstructionVisitor.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Sparse conditional constant propagation.
+ * Values and control flow edges are evaluated together, so constants are propagated only along the edges which may execute.
+ * Afterwards constant branches become unconditional, unreachable blocks are removed and folded values replace their uses.
+ */
+class SCCP final: public Visitor {
+    /**
+     * Lattice value of an instruction. Compares evaluate to a flag, which has no constant form in the IR.
+     */
+    class Cell final {
+    public:
+        enum class State: std::uint8_t {
+            Undefined,
+            Constant,
+            Flag,
+            Overdefined,
+        };
+
+        static Cell undefined() noexcept {
+            return Cell(State::Undefined, std::nullopt, false);
+        }
+
+        static Cell overdefined() noexcept {
+            return Cell(State::Overdefined, std::nullopt, false);
+        }
+
+        static Cell constant(const Value& value) noexcept {
+            return Cell(State::Constant, value, false);
+        }
+
+        static Cell flag(const bool value) noexcept {
+            return Cell(State::Flag, std::nullopt, value);
+        }
+
+        [[nodiscard]]
+        State state() const noexcept {
+            return m_state;
+        }
+
+        [[nodiscard]]
+        const Value& value() const noexcept {
+            return m_value.value();
+        }
+
+        [[nodiscard]]
+        bool flag() const noexcept {
+            return m_flag;
+        }
+
+        [[nodiscard]]
+        Cell meet(const Cell& other) const noexcept;
+
+        bool operator==(const Cell& other) const noexcept;
+
+    private:
+        explicit Cell(const State state, const std::optional<Value>& value, const bool flag) noexcept:
+            m_state(state),
+            m_value(value),
+            m_flag(flag) {}
+
+        State m_state;
+        std::optional<Value> m_value;
+        bool m_flag;
+    };
+
+    explicit SCCP(FunctionData& data) noexcept:
+        m_data(data) {}
+
+public:
+    PreservedAnalyses run() {
+        solve();
+        const auto folded_branches = fold_branches();
+        const auto folded_values = replace_constants();
+        if (folded_branches || m_executable_blocks.size() != m_data.size()) {
+            m_data.remove_unreachable_blocks();
+            return PreservedAnalyses::none();
+        }
+
+        return folded_values ? PreservedAnalyses::cfg() : PreservedAnalyses::all();
+    }
+
+    static SCCP create(AnalysisPassManager*, FunctionData* data) {
+        return SCCP(*data);
+    }
+
+private:
+    void solve();
+    void visit_block(BasicBlock* bb);
+    void add_edge(const BasicBlock* from, BasicBlock* to);
+    void add_successors(const Instruction* inst);
+
+    [[nodiscard]]
+    Cell cell(const Value& value) const;
+    void update(const ValueInstruction* inst, const Cell& cell);
+
+    bool fold_branches();
+    bool replace_constants();
+    bool remove_folded_instructions();
+
+    [[nodiscard]]
+    std::optional<Value> selected_operand(const Select* select) const;
+    [[nodiscard]]
+    bool is_folded(const Instruction* inst) const;
+
+    void accept(Binary *inst) override;
+    void accept(Unary *inst) override;
+    void accept(Branch *branch) override;
+    void accept(CondBranch *cond_branch) override;
+    void accept(Call *inst) override;
+    void accept(TupleCall *inst) override;
+    void accept(Return *inst) override;
+    void accept(ReturnValue *inst) override;
+    void accept(Switch *inst) override;
+    void accept(VCall *call) override;
+    void accept(IVCall *call) override;
+    void accept(Phi *inst) override;
+    void accept(Store *store) override;
+    void accept(Alloc *alloc) override;
+    void accept(IcmpInstruction *icmp) override;
+    void accept(FcmpInstruction *fcmp) override;
+    void accept(GetElementPtr *gep) override;
+    void accept(GetFieldPtr *gfp) override;
+    void accept(Select *select) override;
+    void accept(IntDiv *div) override;
+    void accept(Projection *proj) override;
+    void accept(VectorInstruction *vec) override;
+
+    FunctionData& m_data;
+    std::unordered_map<const ValueInstruction*, Cell> m_cells;
+    std::unordered_set<const BasicBlock*> m_executable_blocks;
+    std::set<std::pair<const BasicBlock*, const BasicBlock*>> m_executable_edges;
+    std::vector<BasicBlock*> m_flow_worklist;
+    std::vector<Instruction*> m_ssa_worklist;
+};
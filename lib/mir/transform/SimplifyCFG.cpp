@@ -0,0 +1,246 @@
+#include "SimplifyCFG.h"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+
+#include "ConstantFolding.h"
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/TerminateInstruction.h"
+#include "mir/value/UsedValue.h"
+
+/**
+ * Evaluates the condition of a branch if it compares two constants.
+ */
+static std::optional<bool> constant_condition(const Value& condition) {
+    if (!condition.is<ValueInstruction*>()) {
+        return std::nullopt;
+    }
+
+    const auto inst = condition.get<ValueInstruction*>();
+    if (const auto icmp = dynamic_cast<const IcmpInstruction*>(inst); icmp != nullptr) {
+        return fold_icmp(icmp->predicate(), icmp->lhs(), icmp->rhs());
+    }
+
+    if (const auto fcmp = dynamic_cast<const FcmpInstruction*>(inst); fcmp != nullptr) {
+        return fold_fcmp(fcmp->predicate(), fcmp->lhs(), fcmp->rhs());
+    }
+
+    return std::nullopt;
+}
+
+static std::vector<Phi*> phis_of(const BasicBlock* bb) {
+    std::vector<Phi*> phis;
+    for (auto& inst: bb->instructions()) {
+        if (const auto phi = dynamic_cast<const Phi*>(&inst); phi != nullptr) {
+            phis.push_back(const_cast<Phi*>(phi));
+        }
+    }
+
+    return phis;
+}
+
+/**
+ * Returns the value which the phi takes when control comes from the given predecessor.
+ */
+static Value incoming_value(const Phi* phi, const BasicBlock* pred) {
+    for (const auto& [value, bb]: std::views::zip(phi->operands(), phi->incoming())) {
+        if (bb == pred) {
+            return value;
+        }
+    }
+
+    die("no incoming value for the predecessor");
+}
+
+/**
+ * Returns the target of a block which holds nothing but an unconditional branch.
+ */
+static BasicBlock* forwarding_target(const BasicBlock* bb) {
+    if (bb->size() != 1) {
+        return nullptr;
+    }
+
+    const auto branch = dynamic_cast<const Branch*>(&*bb->instructions().begin());
+    if (branch == nullptr || branch->target() == bb) {
+        return nullptr;
+    }
+
+    return branch->target();
+}
+
+/**
+ * Rewrites the jump of the predecessor from one block to another one.
+ * Only branches are retargeted, calls keep their continuation.
+ */
+static bool retarget(BasicBlock* pred, const BasicBlock* from, BasicBlock* to) {
+    const auto term = &*pred->instructions().back();
+    if (dynamic_cast<const Branch*>(term) != nullptr) {
+        pred->replace_terminator(Branch::br(to));
+        return true;
+    }
+
+    const auto cond = dynamic_cast<const CondBranch*>(term);
+    if (cond == nullptr) {
+        return false;
+    }
+
+    const auto on_true = cond->on_true() == from ? to : cond->on_true();
+    const auto on_false = cond->on_false() == from ? to : cond->on_false();
+    if (on_true == on_false) {
+        pred->replace_terminator(Branch::br(on_true));
+    } else {
+        pred->replace_terminator(CondBranch::br_cond(cond->condition(), on_true, on_false));
+    }
+
+    return true;
+}
+
+/**
+ * Removes the compare if the branch was its last user.
+ */
+static void remove_unused_condition(const Value& condition) {
+    if (!condition.is<ValueInstruction*>()) {
+        return;
+    }
+
+    const auto inst = condition.get<ValueInstruction*>();
+    if (inst->users().empty() && dynamic_cast<const Compare*>(inst) != nullptr) {
+        inst->owner()->remove(inst);
+    }
+}
+
+bool SimplifyCFG::fold_branches() const {
+    auto changed = false;
+    for (auto& bb: m_data.basic_blocks()) {
+        const auto cond = dynamic_cast<const CondBranch*>(&*bb.instructions().back());
+        if (cond == nullptr) {
+            continue;
+        }
+
+        BasicBlock* target;
+        if (cond->on_true() == cond->on_false()) {
+            // Phi nodes of the target hold a value for each of the two edges.
+            if (!phis_of(cond->on_true()).empty()) {
+                continue;
+            }
+
+            target = cond->on_true();
+        } else if (const auto taken = constant_condition(cond->condition()); taken.has_value()) {
+            target = taken.value() ? cond->on_true() : cond->on_false();
+        } else {
+            continue;
+        }
+
+        const auto condition = cond->condition();
+        const_cast<BasicBlock&>(bb).replace_terminator(Branch::br(target));
+        remove_unused_condition(condition);
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool SimplifyCFG::bypass_empty_blocks() const {
+    auto changed = false;
+    for (auto& block: m_data.basic_blocks()) {
+        const auto bb = &block;
+        const auto target = forwarding_target(bb);
+        if (target == nullptr || bb == m_data.first() || bb->predecessors().empty()) {
+            continue;
+        }
+
+        std::vector<BasicBlock*> preds(bb->predecessors().begin(), bb->predecessors().end());
+        std::ranges::sort(preds);
+        preds.erase(std::ranges::unique(preds).begin(), preds.end());
+
+        const auto can_retarget = [&](const BasicBlock* pred) {
+            const auto term = &*pred->instructions().back();
+            return dynamic_cast<const Branch*>(term) != nullptr || dynamic_cast<const CondBranch*>(term) != nullptr;
+        };
+        if (!std::ranges::all_of(preds, can_retarget)) {
+            continue;
+        }
+
+        // Phi nodes of the target would need two values for an edge if a predecessor already jumps there.
+        // The copies of phi nodes are placed at the end of the predecessor, and the lowering doesn't split critical edges,
+        // so the block stays if a conditional branch would jump into the phi nodes directly.
+        const auto phis = phis_of(target);
+        const auto is_target_pred = [&](const BasicBlock* pred) {
+            return std::ranges::contains(target->predecessors(), pred);
+        };
+        const auto is_branch = [](const BasicBlock* pred) {
+            return dynamic_cast<const Branch*>(&*pred->instructions().back()) != nullptr;
+        };
+        if (!phis.empty() && (std::ranges::any_of(preds, is_target_pred) || !std::ranges::all_of(preds, is_branch))) {
+            continue;
+        }
+
+        std::vector<Value> incoming;
+        incoming.reserve(phis.size());
+        for (const auto phi: phis) {
+            incoming.push_back(incoming_value(phi, bb));
+        }
+
+        for (const auto pred: preds) {
+            retarget(pred, bb, target);
+            for (const auto& [phi, value]: std::views::zip(phis, incoming)) {
+                phi->add_incoming(value, pred);
+            }
+        }
+
+        // The block has no predecessors now and goes away with the unreachable ones.
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool SimplifyCFG::merge_blocks() const {
+    std::unordered_set<const BasicBlock*> merged;
+    std::vector<BasicBlock*> blocks;
+    for (auto& bb: m_data.basic_blocks()) {
+        blocks.push_back(const_cast<BasicBlock*>(&bb));
+    }
+
+    for (const auto bb: blocks) {
+        if (merged.contains(bb)) {
+            continue;
+        }
+
+        // Merge the chain of blocks starting here, so a block is visited once.
+        while (true) {
+            const auto branch = dynamic_cast<const Branch*>(&*bb->instructions().back());
+            if (branch == nullptr) {
+                break;
+            }
+
+            // The return block must stay the last one of the function.
+            const auto succ = branch->target();
+            if (succ == bb || succ == m_data.first() || succ == m_data.last() || succ->predecessors().size() != 1) {
+                break;
+            }
+
+            for (const auto phi: phis_of(succ)) {
+                UsedValue::from(phi).replace_all_uses_with(incoming_value(phi, bb));
+                succ->remove(phi);
+            }
+
+            bb->merge(succ);
+            merged.insert(succ);
+            m_data.remove(succ);
+        }
+    }
+
+    return !merged.empty();
+}
+
+bool SimplifyCFG::simplify() {
+    auto changed = fold_branches();
+    changed |= m_data.remove_unreachable_blocks() != 0;
+    changed |= bypass_empty_blocks();
+    changed |= m_data.remove_unreachable_blocks() != 0;
+    changed |= merge_blocks();
+    return changed;
+}
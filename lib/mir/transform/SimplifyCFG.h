@@ -0,0 +1,38 @@
+#pragma once
+
+#include "mir/analysis/Analysis.h"
+#include "mir/module/FunctionData.h"
+
+/**
+ * Control flow graph cleanup. Repeats until nothing changes:
+ *  - branches on compares of constants and branches to a single target become unconditional;
+ *  - blocks which cannot be reached from the entry are removed;
+ *  - empty blocks which only jump further are bypassed by their predecessors;
+ *  - a block is merged into its predecessor when it is the only successor of the predecessor and has no other predecessors.
+ */
+class SimplifyCFG final {
+    explicit SimplifyCFG(FunctionData& data) noexcept:
+        m_data(data) {}
+
+public:
+    PreservedAnalyses run() {
+        auto changed = false;
+        while (simplify()) {
+            changed = true;
+        }
+
+        return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+    }
+
+    static SimplifyCFG create(AnalysisPassManager*, FunctionData* data) {
+        return SimplifyCFG(*data);
+    }
+
+private:
+    bool simplify();
+    bool fold_branches() const;
+    bool bypass_empty_blocks() const;
+    bool merge_blocks() const;
+
+    FunctionData& m_data;
+};
@@ -3,6 +3,7 @@
 #include "IntegerType.h"
 #include "FloatingPointType.h"
 #include "PointerType.h"
+#include "VectorType.h"
 
 const PrimitiveType* PrimitiveType::cast(const Type *ty) noexcept {
     static constexpr const PrimitiveType* primitives[] = {
@@ -16,7 +17,15 @@ const PrimitiveType* PrimitiveType::cast(const Type *ty) noexcept {
         UnsignedIntegerType::u64(),
         FloatingPointType::f32(),
         FloatingPointType::f64(),
-        PointerType::ptr()
+        PointerType::ptr(),
+        VectorType::f32x4(),
+        VectorType::f32x8(),
+        VectorType::f64x2(),
+        VectorType::f64x4(),
+        VectorType::i32x4(),
+        VectorType::i32x8(),
+        VectorType::i64x2(),
+        VectorType::i64x4()
     };
     for (const auto& type : primitives) {
         if (type == ty) return type;
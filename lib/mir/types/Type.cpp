@@ -3,6 +3,7 @@
 #include "StructType.h"
 #include "ArrayType.h"
 #include "TupleType.h"
+#include "VectorType.h"
 
 #include <ostream>
 
@@ -59,6 +60,12 @@ namespace {
             os << '}';
         }
 
+        void accept(VectorType *type) override {
+            os << '<' << type->length() << " x ";
+            do_print(type->element_type());
+            os << '>';
+        }
+
         std::ostream &os;
     };
 }
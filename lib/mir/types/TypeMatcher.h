@@ -3,6 +3,7 @@
 #include "VoidType.h"
 #include "IntegerType.h"
 #include "FloatingPointType.h"
+#include "VectorType.h"
 
 namespace impls {
     inline bool signed_type(const Type *type) noexcept {
@@ -43,6 +44,10 @@ namespace impls {
     inline bool float_type(const Type *type) noexcept {
         return FloatingPointType::cast(type) != nullptr;
     }
+
+    inline bool vector_type(const Type *type) noexcept {
+        return VectorType::cast(type) != nullptr;
+    }
 }
 
 consteval auto signed_type() noexcept {
@@ -103,4 +108,8 @@ consteval auto gp_type() noexcept {
 
 consteval auto float_type() noexcept {
     return impls::float_type;
+}
+
+consteval auto vector_type() noexcept {
+    return impls::vector_type;
 }
\ No newline at end of file
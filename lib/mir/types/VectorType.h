@@ -0,0 +1,87 @@
+#pragma once
+
+#include "IntegerType.h"
+#include "FloatingPointType.h"
+
+/**
+ * Packed vector of arithmetic elements, held in a single xmm or ymm register.
+ */
+class VectorType final: public PrimitiveType {
+    constexpr VectorType(const ArithmeticType* element, const std::size_t length) noexcept:
+        m_element(element),
+        m_length(length) {}
+
+public:
+    [[nodiscard]]
+    std::size_t size_of() const override {
+        return m_element->size_of() * m_length;
+    }
+
+    void visit(type::Visitor &visitor) override { visitor.accept(this); }
+
+    [[nodiscard]]
+    const ArithmeticType* element_type() const noexcept {
+        return m_element;
+    }
+
+    [[nodiscard]]
+    std::size_t length() const noexcept {
+        return m_length;
+    }
+
+    static consteval const VectorType *f32x4() noexcept {
+        static constexpr VectorType f32x4_instance(FloatingPointType::f32(), 4);
+        return &f32x4_instance;
+    }
+
+    static consteval const VectorType *f32x8() noexcept {
+        static constexpr VectorType f32x8_instance(FloatingPointType::f32(), 8);
+        return &f32x8_instance;
+    }
+
+    static consteval const VectorType *f64x2() noexcept {
+        static constexpr VectorType f64x2_instance(FloatingPointType::f64(), 2);
+        return &f64x2_instance;
+    }
+
+    static consteval const VectorType *f64x4() noexcept {
+        static constexpr VectorType f64x4_instance(FloatingPointType::f64(), 4);
+        return &f64x4_instance;
+    }
+
+    static consteval const VectorType *i32x4() noexcept {
+        static constexpr VectorType i32x4_instance(SignedIntegerType::i32(), 4);
+        return &i32x4_instance;
+    }
+
+    static consteval const VectorType *i32x8() noexcept {
+        static constexpr VectorType i32x8_instance(SignedIntegerType::i32(), 8);
+        return &i32x8_instance;
+    }
+
+    static consteval const VectorType *i64x2() noexcept {
+        static constexpr VectorType i64x2_instance(SignedIntegerType::i64(), 2);
+        return &i64x2_instance;
+    }
+
+    static consteval const VectorType *i64x4() noexcept {
+        static constexpr VectorType i64x4_instance(SignedIntegerType::i64(), 4);
+        return &i64x4_instance;
+    }
+
+    [[nodiscard]]
+    static constexpr const VectorType *cast(const Type *type) noexcept {
+        static constexpr const VectorType* vector_types[] = {
+            f32x4(), f32x8(), f64x2(), f64x4(), i32x4(), i32x8(), i64x2(), i64x4()
+        };
+        for (auto& vector_type : vector_types) {
+            if (vector_type == type) return vector_type;
+        }
+
+        return nullptr;
+    }
+
+private:
+    const ArithmeticType* m_element;
+    const std::size_t m_length;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <span>
 #include <vector>
 #include "mir/mir_frwd.h"
+#include "utility/Error.h"
+#include "utility/StdExtensions.h"
 
 class Use {
 public:
@@ -13,6 +16,12 @@ public:
         m_users.push_back(user);
     }
 
+    void kill_user(const Instruction *user) noexcept {
+        const auto it = std::ranges::find(m_users, user);
+        assertion(it != m_users.end(), "must contain");
+        remove_fast(m_users, it);
+    }
+
     [[nodiscard]]
     std::span<const Instruction* const> users() const noexcept {
         return m_users;
@@ -1,5 +1,7 @@
 #include "UsedValue.h"
 
+#include <vector>
+
 #include "mir/instruction/ValueInstruction.h"
 #include "mir/global/GlobalValue.h"
 #include "mir/value/ArgumentValue.h"
@@ -28,7 +30,7 @@ std::expected<UsedValue, Error> UsedValue::try_from(const Value &value) {
     return value.visit(visit);
 }
 
-void UsedValue::add_user(Instruction* user) {
+void UsedValue::add_user(Instruction* user) const {
     const auto visitor = [&]<typename T>(const T &val) {
         val->add_user(user);
     };
@@ -36,10 +38,42 @@ void UsedValue::add_user(Instruction* user) {
     std::visit(visitor, m_value);
 }
 
+void UsedValue::kill_user(const Instruction* user) const {
+    const auto visitor = [&]<typename T>(const T &val) {
+        val->kill_user(user);
+    };
+
+    std::visit(visitor, m_value);
+}
+
 std::span<const Instruction * const> UsedValue::users() const noexcept {
     const auto visitor = []<typename T>(const T &val) {
         return val->users();
     };
 
     return std::visit(visitor, m_value);
+}
+
+std::size_t UsedValue::replace_all_uses_with(const Value &new_value, const UseFilter filter) const {
+    const auto old_value = std::visit([](const auto& val) { return Value(val); }, m_value);
+    // Rewriting operands modifies the list of users.
+    const auto current = users();
+    const std::vector snapshot(current.begin(), current.end());
+    std::size_t count{};
+    for (const auto user: snapshot) {
+        const auto mutable_user = const_cast<Instruction*>(user);
+        for (std::size_t idx{}; idx < user->operands().size(); ++idx) {
+            if (user->operands()[idx] != old_value) {
+                continue;
+            }
+            if (filter != nullptr && !filter(user, idx, new_value)) {
+                continue;
+            }
+
+            mutable_user->replace_operand(idx, new_value);
+            count += 1;
+        }
+    }
+
+    return count;
 }
\ No newline at end of file
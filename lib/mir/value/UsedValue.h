@@ -11,6 +11,11 @@ concept IsLocalValueType = std::derived_from<T, ValueInstruction> ||
     std::derived_from<T, ArgumentValue>;
 
 class UsedValue final {
+public:
+    /** Decides whether the operand 'idx' of 'user' may be rewritten to 'new_value'. **/
+    using UseFilter = bool(*)(const Instruction* user, std::size_t idx, const Value& new_value);
+
+private:
     explicit UsedValue(ArgumentValue* value) noexcept;
     explicit UsedValue(ValueInstruction * value) noexcept;
 
@@ -30,11 +35,20 @@ public:
         return m_value == other.m_value;
     }
 
-    void add_user(Instruction* user);
+    void add_user(Instruction* user) const;
+
+    void kill_user(const Instruction* user) const;
 
     [[nodiscard]]
     std::span<const Instruction* const> users() const noexcept;
 
+    /**
+     * Rewrites every operand referring to this value to 'new_value'.
+     * Operands rejected by the filter keep the old value.
+     * @return number of rewritten operands
+     */
+    std::size_t replace_all_uses_with(const Value& new_value, UseFilter filter = nullptr) const;
+
     [[nodiscard]]
     static std::expected<UsedValue, Error> try_from(const Value& value);
 
@@ -39,6 +39,8 @@ public:
         return std::holds_alternative<T>(m_value);
     }
 
+    constexpr bool operator==(const Value& other) const noexcept = default;
+
     template<typename Matcher>
     constexpr bool isa(Matcher&& matcher) const noexcept {
         return matcher(*this);
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Error.h"
+
+/**
+ * Bump allocator which owns the blocks and instructions of one function.
+ * Objects are placed one after another in chunks, an object larger than a chunk gets a chunk of its own.
+ * Nothing is freed one by one: @ref clear runs the destructors in reverse order of construction
+ * and drops the chunks all at once.
+ */
+class Arena final {
+    static constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * Placed in front of every object which has a non-trivial destructor.
+     */
+    struct Finalizer final {
+        Finalizer* m_prev;
+        void* m_object;
+        void (*m_destroy)(void*) noexcept;
+    };
+
+public:
+    Arena() noexcept = default;
+
+    ~Arena() {
+        clear();
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    template<typename T, typename... Args>
+    T* make(Args&&... args) {
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        } else {
+            constexpr auto offset = (sizeof(Finalizer) + alignof(T) - 1) / alignof(T) * alignof(T);
+            const auto memory = static_cast<std::byte*>(allocate(offset + sizeof(T), std::max(alignof(T), alignof(Finalizer))));
+            const auto object = new (memory + offset) T(std::forward<Args>(args)...);
+            m_finalizers = new (memory) Finalizer{m_finalizers, object, [](void* ptr) noexcept {
+                static_cast<T*>(ptr)->~T();
+            }};
+            return object;
+        }
+    }
+
+    /**
+     * Destroys every object of the arena and releases the memory.
+     */
+    void clear() noexcept {
+        for (auto finalizer = m_finalizers; finalizer != nullptr; finalizer = finalizer->m_prev) {
+            finalizer->m_destroy(finalizer->m_object);
+        }
+
+        m_finalizers = nullptr;
+        m_chunks.clear();
+        m_cursor = nullptr;
+        m_space = 0;
+    }
+
+    /**
+     * Returns the number of chunks taken from the heap.
+     */
+    [[nodiscard]]
+    std::size_t chunks() const noexcept {
+        return m_chunks.size();
+    }
+
+private:
+    void* allocate(const std::size_t size, const std::size_t align) {
+        if (const auto ptr = std::align(align, size, m_cursor, m_space); ptr != nullptr) {
+            m_cursor = static_cast<std::byte*>(m_cursor) + size;
+            m_space -= size;
+            return ptr;
+        }
+
+        if (size + align > CHUNK_SIZE / 2) {
+            // Big objects get a chunk of their own, so the rest of the current one isn't wasted.
+            return take_chunk(size + align, align, size);
+        }
+
+        m_space = CHUNK_SIZE;
+        m_cursor = take_chunk(m_space, 1, 0);
+        return allocate(size, align);
+    }
+
+    void* take_chunk(std::size_t space, const std::size_t align, const std::size_t size) {
+        void* ptr = m_chunks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(space)).get();
+        ptr = std::align(align, size, ptr, space);
+        assertion(ptr != nullptr, "chunk is too small");
+        return ptr;
+    }
+
+    std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+    void* m_cursor{};
+    std::size_t m_space{};
+    Finalizer* m_finalizers{};
+};
+
+/**
+ * Construction of an object which waits for the arena to place it in.
+ * Factories of instructions return it, and the block inserting the instruction runs it in the arena of its function.
+ */
+template<typename T, typename Fn>
+class [[nodiscard]] Deferred final {
+public:
+    explicit Deferred(Fn fn) noexcept(std::is_nothrow_move_constructible_v<Fn>):
+        m_fn(std::move(fn)) {}
+
+    T* operator()(Arena& arena) && {
+        return m_fn(arena);
+    }
+
+    /**
+     * Adds a step which finishes the object once it is constructed.
+     */
+    template<std::invocable<T*> Post>
+    auto then(Post post) && {
+        auto fn = [fn = std::move(m_fn), post = std::move(post)](Arena& arena) mutable {
+            const auto object = fn(arena);
+            post(object);
+            return object;
+        };
+
+        return Deferred<T, decltype(fn)>(std::move(fn));
+    }
+
+private:
+    Fn m_fn;
+};
+
+/**
+ * Defers the construction done by the function, it receives the arena and returns the constructed object.
+ */
+template<typename T, typename Fn>
+Deferred<T, std::decay_t<Fn>> defer(Fn&& fn) {
+    return Deferred<T, std::decay_t<Fn>>(std::forward<Fn>(fn));
+}
+
+/**
+ * Defers the construction of T from the arguments. They are kept by value until then.
+ */
+template<typename T, typename... Args>
+auto construct(Args&&... args) {
+    return defer<T>([...args = std::forward<Args>(args)](Arena& arena) mutable {
+        return arena.make<T>(std::move(args)...);
+    });
+}
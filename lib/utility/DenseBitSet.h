@@ -0,0 +1,205 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "Error.h"
+
+/**
+ * Growable set of small integers packed into 64-bit words.
+ * Set operations work a word at a time, iteration visits only the set bits.
+ */
+class DenseBitSet final {
+    using word_type = std::uint64_t;
+    static constexpr std::size_t WORD_BITS = 64;
+
+public:
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() noexcept = default;
+
+        const_iterator(const DenseBitSet* set, const std::size_t bit) noexcept:
+            m_set(set),
+            m_bit(set->find_next(bit)) {}
+
+        std::size_t operator*() const noexcept {
+            return m_bit;
+        }
+
+        const_iterator& operator++() noexcept {
+            m_bit = m_set->find_next(m_bit + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            const auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept {
+            return m_bit == other.m_bit;
+        }
+
+    private:
+        const DenseBitSet* m_set{};
+        std::size_t m_bit{};
+    };
+
+    explicit DenseBitSet(const std::size_t size = 0):
+        m_size(size),
+        m_words(words_for(size)) {}
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * Changes the number of bits. New bits are cleared.
+     */
+    void resize(const std::size_t size) {
+        m_words.resize(words_for(size));
+        m_size = size;
+        clear_tail();
+    }
+
+    void set(const std::size_t bit) noexcept {
+        assertion(bit < m_size, "bit index out of range");
+        m_words[bit / WORD_BITS] |= mask(bit);
+    }
+
+    void reset(const std::size_t bit) noexcept {
+        assertion(bit < m_size, "bit index out of range");
+        m_words[bit / WORD_BITS] &= ~mask(bit);
+    }
+
+    [[nodiscard]]
+    bool test(const std::size_t bit) const noexcept {
+        assertion(bit < m_size, "bit index out of range");
+        return (m_words[bit / WORD_BITS] & mask(bit)) != 0;
+    }
+
+    [[nodiscard]]
+    bool none() const noexcept {
+        for (const auto word: m_words) {
+            if (word != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]]
+    std::size_t count() const noexcept {
+        std::size_t result{};
+        for (const auto word: m_words) {
+            result += std::popcount(word);
+        }
+
+        return result;
+    }
+
+    /**
+     * this = this ∪ other.
+     * Returns true if any bit was added.
+     */
+    bool unite(const DenseBitSet& other) noexcept {
+        assertion(m_size == other.m_size, "bit sets must have the same size");
+        word_type changed{};
+        for (std::size_t i = 0; i < m_words.size(); ++i) {
+            const auto word = m_words[i] | other.m_words[i];
+            changed |= word ^ m_words[i];
+            m_words[i] = word;
+        }
+
+        return changed != 0;
+    }
+
+    /**
+     * this = this \ other.
+     */
+    void subtract(const DenseBitSet& other) noexcept {
+        assertion(m_size == other.m_size, "bit sets must have the same size");
+        for (std::size_t i = 0; i < m_words.size(); ++i) {
+            m_words[i] &= ~other.m_words[i];
+        }
+    }
+
+    /**
+     * this = (lhs \ rhs) ∪ extra.
+     * Returns true if the set has changed.
+     */
+    bool assign_difference_union(const DenseBitSet& lhs, const DenseBitSet& rhs, const DenseBitSet& extra) noexcept {
+        assertion(m_size == lhs.m_size && m_size == rhs.m_size && m_size == extra.m_size, "bit sets must have the same size");
+        word_type changed{};
+        for (std::size_t i = 0; i < m_words.size(); ++i) {
+            const auto word = (lhs.m_words[i] & ~rhs.m_words[i]) | extra.m_words[i];
+            changed |= word ^ m_words[i];
+            m_words[i] = word;
+        }
+
+        return changed != 0;
+    }
+
+    /**
+     * Returns the index of the first set bit starting from 'bit', or size() if there is none.
+     */
+    [[nodiscard]]
+    std::size_t find_next(const std::size_t bit) const noexcept {
+        if (bit >= m_size) {
+            return m_size;
+        }
+
+        auto idx = bit / WORD_BITS;
+        auto word = m_words[idx] & (~word_type{} << (bit % WORD_BITS));
+        while (word == 0) {
+            idx += 1;
+            if (idx == m_words.size()) {
+                return m_size;
+            }
+
+            word = m_words[idx];
+        }
+
+        return idx * WORD_BITS + std::countr_zero(word);
+    }
+
+    [[nodiscard]]
+    const_iterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    [[nodiscard]]
+    const_iterator end() const noexcept {
+        return {this, m_size};
+    }
+
+    bool operator==(const DenseBitSet& other) const noexcept = default;
+
+private:
+    static constexpr std::size_t words_for(const std::size_t size) noexcept {
+        return (size + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    static constexpr word_type mask(const std::size_t bit) noexcept {
+        return word_type{1} << (bit % WORD_BITS);
+    }
+
+    void clear_tail() noexcept {
+        if (const auto tail = m_size % WORD_BITS; tail != 0) {
+            m_words.back() &= ~(~word_type{} << tail);
+        }
+    }
+
+    std::size_t m_size;
+    std::vector<word_type> m_words;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * 64-bit FNV-1a hash. Stable across processes and builds, so it can key data stored on disk.
+ */
+class Fnv1a final {
+public:
+    void update(const std::span<const std::uint8_t> bytes) noexcept {
+        for (const auto byte: bytes) {
+            m_hash ^= byte;
+            m_hash *= PRIME;
+        }
+    }
+
+    void update(const std::string_view str) noexcept {
+        update(std::span(reinterpret_cast<const std::uint8_t*>(str.data()), str.size()));
+    }
+
+    template<std::integral T>
+    void update(const T value) noexcept {
+        update(std::span(reinterpret_cast<const std::uint8_t*>(&value), sizeof(value)));
+    }
+
+    [[nodiscard]]
+    std::uint64_t digest() const noexcept {
+        return m_hash;
+    }
+
+private:
+    static constexpr std::uint64_t OFFSET_BASIS = 0xcbf29ce484222325;
+    static constexpr std::uint64_t PRIME = 0x100000001b3;
+
+    std::uint64_t m_hash{OFFSET_BASIS};
+};
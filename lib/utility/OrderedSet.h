@@ -1,27 +1,33 @@
 #pragma once
 
-#include <memory>
+#include <iterator>
+#include <limits>
+#include <utility>
 #include <vector>
-#include <list>
 #include "Error.h"
 
-template<typename iterator, typename T>
+/**
+ * Iterates over the elements of the set in their list order.
+ * The iterator holds the set and the slot index, so it stays valid when the set grows.
+ */
+template<typename Set, typename T>
 class Iterator final {
 public:
     using value_type = T;
     using reference = T&;
     using pointer = T*;
     using const_pointer = pointer;
-    using difference_type = std::iterator_traits<iterator>::difference_type;
+    using difference_type = std::ptrdiff_t;
     using const_reference = reference;
 
     Iterator() noexcept = default;
 
-    explicit Iterator(iterator first) noexcept:
-        current(first) {}
+    explicit Iterator(Set* set, const std::size_t slot) noexcept:
+        m_set(set),
+        m_slot(slot) {}
 
-    Iterator &operator++() {
-        ++current;
+    Iterator &operator++() noexcept {
+        m_slot = m_set->next_slot(m_slot);
         return *this;
     }
 
@@ -32,7 +38,7 @@ public:
     }
 
     Iterator &operator--() noexcept {
-        --current;
+        m_slot = m_set->prev_slot(m_slot);
         return *this;
     }
 
@@ -42,142 +48,200 @@ public:
         return old;
     }
 
-    bool operator==(const Iterator &other) const noexcept { return current == other.current; }
-    bool operator!=(const Iterator &other) const noexcept { return current != other.current; }
+    bool operator==(const Iterator &other) const noexcept { return m_slot == other.m_slot; }
+    bool operator!=(const Iterator &other) const noexcept { return m_slot != other.m_slot; }
 
-    reference operator*() { return *current->get(); }
-    const_reference operator*() const { return *current->get(); }
+    reference operator*() const { return *get(); }
 
-    pointer operator->() { return current->get(); }
-    const_pointer operator->() const { return current->get(); }
+    pointer operator->() const { return get(); }
 
-    pointer get() { return current->get(); }
-    const_pointer get() const { return current->get(); }
+    pointer get() const { return m_set->slot_value(m_slot); }
 
 private:
-    iterator current;
+    Set* m_set{};
+    std::size_t m_slot{};
 };
 
+/**
+ * Keeps the elements in a doubly linked list. The elements are owned by the arena of the function.
+ * The links are stored in a dense vector of slots, indexed by the element id returned on insertion,
+ * so insertion does not allocate list nodes and traversal walks one contiguous array.
+ * Ids of removed elements are reused.
+ */
 template<typename T>
 class OrderedSet final {
-public:
-    using list_iterator = std::list<std::unique_ptr<T>>::iterator;
-    using const_list_iterator = std::list<std::unique_ptr<T>>::const_iterator;
+    static constexpr auto NIL = std::numeric_limits<std::size_t>::max();
+
+    struct Slot final {
+        T* m_value;
+        std::size_t m_prev;
+        std::size_t m_next;
+    };
 
+public:
     using value_type = T;
     using reference = T&;
     using const_reference = const T&;
-    using iterator = Iterator<list_iterator, T>;
-    using const_iterator = Iterator<const_list_iterator, T>;
+    using iterator = Iterator<OrderedSet, T>;
+    using const_iterator = Iterator<const OrderedSet, T>;
 
     OrderedSet() = default;
 
-    std::size_t push_back(std::unique_ptr<T>&& ptr) {
-        const auto free_slot = get_free_index();
-        const auto s = size();
-        m_holder.push_back(std::move(ptr));
-        if (free_slot == s) {
-            m_list.push_back(--m_holder.end());
-            return s;
-        }
-
-        m_list[free_slot] = --m_holder.end();
-        return free_slot;
+    std::size_t push_back(T* ptr) {
+        const auto slot = allocate_slot(ptr);
+        link_before(slot, NIL);
+        return slot;
     }
 
-    std::size_t insert_before(std::size_t idx, std::unique_ptr<T>&& ptr) {
-        auto iter = m_list[idx];
-        if (iter == m_holder.end()) {
-            return push_back(std::move(ptr));
-        }
-
-        const auto free_slot = get_free_index();
-        const auto s = size();
-        m_holder.insert(iter, std::move(ptr));
-        if (free_slot == s) {
-            m_list.push_back(--m_holder.end());
-            return s;
+    std::size_t insert_before(std::size_t idx, T* ptr) {
+        if (!contains(idx)) {
+            return push_back(ptr);
         }
 
-        m_list[free_slot] = --m_holder.end();
-        return free_slot;
+        const auto slot = allocate_slot(ptr);
+        link_before(slot, idx);
+        return slot;
     }
 
-    std::unique_ptr<T> remove(std::size_t idx) {
-        if (idx >= m_list.size()) {
+    /**
+     * Unlinks the element. It stays alive until its arena is cleared.
+     */
+    T* remove(std::size_t idx) {
+        if (!contains(idx)) {
             return nullptr;
         }
 
-        auto it = m_list[idx];
-        if (it == m_holder.end()) {
-            return nullptr;
+        auto& slot = m_slots[idx];
+        if (slot.m_prev == NIL) {
+            m_head = slot.m_next;
+        } else {
+            m_slots[slot.m_prev].m_next = slot.m_next;
+        }
+        if (slot.m_next == NIL) {
+            m_tail = slot.m_prev;
+        } else {
+            m_slots[slot.m_next].m_prev = slot.m_prev;
         }
 
-        auto removed = std::move(*it);
-        m_holder.erase(it);
-        m_list[idx] = m_holder.end();
+        m_size -= 1;
         m_free_indices.push_back(idx);
-        return removed;
+        return std::exchange(slot.m_value, nullptr);
     }
 
     reference operator[](std::size_t index) {
-        return *m_list[index]->get();
+        return *m_slots[index].m_value;
     }
 
     const_reference operator[](std::size_t index) const {
-        return *m_list[index]->data;
+        return *m_slots[index].m_value;
     }
 
     const_reference at(std::size_t index) const {
-        assertion(index < size(), "invariant");
-        return *m_list[index]->get();
+        assertion(contains(index), "invariant");
+        return *m_slots[index].m_value;
     }
 
     reference at(std::size_t index) {
-        assertion(index < size(), "invariant");
-        return *m_list[index]->get();
+        assertion(contains(index), "invariant");
+        return *m_slots[index].m_value;
     }
 
     iterator begin() noexcept {
-        return iterator(m_holder.begin());
+        return iterator(this, m_head);
     }
 
     iterator end() noexcept {
-        return iterator(m_holder.end());
+        return iterator(this, NIL);
     }
 
     const_iterator begin() const noexcept {
-        return const_iterator(m_holder.begin());
+        return const_iterator(this, m_head);
     }
 
     const_iterator end() const noexcept {
-        return const_iterator(m_holder.end());
+        return const_iterator(this, NIL);
     }
 
     [[nodiscard]]
     std::size_t size() const noexcept {
-        return m_holder.size();
+        return m_size;
+    }
+
+    /**
+     * Returns the upper bound of the element ids. Ids of removed elements leave holes until they are reused.
+     */
+    [[nodiscard]]
+    std::size_t id_bound() const noexcept {
+        return m_slots.size();
     }
 
     const_iterator back() const noexcept {
-        return const_iterator(m_list.back());
+        return const_iterator(this, m_tail);
     }
 
 private:
-    std::size_t get_free_index() {
+    friend iterator;
+    friend const_iterator;
+
+    [[nodiscard]]
+    bool contains(const std::size_t idx) const noexcept {
+        return idx < m_slots.size() && m_slots[idx].m_value != nullptr;
+    }
+
+    [[nodiscard]]
+    std::size_t next_slot(const std::size_t slot) const noexcept {
+        return slot == NIL ? m_head : m_slots[slot].m_next;
+    }
+
+    [[nodiscard]]
+    std::size_t prev_slot(const std::size_t slot) const noexcept {
+        return slot == NIL ? m_tail : m_slots[slot].m_prev;
+    }
+
+    [[nodiscard]]
+    T* slot_value(const std::size_t slot) const noexcept {
+        return m_slots[slot].m_value;
+    }
+
+    std::size_t allocate_slot(T* ptr) {
+        assertion(ptr != nullptr, "element must not be null");
+        m_size += 1;
         if (m_free_indices.empty()) {
-            return m_list.size();
+            m_slots.push_back(Slot{ptr, NIL, NIL});
+            return m_slots.size() - 1;
         }
 
         const auto index = m_free_indices.back();
         m_free_indices.pop_back();
+        m_slots[index].m_value = ptr;
         return index;
     }
 
+    /**
+     * Links the slot in front of 'next'. NIL means the end of the list.
+     */
+    void link_before(const std::size_t slot, const std::size_t next) noexcept {
+        const auto prev = next == NIL ? m_tail : m_slots[next].m_prev;
+        m_slots[slot].m_prev = prev;
+        m_slots[slot].m_next = next;
+        if (prev == NIL) {
+            m_head = slot;
+        } else {
+            m_slots[prev].m_next = slot;
+        }
+        if (next == NIL) {
+            m_tail = slot;
+        } else {
+            m_slots[next].m_prev = slot;
+        }
+    }
+
     std::vector<std::size_t> m_free_indices;
-    std::vector<list_iterator> m_list;
-    std::list<std::unique_ptr<T>> m_holder;
+    std::vector<Slot> m_slots;
+    std::size_t m_head{NIL};
+    std::size_t m_tail{NIL};
+    std::size_t m_size{};
 };
 
 static_assert(std::ranges::range<OrderedSet<int>>, "should be");
-static_assert(std::ranges::bidirectional_range<OrderedSet<int>>, "should be");
\ No newline at end of file
+static_assert(std::ranges::bidirectional_range<OrderedSet<int>>, "should be");
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * Returns the number of workers used by default for parallel compilation.
+ */
+inline std::size_t default_concurrency() noexcept {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * Invokes `fn(idx, item)` for every element of `items` using at most `jobs` worker threads.
+ * Workers pick items by index, so the callback must write its result into a slot owned by `idx`.
+ * The first exception thrown by a worker is rethrown in the calling thread.
+ *
+ * @param items The items to process.
+ * @param jobs The maximum number of worker threads. Zero or one runs everything in the calling thread.
+ * @param fn A callable invoked as `fn(std::size_t, T&)`.
+ */
+template<typename T, typename Fn>
+requires std::invocable<Fn&, std::size_t, T&>
+void parallel_for_each(std::span<T> items, const std::size_t jobs, Fn&& fn) {
+    const auto workers = std::min(jobs, items.size());
+    if (workers <= 1) {
+        for (std::size_t idx = 0; idx < items.size(); ++idx) {
+            fn(idx, items[idx]);
+        }
+
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error{};
+    std::mutex error_lock;
+    const auto worker = [&] {
+        for (auto idx = next.fetch_add(1, std::memory_order_relaxed); idx < items.size(); idx = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                fn(idx, items[idx]);
+            } catch (...) {
+                std::lock_guard guard(error_lock);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(items.size(), std::memory_order_relaxed);
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
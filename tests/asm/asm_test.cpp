@@ -1145,6 +1145,152 @@ TEST(Asm, neg_addr) {
     check_bytes(codes, names, generator);
 }
 
+TEST(Asm, not_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0xf6,0xd0},
+        {0x66,0xf7,0xd0},
+        {0xf7,0xd0},
+        {0x48,0xf7,0xd0}
+    };
+    const std::vector<std::string> names = {
+        "notb %al",
+        "notw %ax",
+        "notl %eax",
+        "notq %rax"
+    };
+
+    const auto generator = [](const std::uint8_t size) {
+        aasm::AsmEmitter a;
+        a.nnot(size, aasm::rax);
+        return a;
+    };
+
+    check_bytes(codes, names, generator);
+}
+
+TEST(Asm, imul_reg_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0x66,0x0f,0xaf,0xc1},
+        {0x0f,0xaf,0xc1},
+        {0x48,0x0f,0xaf,0xc1}
+    };
+    const std::vector<std::string> names = {
+        "imulw %cx, %ax",
+        "imull %ecx, %eax",
+        "imulq %rcx, %rax"
+    };
+
+    const auto generator = [](const std::uint8_t size) {
+        aasm::AsmEmitter a;
+        a.imul(size, aasm::rcx, aasm::rax);
+        return a;
+    };
+
+    check_bytes(codes, names, generator, std::views::iota(1U, 4U));
+}
+
+TEST(Asm, imul_addr_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0x66,0x0f,0xaf,0x08},
+        {0x0f,0xaf,0x08},
+        {0x48,0x0f,0xaf,0x08}
+    };
+    const std::vector<std::string> names = {
+        "imulw (%rax), %cx",
+        "imull (%rax), %ecx",
+        "imulq (%rax), %rcx"
+    };
+
+    const auto generator = [](const std::uint8_t size) {
+        aasm::AsmEmitter a;
+        aasm::Address addr(aasm::rax);
+        a.imul(size, addr, aasm::rcx);
+        return a;
+    };
+
+    check_bytes(codes, names, generator, std::views::iota(1U, 4U));
+}
+
+TEST(Asm, imul_imm_reg_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0x66,0x69,0xc1,0xe8,0x03},
+        {0x69,0xc1,0xe8,0x03,0x00,0x00},
+        {0x48,0x69,0xc1,0xe8,0x03,0x00,0x00}
+    };
+    const std::vector<std::string> names = {
+        "imulw $1000, %cx, %ax",
+        "imull $1000, %ecx, %eax",
+        "imulq $1000, %rcx, %rax"
+    };
+
+    const auto generator = [](const std::uint8_t size) {
+        aasm::AsmEmitter a;
+        a.imul(size, 1000, aasm::rcx, aasm::rax);
+        return a;
+    };
+
+    check_bytes(codes, names, generator, std::views::iota(1U, 4U));
+}
+
+TEST(Asm, imul_imm8_reg_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0x66,0x6b,0xc1,0x0a},
+        {0x6b,0xc1,0x0a},
+        {0x48,0x6b,0xc1,0x0a}
+    };
+    const std::vector<std::string> names = {
+        "imulw $10, %cx, %ax",
+        "imull $10, %ecx, %eax",
+        "imulq $10, %rcx, %rax"
+    };
+
+    const auto generator = [](const std::uint8_t size) {
+        aasm::AsmEmitter a;
+        a.imul(size, 10, aasm::rcx, aasm::rax);
+        return a;
+    };
+
+    check_bytes(codes, names, generator, std::views::iota(1U, 4U));
+}
+
+TEST(Asm, call_reg) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0xff,0xd0},
+        {0x41,0xff,0xd3}
+    };
+    const std::vector<std::string> names = {
+        "call *%rax",
+        "call *%r11"
+    };
+
+    const auto generator = [](const std::uint8_t scale) {
+        aasm::AsmEmitter a;
+        a.call(scale == 1 ? aasm::rax : aasm::r11);
+        return a;
+    };
+
+    check_bytes(codes, names, generator);
+}
+
+TEST(Asm, jmp_addr) {
+    const std::vector<std::vector<std::uint8_t>> codes = {
+        {0xff,0x20},
+        {0x41,0xff,0x63,0x08}
+    };
+    const std::vector<std::string> names = {
+        "jmp *(%rax)",
+        "jmp *8(%r11)"
+    };
+
+    const auto generator = [](const std::uint8_t scale) {
+        aasm::AsmEmitter a;
+        a.jmp(scale == 1 ? aasm::Address(aasm::rax) : aasm::Address(aasm::r11, 8));
+        return a;
+    };
+
+    check_bytes(codes, names, generator);
+}
+
 TEST(Asm, idiv_reg) {
     const std::vector<std::vector<std::uint8_t>> codes = {
         {0xf6,0xf8},
@@ -24,7 +24,7 @@ TEST(Asm1, forward_jmp1) {
      */
 
     std::vector<std::uint8_t> codes = {
-        0xe9, 0x0a, 0x00, 0x00, 0x00,
+        0xeb, 0x0a,
         0x48, 0xb8, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0xc3
     };
@@ -82,7 +82,7 @@ TEST(Asm1, forward_cond_jmp1) {
 
     std::vector<std::uint8_t> codes = {
         0x48, 0x81, 0xf8, 0x08, 0x00, 0x00, 0x00,
-        0x0F, 0x87, 0x0A, 0x00, 0x00, 0x00,
+        0x77, 0x0A,
         0x48, 0xb8, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0xC3
     };
@@ -123,6 +123,51 @@ TEST(Asm1, backward_cond_jmp1) {
     verify_codes(codes, v);
 }
 
+TEST(Asm1, long_forward_jmp) {
+    aasm::AsmEmitter a;
+    const auto label = a.create_label();
+    a.jmp(label);
+    for (std::size_t i = 0; i < 13; ++i) {
+        a.mov(8, 8, aasm::rax);
+    }
+    a.set_label(label);
+    a.ret();
+
+    std::uint8_t v[256];
+    const auto size = to_byte_buffer(a.to_buffer(), v);
+    ASSERT_EQ(size, 5 + 13 * 10 + 1);
+    verify_codes({0xE9, 0x82, 0x00, 0x00, 0x00}, v);
+    ASSERT_EQ(v[size - 1], 0xC3);
+}
+
+TEST(Asm1, relaxation_grows_dependent_jumps) {
+    aasm::AsmEmitter a;
+    const auto first = a.create_label();
+    const auto second = a.create_label();
+    a.jmp(first);
+    for (std::size_t i = 0; i < 12; ++i) {
+        a.mov(8, 8, aasm::rax);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        a.ret();
+    }
+    // This jump doesn't fit rel8, so it pushes 'first' out of the rel8 range of the first jump.
+    a.jmp(second);
+    a.set_label(first);
+    a.ret();
+    for (std::size_t i = 0; i < 13; ++i) {
+        a.mov(8, 8, aasm::rax);
+    }
+    a.set_label(second);
+    a.ret();
+
+    std::uint8_t v[512];
+    const auto size = to_byte_buffer(a.to_buffer(), v);
+    ASSERT_EQ(size, 5 + 12 * 10 + 4 + 5 + 1 + 13 * 10 + 1);
+    verify_codes({0xE9, 0x81, 0x00, 0x00, 0x00}, v);
+    verify_codes({0xE9, 0x83, 0x00, 0x00, 0x00}, v + 129);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "helpers/Utils.h"
+#include "asm/x64/asm.h"
+
+
+TEST(AVX_Asm, vmovups_addr_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xfc,0x10,0x07};
+
+    aasm::AsmEmitter a;
+    constexpr aasm::Address addr(aasm::rdi);
+    a.vmovups(32, addr, aasm::xmm0);
+    check_coding(std::move(a), codes, "vmovups (%rdi), %ymm0");
+}
+
+TEST(AVX_Asm, vmovups_reg_addr) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xfc,0x11,0x4f,0x20};
+
+    aasm::AsmEmitter a;
+    constexpr aasm::Address addr(aasm::rdi, 32);
+    a.vmovups(32, aasm::xmm1, addr);
+    check_coding(std::move(a), codes, "vmovups %ymm1, 32(%rdi)");
+}
+
+TEST(AVX_Asm, vmovups_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xfc,0x10,0xd1};
+
+    aasm::AsmEmitter a;
+    a.vmovups(32, aasm::xmm1, aasm::xmm2);
+    check_coding(std::move(a), codes, "vmovups %ymm1, %ymm2");
+}
+
+TEST(AVX_Asm, vaddps_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf4,0x58,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vaddps(32, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vaddps %ymm2, %ymm1, %ymm0");
+}
+
+TEST(AVX_Asm, vaddps_reg_reg_high) {
+    const std::vector<std::uint8_t> codes = {0xc4,0xc1,0x70,0x58,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vaddps(16, aasm::xmm10, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vaddps %xmm10, %xmm1, %xmm0");
+}
+
+TEST(AVX_Asm, vaddpd_addr_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0x65,0x58,0x64,0xc8,0x10};
+
+    aasm::AsmEmitter a;
+    constexpr aasm::Address addr(aasm::rax, aasm::rcx, 8, 16);
+    a.vaddpd(32, addr, aasm::xmm3, aasm::xmm12);
+    check_coding(std::move(a), codes, "vaddpd 16(%rax,%rcx,8), %ymm3, %ymm12");
+}
+
+TEST(AVX_Asm, vpaddd_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf5,0xfe,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vpaddd(32, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vpaddd %ymm2, %ymm1, %ymm0");
+}
+
+TEST(AVX_Asm, vpmulld_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc4,0xe2,0x75,0x40,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vpmulld(32, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vpmulld %ymm2, %ymm1, %ymm0");
+}
+
+TEST(AVX_Asm, vsubpd_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xb5,0x5c,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vsubpd(32, aasm::xmm2, aasm::xmm9, aasm::xmm0);
+    check_coding(std::move(a), codes, "vsubpd %ymm2, %ymm9, %ymm0");
+}
+
+TEST(AVX_Asm, vcmpps_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf4,0xc2,0xc2,0x01};
+
+    aasm::AsmEmitter a;
+    a.vcmpps(32, aasm::VcmpPredicate::LT_OS, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vcmpps $1, %ymm2, %ymm1, %ymm0");
+}
+
+TEST(AVX_Asm, vpcmpgtd_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf5,0x66,0xc2};
+
+    aasm::AsmEmitter a;
+    a.vpcmpgtd(32, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vpcmpgtd %ymm2, %ymm1, %ymm0");
+}
+
+TEST(AVX_Asm, vshufps_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf0,0xc6,0xc2,0x1b};
+
+    aasm::AsmEmitter a;
+    a.vshufps(16, 0x1b, aasm::xmm2, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vshufps $27, %xmm2, %xmm1, %xmm0");
+}
+
+TEST(AVX_Asm, vbroadcastss_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc4,0xe2,0x7d,0x18,0xc1};
+
+    aasm::AsmEmitter a;
+    a.vbroadcastss(32, aasm::xmm1, aasm::xmm0);
+    check_coding(std::move(a), codes, "vbroadcastss %xmm1, %ymm0");
+}
+
+TEST(AVX_Asm, vbroadcastss_addr_reg) {
+    const std::vector<std::uint8_t> codes = {0xc4,0xe2,0x7d,0x18,0x07};
+
+    aasm::AsmEmitter a;
+    constexpr aasm::Address addr(aasm::rdi);
+    a.vbroadcastss(32, addr, aasm::xmm0);
+    check_coding(std::move(a), codes, "vbroadcastss (%rdi), %ymm0");
+}
+
+TEST(AVX_Asm, vpbroadcastq_reg_reg_high) {
+    const std::vector<std::uint8_t> codes = {0xc4,0x62,0x7d,0x59,0xc3};
+
+    aasm::AsmEmitter a;
+    a.vpbroadcastq(32, aasm::xmm3, aasm::xmm8);
+    check_coding(std::move(a), codes, "vpbroadcastq %xmm3, %ymm8");
+}
+
+TEST(AVX_Asm, vmovd_gp_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf9,0x6e,0xc7};
+
+    aasm::AsmEmitter a;
+    a.vmovd(4, aasm::rdi, aasm::xmm0);
+    check_coding(std::move(a), codes, "vmovd %edi, %xmm0");
+}
+
+TEST(AVX_Asm, vmovq_gp_reg_high) {
+    const std::vector<std::uint8_t> codes = {0xc4,0xc1,0xf9,0x6e,0xc1};
+
+    aasm::AsmEmitter a;
+    a.vmovd(8, aasm::r9, aasm::xmm0);
+    check_coding(std::move(a), codes, "vmovq %r9, %xmm0");
+}
+
+TEST(AVX_Asm, vxorps_reg_reg) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xfc,0x57,0xc0};
+
+    aasm::AsmEmitter a;
+    a.vxorps(32, aasm::xmm0, aasm::xmm0, aasm::xmm0);
+    check_coding(std::move(a), codes, "vxorps %ymm0, %ymm0, %ymm0");
+}
+
+TEST(AVX_Asm, vzeroupper) {
+    const std::vector<std::uint8_t> codes = {0xc5,0xf8,0x77};
+
+    aasm::AsmEmitter a;
+    a.vzeroupper();
+    check_coding(std::move(a), codes, "vzeroupper");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "helpers/Utils.h"
+
+static void verify_codes(aasm::AsmBuffer& buffer, const std::vector<std::uint8_t>& codes) {
+    std::uint8_t v[64];
+    const auto size = to_byte_buffer(buffer, v);
+    ASSERT_EQ(size, codes.size());
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+        ASSERT_EQ(v[i], codes[i]) << "Mismatch at index=" << i;
+    }
+}
+
+TEST(Peephole, redundant_moves) {
+    aasm::AsmEmitter a;
+    a.mov(8, aasm::rax, aasm::rcx);
+    a.mov(8, aasm::rcx, aasm::rax);
+    a.mov(8, aasm::rdx, aasm::rdx);
+    a.ret();
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.count("move_back"), 1);
+    ASSERT_EQ(stats.count("self_move"), 1);
+    ASSERT_EQ(stats.total(), 2);
+
+    /*
+     movq %rax, %rcx
+     ret
+     */
+    verify_codes(buffer, {0x48, 0x89, 0xc1, 0xc3});
+}
+
+TEST(Peephole, move_back_to_label_stays) {
+    aasm::AsmEmitter a;
+    const auto label = a.create_label();
+    a.mov(8, aasm::rax, aasm::rcx);
+    a.set_label(label);
+    a.mov(8, aasm::rcx, aasm::rax);
+    a.jmp(label);
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.total(), 0);
+    ASSERT_EQ(buffer.size(), 3);
+}
+
+TEST(Peephole, move_through_temporary) {
+    aasm::AsmEmitter a;
+    a.mov(8, aasm::rdi, aasm::rax);
+    a.mov(8, aasm::rax, aasm::rcx);
+    a.mov(8, 1, aasm::rax);
+    a.ret();
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.count("move_through_temporary"), 1);
+
+    /*
+     movq %rdi, %rcx
+     movabsq $1, %rax
+     ret
+     */
+    verify_codes(buffer, {
+        0x48, 0x89, 0xf9,
+        0x48, 0xb8, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xc3
+    });
+}
+
+TEST(Peephole, zero_idioms) {
+    aasm::AsmEmitter a;
+    const auto label = a.create_label();
+    a.cmp(8, 0, aasm::rdi);
+    a.jcc(aasm::CondType::E, label);
+    a.mov(8, 0, aasm::rax);
+    a.set_label(label);
+    a.ret();
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.count("compare_with_zero"), 1);
+    ASSERT_EQ(stats.count("move_zero"), 1);
+
+    /*
+     testq %rdi, %rdi
+     je L1
+     xorl %eax, %eax
+     L1:
+     ret
+     */
+    verify_codes(buffer, {0x48, 0x85, 0xff, 0x74, 0x02, 0x31, 0xc0, 0xc3});
+}
+
+TEST(Peephole, move_zero_keeps_live_flags) {
+    aasm::AsmEmitter a;
+    a.cmp(8, aasm::rsi, aasm::rdi);
+    a.mov(8, 0, aasm::rax);
+    a.setcc(aasm::CondType::E, aasm::rax);
+    a.ret();
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.count("move_zero"), 0);
+    ASSERT_EQ(buffer.size(), 4);
+}
+
+TEST(Peephole, jumps) {
+    aasm::AsmEmitter a;
+    const auto on_true = a.create_label();
+    const auto on_false = a.create_label();
+    const auto next = a.create_label();
+    a.test(8, aasm::rdi, aasm::rdi);
+    a.jcc(aasm::CondType::E, on_true);
+    a.jmp(on_false);
+    a.set_label(on_true);
+    a.mov(8, 1, aasm::rax);
+    a.jmp(next);
+    a.set_label(next);
+    a.ret();
+    a.set_label(on_false);
+    a.mov(8, 2, aasm::rax);
+    a.ret();
+
+    auto buffer = a.to_buffer();
+    const auto stats = buffer.optimize();
+    ASSERT_EQ(stats.count("branch_over_jump"), 1);
+    ASSERT_EQ(stats.count("jump_to_next"), 1);
+
+    /*
+     testq %rdi, %rdi
+     jne L2
+     movabsq $1, %rax
+     ret
+     L2:
+     movabsq $2, %rax
+     ret
+     */
+    verify_codes(buffer, {
+        0x48, 0x85, 0xff,
+        0x75, 0x0b,
+        0x48, 0xb8, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xc3,
+        0x48, 0xb8, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xc3
+    });
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
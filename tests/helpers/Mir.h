@@ -0,0 +1,42 @@
+#pragma once
+
+#include "mir/mir.h"
+#include "mir/transform/PassManager.h"
+
+/**
+ * Runs the given function passes over every function of the module, in this order.
+ */
+template<typename... Passes>
+void run_passes(Module& module) {
+    ModulePassManager manager;
+    (manager.add<Passes>(), ...);
+    manager.run(module);
+}
+
+/**
+ * Counts the instructions of type T in the basic block.
+ */
+template<typename T>
+std::size_t count_instructions(const BasicBlock& bb) {
+    std::size_t count{};
+    for (const auto& inst: bb.instructions()) {
+        if (dynamic_cast<const T*>(&inst) != nullptr) {
+            count += 1;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Counts the instructions of type T in the function.
+ */
+template<typename T>
+std::size_t count_instructions(const FunctionData& fd) {
+    std::size_t count{};
+    for (const auto& bb: fd.basic_blocks()) {
+        count += count_instructions<T>(bb);
+    }
+
+    return count;
+}
@@ -0,0 +1,93 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "utility/Arena.h"
+
+struct Tracked {
+    Tracked(std::vector<int>& destroyed, const int id) noexcept:
+        destroyed(destroyed),
+        id(id) {}
+
+    ~Tracked() {
+        destroyed.push_back(id);
+    }
+
+    std::vector<int>& destroyed;
+    int id;
+};
+
+struct alignas(64) Aligned {
+    std::uint8_t bytes[24];
+};
+
+TEST(Arena, destructors_run_on_clear) {
+    std::vector<int> destroyed;
+    Arena arena;
+    for (int i = 0; i < 3; ++i) {
+        arena.make<Tracked>(destroyed, i);
+    }
+
+    ASSERT_TRUE(destroyed.empty());
+    arena.clear();
+    ASSERT_EQ(destroyed, (std::vector{2, 1, 0}));
+    ASSERT_EQ(arena.chunks(), 0);
+}
+
+TEST(Arena, destructors_run_with_arena) {
+    std::vector<int> destroyed;
+    {
+        Arena arena;
+        const auto str = arena.make<std::string>(100, 'x');
+        ASSERT_EQ(str->size(), 100);
+        arena.make<Tracked>(destroyed, 7);
+    }
+
+    ASSERT_EQ(destroyed, (std::vector{7}));
+}
+
+TEST(Arena, objects_share_chunks) {
+    Arena arena;
+    std::vector<std::uint64_t*> values;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        values.push_back(arena.make<std::uint64_t>(i));
+    }
+
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(*values[i], i);
+    }
+    ASSERT_EQ(arena.chunks(), 1);
+}
+
+TEST(Arena, alignment) {
+    Arena arena;
+    for (int i = 0; i < 100; ++i) {
+        arena.make<std::uint8_t>(1);
+        const auto aligned = arena.make<Aligned>();
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % alignof(Aligned), 0);
+    }
+}
+
+TEST(Arena, big_object_keeps_current_chunk) {
+    Arena arena;
+    const auto first = arena.make<std::uint64_t>(1);
+    arena.make<std::array<std::uint8_t, 64 * 1024>>();
+    const auto second = arena.make<std::uint64_t>(2);
+
+    ASSERT_EQ(arena.chunks(), 2);
+    ASSERT_EQ(second - first, 1);
+}
+
+TEST(Arena, deferred_construction) {
+    Arena arena;
+    auto deferred = construct<std::string>(std::string("deferred"));
+    const auto str = std::move(deferred)(arena);
+    ASSERT_EQ(*str, "deferred");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,351 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "lir/x64/instruction/LIRICmp.h"
+#include "lir/x64/instruction/LIRProducerInstruction.h"
+#include "lir/x64/lower/Lowering.h"
+#include "helpers/Jit.h"
+
+/**
+ * for (i = 0; i < n; i++) p[i] = p[i + 1];
+ */
+static void shift_left(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), ty}, "shift_left", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto p = data.arg(0);
+    const auto n = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto next_i = data.add(i, Value::i64(1));
+    const auto val = data.load(ty, data.gep(ty, p, next_i));
+    data.store(data.gep(ty, p, i), val);
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret();
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, body);
+}
+
+/**
+ * return (p + 2)[i];
+ */
+static void load_with_offset(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), ty}, "load_with_offset", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto base = data.gep(ty, data.arg(0), Value::i64(2));
+    data.ret(data.load(ty, data.gep(ty, base, data.arg(1))));
+}
+
+/**
+ * return p[i - 1];
+ */
+static void load_prev_f64(ModuleBuilder& builder) {
+    const auto ty = FloatingPointType::f64();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), SignedIntegerType::i64()}, "load_prev_f64", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto prev = data.sub(data.arg(1), Value::i64(1));
+    data.ret(data.load(ty, data.gep(ty, data.arg(0), prev)));
+}
+
+/**
+ * s = 0; for (i = 0; i < n; i++) s += p[i]; return s;
+ */
+static void sum(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), ty}, "sum", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto p = data.arg(0);
+    const auto n = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto s = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto next_s = data.add(s, data.load(ty, data.gep(ty, p, i)));
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(s);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, body);
+    dynamic_cast<Phi*>(s.get<ValueInstruction*>())->add_incoming(next_s, body);
+}
+
+/**
+ * for (i = 0; i < n; i++) if (p[i] == key) return i; return n;
+ */
+static void find_i32(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto elem_ty = SignedIntegerType::i32();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), ty, elem_ty}, "find_i32", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto p = data.arg(0);
+    const auto n = data.arg(1);
+    const auto key = data.arg(2);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto latch = data.create_basic_block();
+    const auto found = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto val = data.load(elem_ty, data.gep(elem_ty, p, i));
+    data.br_cond(data.icmp(IcmpPredicate::Eq, val, key), found, latch);
+
+    data.switch_block(latch);
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(found);
+    data.ret(i);
+
+    data.switch_block(end);
+    data.ret(n);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, latch);
+}
+
+/**
+ * return x - *p;
+ */
+static void sub_from(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), ty}, "sub_from", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    data.ret(data.sub(data.arg(1), data.load(ty, data.arg(0))));
+}
+
+/**
+ * return p[i + 1] ^ x;
+ */
+static void xor_next(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr(), ty, ty}, "xor_next", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto next = data.add(data.arg(1), Value::i64(1));
+    data.ret(data.xxor(data.load(ty, data.gep(ty, data.arg(0), next)), data.arg(2)));
+}
+
+static Module address_folding() {
+    ModuleBuilder builder;
+    shift_left(builder);
+    load_with_offset(builder);
+    load_prev_f64(builder);
+    sum(builder);
+    find_i32(builder);
+    sub_from(builder);
+    xor_next(builder);
+    return builder.build();
+}
+
+/**
+ * Returns displacements of the indexed loads, fails if the address is materialized by lea.
+ */
+static std::vector<std::int64_t> load_displacements(const Module& module, const std::string& name) {
+    Lowering lower(module);
+    lower.run();
+    auto lir = lower.result();
+    const auto func = lir.find_function_data(name).value();
+
+    std::vector<std::int64_t> displacements;
+    for (const auto& bb: func->basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            const auto prod = dynamic_cast<const LIRProducerInstruction*>(&inst);
+            if (prod == nullptr) {
+                continue;
+            }
+
+            EXPECT_NE(prod->op(), LIRProdInstKind::Lea);
+            if (prod->op() == LIRProdInstKind::LoadByIdx) {
+                displacements.push_back(prod->in(2).as_cst().value().value());
+            }
+        }
+    }
+
+    return displacements;
+}
+
+/**
+ * Returns kinds of the producers which read the memory.
+ */
+static std::vector<LIRProdInstKind> memory_readers(const Module& module, const std::string& name) {
+    Lowering lower(module);
+    lower.run();
+    auto lir = lower.result();
+    const auto func = lir.find_function_data(name).value();
+
+    std::vector<LIRProdInstKind> kinds;
+    for (const auto& bb: func->basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            const auto prod = dynamic_cast<const LIRProducerInstruction*>(&inst);
+            if (prod == nullptr) {
+                continue;
+            }
+
+            switch (prod->op()) {
+                case LIRProdInstKind::Load: [[fallthrough]];
+                case LIRProdInstKind::LoadByIdx: [[fallthrough]];
+                case LIRProdInstKind::AddByIdx: [[fallthrough]];
+                case LIRProdInstKind::SubByIdx: [[fallthrough]];
+                case LIRProdInstKind::AndByIdx: [[fallthrough]];
+                case LIRProdInstKind::OrByIdx: [[fallthrough]];
+                case LIRProdInstKind::XorByIdx: kinds.push_back(prod->op()); break;
+                default: break;
+            }
+        }
+    }
+
+    return kinds;
+}
+
+/**
+ * Counts the compares which read their left operand from the memory.
+ */
+static std::size_t memory_compares(const Module& module, const std::string& name) {
+    Lowering lower(module);
+    lower.run();
+    auto lir = lower.result();
+    const auto func = lir.find_function_data(name).value();
+
+    std::size_t count{};
+    for (const auto& bb: func->basic_blocks()) {
+        for (const auto& inst: bb.instructions()) {
+            if (const auto cmp = dynamic_cast<const LIRICmp*>(&inst); cmp != nullptr && cmp->inputs().size() == 4) {
+                count += 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+TEST(AddressFolding, constant_addend) {
+    const auto module = address_folding();
+    ASSERT_EQ(load_displacements(module, "shift_left"), std::vector<std::int64_t>{8});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<void(std::int64_t*, std::int64_t)>("shift_left").value();
+    std::int64_t arr[] = {1, 2, 3, 4, 5};
+    fn(arr, 4);
+    const std::vector<std::int64_t> expected{2, 3, 4, 5, 5};
+    ASSERT_EQ(std::vector(std::begin(arr), std::end(arr)), expected);
+}
+
+TEST(AddressFolding, constant_base_offset) {
+    const auto module = address_folding();
+    ASSERT_EQ(load_displacements(module, "load_with_offset"), std::vector<std::int64_t>{16});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(const std::int64_t*, std::int64_t)>("load_with_offset").value();
+    const std::int64_t arr[] = {10, 20, 30, 40, 50};
+    ASSERT_EQ(fn(arr, 0), 30);
+    ASSERT_EQ(fn(arr, 2), 50);
+    ASSERT_EQ(fn(arr, -1), 20);
+}
+
+TEST(AddressFolding, negative_addend_f64) {
+    const auto module = address_folding();
+    ASSERT_EQ(load_displacements(module, "load_prev_f64"), std::vector<std::int64_t>{-8});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<double(const double*, std::int64_t)>("load_prev_f64").value();
+    const double arr[] = {1.5, 2.5, 3.5};
+    ASSERT_EQ(fn(arr, 1), 1.5);
+    ASSERT_EQ(fn(arr, 3), 3.5);
+}
+
+TEST(AddressFolding, load_into_add) {
+    const auto module = address_folding();
+    ASSERT_EQ(memory_readers(module, "sum"), std::vector{LIRProdInstKind::AddByIdx});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(const std::int64_t*, std::int64_t)>("sum").value();
+    const std::int64_t arr[] = {1, -2, 30, 400, 5000};
+    ASSERT_EQ(fn(arr, 0), 0);
+    ASSERT_EQ(fn(arr, 3), 29);
+    ASSERT_EQ(fn(arr, 5), 5429);
+}
+
+TEST(AddressFolding, load_into_cmp) {
+    const auto module = address_folding();
+    ASSERT_TRUE(memory_readers(module, "find_i32").empty());
+    ASSERT_EQ(memory_compares(module, "find_i32"), 1);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(const std::int32_t*, std::int64_t, std::int32_t)>("find_i32").value();
+    const std::int32_t arr[] = {7, -1, 42, 42, 3};
+    ASSERT_EQ(fn(arr, 5, 7), 0);
+    ASSERT_EQ(fn(arr, 5, 42), 2);
+    ASSERT_EQ(fn(arr, 5, 3), 4);
+    ASSERT_EQ(fn(arr, 5, 100), 5);
+    ASSERT_EQ(fn(arr, 2, 42), 2);
+}
+
+TEST(AddressFolding, load_into_sub) {
+    const auto module = address_folding();
+    ASSERT_EQ(memory_readers(module, "sub_from"), std::vector{LIRProdInstKind::SubByIdx});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(const std::int64_t*, std::int64_t)>("sub_from").value();
+    const std::int64_t val = 12;
+    ASSERT_EQ(fn(&val, 5), -7);
+    ASSERT_EQ(fn(&val, 100), 88);
+}
+
+TEST(AddressFolding, load_into_xor) {
+    const auto module = address_folding();
+    ASSERT_EQ(memory_readers(module, "xor_next"), std::vector{LIRProdInstKind::XorByIdx});
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(const std::int64_t*, std::int64_t, std::int64_t)>("xor_next").value();
+    const std::int64_t arr[] = {0b1100, 0b1010, 0b0110};
+    ASSERT_EQ(fn(arr, 0, 0b0110), 0b1100);
+    ASSERT_EQ(fn(arr, 1, 0b1111), 0b1001);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
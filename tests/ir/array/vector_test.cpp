@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/module/verify/Verifier.h"
+#include "helpers/Jit.h"
+
+/**
+ * for (i = 0; i < n; i += 8) out[i..i+8] = a[i..i+8] + b[i..i+8];
+ */
+static void add_f32x8(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), PointerType::ptr(), PointerType::ptr(), ty}, "add_f32x8", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto a = data.arg(0);
+    const auto b = data.arg(1);
+    const auto out = data.arg(2);
+    const auto n = data.arg(3);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto elem = FloatingPointType::f32();
+    const auto lhs = data.load(VectorType::f32x8(), data.gep(elem, a, i));
+    const auto rhs = data.load(VectorType::f32x8(), data.gep(elem, b, i));
+    data.store(data.gep(elem, out, i), data.add(lhs, rhs));
+    const auto next_i = data.add(i, Value::i64(8));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret();
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, body);
+}
+
+/**
+ * p[0..4] = (p[0..4] - {k, k, k, k}) * {k, k, k, k};
+ */
+static void scale_i32x4(ModuleBuilder& builder) {
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), SignedIntegerType::i32()}, "scale_i32x4", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto p = data.arg(0);
+    const auto k = data.broadcast(VectorType::i32x4(), data.arg(1));
+    const auto v = data.load(VectorType::i32x4(), p);
+    data.store(p, data.mul(data.sub(v, k), k));
+    data.ret();
+}
+
+/**
+ * mask[0..4] = a[0..4] > b[0..4] ? -1 : 0;
+ */
+static void cmp_gt_f64x4(ModuleBuilder& builder) {
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), PointerType::ptr(), PointerType::ptr()}, "cmp_gt_f64x4", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto lhs = data.load(VectorType::f64x4(), data.arg(0));
+    const auto rhs = data.load(VectorType::f64x4(), data.arg(1));
+    data.store(data.arg(2), data.vcmp(IcmpPredicate::Gt, lhs, rhs));
+    data.ret();
+}
+
+/**
+ * mask[0..8] = a[0..8] < b[0..8] ? -1 : 0;
+ */
+static void cmp_lt_i32x8(ModuleBuilder& builder) {
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), PointerType::ptr(), PointerType::ptr()}, "cmp_lt_i32x8", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto lhs = data.load(VectorType::i32x8(), data.arg(0));
+    const auto rhs = data.load(VectorType::i32x8(), data.arg(1));
+    data.store(data.arg(2), data.vcmp(IcmpPredicate::Lt, lhs, rhs));
+    data.ret();
+}
+
+/**
+ * mask[0..4] = a[0..4] <predicate> b[0..4] ? -1 : 0;
+ * Packed integers have no such compare instruction, it is lowered as the negation of the opposite one.
+ */
+static void cmp_negated_i64x4(ModuleBuilder& builder, const IcmpPredicate predicate, const std::string_view name) {
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), PointerType::ptr(), PointerType::ptr()}, std::string(name), FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto lhs = data.load(VectorType::i64x4(), data.arg(0));
+    const auto rhs = data.load(VectorType::i64x4(), data.arg(1));
+    data.store(data.arg(2), data.vcmp(predicate, lhs, rhs));
+    data.ret();
+}
+
+/**
+ * Reverses the lanes: p[0..4] = {p[3], p[2], p[1], p[0]};
+ */
+static void reverse_f32x4(ModuleBuilder& builder) {
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr()}, "reverse_f32x4", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto v = data.load(VectorType::f32x4(), data.arg(0));
+    data.store(data.arg(0), data.shuffle(v, v, 0x1B));
+    data.ret();
+}
+
+static Module vector_module() {
+    ModuleBuilder builder;
+    add_f32x8(builder);
+    scale_i32x4(builder);
+    cmp_gt_f64x4(builder);
+    cmp_lt_i32x8(builder);
+    reverse_f32x4(builder);
+    cmp_negated_i64x4(builder, IcmpPredicate::Ne, "cmp_ne_i64x4");
+    cmp_negated_i64x4(builder, IcmpPredicate::Le, "cmp_le_i64x4");
+    cmp_negated_i64x4(builder, IcmpPredicate::Ge, "cmp_ge_i64x4");
+    return builder.build();
+}
+
+static bool has_avx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+TEST(Vector, print) {
+    const auto module = vector_module();
+    std::ostringstream os;
+    os << module;
+    const auto text = os.str();
+    ASSERT_NE(text.find("load <8 x f32>"), std::string::npos) << text;
+    ASSERT_NE(text.find("vector broadcast <4 x i32>"), std::string::npos) << text;
+    ASSERT_NE(text.find("vector shuffle <4 x f32>"), std::string::npos) << text;
+}
+
+TEST(Vector, add_f32x8) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const auto fn = buffer.code_start_as<void(const float*, const float*, float*, std::int64_t)>("add_f32x8").value();
+    float a[16];
+    float b[16];
+    float out[16];
+    for (std::size_t i = 0; i < 16; ++i) {
+        a[i] = static_cast<float>(i);
+        b[i] = static_cast<float>(i) * 0.5f;
+    }
+
+    fn(a, b, out, 16);
+    for (std::size_t i = 0; i < 16; ++i) {
+        ASSERT_EQ(out[i], a[i] + b[i]) << "Mismatch at index=" << i;
+    }
+}
+
+TEST(Vector, scale_i32x4) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const auto fn = buffer.code_start_as<void(std::int32_t*, std::int32_t)>("scale_i32x4").value();
+    std::int32_t p[] = {1, 2, 3, -4};
+    fn(p, 3);
+    const std::vector<std::int32_t> expected{-6, -3, 0, -21};
+    ASSERT_EQ(std::vector(std::begin(p), std::end(p)), expected);
+}
+
+TEST(Vector, cmp_gt_f64x4) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const auto fn = buffer.code_start_as<void(const double*, const double*, std::int64_t*)>("cmp_gt_f64x4").value();
+    const double a[] = {1.0, 2.0, 3.0, 4.0};
+    const double b[] = {0.5, 2.0, 3.5, -1.0};
+    std::int64_t mask[4];
+    fn(a, b, mask);
+    const std::vector<std::int64_t> expected{-1, 0, 0, -1};
+    ASSERT_EQ(std::vector(std::begin(mask), std::end(mask)), expected);
+}
+
+TEST(Vector, cmp_lt_i32x8) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const auto fn = buffer.code_start_as<void(const std::int32_t*, const std::int32_t*, std::int32_t*)>("cmp_lt_i32x8").value();
+    const std::int32_t a[] = {1, 2, 3, 4, -5, 6, 7, 8};
+    const std::int32_t b[] = {2, 2, 2, 2, 0, 7, 7, 9};
+    std::int32_t mask[8];
+    fn(a, b, mask);
+    const std::vector<std::int32_t> expected{-1, 0, 0, 0, -1, -1, 0, -1};
+    ASSERT_EQ(std::vector(std::begin(mask), std::end(mask)), expected);
+}
+
+TEST(Vector, reverse_f32x4) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const auto fn = buffer.code_start_as<void(float*)>("reverse_f32x4").value();
+    float p[] = {1.0f, 2.0f, 3.0f, 4.0f};
+    fn(p);
+    const std::vector expected{4.0f, 3.0f, 2.0f, 1.0f};
+    ASSERT_EQ(std::vector(std::begin(p), std::end(p)), expected);
+}
+
+TEST(Vector, cmp_negated_i64x4) {
+    if (!has_avx2()) {
+        GTEST_SKIP() << "AVX2 is not supported";
+    }
+
+    const auto buffer = jit_compile_and_assembly(vector_module());
+    const std::int64_t a[] = {1, 2, 3, -4};
+    const std::int64_t b[] = {1, 3, 2, -4};
+    const std::vector<std::pair<std::string, std::vector<std::int64_t>>> cases = {
+        {"cmp_ne_i64x4", {0, -1, -1, 0}},
+        {"cmp_le_i64x4", {-1, -1, 0, -1}},
+        {"cmp_ge_i64x4", {-1, 0, -1, -1}},
+    };
+
+    for (const auto& [name, expected]: cases) {
+        const auto fn = buffer.code_start_as<void(const std::int64_t*, const std::int64_t*, std::int64_t*)>(name).value();
+        std::int64_t mask[4];
+        fn(a, b, mask);
+        ASSERT_EQ(std::vector(std::begin(mask), std::end(mask)), expected) << name;
+    }
+}
+
+TEST(Vector, i64_mul_is_rejected) {
+    ModuleBuilder builder;
+    const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr()}, "square_i64x4", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto v = data.load(VectorType::i64x4(), data.arg(0));
+    data.store(data.arg(0), data.mul(v, v));
+    data.ret();
+
+    ASSERT_TRUE(Verifier::apply(builder.build()).has_value());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "lir/x64/codegen/BlockLayout.h"
+#include "lir/x64/lower/Lowering.h"
+#include "helpers/Jit.h"
+
+struct Blocks final {
+    BasicBlock* header;
+    BasicBlock* check;
+    BasicBlock* rare;
+    BasicBlock* inc;
+    BasicBlock* end;
+};
+
+/**
+ * for (i = 0; i < n; i++) {
+ *     if (i == k) s += 100;
+ *     s += i;
+ * }
+ */
+static Module rare_path(Blocks& blocks) {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "rare_path", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto k = data.arg(1);
+    const auto s = data.alloc(ty);
+    const auto i = data.alloc(ty);
+    blocks = Blocks{
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+    };
+
+    data.store(s, Value::i64(0));
+    data.store(i, Value::i64(0));
+    data.br(blocks.header);
+
+    data.switch_block(blocks.header);
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.load(ty, i), n), blocks.check, blocks.end);
+
+    data.switch_block(blocks.check);
+    data.br_cond(data.icmp(IcmpPredicate::Eq, data.load(ty, i), k), blocks.rare, blocks.inc);
+
+    data.switch_block(blocks.rare);
+    data.store(s, data.add(data.load(ty, s), Value::i64(100)));
+    data.br(blocks.inc);
+
+    data.switch_block(blocks.inc);
+    data.store(s, data.add(data.load(ty, s), data.load(ty, i)));
+    data.store(i, data.add(data.load(ty, i), Value::i64(1)));
+    data.br(blocks.header);
+
+    data.switch_block(blocks.end);
+    data.ret(data.load(ty, s));
+    return builder.build();
+}
+
+/**
+ * Returns ids of the blocks in the emission order. Lowering keeps the ids of the blocks when none were removed.
+ */
+static std::vector<std::size_t> layout(const Module& module) {
+    Lowering lower(module);
+    lower.run();
+    auto lir = lower.result();
+    const auto func = lir.find_function_data("rare_path").value();
+
+    LIRAnalysisPassManager cache;
+    auto layout = BlockLayout::create(&cache, func);
+    layout.run();
+    const auto order = layout.result();
+
+    std::vector<std::size_t> ids;
+    for (const auto bb: order) {
+        ids.push_back(bb->id());
+    }
+
+    return ids;
+}
+
+TEST(BlockLayout, loop_is_contiguous) {
+    Blocks blocks{};
+    const auto module = rare_path(blocks);
+
+    const auto order = layout(module);
+    const std::vector<std::size_t> expected{0, blocks.header->id(), blocks.check->id(), blocks.rare->id(), blocks.inc->id(), blocks.end->id()};
+    ASSERT_EQ(order, expected);
+}
+
+TEST(BlockLayout, cold_block_is_sunk) {
+    Blocks blocks{};
+    auto module = rare_path(blocks);
+
+    const auto fd = module.find_function_data("rare_path").value();
+    auto& profile = fd->edge_profile();
+    profile.add(fd->first()->id(), blocks.header->id());
+    profile.add(blocks.header->id(), blocks.check->id(), 1000);
+    profile.add(blocks.header->id(), blocks.end->id());
+    profile.add(blocks.check->id(), blocks.inc->id(), 1000);
+    profile.add(blocks.inc->id(), blocks.header->id(), 1000);
+
+    const auto order = layout(module);
+    const std::vector<std::size_t> expected{0, blocks.header->id(), blocks.check->id(), blocks.inc->id(), blocks.end->id(), blocks.rare->id()};
+    ASSERT_EQ(order, expected);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("rare_path").value();
+    ASSERT_EQ(fn(10, 3), 145);
+    ASSERT_EQ(fn(10, 20), 45);
+    ASSERT_EQ(fn(0, 0), 0);
+}
+
+TEST(BlockLayout, static_layout) {
+    Blocks blocks{};
+    const auto module = rare_path(blocks);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("rare_path").value();
+    ASSERT_EQ(fn(10, 3), 145);
+    ASSERT_EQ(fn(10, 20), 45);
+    ASSERT_EQ(fn(1, 0), 100);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
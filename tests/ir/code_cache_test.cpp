@@ -0,0 +1,170 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "lir/x64/asm/jit/CodeCache.h"
+#include "mir/mir.h"
+
+static std::int16_t deref_int16(const std::int16_t* p) {
+    return *p;
+}
+
+static std::int16_t deref_int16_twice(const std::int16_t* p) {
+    return static_cast<std::int16_t>(*p * 2);
+}
+
+static Module escape_constant(const std::int64_t value) {
+    ModuleBuilder builder;
+    {
+        const auto ty = SignedIntegerType::i16();
+        const auto prototype = builder.add_function_prototype(ty, {}, "escape_constant", FunctionBind::DEFAULT);
+        const auto deref_prototype = builder.add_function_prototype(ty, {PointerType::ptr()}, "deref_int16", FunctionBind::EXTERN);
+
+        auto data = builder.make_function_builder(prototype).value();
+        const auto constant = builder.add_constant("my_global_const", ty, value).value();
+        data.ret(data.call(deref_prototype, {constant}));
+    }
+    {
+        const auto ty = SignedIntegerType::i64();
+        const auto prototype = builder.add_function_prototype(ty, {ty}, "twice", FunctionBind::DEFAULT);
+        auto data = builder.make_function_builder(prototype).value();
+        data.ret(data.add(data.arg(0), data.arg(0)));
+    }
+    return builder.build();
+}
+
+/**
+ * Fresh cache directory for one test.
+ */
+class CodeCacheTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        m_directory = std::filesystem::temp_directory_path() / std::format("polymorphine_code_cache_{}_{}", getpid(), test_name);
+        std::filesystem::remove_all(m_directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+};
+
+static const std::unordered_map<std::string, std::size_t> EXTERNAL_SYMBOLS{
+    {"deref_int16", reinterpret_cast<std::size_t>(&deref_int16)},
+};
+
+TEST_F(CodeCacheTest, miss_then_hit) {
+    const auto module = escape_constant(256);
+    CodeCache cache(m_directory);
+    {
+        const auto buffer = jit_compile_cached(cache, module, EXTERNAL_SYMBOLS);
+        ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 256);
+        ASSERT_EQ(buffer.code_start_as<std::int64_t(std::int64_t)>("twice").value()(21), 42);
+    }
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.hits(), 0);
+
+    const auto buffer = jit_compile_cached(cache, module, EXTERNAL_SYMBOLS);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 256);
+    ASSERT_EQ(buffer.code_start_as<std::int64_t(std::int64_t)>("twice").value()(21), 42);
+}
+
+TEST_F(CodeCacheTest, external_symbols_are_resolved_on_hit) {
+    const auto module = escape_constant(256);
+    CodeCache cache(m_directory);
+    static_cast<void>(jit_compile_cached(cache, module, EXTERNAL_SYMBOLS));
+
+    const std::unordered_map<std::string, std::size_t> moved_symbols{
+        {"deref_int16", reinterpret_cast<std::size_t>(&deref_int16_twice)},
+    };
+
+    const auto buffer = jit_compile_cached(cache, module, moved_symbols);
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 512);
+}
+
+TEST_F(CodeCacheTest, key_depends_on_content) {
+    const std::vector<std::string> names{"deref_int16"};
+    const std::vector<std::string> other_names{"deref_int32"};
+
+    const auto key = CodeCache::key(escape_constant(256), names);
+    ASSERT_EQ(key, CodeCache::key(escape_constant(256), names));
+    ASSERT_NE(key, CodeCache::key(escape_constant(257), names));
+    ASSERT_NE(key, CodeCache::key(escape_constant(256), other_names));
+}
+
+TEST_F(CodeCacheTest, oversized_count_is_miss) {
+    const auto module = escape_constant(256);
+    CodeCache cache(m_directory);
+    static_cast<void>(jit_compile_cached(cache, module, EXTERNAL_SYMBOLS));
+
+    const std::vector<std::string> names{"deref_int16"};
+    const auto path = cache.entry_path(CodeCache::key(module, names));
+    {
+        // The symbol count follows the magic, the compiler version and the key.
+        std::fstream entry(path, std::ios::binary | std::ios::in | std::ios::out);
+        entry.seekp(sizeof(std::uint64_t) + sizeof(std::uint32_t) + sizeof(std::uint64_t));
+        const std::uint32_t count = UINT32_MAX;
+        entry.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    const auto buffer = jit_compile_cached(cache, module, EXTERNAL_SYMBOLS);
+    ASSERT_EQ(cache.misses(), 2);
+    ASSERT_EQ(cache.hits(), 0);
+    ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 256);
+}
+
+static Module scale(const double factor, const double initial) {
+    ModuleBuilder builder;
+    const auto ty = FloatingPointType::f64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "scale", FunctionBind::DEFAULT);
+    const auto data = builder.make_function_builder(prototype).value();
+    static_cast<void>(builder.add_constant("initial", ty, initial).value());
+    data.ret(data.mul(data.arg(0), Value::f64(factor)));
+    return builder.build();
+}
+
+TEST_F(CodeCacheTest, key_depends_on_float_bits) {
+    const std::vector<std::string> names{};
+
+    const auto key = CodeCache::key(scale(1.5, 0.1), names);
+    ASSERT_EQ(key, CodeCache::key(scale(1.5, 0.1), names));
+    ASSERT_NE(key, CodeCache::key(scale(1.5000001, 0.1), names));
+    ASSERT_NE(key, CodeCache::key(scale(1.5, 0.1000000001), names));
+}
+
+TEST_F(CodeCacheTest, corrupt_entry_is_miss) {
+    const auto module = escape_constant(256);
+    CodeCache cache(m_directory);
+    static_cast<void>(jit_compile_cached(cache, module, EXTERNAL_SYMBOLS));
+
+    const std::vector<std::string> names{"deref_int16"};
+    const auto path = cache.entry_path(CodeCache::key(module, names));
+    ASSERT_TRUE(std::filesystem::exists(path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+    {
+        const auto buffer = jit_compile_cached(cache, module, EXTERNAL_SYMBOLS);
+        ASSERT_EQ(cache.misses(), 2);
+        ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 256);
+    }
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "garbage";
+    static_cast<void>(jit_compile_cached(cache, module, EXTERNAL_SYMBOLS));
+    ASSERT_EQ(cache.misses(), 3);
+
+    const auto buffer = jit_compile_cached(cache, module, EXTERNAL_SYMBOLS);
+    ASSERT_EQ(cache.hits(), 1);
+    ASSERT_EQ(buffer.code_start_as<std::int16_t()>("escape_constant").value()(), 256);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,71 @@
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include "lir/x64/asm/jit/CodeHeap.h"
+
+TEST(FreeList, allocate_and_coalesce) {
+    details::FreeList list(64);
+    const auto a = list.allocate(16);
+    const auto b = list.allocate(16);
+    const auto c = list.allocate(32);
+    ASSERT_EQ(a, 0);
+    ASSERT_EQ(b, 16);
+    ASSERT_EQ(c, 32);
+    ASSERT_FALSE(list.allocate(16).has_value());
+
+    list.release(a.value(), 16);
+    list.release(c.value(), 32);
+    ASSERT_FALSE(list.allocate(48).has_value());
+
+    list.release(b.value(), 16);
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.allocate(64), 0);
+}
+
+TEST(CodeHeap, chunks_do_not_overlap) {
+    CodeHeap heap;
+    auto first = heap.allocate(10, 100);
+    auto second = heap.allocate(10, 100);
+
+    ASSERT_EQ(first.data().size(), 16);
+    ASSERT_EQ(first.code().size(), 112);
+    ASSERT_NE(first.code_start(), second.code_start());
+    ASSERT_NE(first.data().data(), second.data().data());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(first.code_start()) % CodeHeap::ALIGNMENT, 0);
+}
+
+TEST(CodeHeap, writable_view_is_visible_in_executable_view) {
+    CodeHeap heap;
+    const auto chunk = heap.allocate(0, 4);
+
+    constexpr std::uint8_t ret[] = {0xC3, 0x90, 0x90, 0x90};
+    std::memcpy(chunk.code().data(), ret, sizeof(ret));
+    ASSERT_EQ(std::memcmp(chunk.code_start(), ret, sizeof(ret)), 0);
+    ASSERT_NE(chunk.code().data(), chunk.code_start());
+}
+
+TEST(CodeHeap, released_memory_is_reused) {
+    CodeHeap heap;
+    std::uint8_t* start{};
+    {
+        const auto chunk = heap.allocate(32, 64);
+        start = chunk.code_start();
+    }
+
+    const auto chunk = heap.allocate(32, 64);
+    ASSERT_EQ(chunk.code_start(), start);
+}
+
+TEST(CodeHeap, large_chunk) {
+    CodeHeap heap;
+    const auto small = heap.allocate(16, 16);
+    const auto large = heap.allocate(16, 2 * CodeHeap::ARENA_SECTION_SIZE);
+    ASSERT_EQ(large.code().size(), 2 * CodeHeap::ARENA_SECTION_SIZE);
+    large.code().back() = 0xC3;
+    ASSERT_EQ(large.code_start()[large.code().size() - 1], 0xC3);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
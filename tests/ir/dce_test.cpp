@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/instruction/IntDiv.h"
+#include "mir/instruction/Phi.h"
+#include "mir/instruction/Projection.h"
+#include "mir/transform/DCE.h"
+#include "mir/transform/PassManager.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+static Module unused_values() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "unused_values", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto ptr = data.alloc(ty);
+    data.store(ptr, data.arg(0));
+    [[maybe_unused]] const auto load = data.load(ty, ptr);
+    const auto x = data.add(data.arg(0), Value::i64(1));
+    [[maybe_unused]] const auto y = data.mul(x, Value::i64(2));
+    data.ret(data.arg(0));
+    return builder.build();
+}
+
+TEST(DCE, unused_values) {
+    auto module = unused_values();
+    run_passes<DCE>(module);
+
+    const auto fd = module.find_function_data("unused_values").value();
+    ASSERT_EQ(count_instructions<Binary>(*fd), 0);
+    ASSERT_EQ(count_instructions<Unary>(*fd), 0);
+    ASSERT_EQ(count_instructions<Alloc>(*fd), 1);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("unused_values").value();
+    ASSERT_EQ(fn(7), 7);
+}
+
+/**
+ * The sum is carried around the loop by a phi node, but never leaves it.
+ */
+static Module dead_phi_cycle() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "dead_phi_cycle", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto entry = data.create_basic_block();
+    const auto loop = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(loop);
+
+    data.switch_block(loop);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto sum = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto next_sum = data.add(sum, i);
+    const auto next_i = data.add(i, Value::i64(1));
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, loop);
+    dynamic_cast<Phi*>(sum.get<ValueInstruction*>())->add_incoming(next_sum, loop);
+    data.br_cond(data.icmp(IcmpPredicate::Lt, next_i, data.arg(0)), loop, end);
+
+    data.switch_block(end);
+    data.ret(next_i);
+    return builder.build();
+}
+
+TEST(DCE, dead_phi_cycle) {
+    auto module = dead_phi_cycle();
+    run_passes<DCE>(module);
+
+    const auto fd = module.find_function_data("dead_phi_cycle").value();
+    ASSERT_EQ(count_instructions<Phi>(*fd), 1);
+    ASSERT_EQ(count_instructions<Binary>(*fd), 1);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("dead_phi_cycle").value();
+    ASSERT_EQ(fn(10), 10);
+}
+
+static Module division(const bool use_quotient) {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "division", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto [quotient, remain] = data.idiv(data.arg(0), data.arg(0));
+    data.ret(use_quotient ? quotient : data.arg(0));
+    return builder.build();
+}
+
+TEST(DCE, projections_stay_with_division) {
+    auto module = division(true);
+    run_passes<DCE>(module);
+
+    const auto fd = module.find_function_data("division").value();
+    ASSERT_EQ(count_instructions<IntDiv>(*fd), 1);
+    ASSERT_EQ(count_instructions<Projection>(*fd), 2);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("division").value();
+    ASSERT_EQ(fn(7), 1);
+}
+
+TEST(DCE, unused_division) {
+    auto module = division(false);
+    run_passes<DCE>(module);
+
+    const auto fd = module.find_function_data("division").value();
+    ASSERT_EQ(count_instructions<IntDiv>(*fd), 0);
+    ASSERT_EQ(count_instructions<Projection>(*fd), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "utility/DenseBitSet.h"
+
+TEST(DenseBitSet, set_and_test) {
+    DenseBitSet set(130);
+    set.set(0);
+    set.set(63);
+    set.set(64);
+    set.set(129);
+
+    ASSERT_TRUE(set.test(0));
+    ASSERT_TRUE(set.test(63));
+    ASSERT_TRUE(set.test(64));
+    ASSERT_TRUE(set.test(129));
+    ASSERT_FALSE(set.test(1));
+    ASSERT_EQ(set.count(), 4);
+
+    set.reset(63);
+    ASSERT_FALSE(set.test(63));
+    ASSERT_EQ(set.count(), 3);
+}
+
+TEST(DenseBitSet, iterate) {
+    DenseBitSet set(200);
+    const std::vector<std::size_t> bits{3, 64, 65, 127, 128, 199};
+    for (const auto bit: bits) {
+        set.set(bit);
+    }
+
+    const std::vector<std::size_t> visited(set.begin(), set.end());
+    ASSERT_EQ(visited, bits);
+
+    const DenseBitSet empty(200);
+    ASSERT_TRUE(empty.none());
+    ASSERT_EQ(empty.begin(), empty.end());
+}
+
+TEST(DenseBitSet, unite) {
+    DenseBitSet lhs(100);
+    DenseBitSet rhs(100);
+    lhs.set(1);
+    rhs.set(1);
+    rhs.set(99);
+
+    ASSERT_TRUE(lhs.unite(rhs));
+    ASSERT_TRUE(lhs.test(99));
+    ASSERT_FALSE(lhs.unite(rhs));
+}
+
+TEST(DenseBitSet, difference_union) {
+    DenseBitSet out(70);
+    DenseBitSet kill(70);
+    DenseBitSet gen(70);
+    out.set(5);
+    out.set(66);
+    kill.set(66);
+    gen.set(10);
+
+    DenseBitSet in(70);
+    ASSERT_TRUE(in.assign_difference_union(out, kill, gen));
+    const std::vector<std::size_t> visited(in.begin(), in.end());
+    ASSERT_EQ(visited, (std::vector<std::size_t>{5, 10}));
+    ASSERT_FALSE(in.assign_difference_union(out, kill, gen));
+
+    in.subtract(gen);
+    ASSERT_FALSE(in.test(10));
+}
+
+TEST(DenseBitSet, resize) {
+    DenseBitSet set(10);
+    set.set(9);
+    set.resize(100);
+    set.set(99);
+    ASSERT_EQ(set.count(), 2);
+
+    set.resize(9);
+    ASSERT_TRUE(set.none());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
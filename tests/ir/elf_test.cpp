@@ -0,0 +1,125 @@
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "lir/x64/asm/elf/Elf.h"
+#include "lir/x64/asm/jit/JitComplation.h"
+#include "mir/mir.h"
+
+static Module counter_module() {
+    ModuleBuilder builder;
+    const auto counter = builder.add_variable("counter", SignedIntegerType::i64(), 40L).value();
+    const auto zeroed = builder.add_variable("zeroed", SignedIntegerType::i64(), 0L).value();
+    const auto pointer = builder.add_variable("counter_ptr", PointerType::ptr(), counter).value();
+    const auto add_two = builder.add_function_prototype(SignedIntegerType::i64(), {SignedIntegerType::i64()}, "add_two", FunctionBind::INTERNAL);
+    {
+        const auto data = builder.make_function_builder(add_two).value();
+        data.ret(data.add(data.arg(0), Value::i64(2)));
+    }
+    {
+        const auto prototype = builder.add_function_prototype(SignedIntegerType::i64(), {}, "increment", FunctionBind::DEFAULT);
+        auto data = builder.make_function_builder(prototype).value();
+        const auto ptr = data.load(PointerType::ptr(), pointer);
+        const auto value = data.load(SignedIntegerType::i64(), ptr);
+        const auto zero = data.load(SignedIntegerType::i64(), zeroed);
+        const auto next = data.call(add_two, {data.add(value, zero)});
+        data.store(counter, next);
+        data.ret(next);
+    }
+    {
+        const auto abs_proto = builder.add_function_prototype(SignedIntegerType::i32(), {SignedIntegerType::i32()}, "abs", FunctionBind::EXTERN);
+        const auto prototype = builder.add_function_prototype(SignedIntegerType::i32(), {}, "call_abs", FunctionBind::DEFAULT);
+        auto data = builder.make_function_builder(prototype).value();
+        data.ret(data.call(abs_proto, {Value::i32(-5)}));
+    }
+    return builder.build();
+}
+
+static constexpr auto DRIVER = R"(
+long increment(void);
+int call_abs(void);
+extern long counter;
+
+int main(void) {
+    if (increment() != 42) return 1;
+    if (increment() != 44) return 2;
+    if (counter != 44) return 3;
+    if (call_abs() != 5) return 4;
+    return 0;
+}
+)";
+
+static int run(const std::string& command) {
+    const auto status = std::system(command.c_str());
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+TEST(Elf, link_with_system_linker) {
+    if (run("cc --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "C compiler is not available";
+    }
+
+    const auto test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    const auto dir = std::filesystem::temp_directory_path() / std::format("polymorphine_elf_{}_{}", getpid(), test_name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto object = dir / "module.o";
+    const auto driver = dir / "main.c";
+    const auto executable = dir / "main";
+
+    auto elf = Elf::collect(jit_compile(counter_module(), false));
+    elf.save(object.string());
+    std::ofstream(driver) << DRIVER;
+
+    ASSERT_EQ(run(std::format("cc -o {} {} {}", executable.string(), driver.string(), object.string())), 0);
+    ASSERT_EQ(run(executable.string()), 0);
+    std::filesystem::remove_all(dir);
+}
+
+static std::string output(const std::string& command) {
+    std::string result;
+    const auto pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) {
+        return result;
+    }
+
+    std::array<char, 256> buffer{};
+    while (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+        result += buffer.data();
+    }
+
+    pclose(pipe);
+    return result;
+}
+
+TEST(Elf, internal_functions_are_local) {
+    if (run("nm --version > /dev/null 2>&1") != 0) {
+        GTEST_SKIP() << "nm is not available";
+    }
+
+    const auto test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    const auto dir = std::filesystem::temp_directory_path() / std::format("polymorphine_elf_{}_{}", getpid(), test_name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto object = dir / "module.o";
+
+    auto elf = Elf::collect(jit_compile(counter_module(), false));
+    elf.save(object.string());
+
+    // nm prints local text symbols with 't' and global ones with 'T'.
+    const auto symbols = output(std::format("nm {}", object.string()));
+    ASSERT_NE(symbols.find(" t add_two\n"), std::string::npos) << symbols;
+    ASSERT_NE(symbols.find(" T increment\n"), std::string::npos) << symbols;
+    ASSERT_NE(symbols.find(" T call_abs\n"), std::string::npos) << symbols;
+    std::filesystem::remove_all(dir);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
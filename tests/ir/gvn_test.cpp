@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/transform/GVN.h"
+#include "mir/transform/PassManager.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+static Module commutative() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "commutative", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto x = data.add(data.arg(0), data.arg(1));
+    const auto y = data.add(data.arg(1), data.arg(0));
+    const auto u = data.mul(x, Value::i64(3));
+    const auto v = data.mul(y, Value::i64(3));
+    data.ret(data.sub(u, v));
+    return builder.build();
+}
+
+TEST(GVN, same_block_and_chains) {
+    auto module = commutative();
+    run_passes<GVN>(module);
+
+    const auto fd = module.find_function_data("commutative").value();
+    ASSERT_EQ(count_instructions<Binary>(*fd), 3);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("commutative").value();
+    ASSERT_EQ(fn(3, 4), 0);
+}
+
+static Module non_commutative() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "non_commutative", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto x = data.sub(data.arg(0), data.arg(1));
+    const auto y = data.sub(data.arg(1), data.arg(0));
+    data.ret(data.add(x, y));
+    return builder.build();
+}
+
+TEST(GVN, keep_operand_order) {
+    auto module = non_commutative();
+    run_passes<GVN>(module);
+
+    const auto fd = module.find_function_data("non_commutative").value();
+    ASSERT_EQ(count_instructions<Binary>(*fd), 3);
+}
+
+/**
+ * 'a + b' is computed in the entry and in both branches, and once more after the merge.
+ */
+template<bool IN_ENTRY>
+static Module diamond() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "diamond", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto on_true = data.create_basic_block();
+    const auto on_false = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    auto base = Value::i64(0);
+    if constexpr (IN_ENTRY) {
+        base = data.add(data.arg(0), data.arg(1));
+    }
+
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.arg(0), data.arg(1)), on_true, on_false);
+
+    data.switch_block(on_true);
+    const auto lhs = data.add(data.arg(0), data.arg(1));
+    data.br(end);
+
+    data.switch_block(on_false);
+    const auto rhs = data.add(data.arg(0), data.arg(1));
+    data.br(end);
+
+    data.switch_block(end);
+    const auto merged = data.phi(ty, {lhs, rhs}, {on_true, on_false});
+    const auto after = data.add(data.arg(0), data.arg(1));
+    data.ret(data.add(data.add(merged, after), base));
+    return builder.build();
+}
+
+TEST(GVN, dominating_block) {
+    auto module = diamond<true>();
+    run_passes<GVN>(module);
+
+    const auto fd = module.find_function_data("diamond").value();
+    ASSERT_EQ(count_instructions<Binary>(*fd), 3);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("diamond").value();
+    ASSERT_EQ(fn(1, 2), 9);
+    ASSERT_EQ(fn(5, 2), 21);
+}
+
+TEST(GVN, sibling_blocks_are_kept) {
+    auto module = diamond<false>();
+    run_passes<GVN>(module);
+
+    const auto fd = module.find_function_data("diamond").value();
+    ASSERT_EQ(count_instructions<Binary>(*fd), 5);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("diamond").value();
+    ASSERT_EQ(fn(1, 2), 6);
+}
+
+static Module loads() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "loads", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto ptr = data.alloc(ty);
+    data.store(ptr, data.arg(0));
+    const auto first = data.load(ty, ptr);
+    data.store(ptr, Value::i64(10));
+    const auto second = data.load(ty, ptr);
+    data.ret(data.add(first, second));
+    return builder.build();
+}
+
+TEST(GVN, loads_are_kept) {
+    auto module = loads();
+    run_passes<GVN>(module);
+
+    const auto fd = module.find_function_data("loads").value();
+    ASSERT_EQ(count_instructions<Unary>(*fd), 2);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("loads").value();
+    ASSERT_EQ(fn(5), 15);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
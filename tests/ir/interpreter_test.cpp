@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/interpreter/Interpreter.h"
+#include "helpers/Jit.h"
+
+static std::int64_t external_scale(const std::int64_t x, const double factor) {
+    return static_cast<std::int64_t>(static_cast<double>(x) * factor);
+}
+
+static void id(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.arg(0));
+}
+
+/**
+ * s = 0;
+ * for (i = 0; i < n; i++)
+ *     s += id(i) * a;
+ * return s;
+ */
+static void sum_loop(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "sum_loop", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto s = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto call = data.call(id_prototype, {i});
+    const auto latch = data.create_basic_block();
+    data.br(latch);
+
+    data.switch_block(latch);
+    const auto next_s = data.add(s, data.mul(call, a));
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(s);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, latch);
+    dynamic_cast<Phi*>(s.get<ValueInstruction*>())->add_incoming(next_s, latch);
+}
+
+/**
+ * (a, b) = (0, 1);
+ * while (n-- > 0) (a, b) = (b, a + b);
+ * return a;
+ * The phis read each other on the back edge.
+ */
+static void fib(ModuleBuilder& builder) {
+    const auto ty = UnsignedIntegerType::u64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "fib", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto n = data.phi(ty, {data.arg(0)}, {entry});
+    const auto a = data.phi(ty, {Value::u64(0)}, {entry});
+    const auto b = data.phi(ty, {Value::u64(1)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Gt, n, Value::u64(0)), body, end);
+
+    data.switch_block(body);
+    const auto next_n = data.sub(n, Value::u64(1));
+    const auto next_b = data.add(a, b);
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(a);
+
+    dynamic_cast<Phi*>(n.get<ValueInstruction*>())->add_incoming(next_n, body);
+    dynamic_cast<Phi*>(a.get<ValueInstruction*>())->add_incoming(b, body);
+    dynamic_cast<Phi*>(b.get<ValueInstruction*>())->add_incoming(next_b, body);
+}
+
+static void narrow_arith(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i8();
+    const auto prototype = builder.add_function_prototype(SignedIntegerType::i64(), {ty, ty}, "narrow_arith", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto [quotient, remain] = data.idiv(data.add(data.arg(0), data.arg(1)), Value::i8(3));
+    const auto wide = data.sext(SignedIntegerType::i64(), quotient);
+    data.ret(data.add(data.mul(wide, Value::i64(10)), data.sext(SignedIntegerType::i64(), remain)));
+}
+
+static void fp_select(ModuleBuilder& builder) {
+    const auto ty = FloatingPointType::f32();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "fp_select", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto product = data.mul(data.arg(0), data.arg(1));
+    const auto is_less = data.fcmp(FcmpPredicate::Olt, data.arg(0), data.arg(1));
+    data.ret(data.select(is_less, product, data.neg(data.arg(0))));
+}
+
+/**
+ * counter += step; return counter + table[1];
+ */
+static void globals(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto counter = builder.add_variable("counter", ty, 5L).value();
+    const auto array_type = builder.add_array_type(ty, 2);
+    const auto table = builder.add_constant("table", array_type, Initializer{100L, 200L}).value();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "bump", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto next = data.add(data.load(ty, counter), data.arg(0));
+    data.store(counter, next);
+    data.ret(data.add(next, data.load(ty, data.gep(ty, table, Value::i64(1)))));
+}
+
+static void scaled(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto fp = FloatingPointType::f64();
+    const auto scale_prototype = builder.add_function_prototype(ty, {ty, fp}, "external_scale", FunctionBind::EXTERN);
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "scaled", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.add(data.call(scale_prototype, {data.arg(0), Value::f64(2.5)}), Value::i64(1)));
+}
+
+static Module interpreted_module() {
+    ModuleBuilder builder;
+    id(builder);
+    sum_loop(builder);
+    fib(builder);
+    narrow_arith(builder);
+    fp_select(builder);
+    globals(builder);
+    scaled(builder);
+    return builder.build();
+}
+
+static const std::unordered_map<std::string, std::size_t> EXTERNAL_SYMBOLS{
+    {"external_scale", reinterpret_cast<std::size_t>(&external_scale)},
+};
+
+TEST(Interpreter, loop_with_call) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto sum = interpreter.function_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(0, 3), 0);
+    ASSERT_EQ(sum(10, 3), 135);
+}
+
+TEST(Interpreter, phis_swap_on_back_edge) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto fn = interpreter.function_as<std::uint64_t(std::uint64_t)>("fib").value();
+    ASSERT_EQ(fn(0), 0);
+    ASSERT_EQ(fn(1), 1);
+    ASSERT_EQ(fn(10), 55);
+    ASSERT_EQ(fn(90), 2880067194370816120ULL);
+}
+
+TEST(Interpreter, narrow_integers_wrap) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto fn = interpreter.function_as<std::int64_t(std::int8_t, std::int8_t)>("narrow_arith").value();
+    // 100 + 100 wraps to -56 in i8: -56 / 3 = -18, -56 % 3 = -2.
+    ASSERT_EQ(fn(100, 100), -182);
+    ASSERT_EQ(fn(10, 4), 42);
+}
+
+TEST(Interpreter, floating_point) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto fn = interpreter.function_as<float(float, float)>("fp_select").value();
+    ASSERT_FLOAT_EQ(fn(1.5f, 4.0f), 6.0f);
+    ASSERT_FLOAT_EQ(fn(4.0f, 1.5f), -4.0f);
+}
+
+TEST(Interpreter, globals_keep_state) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto fn = interpreter.function_as<std::int64_t(std::int64_t)>("bump").value();
+    ASSERT_EQ(fn(1), 206);
+    ASSERT_EQ(fn(10), 216);
+}
+
+TEST(Interpreter, native_call) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    const auto fn = interpreter.function_as<std::int64_t(std::int64_t)>("scaled").value();
+    ASSERT_EQ(fn(4), 11);
+}
+
+TEST(Interpreter, calls_jit_compiled_code) {
+    const auto module = interpreted_module();
+    const auto compiled = jit_compile_and_assembly(EXTERNAL_SYMBOLS, module);
+
+    // 'id' and the global 'counter' come from the compiled module, the rest is interpreted.
+    auto symbols = EXTERNAL_SYMBOLS;
+    const auto exports = compiled.exports();
+    symbols.emplace("id", static_cast<std::size_t>(exports.at("id")));
+    symbols.emplace("counter", static_cast<std::size_t>(exports.at("counter")));
+
+    Interpreter interpreter(module, symbols);
+    const auto sum = interpreter.function_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(10, 3), 135);
+
+    const auto bump = interpreter.function_as<std::int64_t(std::int64_t)>("bump").value();
+    ASSERT_EQ(bump(1), 206);
+    const auto compiled_bump = compiled.code_start_as<std::int64_t(std::int64_t)>("bump").value();
+    ASSERT_EQ(compiled_bump(1), 207);
+}
+
+TEST(Interpreter, unknown_function) {
+    const auto module = interpreted_module();
+    Interpreter interpreter(module, EXTERNAL_SYMBOLS);
+    ASSERT_FALSE(interpreter.function_as<void()>("unknown").has_value());
+}
+
+static std::int64_t external_sum7(const std::int64_t a0, const std::int64_t a1, const std::int64_t a2, const std::int64_t a3,
+                                   const std::int64_t a4, const std::int64_t a5, const std::int64_t a6) {
+    return a0 + a1 + a2 + a3 + a4 + a5 + a6;
+}
+
+TEST(InterpreterDeathTest, too_many_native_arguments) {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto callee = builder.add_function_prototype(ty, {ty, ty, ty, ty, ty, ty, ty}, "external_sum7", FunctionBind::EXTERN);
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "sum7", FunctionBind::DEFAULT);
+    {
+        auto data = builder.make_function_builder(prototype).value();
+        const auto a = data.arg(0);
+        data.ret(data.call(callee, {a, a, a, a, a, a, a}));
+    }
+    const auto module = builder.build();
+
+    Interpreter interpreter(module, {{"external_sum7", reinterpret_cast<std::size_t>(&external_sum7)}});
+    const auto fn = interpreter.function_as<std::int64_t(std::int64_t)>("sum7").value();
+    ASSERT_DEATH(fn(1), "Too many integer arguments for a native call of 'external_sum7'");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
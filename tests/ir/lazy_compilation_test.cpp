@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "lir/x64/asm/jit/LazyModule.h"
+#include "mir/mir.h"
+
+static std::int64_t external_neg(const std::int64_t x) {
+    return -x;
+}
+
+static const std::unordered_map<std::string, std::size_t> EXTERNAL_SYMBOLS{
+    {"external_neg", reinterpret_cast<std::size_t>(&external_neg)},
+};
+
+static void id(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.arg(0));
+}
+
+/**
+ * s = 0;
+ * for (i = 0; i < n; i++)
+ *     s += id(i) * a;
+ * return s;
+ */
+static void sum_loop(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "sum_loop", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto s = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto call = data.call(id_prototype, {i});
+    const auto latch = data.create_basic_block();
+    data.br(latch);
+
+    data.switch_block(latch);
+    const auto next_s = data.add(s, data.mul(call, a));
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(s);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, latch);
+    dynamic_cast<Phi*>(s.get<ValueInstruction*>())->add_incoming(next_s, latch);
+}
+
+/**
+ * Two of the integer arguments are passed on the stack.
+ * return a0 * 1 + a1 * 2 + ... + a7 * 8 + (long)(d0 * d1);
+ */
+static void many_args(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto fp = FloatingPointType::f64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty, ty, ty, ty, ty, ty, ty, fp, fp}, "many_args", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    auto acc = data.fp2int(ty, data.mul(data.arg(8), data.arg(9)));
+    for (std::size_t idx{}; idx < 8; idx++) {
+        acc = data.add(acc, data.mul(data.arg(idx), Value::i64(static_cast<std::int64_t>(idx) + 1)));
+    }
+
+    data.ret(acc);
+}
+
+static void neg_twice(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto neg_prototype = builder.add_function_prototype(ty, {ty}, "external_neg", FunctionBind::EXTERN);
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "neg_twice", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto x = data.call(neg_prototype, {data.arg(0)});
+    data.ret(data.add(x, x));
+}
+
+/**
+ * counter += step; return counter;
+ */
+static void bump(ModuleBuilder& builder, const GlobalValue* counter) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "bump", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto next = data.add(data.load(ty, counter), data.arg(0));
+    data.store(counter, next);
+    data.ret(next);
+}
+
+static void read_counter(ModuleBuilder& builder, const GlobalValue* counter) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {}, "read_counter", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.load(ty, counter));
+}
+
+static Module lazy_module() {
+    ModuleBuilder builder;
+    id(builder);
+    sum_loop(builder);
+    many_args(builder);
+    neg_twice(builder);
+    const auto counter = builder.add_variable("counter", SignedIntegerType::i64(), 10L).value();
+    bump(builder, counter);
+    read_counter(builder, counter);
+    return builder.build();
+}
+
+TEST(LazyCompilation, compiles_called_functions_only) {
+    const auto module = lazy_module();
+    const auto lazy = LazyModule::compile(module, EXTERNAL_SYMBOLS);
+    ASSERT_EQ(lazy->compiled_count(), 0);
+    ASSERT_FALSE(lazy->is_compiled("sum_loop"));
+
+    const auto sum = lazy->code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(10, 3), 135);
+    ASSERT_TRUE(lazy->is_compiled("sum_loop"));
+    ASSERT_TRUE(lazy->is_compiled("id"));
+    ASSERT_FALSE(lazy->is_compiled("neg_twice"));
+    ASSERT_FALSE(lazy->is_compiled("unknown"));
+    ASSERT_EQ(lazy->compiled_count(), 2);
+
+    // The patched stubs jump straight to the compiled code.
+    ASSERT_EQ(sum(0, 3), 0);
+    ASSERT_EQ(sum(4, 2), 12);
+    ASSERT_EQ(lazy->compiled_count(), 2);
+}
+
+TEST(LazyCompilation, stub_keeps_arguments) {
+    const auto module = lazy_module();
+    const auto lazy = LazyModule::compile(module, EXTERNAL_SYMBOLS);
+
+    const auto fn = lazy->code_start_as<std::int64_t(std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::int64_t, double, double)>("many_args").value();
+    ASSERT_EQ(fn(1, 2, 3, 4, 5, 6, 7, 8, 2.5, 4.0), 214);
+    ASSERT_EQ(fn(1, 1, 1, 1, 1, 1, 1, 1, 0.5, 0.5), 36);
+
+    const auto neg = lazy->code_start_as<std::int64_t(std::int64_t)>("neg_twice").value();
+    ASSERT_EQ(neg(21), -42);
+}
+
+TEST(LazyCompilation, functions_share_globals) {
+    const auto module = lazy_module();
+    const auto lazy = LazyModule::compile(module, EXTERNAL_SYMBOLS);
+
+    const auto inc = lazy->code_start_as<std::int64_t(std::int64_t)>("bump").value();
+    const auto read = lazy->code_start_as<std::int64_t()>("read_counter").value();
+    ASSERT_EQ(inc(5), 15);
+    ASSERT_EQ(read(), 15);
+    ASSERT_EQ(inc(1), 16);
+    ASSERT_EQ(read(), 16);
+}
+
+TEST(LazyCompilation, concurrent_first_calls) {
+    static constexpr std::size_t THREADS = 8;
+    const auto module = lazy_module();
+    const auto lazy = LazyModule::compile(module, EXTERNAL_SYMBOLS);
+    const auto sum = lazy->code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+
+    std::atomic<bool> start{};
+    std::vector<std::int64_t> results(THREADS);
+    std::vector<std::thread> threads;
+    for (std::size_t idx{}; idx < THREADS; idx++) {
+        threads.emplace_back([&, idx] {
+            while (!start.load(std::memory_order_acquire)) {}
+            results[idx] = sum(10, static_cast<std::int64_t>(idx));
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    for (std::size_t idx{}; idx < THREADS; idx++) {
+        ASSERT_EQ(results[idx], 45 * static_cast<std::int64_t>(idx));
+    }
+    ASSERT_EQ(lazy->compiled_count(), 2);
+}
+
+static constexpr std::size_t STORES = CodeHeap::ARENA_SECTION_SIZE / 8;
+
+/**
+ * Stores distinct 64-bit constants, so the code of the function is larger than a code heap arena.
+ * return id(STORES);
+ */
+static Module huge_function() {
+    ModuleBuilder builder;
+    id(builder);
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {PointerType::ptr()}, "huge", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    for (std::size_t idx{}; idx < STORES; idx++) {
+        data.store(data.arg(0), Value::i64(0x1234'5678'0000'0000L + static_cast<std::int64_t>(idx)));
+    }
+
+    data.ret(data.call(id_prototype, {Value::i64(static_cast<std::int64_t>(STORES))}));
+    return builder.build();
+}
+
+TEST(LazyCompilation, full_arena) {
+    const auto module = huge_function();
+    const auto lazy = LazyModule::compile(module, EXTERNAL_SYMBOLS);
+    const auto huge = lazy->code_start_as<std::int64_t(std::int64_t*)>("huge").value();
+
+    std::int64_t value{};
+    ASSERT_EQ(huge(&value), static_cast<std::int64_t>(STORES));
+    ASSERT_EQ(value, 0x1234'5678'0000'0000L + static_cast<std::int64_t>(STORES - 1));
+    ASSERT_TRUE(lazy->is_compiled("huge"));
+    ASSERT_TRUE(lazy->is_compiled("id"));
+
+    value = 0;
+    ASSERT_EQ(huge(&value), static_cast<std::int64_t>(STORES));
+    ASSERT_EQ(value, 0x1234'5678'0000'0000L + static_cast<std::int64_t>(STORES - 1));
+    ASSERT_EQ(lazy->compiled_count(), 2);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
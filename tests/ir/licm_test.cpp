@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/analysis/Analysis.h"
+#include "mir/transform/LICM.h"
+#include "mir/transform/Mem2Reg.h"
+#include "mir/transform/PassManager.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+struct Blocks final {
+    BasicBlock* outer_cond;
+    BasicBlock* outer_body;
+    BasicBlock* inner_cond;
+    BasicBlock* inner_body;
+    BasicBlock* outer_inc;
+    BasicBlock* end;
+};
+
+/**
+ * for (i = 0; i < n; i++)
+ *     for (j = 0; j < n; j++)
+ *         s += a * 7 + K + i * a;
+ */
+static Module nested(Blocks& blocks) {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "nested", FunctionBind::DEFAULT);
+    const auto constant = builder.add_constant("K", ty, 5).value();
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto s = data.alloc(ty);
+    const auto i = data.alloc(ty);
+    const auto j = data.alloc(ty);
+    blocks = Blocks{
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+        data.create_basic_block(),
+    };
+
+    data.store(s, Value::i64(0));
+    data.store(i, Value::i64(0));
+    data.br(blocks.outer_cond);
+
+    data.switch_block(blocks.outer_cond);
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.load(ty, i), n), blocks.outer_body, blocks.end);
+
+    data.switch_block(blocks.outer_body);
+    data.store(j, Value::i64(0));
+    data.br(blocks.inner_cond);
+
+    data.switch_block(blocks.inner_cond);
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.load(ty, j), n), blocks.inner_body, blocks.outer_inc);
+
+    data.switch_block(blocks.inner_body);
+    const auto x = data.mul(a, Value::i64(7));
+    const auto k = data.load(ty, constant);
+    const auto ia = data.mul(data.load(ty, i), a);
+    const auto t = data.add(data.add(x, k), ia);
+    data.store(s, data.add(data.load(ty, s), t));
+    data.store(j, data.add(data.load(ty, j), Value::i64(1)));
+    data.br(blocks.inner_cond);
+
+    data.switch_block(blocks.outer_inc);
+    data.store(i, data.add(data.load(ty, i), Value::i64(1)));
+    data.br(blocks.outer_cond);
+
+    data.switch_block(blocks.end);
+    data.ret(data.load(ty, s));
+    return builder.build();
+}
+
+TEST(LoopInfo, nested_loops) {
+    Blocks blocks{};
+    auto module = nested(blocks);
+    const auto fd = module.find_function_data("nested").value();
+
+    AnalysisPassManager cache;
+    const auto loops = cache.analyze<LoopInfoEval>(fd);
+    ASSERT_EQ(loops->loops().size(), 2);
+
+    const auto outer = loops->loop_of(blocks.outer_cond);
+    ASSERT_NE(outer, nullptr);
+    ASSERT_EQ(outer->header(), blocks.outer_cond);
+    ASSERT_EQ(outer->preheader(), fd->first());
+    ASSERT_EQ(outer->parent(), nullptr);
+    ASSERT_EQ(outer->blocks().size(), 5);
+    ASSERT_EQ(outer->latches().size(), 1);
+    ASSERT_EQ(outer->latches().front(), blocks.outer_inc);
+    ASSERT_EQ(outer->exits().size(), 1);
+    ASSERT_EQ(outer->exits().front(), blocks.end);
+
+    const auto inner = loops->loop_of(blocks.inner_body);
+    ASSERT_NE(inner, nullptr);
+    ASSERT_EQ(inner->header(), blocks.inner_cond);
+    ASSERT_EQ(inner->preheader(), blocks.outer_body);
+    ASSERT_EQ(inner->parent(), outer);
+    ASSERT_EQ(inner->blocks().size(), 2);
+    ASSERT_EQ(inner->exits().front(), blocks.outer_inc);
+
+    ASSERT_EQ(loops->depth(fd->first()), 0);
+    ASSERT_EQ(loops->depth(blocks.end), 0);
+    ASSERT_EQ(loops->depth(blocks.outer_inc), 1);
+    ASSERT_EQ(loops->depth(blocks.inner_body), 2);
+}
+
+TEST(LICM, hoist_to_outermost_preheader) {
+    Blocks blocks{};
+    auto module = nested(blocks);
+
+    run_passes<Mem2Reg, LICM>(module);
+
+    const auto fd = module.find_function_data("nested").value();
+    // 'a * 7', the load of 'K' and their sum do not depend on any loop.
+    ASSERT_EQ(count_instructions<Binary>(*fd->first()), 2);
+    ASSERT_EQ(count_instructions<Unary>(*fd->first()), 1);
+    // 'i * a' and the sum with it depend only on the outer loop.
+    ASSERT_EQ(count_instructions<Binary>(*blocks.outer_body), 2);
+    ASSERT_EQ(count_instructions<Binary>(*blocks.inner_body), 2);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("nested").value();
+    ASSERT_EQ(fn(3, 2), 189);
+    ASSERT_EQ(fn(0, 2), 0);
+}
+
+static std::int64_t inc(const std::int64_t a) {
+    return a + 1;
+}
+
+/**
+ * r = inc(a);
+ * for (i = 0; i < n; i++)
+ *     s += r * 2 + a * 3;
+ */
+static Module call_before_loop() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "call_before_loop", FunctionBind::DEFAULT);
+    const auto inc_prototype = builder.add_function_prototype(ty, {ty}, "inc", FunctionBind::EXTERN);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto s = data.alloc(ty);
+    const auto i = data.alloc(ty);
+    data.store(s, Value::i64(0));
+    data.store(i, Value::i64(0));
+    // The continuation of the call is the loop header, so the call ends the preheader.
+    const auto r = data.call(inc_prototype, {a});
+    const auto header = const_cast<BasicBlock*>(dynamic_cast<const Call*>(r.get<ValueInstruction*>())->cont());
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.load(ty, i), n), body, end);
+
+    data.switch_block(body);
+    const auto t = data.add(data.mul(r, Value::i64(2)), data.mul(a, Value::i64(3)));
+    data.store(s, data.add(data.load(ty, s), t));
+    data.store(i, data.add(data.load(ty, i), Value::i64(1)));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(data.load(ty, s));
+    return builder.build();
+}
+
+TEST(LICM, keep_users_of_preheader_call) {
+    auto module = call_before_loop();
+
+    run_passes<Mem2Reg, LICM>(module);
+
+    const auto fd = module.find_function_data("call_before_loop").value();
+    AnalysisPassManager cache;
+    const auto loops = cache.analyze<LoopInfoEval>(fd);
+    ASSERT_EQ(loops->loops().size(), 1);
+    ASSERT_EQ(loops->loops().front()->preheader(), fd->first());
+    // Only 'a * 3' is hoisted, 'r * 2' must stay after the call.
+    ASSERT_EQ(count_instructions<Binary>(*fd->first()), 1);
+
+    const std::unordered_map<std::string, std::size_t> external_symbols{
+        {"inc", reinterpret_cast<std::size_t>(&inc)},
+    };
+
+    const auto buffer = jit_compile_and_assembly(external_symbols, module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("call_before_loop").value();
+    ASSERT_EQ(fn(3, 2), 36);
+    ASSERT_EQ(fn(0, 2), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
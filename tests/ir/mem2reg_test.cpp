@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/instruction/Phi.h"
+#include "mir/transform/Mem2Reg.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+template<typename Fn>
+static Module fib(const IntegerType* ty, Fn&& fn) {
+    ModuleBuilder builder;
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "fib", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    auto n = data.arg(0);
+    auto ret_addr = data.alloc(ty);
+    auto n_addr = data.alloc(ty);
+    auto a = data.alloc(ty);
+    auto b = data.alloc(ty);
+    auto i = data.alloc(ty);
+
+    data.store(n_addr, n);
+    data.store(a, fn(0));
+    data.store(b, fn(1));
+
+    auto v0 = data.load(ty, n_addr);
+    auto cmp0 = data.icmp(IcmpPredicate::Eq, v0, fn(0));
+
+    auto if_then = data.create_basic_block();
+    auto if_end = data.create_basic_block();
+    auto for_cond = data.create_basic_block();
+    auto for_body = data.create_basic_block();
+    auto for_end = data.create_basic_block();
+    auto ret = data.create_basic_block();
+    data.br_cond(cmp0, if_then, if_end);
+
+    data.switch_block(if_then);
+    data.store(ret_addr, data.load(ty, a));
+    data.br(ret);
+
+    data.switch_block(if_end);
+    data.store(i, fn(2));
+    data.br(for_cond);
+
+    data.switch_block(for_cond);
+    auto cmp = data.icmp(IcmpPredicate::Le, data.load(ty, i), data.load(ty, n_addr));
+    data.br_cond(cmp, for_body, for_end);
+
+    data.switch_block(for_body);
+    auto add = data.add(data.load(ty, a), data.load(ty, b));
+    data.store(a, data.load(ty, b));
+    data.store(b, add);
+    data.store(i, data.add(data.load(ty, i), fn(1)));
+    data.br(for_cond);
+
+    data.switch_block(for_end);
+    data.store(ret_addr, data.load(ty, b));
+    data.br(ret);
+
+    data.switch_block(ret);
+    data.ret(data.load(ty, ret_addr));
+    return builder.build();
+}
+
+static Module escaped_alloc() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "escaped", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    auto x = data.alloc(ty);
+    auto p = data.alloc(PointerType::ptr());
+    data.store(x, data.arg(0));
+    data.store(p, x);
+    auto ptr = data.load(PointerType::ptr(), p);
+    data.ret(data.load(ty, ptr));
+    return builder.build();
+}
+
+static void mem2reg(Module& module, const std::string& name) {
+    const auto fd = module.find_function_data(name).value();
+    AnalysisPassManager cache;
+    auto pass = Mem2Reg::create(&cache, fd);
+    pass.run();
+}
+
+template<std::integral T>
+static T fib_value(T n) {
+    T n0 = 0;
+    T n1 = 1;
+    if (n == 0) return n0;
+    for (T i = 2; i <= n; ++i) {
+        const T n2 = n0 + n1;
+        n0 = n1;
+        n1 = n2;
+    }
+    return n1;
+}
+
+TEST(Mem2Reg, fib_promoted) {
+    auto module = fib(SignedIntegerType::i32(), Value::i32);
+    mem2reg(module, "fib");
+
+    const auto fd = module.find_function_data("fib").value();
+    ASSERT_EQ(count_instructions<Alloc>(*fd), 0);
+    ASSERT_EQ(count_instructions<Unary>(*fd), 0);
+    ASSERT_EQ(count_instructions<Store>(*fd), 0);
+    ASSERT_GT(count_instructions<Phi>(*fd), 0);
+}
+
+TEST(Mem2Reg, fib_i32) {
+    auto module = fib(SignedIntegerType::i32(), Value::i32);
+    mem2reg(module, "fib");
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int32_t(std::int32_t)>("fib").value();
+    for (std::int32_t i = 0; i < 30; ++i) {
+        ASSERT_EQ(fn(i), fib_value(i)) << "Failed for value: " << i;
+    }
+}
+
+TEST(Mem2Reg, fib_u64) {
+    auto module = fib(UnsignedIntegerType::u64(), Value::u64);
+    mem2reg(module, "fib");
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::uint64_t(std::uint64_t)>("fib").value();
+    for (std::uint64_t i = 0; i < 60; ++i) {
+        ASSERT_EQ(fn(i), fib_value(i)) << "Failed for value: " << i;
+    }
+}
+
+TEST(Mem2Reg, escaped_alloc) {
+    auto module = escaped_alloc();
+    mem2reg(module, "escaped");
+
+    const auto fd = module.find_function_data("escaped").value();
+    ASSERT_EQ(count_instructions<Alloc>(*fd), 2);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("escaped").value();
+    ASSERT_EQ(fn(42), 42);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include "helpers/Jit.h"
+#include "mir/mir.h"
+
+static Module mul(const IntegerType* ty) {
+    ModuleBuilder builder;
+    {
+        const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "mul", FunctionBind::DEFAULT);
+        const auto data = builder.make_function_builder(prototype).value();
+        const auto a = data.arg(0);
+        const auto b = data.arg(1);
+        data.ret(data.mul(a, b));
+    }
+    return builder.build();
+}
+
+TEST(Mul, basic_i64) {
+    const auto buffer = jit_compile_and_assembly(mul(SignedIntegerType::i64()));
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("mul").value();
+    ASSERT_EQ(fn(6, 7), 42);
+    ASSERT_EQ(fn(-6, 7), -42);
+    ASSERT_EQ(fn(1L << 40, 3), 3L << 40);
+}
+
+TEST(Mul, basic_i32) {
+    const auto buffer = jit_compile_and_assembly(mul(SignedIntegerType::i32()));
+    const auto fn = buffer.code_start_as<std::int32_t(std::int32_t, std::int32_t)>("mul").value();
+    ASSERT_EQ(fn(6, 7), 42);
+    ASSERT_EQ(fn(-6, 7), -42);
+}
+
+TEST(Mul, basic_u16) {
+    const auto buffer = jit_compile_and_assembly(mul(UnsignedIntegerType::u16()));
+    const auto fn = buffer.code_start_as<std::uint16_t(std::uint16_t, std::uint16_t)>("mul").value();
+    ASSERT_EQ(fn(300, 300), static_cast<std::uint16_t>(300 * 300));
+}
+
+TEST(Mul, basic_i8) {
+    const auto buffer = jit_compile_and_assembly(mul(SignedIntegerType::i8()));
+    const auto fn = buffer.code_start_as<std::int8_t(std::int8_t, std::int8_t)>("mul").value();
+    ASSERT_EQ(fn(5, 7), 35);
+    ASSERT_EQ(fn(16, 16), 0);
+    ASSERT_EQ(fn(-3, 5), -15);
+}
+
+static Module mul_cst(const IntegerType* ty, const Value& cst) {
+    ModuleBuilder builder;
+    {
+        const auto prototype = builder.add_function_prototype(ty, {ty}, "mul_cst", FunctionBind::DEFAULT);
+        const auto data = builder.make_function_builder(prototype).value();
+        const auto a = data.arg(0);
+        data.ret(data.mul(a, cst));
+    }
+    return builder.build();
+}
+
+TEST(Mul, by_constant_i64) {
+    for (const std::int64_t cst: {0L, 1L, -1L, 8L, 3L, 5L, 9L, 10L, 1000L, -7L}) {
+        const auto buffer = jit_compile_and_assembly(mul_cst(SignedIntegerType::i64(), Value::i64(cst)));
+        const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("mul_cst").value();
+        for (const std::int64_t v: {0L, 1L, -3L, 12345L}) {
+            ASSERT_EQ(fn(v), v * cst) << "cst=" << cst << " v=" << v;
+        }
+    }
+}
+
+TEST(Mul, by_constant_i32) {
+    for (const std::int32_t cst: {0, 1, -1, 16, 3, 5, 9, 10, 1000}) {
+        const auto buffer = jit_compile_and_assembly(mul_cst(SignedIntegerType::i32(), Value::i32(cst)));
+        const auto fn = buffer.code_start_as<std::int32_t(std::int32_t)>("mul_cst").value();
+        for (const std::int32_t v: {0, 1, -3, 12345}) {
+            ASSERT_EQ(fn(v), v * cst) << "cst=" << cst << " v=" << v;
+        }
+    }
+}
+
+TEST(Mul, by_constant_imm64) {
+    for (const std::uint64_t cst: {0x1'0000'0001UL, 0xFFFF'FFFF'0000'0003UL, 0x8000'0000UL}) {
+        const auto buffer = jit_compile_and_assembly(mul_cst(UnsignedIntegerType::u64(), Value::u64(cst)));
+        const auto fn = buffer.code_start_as<std::uint64_t(std::uint64_t)>("mul_cst").value();
+        for (const std::uint64_t v: {0UL, 1UL, 3UL, 0x1234'5678'9ABCUL}) {
+            ASSERT_EQ(fn(v), v * cst) << "cst=" << cst << " v=" << v;
+        }
+    }
+}
+
+template<typename Fn>
+static Module bitwise(const IntegerType* ty, Fn&& fn) {
+    ModuleBuilder builder;
+    {
+        const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "bitwise", FunctionBind::DEFAULT);
+        const auto data = builder.make_function_builder(prototype).value();
+        const auto a = data.arg(0);
+        const auto b = data.arg(1);
+        data.ret(fn(data, a, b));
+    }
+    return builder.build();
+}
+
+TEST(Bitwise, and_i64) {
+    const auto module = bitwise(SignedIntegerType::i64(), [](const FunctionBuilder& data, const Value& a, const Value& b) {
+        return data.aand(a, b);
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("bitwise").value();
+    ASSERT_EQ(fn(0b1100, 0b1010), 0b1000);
+    ASSERT_EQ(fn(-1, 0x1234), 0x1234);
+}
+
+TEST(Bitwise, or_i32) {
+    const auto module = bitwise(SignedIntegerType::i32(), [](const FunctionBuilder& data, const Value& a, const Value& b) {
+        return data.oor(a, b);
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int32_t(std::int32_t, std::int32_t)>("bitwise").value();
+    ASSERT_EQ(fn(0b1100, 0b1010), 0b1110);
+}
+
+TEST(Bitwise, and_imm64) {
+    const auto module = bitwise(UnsignedIntegerType::u64(), [](const FunctionBuilder& data, const Value& a, const Value&) {
+        return data.aand(a, Value::u64(0xFFFF'0000'0000'FFFFUL));
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::uint64_t(std::uint64_t, std::uint64_t)>("bitwise").value();
+    ASSERT_EQ(fn(0x1234'5678'9ABC'DEF0UL, 0), 0x1234'0000'0000'DEF0UL);
+}
+
+TEST(Bitwise, or_imm) {
+    const auto module = bitwise(UnsignedIntegerType::u32(), [](const FunctionBuilder& data, const Value& a, const Value&) {
+        return data.oor(a, Value::u32(0xF0));
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::uint32_t(std::uint32_t, std::uint32_t)>("bitwise").value();
+    ASSERT_EQ(fn(0x0F, 0), 0xFFU);
+}
+
+template<typename Fn>
+static Module unary(const IntegerType* ty, Fn&& fn) {
+    ModuleBuilder builder;
+    {
+        const auto prototype = builder.add_function_prototype(ty, {ty}, "unary", FunctionBind::DEFAULT);
+        const auto data = builder.make_function_builder(prototype).value();
+        data.ret(fn(data, data.arg(0)));
+    }
+    return builder.build();
+}
+
+TEST(Unary, neg_i64) {
+    const auto module = unary(SignedIntegerType::i64(), [](const FunctionBuilder& data, const Value& a) {
+        return data.neg(a);
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("unary").value();
+    ASSERT_EQ(fn(42), -42);
+    ASSERT_EQ(fn(-42), 42);
+}
+
+TEST(Unary, not_u8) {
+    const auto module = unary(UnsignedIntegerType::u8(), [](const FunctionBuilder& data, const Value& a) {
+        return data.nnot(a);
+    });
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::uint8_t(std::uint8_t)>("unary").value();
+    ASSERT_EQ(fn(0x0F), 0xF0);
+}
+
+static void store_twice(std::int64_t* out, const std::int64_t value) {
+    *out = value * 2;
+}
+
+static Module indirect_call() {
+    ModuleBuilder builder;
+    {
+        const auto prototype = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), PointerType::ptr(), SignedIntegerType::i64()}, "indirect_call", FunctionBind::DEFAULT);
+        auto data = builder.make_function_builder(prototype).value();
+        const auto callee = builder.add_function_prototype(VoidType::type(), {PointerType::ptr(), SignedIntegerType::i64()}, "callee", FunctionBind::EXTERN);
+        data.ivcall(callee, data.arg(0), {data.arg(1), data.arg(2)});
+        data.ret();
+    }
+    return builder.build();
+}
+
+TEST(IndirectCall, void_callee) {
+    const auto buffer = jit_compile_and_assembly(indirect_call());
+    const auto fn = buffer.code_start_as<void(void(*)(std::int64_t*, std::int64_t), std::int64_t*, std::int64_t)>("indirect_call").value();
+    std::int64_t out{};
+    fn(store_twice, &out, 21);
+    ASSERT_EQ(out, 42);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #include <ranges>
 #include <gtest/gtest.h>
 
+#include "utility/Arena.h"
 #include "utility/OrderedSet.h"
 
 template<typename T>
@@ -11,11 +12,12 @@ struct Elem {
 };
 
 template<typename T>
-using create_fn = std::function<std::unique_ptr<Elem<T>>(std::size_t)>;
+using create_fn = std::function<Elem<T>*(std::size_t)>;
 
+static Arena arena;
 
-std::unique_ptr<Elem<int>> create(int value) {
-    return std::make_unique<Elem<int>>(value);
+Elem<int>* create(int value) {
+    return arena.make<Elem<int>>(value);
 }
 
 TEST(OrderedSet, test1) {
@@ -49,6 +51,51 @@ TEST(OrderedSet, iterator2) {
     ASSERT_EQ(it->value, 3);
 }
 
+TEST(OrderedSet, insert_before) {
+    OrderedSet<Elem<int>> set;
+    set.push_back(create(3));
+    const auto idx = set.push_back(create(5));
+    const auto inserted = set.insert_before(idx, create(4));
+
+    ASSERT_EQ(set.at(inserted).value, 4);
+    ASSERT_EQ(set.at(idx).value, 5);
+    ASSERT_EQ(set.back()->value, 5);
+
+    std::vector<int> values;
+    for (auto& elem: set) {
+        values.push_back(elem.value);
+    }
+    ASSERT_EQ(values, (std::vector{3, 4, 5}));
+}
+
+TEST(OrderedSet, remove_and_reuse) {
+    OrderedSet<Elem<int>> set;
+    const auto first = set.push_back(create(3));
+    set.push_back(create(4));
+    set.push_back(create(5));
+
+    const auto removed = set.remove(first);
+    ASSERT_EQ(removed->value, 3);
+
+    const auto reused = set.push_back(create(6));
+    ASSERT_EQ(reused, first);
+    ASSERT_EQ(set.at(reused).value, 6);
+    ASSERT_EQ(set.back()->value, 6);
+    ASSERT_EQ(set.size(), 3);
+}
+
+TEST(OrderedSet, iterator_survives_growth) {
+    OrderedSet<Elem<int>> set;
+    set.push_back(create(3));
+    const auto it = set.begin();
+    for (int i = 0; i < 100; ++i) {
+        set.push_back(create(i));
+    }
+
+    ASSERT_EQ(it->value, 3);
+    ASSERT_EQ(set.size(), 101);
+    ASSERT_EQ((--set.end())->value, 99);
+}
 
 /*
 TEST(OrderedSet, iterator3) {
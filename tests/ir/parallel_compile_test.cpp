@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "asm/x64/AssembledModule.h"
+#include "helpers/Jit.h"
+#include "lir/x64/asm/jit/JitComplation.h"
+#include "mir/mir.h"
+
+static constexpr std::size_t FUNCTIONS = 16;
+
+static Module create_add_chain() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    for (std::size_t i = 0; i < FUNCTIONS; ++i) {
+        const auto prototype = builder.add_function_prototype(ty, {ty}, std::format("add_{}", i), FunctionBind::DEFAULT);
+        auto data = builder.make_function_builder(prototype).value();
+        auto res = data.add(data.arg(0), Value::i64(static_cast<std::int64_t>(i)));
+        if (i != 0) {
+            const auto callee = builder.add_function_prototype(ty, {ty}, std::format("add_{}", i - 1), FunctionBind::DEFAULT);
+            res = data.call(callee, {res});
+        }
+
+        data.ret(res);
+    }
+
+    return builder.build();
+}
+
+TEST(ParallelCompile, same_output) {
+    const auto module = create_add_chain();
+    const auto sequential_module = jit_compile(module, false, 1);
+    const auto parallel_module = jit_compile(module, false, 8);
+    const auto sequential = aasm::AssembledModule::assemble(sequential_module);
+    const auto parallel = aasm::AssembledModule::assemble(parallel_module);
+
+    const auto& seq_text = sequential.text();
+    const auto& par_text = parallel.text();
+    ASSERT_EQ(seq_text.chunks().size(), FUNCTIONS);
+    ASSERT_EQ(seq_text.chunks().size(), par_text.chunks().size());
+    for (std::size_t i = 0; i < FUNCTIONS; ++i) {
+        // Both sections are sorted by name, so the chunks describe the same function.
+        const auto& seq_chunk = seq_text.chunks()[i];
+        const auto& par_chunk = par_text.chunks()[i];
+        ASSERT_EQ(seq_chunk.symbol->name(), par_chunk.symbol->name());
+        ASSERT_TRUE(std::ranges::equal(seq_text.bytes(seq_chunk), par_text.bytes(par_chunk))) << seq_chunk.symbol->name();
+    }
+}
+
+TEST(ParallelCompile, execute) {
+    const auto module = create_add_chain();
+    auto code = jit_compile_and_assembly(module);
+    const auto fn = code.code_start_as<std::int64_t(std::int64_t)>(std::format("add_{}", FUNCTIONS - 1)).value();
+    ASSERT_EQ(fn(1), 1 + static_cast<std::int64_t>(FUNCTIONS * (FUNCTIONS - 1) / 2));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/instruction/Alloc.h"
+#include "mir/transform/Mem2Reg.h"
+#include "mir/transform/PassManager.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+static Module sum(const std::string& name) {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, name, FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    auto acc = data.alloc(ty);
+    auto i = data.alloc(ty);
+    data.store(acc, Value::i64(0));
+    data.store(i, Value::i64(0));
+
+    auto cond = data.create_basic_block();
+    auto body = data.create_basic_block();
+    auto end = data.create_basic_block();
+    data.br(cond);
+
+    data.switch_block(cond);
+    auto cmp = data.icmp(IcmpPredicate::Lt, data.load(ty, i), data.arg(0));
+    data.br_cond(cmp, body, end);
+
+    data.switch_block(body);
+    data.store(acc, data.add(data.load(ty, acc), data.load(ty, i)));
+    data.store(i, data.add(data.load(ty, i), Value::i64(1)));
+    data.br(cond);
+
+    data.switch_block(end);
+    data.ret(data.load(ty, acc));
+    return builder.build();
+}
+
+/** Pass which pretends to rewrite the control flow graph. */
+class ClobberCfg final {
+public:
+    PreservedAnalyses run() {
+        s_runs += 1;
+        return PreservedAnalyses::none();
+    }
+
+    static ClobberCfg create(AnalysisPassManager*, FunctionData*) {
+        return {};
+    }
+
+    static inline std::size_t s_runs{};
+};
+
+/** Module pass which keeps every analysis valid. */
+class NoopModulePass final {
+public:
+    PreservedAnalyses run() {
+        s_runs += 1;
+        return PreservedAnalyses::all();
+    }
+
+    static NoopModulePass create(Module&) {
+        return {};
+    }
+
+    static inline std::size_t s_runs{};
+};
+
+static_assert(TransformPass<Mem2Reg, FunctionData>);
+static_assert(TransformPass<ClobberCfg, FunctionData>);
+static_assert(ModulePass<NoopModulePass>);
+
+TEST(PassManager, analysis_is_cached) {
+    auto module = sum("sum");
+    const auto fd = module.find_function_data("sum").value();
+
+    AnalysisPassManager cache;
+    const auto dom_tree = cache.analyze<DominatorTreeEval>(fd);
+    ASSERT_EQ(cache.analyze<DominatorTreeEval>(fd), dom_tree);
+    ASSERT_TRUE(cache.is_cached<DominatorTreeEval>());
+    ASSERT_TRUE(cache.is_cached<PostOrderTraverse>());
+}
+
+TEST(PassManager, invalidation_drops_dependents) {
+    auto module = sum("sum");
+    const auto fd = module.find_function_data("sum").value();
+
+    AnalysisPassManager cache;
+    cache.analyze<DominanceFrontierEval>(fd);
+    cache.analyze<BFSOrderTraverse>(fd);
+    ASSERT_TRUE(cache.is_cached<DominatorTreeEval>());
+
+    // The frontier is built from the dominator tree, which is built from the postorder.
+    cache.invalidate<PostOrderTraverse>();
+    ASSERT_FALSE(cache.is_cached<PostOrderTraverse>());
+    ASSERT_FALSE(cache.is_cached<DominatorTreeEval>());
+    ASSERT_FALSE(cache.is_cached<DominanceFrontierEval>());
+    ASSERT_TRUE(cache.is_cached<PreorderTraverse>());
+    ASSERT_TRUE(cache.is_cached<BFSOrderTraverse>());
+
+    cache.analyze<DominanceFrontierEval>(fd);
+    ASSERT_TRUE(cache.is_cached<DominatorTreeEval>());
+    cache.invalidate_all();
+    ASSERT_FALSE(cache.is_cached<PreorderTraverse>());
+    ASSERT_FALSE(cache.is_cached<DominanceFrontierEval>());
+}
+
+TEST(PassManager, pipeline_keeps_preserved_analyses) {
+    auto module = sum("sum");
+    const auto fd = module.find_function_data("sum").value();
+
+    AnalysisPassManager cache;
+    FunctionPassPipeline pipeline;
+    pipeline.add<Mem2Reg>();
+
+    const auto preserved = pipeline.run(cache, fd);
+    ASSERT_TRUE(preserved.is_preserved(AnalysisType::DominatorTree));
+    ASSERT_FALSE(preserved.is_preserved(AnalysisType::LivenessAnalysis));
+    ASSERT_TRUE(cache.is_cached<DominatorTreeEval>());
+    ASSERT_TRUE(cache.is_cached<DominanceFrontierEval>());
+    ASSERT_EQ(count_instructions<Alloc>(*fd), 0);
+
+    const auto before = ClobberCfg::s_runs;
+    pipeline.add<ClobberCfg>();
+    pipeline.run(cache, fd);
+    ASSERT_EQ(ClobberCfg::s_runs, before + 1);
+    ASSERT_FALSE(cache.is_cached<DominatorTreeEval>());
+    ASSERT_FALSE(cache.is_cached<PreorderTraverse>());
+}
+
+TEST(PassManager, module_pipeline) {
+    auto module = sum("sum");
+    ModulePassManager manager(2);
+    manager.add<Mem2Reg>()
+        .add_module_pass<NoopModulePass>()
+        .add<ClobberCfg>();
+
+    const auto module_runs = NoopModulePass::s_runs;
+    manager.run(module);
+    ASSERT_EQ(NoopModulePass::s_runs, module_runs + 1);
+    ASSERT_EQ(count_instructions<Alloc>(*module.find_function_data("sum").value()), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("sum").value();
+    for (std::int64_t n = 0; n < 10; ++n) {
+        ASSERT_EQ(fn(n), n * (n - 1) / 2) << "Failed for value: " << n;
+    }
+}
+
+TEST(PassManager, standard_pipeline) {
+    auto module = sum("sum");
+    ModulePassManager::standard().run(module);
+    ASSERT_EQ(count_instructions<Alloc>(*module.find_function_data("sum").value()), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("sum").value();
+    ASSERT_EQ(fn(5), 10);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <unistd.h>
+
+#include "lir/x64/asm/jit/PerfListener.h"
+#include "helpers/Jit.h"
+#include "mir/mir.h"
+
+static Module twice_module() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "twice", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.add(data.arg(0), data.arg(0)));
+    return builder.build();
+}
+
+static std::string read_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+/**
+ * Fresh output directory for one test, the shared listener is disabled after it.
+ */
+class PerfListenerTest: public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        m_directory = std::filesystem::temp_directory_path() / std::format("polymorphine_perf_{}_{}", getpid(), test_name);
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override {
+        PerfListener::shared().disable();
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(PerfListenerTest, disabled_by_default) {
+    ASSERT_FALSE(PerfListener::shared().enabled());
+    const auto module = jit_compile_and_assembly(twice_module());
+    ASSERT_FALSE(std::filesystem::exists(m_directory / std::format("perf-{}.map", getpid())));
+}
+
+TEST_F(PerfListenerTest, writes_perf_map) {
+    ASSERT_TRUE(PerfListener::shared().enable({.directory = m_directory}));
+    const auto module = jit_compile_and_assembly(twice_module());
+    const auto twice = module.code_start_as<std::int64_t(std::int64_t)>("twice").value();
+    ASSERT_EQ(twice(21), 42);
+
+    const auto address = module.exports().at("twice");
+    const auto map = read_file(m_directory / std::format("perf-{}.map", getpid()));
+    ASSERT_NE(map.find(std::format("{:x} ", address)), std::string::npos) << map;
+    ASSERT_NE(map.find(" twice\n"), std::string::npos) << map;
+    ASSERT_FALSE(std::filesystem::exists(m_directory / std::format("jit-{}.dump", getpid())));
+}
+
+TEST_F(PerfListenerTest, truncates_stale_perf_map) {
+    const auto path = m_directory / std::format("perf-{}.map", getpid());
+    std::ofstream(path) << "1000 10 stale\n";
+
+    ASSERT_TRUE(PerfListener::shared().enable({.directory = m_directory}));
+    const auto module = jit_compile_and_assembly(twice_module());
+    const auto map = read_file(path);
+    ASSERT_EQ(map.find("stale"), std::string::npos) << map;
+    ASSERT_NE(map.find(" twice\n"), std::string::npos) << map;
+}
+
+TEST_F(PerfListenerTest, writes_jitdump) {
+    ASSERT_TRUE(PerfListener::shared().enable({.perf_map = false, .jitdump = true, .directory = m_directory}));
+    const auto module = jit_compile_and_assembly(twice_module());
+    PerfListener::shared().disable();
+
+    const auto dump = read_file(m_directory / std::format("jit-{}.dump", getpid()));
+    ASSERT_GE(dump.size(), 40);
+    ASSERT_EQ(dump.substr(0, 4), std::string("DTiJ", 4));
+
+    // The code load record carries the name and the code bytes.
+    const auto name = dump.find(std::string("twice\0", 6));
+    ASSERT_NE(name, std::string::npos);
+    const auto address = module.exports().at("twice");
+    const auto code = reinterpret_cast<const char*>(address);
+    ASSERT_EQ(dump.compare(name + 6, 4, code, 4), 0);
+    ASSERT_FALSE(std::filesystem::exists(m_directory / std::format("perf-{}.map", getpid())));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <limits>
+
+#include "mir/mir.h"
+#include "mir/transform/ConstantFolding.h"
+#include "mir/transform/Mem2Reg.h"
+#include "mir/transform/PassManager.h"
+#include "mir/transform/SCCP.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+TEST(ConstantFolding, integers_wrap_to_type) {
+    ASSERT_EQ(fold_binary(BinaryOp::Add, Value::i8(127), Value::i8(1)), Value::i8(-128));
+    ASSERT_EQ(fold_binary(BinaryOp::Add, Value::u8(255), Value::u8(1)), Value::u8(0));
+    ASSERT_EQ(fold_binary(BinaryOp::Subtract, Value::u64(0), Value::u64(1)), Value::u64(UINT64_MAX));
+    ASSERT_EQ(fold_binary(BinaryOp::Multiply, Value::i32(65536), Value::i32(65536)), Value::i32(0));
+    ASSERT_EQ(fold_binary(BinaryOp::BitwiseXor, Value::u16(0xFF00), Value::u16(0x0FF0)), Value::u16(0xF0F0));
+}
+
+TEST(ConstantFolding, shifts) {
+    ASSERT_EQ(fold_binary(BinaryOp::ShiftRight, Value::i32(-8), Value::i32(1)), Value::i32(-4));
+    ASSERT_EQ(fold_binary(BinaryOp::ShiftRight, Value::u32(0x80000000), Value::u32(31)), Value::u32(1));
+    ASSERT_EQ(fold_binary(BinaryOp::ShiftLeft, Value::i8(1), Value::i8(7)), Value::i8(-128));
+    ASSERT_FALSE(fold_binary(BinaryOp::ShiftLeft, Value::i32(1), Value::i32(32)).has_value());
+    ASSERT_FALSE(fold_binary(BinaryOp::ShiftRight, Value::i32(1), Value::i32(-1)).has_value());
+}
+
+TEST(ConstantFolding, casts) {
+    ASSERT_EQ(fold_unary(UnaryOp::SignExtend, SignedIntegerType::i64(), Value::i8(-1)), Value::i64(-1));
+    ASSERT_EQ(fold_unary(UnaryOp::ZeroExtend, SignedIntegerType::i32(), Value::i8(-1)), Value::i32(255));
+    ASSERT_EQ(fold_unary(UnaryOp::Trunk, UnsignedIntegerType::u8(), Value::i64(0x1234)), Value::u8(0x34));
+    ASSERT_EQ(fold_unary(UnaryOp::Float2Int, SignedIntegerType::i32(), Value::f64(-2.7)), Value::i32(-2));
+    ASSERT_FALSE(fold_unary(UnaryOp::Float2Int, SignedIntegerType::i32(), Value::f64(1e30)).has_value());
+    ASSERT_FALSE(fold_unary(UnaryOp::Float2Int, UnsignedIntegerType::u8(), Value::f64(-1.0)).has_value());
+    ASSERT_EQ(fold_unary(UnaryOp::Int2Float, FloatingPointType::f64(), Value::u64(UINT64_MAX)), Value::f64(18446744073709551615.0));
+    ASSERT_EQ(fold_unary(UnaryOp::LogicalNot, SignedIntegerType::i32(), Value::i32(0)), Value::i32(-1));
+    ASSERT_FALSE(fold_unary(UnaryOp::Load, SignedIntegerType::i32(), Value::i32(0)).has_value());
+}
+
+TEST(ConstantFolding, compares) {
+    ASSERT_EQ(fold_icmp(IcmpPredicate::Gt, Value::u8(255), Value::u8(1)), true);
+    ASSERT_EQ(fold_icmp(IcmpPredicate::Lt, Value::i8(-1), Value::i8(1)), true);
+    ASSERT_EQ(fold_icmp(IcmpPredicate::Lt, Value::u64(UINT64_MAX), Value::u64(1)), false);
+
+    const auto nan = Value::f64(std::numeric_limits<double>::quiet_NaN());
+    ASSERT_EQ(fold_fcmp(FcmpPredicate::Olt, nan, Value::f64(1.0)), false);
+    ASSERT_EQ(fold_fcmp(FcmpPredicate::Ult, nan, Value::f64(1.0)), true);
+    ASSERT_EQ(fold_fcmp(FcmpPredicate::Oge, Value::f64(2.0), Value::f64(1.0)), true);
+}
+
+TEST(ConstantFolding, floats_keep_precision) {
+    ASSERT_EQ(fold_binary(BinaryOp::Add, Value::f32(0.1f), Value::f32(0.2f)), Value::f32(0.1f + 0.2f));
+    ASSERT_EQ(fold_binary(BinaryOp::Divide, Value::f64(1.0), Value::f64(4.0)), Value::f64(0.25));
+}
+
+static Module arithmetic() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i32();
+    const auto prototype = builder.add_function_prototype(ty, {}, "arithmetic", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto x = data.add(Value::i32(40), Value::i32(2));
+    const auto y = data.mul(x, Value::i32(3));
+    const auto z = data.sub(y, Value::i32(26));
+    data.ret(data.shl(z, Value::i32(1)));
+    return builder.build();
+}
+
+TEST(SCCP, fold_arithmetic) {
+    auto module = arithmetic();
+    run_passes<Mem2Reg, SCCP>(module);
+
+    const auto fd = module.find_function_data("arithmetic").value();
+    ASSERT_EQ(count_instructions<Instruction>(*fd), 1);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int32_t()>("arithmetic").value();
+    ASSERT_EQ(fn(), 200);
+}
+
+static Module constant_branch() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "constant_branch", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto on_true = data.create_basic_block();
+    const auto on_false = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    const auto cond = data.icmp(IcmpPredicate::Gt, Value::i64(10), Value::i64(5));
+    data.br_cond(cond, on_true, on_false);
+
+    data.switch_block(on_true);
+    const auto inc = data.add(data.arg(0), Value::i64(1));
+    data.br(end);
+
+    data.switch_block(on_false);
+    const auto dec = data.sub(data.arg(0), Value::i64(1));
+    data.br(end);
+
+    data.switch_block(end);
+    data.ret(data.phi(ty, {inc, dec}, {on_true, on_false}));
+    return builder.build();
+}
+
+TEST(SCCP, fold_branch) {
+    auto module = constant_branch();
+    run_passes<Mem2Reg, SCCP>(module);
+
+    const auto fd = module.find_function_data("constant_branch").value();
+    ASSERT_EQ(fd->size(), 3);
+    ASSERT_EQ(count_instructions<IcmpInstruction>(*fd), 0);
+    ASSERT_EQ(count_instructions<CondBranch>(*fd), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("constant_branch").value();
+    for (std::int64_t i = -5; i < 5; ++i) {
+        ASSERT_EQ(fn(i), i + 1);
+    }
+}
+
+/**
+ * 'x' is assigned in the loop only under a condition which never holds,
+ * so it is a constant only if the propagation ignores the edges which cannot execute.
+ */
+static Module loop_constant() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "loop_constant", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto i = data.alloc(ty);
+    const auto x = data.alloc(ty);
+    data.store(i, Value::i64(0));
+    data.store(x, Value::i64(7));
+
+    const auto cond = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto update = data.create_basic_block();
+    const auto next = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(cond);
+
+    data.switch_block(cond);
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.load(ty, i), data.arg(0)), body, end);
+
+    data.switch_block(body);
+    data.br_cond(data.icmp(IcmpPredicate::Ne, data.load(ty, x), Value::i64(7)), update, next);
+
+    data.switch_block(update);
+    data.store(x, data.add(data.load(ty, x), Value::i64(1)));
+    data.br(next);
+
+    data.switch_block(next);
+    data.store(i, data.add(data.load(ty, i), Value::i64(1)));
+    data.br(cond);
+
+    data.switch_block(end);
+    data.ret(data.mul(data.load(ty, x), Value::i64(2)));
+    return builder.build();
+}
+
+TEST(SCCP, constant_through_loop) {
+    auto module = loop_constant();
+    run_passes<Mem2Reg, SCCP>(module);
+
+    const auto fd = module.find_function_data("loop_constant").value();
+    ASSERT_EQ(fd->size(), 5);
+    ASSERT_EQ(count_instructions<Binary>(*fd), 1);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("loop_constant").value();
+    for (std::int64_t n = 0; n < 5; ++n) {
+        ASSERT_EQ(fn(n), 14);
+    }
+}
+
+static Module select_flag() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "select_flag", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto cond = data.icmp(IcmpPredicate::Lt, Value::i64(3), Value::i64(4));
+    const auto selected = data.select(cond, data.arg(0), Value::i64(0));
+    const auto as_int = data.flag2int(ty, cond);
+    data.ret(data.add(selected, as_int));
+    return builder.build();
+}
+
+TEST(SCCP, fold_select_and_flag) {
+    auto module = select_flag();
+    run_passes<Mem2Reg, SCCP>(module);
+
+    const auto fd = module.find_function_data("select_flag").value();
+    ASSERT_EQ(count_instructions<Select>(*fd), 0);
+    ASSERT_EQ(count_instructions<IcmpInstruction>(*fd), 0);
+    ASSERT_EQ(count_instructions<Unary>(*fd), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("select_flag").value();
+    ASSERT_EQ(fn(41), 42);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "lir/x64/lir.h"
+#include "lir/x64/codegen/ShrinkWrapping.h"
+#include "lir/x64/transform/callinfo/CallInfoInitialize.h"
+#include "lir/x64/transform/regalloc/LinearScan.h"
+#include "lir/x64/transform/regalloc/Spilling.h"
+#include "helpers/Jit.h"
+
+struct Blocks final {
+    BasicBlock* fast;
+    BasicBlock* slow;
+};
+
+static void id(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.arg(0));
+}
+
+/**
+ * if (n < 0) return -1;
+ * b = a * 3;
+ * return id(n) + b;
+ */
+static Module early_return(Blocks& blocks) {
+    ModuleBuilder builder;
+    id(builder);
+
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "early_return", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    blocks = Blocks{
+        data.create_basic_block(),
+        data.create_basic_block(),
+    };
+    data.br_cond(data.icmp(IcmpPredicate::Lt, n, Value::i64(0)), blocks.fast, blocks.slow);
+
+    data.switch_block(blocks.slow);
+    const auto b = data.mul(a, Value::i64(3));
+    const auto t = data.call(id_prototype, {n});
+    const auto join = data.create_basic_block();
+    data.br(join);
+
+    data.switch_block(join);
+    const auto sum = data.add(t, b);
+    const auto exit = data.create_basic_block();
+    data.br(exit);
+
+    data.switch_block(blocks.fast);
+    data.br(exit);
+
+    data.switch_block(exit);
+    data.ret(data.phi(ty, {Value::i64(-1), sum}, {blocks.fast, join}));
+    return builder.build();
+}
+
+/**
+ * for (i = 0; i < n; i++) s += id(i) * a;
+ */
+static Module call_in_loop() {
+    ModuleBuilder builder;
+    id(builder);
+
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "call_in_loop", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto s = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto end = data.create_basic_block();
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto x = data.call(id_prototype, {i});
+    const auto latch = data.create_basic_block();
+    data.br(latch);
+
+    data.switch_block(latch);
+    const auto next_s = data.add(s, data.mul(x, a));
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(s);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, latch);
+    dynamic_cast<Phi*>(s.get<ValueInstruction*>())->add_incoming(next_s, latch);
+    return builder.build();
+}
+
+TEST(ShrinkWrapping, prologue_moves_to_slow_path) {
+    Blocks blocks{};
+    const auto module = early_return(blocks);
+
+    Lowering lower(module);
+    lower.run();
+    auto lir = lower.result();
+    const auto func = lir.find_function_data("early_return").value();
+
+    auto spilling = Spilling::create(func, call_conv::CC_LinuxX64());
+    spilling.run();
+
+    aasm::SymbolTable symbol_table;
+    LIRAnalysisPassManager cache;
+    auto linear_scan = LinearScan::create(&cache, func, symbol_table, call_conv::CC_LinuxX64());
+    linear_scan.run();
+    auto call_info = CallInfoInitialize::create(&cache, func, call_conv::CC_LinuxX64());
+    call_info.run();
+
+    auto shrink_wrapping = ShrinkWrapping::create(&cache, func, call_conv::CC_LinuxX64());
+    shrink_wrapping.run();
+    const auto frame = shrink_wrapping.result();
+    // Lowering keeps the ids of the blocks when none were removed.
+    ASSERT_EQ(frame.save_block()->id(), blocks.slow->id());
+
+    for (const auto& bb: func->basic_blocks()) {
+        ASSERT_EQ(frame.bypasses(&bb), bb.id() == blocks.fast->id());
+    }
+}
+
+TEST(ShrinkWrapping, early_return) {
+    Blocks blocks{};
+    const auto module = early_return(blocks);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("early_return").value();
+    ASSERT_EQ(fn(-5, 2), -1);
+    ASSERT_EQ(fn(4, 2), 10);
+    ASSERT_EQ(fn(0, 7), 21);
+}
+
+TEST(CalleeSavedPreference, call_in_loop) {
+    const auto module = call_in_loop();
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("call_in_loop").value();
+    ASSERT_EQ(fn(10, 2), 90);
+    ASSERT_EQ(fn(0, 2), 0);
+    ASSERT_EQ(fn(100, 1), 4950);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "mir/mir.h"
+#include "mir/transform/PassManager.h"
+#include "mir/transform/SimplifyCFG.h"
+#include "helpers/Jit.h"
+#include "helpers/Mir.h"
+
+/**
+ * One side of the diamond reaches the merge point through two empty blocks.
+ * The last one holds the copy of the phi node, so only the first one is bypassed.
+ */
+static Module forwarding_blocks() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "forwarding_blocks", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto on_true = data.create_basic_block();
+    const auto jump = data.create_basic_block();
+    const auto on_false = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br_cond(data.icmp(IcmpPredicate::Lt, data.arg(0), data.arg(1)), on_true, on_false);
+
+    data.switch_block(on_true);
+    data.br(jump);
+
+    data.switch_block(jump);
+    data.br(end);
+
+    data.switch_block(on_false);
+    const auto doubled = data.mul(data.arg(0), Value::i64(2));
+    data.br(end);
+
+    data.switch_block(end);
+    data.ret(data.phi(ty, {Value::i64(1), doubled}, {jump, on_false}));
+    return builder.build();
+}
+
+TEST(SimplifyCFG, bypass_empty_blocks) {
+    auto module = forwarding_blocks();
+    run_passes<SimplifyCFG>(module);
+
+    const auto fd = module.find_function_data("forwarding_blocks").value();
+    ASSERT_EQ(fd->size(), 4);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("forwarding_blocks").value();
+    ASSERT_EQ(fn(1, 2), 1);
+    ASSERT_EQ(fn(5, 2), 10);
+}
+
+static Module straight_line() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "straight_line", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto first = data.create_basic_block();
+    const auto second = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    const auto x = data.add(data.arg(0), Value::i64(1));
+    data.br(first);
+
+    data.switch_block(first);
+    const auto y = data.mul(x, Value::i64(3));
+    data.br(second);
+
+    data.switch_block(second);
+    const auto z = data.phi(ty, {y}, {first});
+    const auto w = data.add(z, Value::i64(4));
+    data.br(end);
+
+    data.switch_block(end);
+    data.ret(w);
+    return builder.build();
+}
+
+TEST(SimplifyCFG, merge_blocks) {
+    auto module = straight_line();
+    run_passes<SimplifyCFG>(module);
+
+    const auto fd = module.find_function_data("straight_line").value();
+    ASSERT_EQ(fd->size(), 2);
+    ASSERT_EQ(count_instructions<Phi>(*fd), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("straight_line").value();
+    ASSERT_EQ(fn(1), 10);
+}
+
+static Module constant_branch() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "constant_branch", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto on_true = data.create_basic_block();
+    const auto on_false = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br_cond(data.icmp(IcmpPredicate::Eq, Value::i64(1), Value::i64(2)), on_true, on_false);
+
+    data.switch_block(on_true);
+    const auto inc = data.add(data.arg(0), Value::i64(1));
+    data.br(end);
+
+    data.switch_block(on_false);
+    const auto dec = data.sub(data.arg(0), Value::i64(1));
+    data.br(end);
+
+    data.switch_block(end);
+    data.ret(data.phi(ty, {inc, dec}, {on_true, on_false}));
+    return builder.build();
+}
+
+TEST(SimplifyCFG, fold_constant_branch) {
+    auto module = constant_branch();
+    run_passes<SimplifyCFG>(module);
+
+    const auto fd = module.find_function_data("constant_branch").value();
+    ASSERT_EQ(fd->size(), 2);
+    ASSERT_EQ(count_instructions<IcmpInstruction>(*fd), 0);
+    ASSERT_EQ(count_instructions<CondBranch>(*fd), 0);
+
+    const auto buffer = jit_compile_and_assembly(module);
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("constant_branch").value();
+    ASSERT_EQ(fn(5), 4);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
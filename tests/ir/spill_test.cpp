@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <ranges>
+
+#include "helpers/Jit.h"
+#include "mir/mir.h"
+
+static constexpr std::int64_t VALUES = 24;
+
+/**
+ * Defines more values in the entry block than there are registers and uses all of them in the successors.
+ */
+static Module high_pressure() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "high_pressure", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    std::vector<Value> values;
+    for (std::int64_t i = 0; i < VALUES; ++i) {
+        values.push_back(data.add(data.arg(0), Value::i64(i)));
+    }
+
+    const auto positive = data.create_basic_block();
+    const auto negative = data.create_basic_block();
+    data.br_cond(data.icmp(IcmpPredicate::Gt, data.arg(0), Value::i64(0)), positive, negative);
+
+    data.switch_block(positive);
+    auto sum = values.front();
+    for (const auto& value: values | std::views::drop(1)) {
+        sum = data.add(sum, value);
+    }
+    for (const auto& value: values) {
+        sum = data.add(sum, value);
+    }
+    data.ret(sum);
+
+    data.switch_block(negative);
+    auto neg_sum = values.front();
+    for (const auto& value: values | std::views::drop(1)) {
+        neg_sum = data.add(neg_sum, value);
+    }
+    data.ret(neg_sum);
+    return builder.build();
+}
+
+/**
+ * Keeps all the values live at once inside the single block, they are summed in reverse order of definition.
+ */
+static Module single_block_pressure() {
+    ModuleBuilder builder;
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "single_block_pressure", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+
+    std::vector<Value> values;
+    for (std::int64_t i = 0; i < VALUES; ++i) {
+        values.push_back(data.add(data.arg(0), Value::i64(i)));
+    }
+
+    auto sum = values.back();
+    for (const auto& value: values | std::views::reverse | std::views::drop(1)) {
+        sum = data.sub(value, sum);
+    }
+    data.ret(sum);
+    return builder.build();
+}
+
+static std::int64_t expected_sum(const std::int64_t arg) {
+    return VALUES * arg + VALUES * (VALUES - 1) / 2;
+}
+
+TEST(Spill, values_across_blocks) {
+    const auto buffer = jit_compile_and_assembly(high_pressure());
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("high_pressure").value();
+    for (const std::int64_t arg: {1, 7, 100}) {
+        ASSERT_EQ(fn(arg), 2 * expected_sum(arg)) << arg;
+    }
+}
+
+TEST(Spill, reload_in_each_block) {
+    const auto buffer = jit_compile_and_assembly(high_pressure());
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("high_pressure").value();
+    for (const std::int64_t arg: {0, -1, -50}) {
+        ASSERT_EQ(fn(arg), expected_sum(arg)) << arg;
+    }
+}
+
+TEST(Spill, values_in_one_block) {
+    const auto buffer = jit_compile_and_assembly(single_block_pressure());
+    const auto fn = buffer.code_start_as<std::int64_t(std::int64_t)>("single_block_pressure").value();
+    for (const std::int64_t arg: {0, 3, -20}) {
+        // Alternating signs: (a + 0) - (a + 1) + (a + 2) - ... - (a + 23).
+        ASSERT_EQ(fn(arg), -VALUES / 2) << arg;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "lir/x64/asm/jit/TieredModule.h"
+#include "mir/mir.h"
+
+static std::int64_t external_neg(const std::int64_t x) {
+    return -x;
+}
+
+static const std::unordered_map<std::string, std::size_t> EXTERNAL_SYMBOLS{
+    {"external_neg", reinterpret_cast<std::size_t>(&external_neg)},
+};
+
+static void id(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.arg(0));
+}
+
+/**
+ * s = 0;
+ * for (i = 0; i < n; i++)
+ *     s += id(i) * a + K;
+ * return s;
+ */
+static void sum_loop(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto id_prototype = builder.add_function_prototype(ty, {ty}, "id", FunctionBind::DEFAULT);
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty}, "sum_loop", FunctionBind::DEFAULT);
+    const auto constant = builder.add_constant("K", ty, 3).value();
+    auto data = builder.make_function_builder(prototype).value();
+
+    const auto n = data.arg(0);
+    const auto a = data.arg(1);
+    const auto entry = data.create_basic_block();
+    const auto header = data.create_basic_block();
+    const auto body = data.create_basic_block();
+    const auto end = data.create_basic_block();
+    data.br(entry);
+
+    data.switch_block(entry);
+    data.br(header);
+
+    data.switch_block(header);
+    const auto i = data.phi(ty, {Value::i64(0)}, {entry});
+    const auto s = data.phi(ty, {Value::i64(0)}, {entry});
+    data.br_cond(data.icmp(IcmpPredicate::Lt, i, n), body, end);
+
+    data.switch_block(body);
+    const auto call = data.call(id_prototype, {i});
+    const auto latch = data.create_basic_block();
+    data.br(latch);
+
+    data.switch_block(latch);
+    const auto x = data.mul(call, a);
+    const auto next_s = data.add(s, data.add(x, data.load(ty, constant)));
+    const auto next_i = data.add(i, Value::i64(1));
+    data.br(header);
+
+    data.switch_block(end);
+    data.ret(s);
+
+    dynamic_cast<Phi*>(i.get<ValueInstruction*>())->add_incoming(next_i, latch);
+    dynamic_cast<Phi*>(s.get<ValueInstruction*>())->add_incoming(next_s, latch);
+}
+
+static void neg_twice(ModuleBuilder& builder) {
+    const auto ty = SignedIntegerType::i64();
+    const auto neg_prototype = builder.add_function_prototype(ty, {ty}, "external_neg", FunctionBind::EXTERN);
+    const auto prototype = builder.add_function_prototype(ty, {ty}, "neg_twice", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    const auto x = data.call(neg_prototype, {data.arg(0)});
+    data.ret(data.add(x, x));
+}
+
+static void fma_like(ModuleBuilder& builder) {
+    const auto ty = FloatingPointType::f64();
+    const auto prototype = builder.add_function_prototype(ty, {ty, ty, ty}, "fma_like", FunctionBind::DEFAULT);
+    auto data = builder.make_function_builder(prototype).value();
+    data.ret(data.add(data.mul(data.arg(0), data.arg(1)), data.arg(2)));
+}
+
+static Module tiered_module() {
+    ModuleBuilder builder;
+    id(builder);
+    sum_loop(builder);
+    neg_twice(builder);
+    fma_like(builder);
+    return builder.build();
+}
+
+static std::int64_t expected_sum(const std::int64_t n, const std::int64_t a) {
+    std::int64_t s{};
+    for (std::int64_t i{}; i < n; i++) {
+        s += i * a + 3;
+    }
+
+    return s;
+}
+
+TEST(TieredCompilation, baseline_is_correct) {
+    const auto module = tiered_module();
+    const auto tiered = TieredModule::compile(module, EXTERNAL_SYMBOLS);
+
+    const auto sum = tiered.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(0, 5), 0);
+    ASSERT_EQ(sum(10, 7), expected_sum(10, 7));
+
+    const auto neg = tiered.code_start_as<std::int64_t(std::int64_t)>("neg_twice").value();
+    ASSERT_EQ(neg(21), -42);
+
+    const auto fma = tiered.code_start_as<double(double, double, double)>("fma_like").value();
+    ASSERT_DOUBLE_EQ(fma(2.0, 3.0, 0.5), 6.5);
+}
+
+TEST(TieredCompilation, counts_invocations) {
+    const auto module = tiered_module();
+    const auto tiered = TieredModule::compile(module, EXTERNAL_SYMBOLS);
+
+    const auto sum = tiered.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(4, 1), expected_sum(4, 1));
+    ASSERT_EQ(sum(2, 1), expected_sum(2, 1));
+    ASSERT_EQ(tiered.invocation_count("sum_loop"), 2);
+    ASSERT_EQ(tiered.invocation_count("id"), 6);
+    ASSERT_EQ(tiered.invocation_count("neg_twice"), 0);
+    ASSERT_EQ(tiered.invocation_count("unknown"), 0);
+}
+
+TEST(TieredCompilation, tier_up_hot_functions) {
+    const auto module = tiered_module();
+    auto tiered = TieredModule::compile(module, EXTERNAL_SYMBOLS, 10);
+
+    const auto sum = tiered.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    const auto neg = tiered.code_start_as<std::int64_t(std::int64_t)>("neg_twice").value();
+    ASSERT_EQ(tiered.tier_up(), 0);
+
+    for (std::int64_t n{}; n < 10; n++) {
+        ASSERT_EQ(sum(n, 2), expected_sum(n, 2));
+    }
+    ASSERT_EQ(neg(1), -2);
+
+    // 'sum_loop' and 'id' are hot, 'neg_twice' isn't.
+    ASSERT_EQ(tiered.tier_up(), 2);
+    ASSERT_TRUE(tiered.is_optimized("sum_loop"));
+    ASSERT_TRUE(tiered.is_optimized("id"));
+    ASSERT_FALSE(tiered.is_optimized("neg_twice"));
+
+    // The patched entries jump to the optimized code, the baseline counters stop growing.
+    const auto count = tiered.invocation_count("sum_loop");
+    ASSERT_EQ(sum(100, 3), expected_sum(100, 3));
+    ASSERT_EQ(neg(5), -10);
+    ASSERT_EQ(tiered.invocation_count("sum_loop"), count);
+    ASSERT_EQ(tiered.tier_up(), 0);
+}
+
+TEST(TieredCompilation, optimized_code_calls_baseline) {
+    const auto module = tiered_module();
+    auto tiered = TieredModule::compile(module, EXTERNAL_SYMBOLS, 3);
+
+    const auto sum = tiered.code_start_as<std::int64_t(std::int64_t, std::int64_t)>("sum_loop").value();
+    ASSERT_EQ(sum(0, 4), 0);
+    ASSERT_EQ(sum(0, 4), 0);
+    ASSERT_EQ(sum(1, 4), expected_sum(1, 4));
+
+    // Only the caller is hot, the optimized 'sum_loop' still calls the baseline 'id'.
+    ASSERT_EQ(tiered.invocation_count("id"), 1);
+    ASSERT_EQ(tiered.tier_up(), 1);
+    ASSERT_FALSE(tiered.is_optimized("id"));
+    ASSERT_EQ(sum(2, 4), expected_sum(2, 4));
+    ASSERT_EQ(tiered.invocation_count("id"), 3);
+
+    ASSERT_EQ(tiered.tier_up(), 1);
+    ASSERT_TRUE(tiered.is_optimized("id"));
+    ASSERT_EQ(sum(50, 4), expected_sum(50, 4));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}